@@ -0,0 +1,180 @@
+#include "cascade.hpp"
+
+// the world is simulated in units of 10 pixels, so the card sizes and speeds stay in the range bullet is tuned for
+static constexpr auto pixels_per_unit = 10.0f;
+
+static constexpr auto fixed_step    = 1.0f / 120.0f;
+static constexpr auto max_sub_steps = 8;
+
+// the mesh of a card is scaled by 130 on the board, the cascade cards are a tenth of that
+static constexpr auto card_scale       = 13.0f;
+static constexpr auto card_half_width  = 0.5f   * card_scale / pixels_per_unit;
+static constexpr auto card_half_height = 0.746f * card_scale / pixels_per_unit;
+// the cards move on the screen plane only, so their collision boxes are deep, otherwise two overlapping cards would be pushed apart along the locked z axis
+static constexpr auto card_half_depth  = 1.0f;
+
+static constexpr auto card_mass = 1.0f;
+
+static_assert(std::is_same_v<btScalar, float>, "the model matrices are written straight from the bullet transforms");
+
+class cascade_world final : public btDiscreteDynamicsWorldMt
+{
+public:
+    using btDiscreteDynamicsWorldMt::btDiscreteDynamicsWorldMt;
+
+    // the same time btDiscreteDynamicsWorld::synchronizeSingleMotionState integrates the transforms over
+    [[nodiscard]] auto interpolation_time() const -> btScalar
+    {
+        return m_latencyMotionStateInterpolation && m_fixedTimeStep ? m_localTime - m_fixedTimeStep : m_localTime;
+    }
+};
+
+cascade::cascade(const float width, const float height, const random_generator random) : random(random)
+{
+    collision_configuration = std::make_unique<btDefaultCollisionConfiguration>();
+    dispatcher              = std::make_unique<btCollisionDispatcherMt>(collision_configuration.get());
+    broadphase              = std::make_unique<btDbvtBroadphase>();
+    solver_pool             = std::make_unique<btConstraintSolverPoolMt>(btGetTaskScheduler()->getNumThreads());
+    solver                  = std::make_unique<btSequentialImpulseConstraintSolverMt>(); // solves the pile, which ends up being one large island
+
+    world = std::make_unique<cascade_world>(dispatcher.get(), broadphase.get(), solver_pool.get(), solver.get(), collision_configuration.get());
+    world->setGravity(btVector3(0.0f, -200.0f, 0.0f));
+    world->getDispatchInfo().m_deterministicOverlappingPairs = true;
+
+    // fast cards are clamped to their time of impact with the pairs of their swept aabbs, instead of a sweep test per card
+    world->setUseSweptPairCcd(true);
+
+    card_shape = std::make_unique<btBoxShape>(btVector3(card_half_width, card_half_height, card_half_depth));
+
+    const auto half_width  = width  / pixels_per_unit / 2.0f;
+    const auto half_height = height / pixels_per_unit / 2.0f;
+
+    // the floor and the side walls are as large as the screen, and sit right outside of it
+    wall_shape = std::make_unique<btBoxShape>(btVector3(half_width, half_height, half_width));
+
+    add_wall(btVector3(     half_width, -half_height, 0.0f));
+    add_wall(btVector3(    -half_width,  half_height, 0.0f));
+    add_wall(btVector3(3 * half_width,  half_height, 0.0f));
+}
+
+cascade::~cascade()
+{
+    clear();
+
+    for (const auto& wall : walls)
+    {
+        world->removeRigidBody(wall.get());
+    }
+}
+
+auto cascade::add_wall(const btVector3& position) -> void
+{
+    btTransform transform;
+    transform.setIdentity();
+    transform.setOrigin(position);
+
+    btRigidBody::btRigidBodyConstructionInfo info(0.0f, nullptr, wall_shape.get());
+    info.m_startWorldTransform = transform;
+
+    auto& wall = walls.emplace_back(std::make_unique<btRigidBody>(info));
+
+    world->addRigidBody(wall.get());
+}
+
+auto cascade::spawn(const glm::vec3& position, const glm::vec3& color, const int32_t count) -> void
+{
+    btVector3 inertia;
+    card_shape->calculateLocalInertia(card_mass, inertia);
+
+    bodies.reserve(bodies.size() + count);
+
+    for (auto i = 0; i < count; i++)
+    {
+        const auto offset = random.uniform(glm::vec2(-4.0f), glm::vec2(4.0f));
+
+        btTransform transform;
+        transform.setIdentity();
+        transform.setOrigin(btVector3(position.x / pixels_per_unit + offset.x, position.y / pixels_per_unit + offset.y, 0.0f));
+        transform.setRotation(btQuaternion(btVector3(0.0f, 0.0f, 1.0f), random.uniform(0.0f, glm::two_pi<float>())));
+
+        // no motion state, the models are read from the world transforms
+        btRigidBody::btRigidBodyConstructionInfo info(card_mass, nullptr, card_shape.get(), inertia);
+        info.m_startWorldTransform = transform;
+        info.m_friction            = 0.6f;
+        info.m_restitution         = 0.2f;
+
+        auto& body = bodies.emplace_back(std::make_unique<btRigidBody>(info));
+
+        // the cards tumble on the screen plane, so they stack instead of sliding behind each other
+        body->setLinearFactor(btVector3(1.0f, 1.0f, 0.0f));
+        body->setAngularFactor(btVector3(0.0f, 0.0f, 1.0f));
+
+        const auto velocity = random.uniform(glm::vec2(-40.0f, 0.0f), glm::vec2(40.0f, 60.0f));
+
+        body->setLinearVelocity(btVector3(velocity.x, velocity.y, 0.0f));
+        body->setAngularVelocity(btVector3(0.0f, 0.0f, random.uniform(-10.0f, 10.0f)));
+
+        // a card that moves more than half of its width in a sub step could pass through another one
+        body->setCcdMotionThreshold(card_half_width);
+
+        world->addRigidBody(body.get());
+
+        body_colors.emplace_back(color);
+    }
+
+    body_models.resize(bodies.size());
+
+    update_models();
+}
+
+auto cascade::update(const double delta_time) -> void
+{
+    if (bodies.empty())
+    {
+        return;
+    }
+
+    world->stepSimulation(static_cast<btScalar>(delta_time), max_sub_steps, fixed_step);
+
+    update_models();
+}
+
+auto cascade::clear() -> void
+{
+    for (const auto& body : bodies)
+    {
+        world->removeRigidBody(body.get());
+    }
+
+    bodies.clear();
+
+    body_models.clear();
+    body_colors.clear();
+}
+
+auto cascade::update_models() -> void
+{
+    const auto time = world->interpolation_time();
+
+    for (size_t i = 0; i < bodies.size(); i++)
+    {
+        const auto& body = *bodies[i];
+
+        auto& model = body_models[i];
+
+        if (body.isActive())
+        {
+            btTransform transform;
+            btTransformUtil::integrateTransform(body.getInterpolationWorldTransform(), body.getInterpolationLinearVelocity(), body.getInterpolationAngularVelocity(), time, transform);
+
+            transform.getOpenGLMatrix(glm::value_ptr(model));
+        }
+        else
+        {
+            body.getWorldTransform().getOpenGLMatrix(glm::value_ptr(model));
+        }
+
+        model[3] = glm::vec4(glm::vec3(model[3]) * pixels_per_unit, 1.0f);
+        model    = glm::scale(model, glm::vec3(card_scale, card_scale, 1.0f));
+    }
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include "random.hpp"
+
+class cascade_world;
+
+// the end of round effect - every matched card bursts into small cards that tumble down and pile up at the bottom of the screen
+// the bodies are simulated by a multithreaded dynamics world with a fixed sub step, and have no motion states: their model
+// matrices are written straight from the rigid body transforms in to one contiguous array that the renderer reads
+class cascade
+{
+public:
+    // the cards burst in random directions drawn from the given generator
+    cascade(float width, float height, random_generator random);
+    ~cascade();
+
+    cascade(const cascade&) = delete;
+
+    auto operator=(const cascade&) -> cascade& = delete;
+
+    auto spawn(const glm::vec3& position, const glm::vec3& color, int32_t count) -> void;
+
+    auto update(double delta_time) -> void;
+
+    auto clear() -> void;
+
+    [[nodiscard]] auto size() const -> size_t
+    {
+        return bodies.size();
+    }
+
+    [[nodiscard]] auto empty() const -> bool
+    {
+        return bodies.empty();
+    }
+
+    [[nodiscard]] auto models() const -> const std::vector<glm::mat4>&
+    {
+        return body_models;
+    }
+
+    [[nodiscard]] auto colors() const -> const std::vector<glm::vec3>&
+    {
+        return body_colors;
+    }
+
+private:
+    std::unique_ptr<btDefaultCollisionConfiguration>       collision_configuration;
+    std::unique_ptr<btCollisionDispatcherMt>               dispatcher;
+    std::unique_ptr<btDbvtBroadphase>                      broadphase;
+    std::unique_ptr<btConstraintSolverPoolMt>              solver_pool;
+    std::unique_ptr<btSequentialImpulseConstraintSolverMt> solver;
+    std::unique_ptr<cascade_world>                         world;
+
+    std::unique_ptr<btBoxShape> card_shape;
+    std::unique_ptr<btBoxShape> wall_shape;
+
+    std::vector<std::unique_ptr<btRigidBody>> walls;
+    std::vector<std::unique_ptr<btRigidBody>> bodies;
+
+    random_generator random;
+
+    std::vector<glm::mat4> body_models;
+    std::vector<glm::vec3> body_colors;
+
+    auto add_wall(const btVector3& position) -> void;
+
+    auto update_models() -> void;
+};
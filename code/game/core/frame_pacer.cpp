@@ -0,0 +1,124 @@
+#include "frame_pacer.hpp"
+
+// the spin margin is the average oversleep plus two deviations, it never drops under half a millisecond, a sleep that short is rarely on time
+static constexpr auto initial_oversleep   = 0.002;
+static constexpr auto minimal_spin_margin = 0.0005;
+static constexpr auto oversleep_weight    = 0.1;
+
+// after a long stall the simulation catches up by at most this much, instead of running a burst of steps
+static constexpr auto max_accumulated_time = 0.25;
+
+frame_pacer::frame_pacer(const double frame_rate, const double step_rate, const double time_scale)
+    : frame_period(std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(1.0 / frame_rate)))
+    , spin_margin(std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(initial_oversleep)))
+    , oversleep_mean(initial_oversleep)
+    , frame_start(clock::now())
+    , next_frame(frame_start + frame_period)
+    , fixed_step(1.0 / step_rate)
+    , time_scale(time_scale)
+    , statistics_start(frame_start)
+{
+}
+
+auto frame_pacer::begin_frame() -> double
+{
+    auto now = clock::now();
+
+    if (next_frame - now > spin_margin)
+    {
+        const auto sleep = next_frame - now - spin_margin;
+
+        std::this_thread::sleep_for(sleep);
+
+        const auto woken = clock::now();
+
+        slept += woken - now;
+
+        const auto oversleep = std::chrono::duration<double>(woken - now - sleep).count();
+        const auto deviation = oversleep - oversleep_mean;
+
+        oversleep_mean     += oversleep_weight * deviation;
+        oversleep_variance  = (1.0 - oversleep_weight) * (oversleep_variance + oversleep_weight * deviation * deviation);
+
+        const auto margin = std::max(oversleep_mean + 2.0 * std::sqrt(oversleep_variance), minimal_spin_margin);
+
+        spin_margin = std::min(std::chrono::duration_cast<clock::duration>(std::chrono::duration<double>(margin)), frame_period);
+
+        now = woken;
+    }
+
+    while (now < next_frame)
+    {
+        now = clock::now();
+    }
+
+    const auto delta_time = std::chrono::duration<double>(now - frame_start).count();
+
+    // a frame that ran late starts the schedule over, so the next frames aren't rushed to catch up with it
+    next_frame  = now - next_frame >= frame_period ? now + frame_period : next_frame + frame_period;
+    frame_start = now;
+
+    accumulator = std::min(accumulator + delta_time * time_scale, max_accumulated_time * time_scale);
+    frame_steps = static_cast<int32_t>(accumulator / fixed_step);
+    accumulator -= frame_steps * fixed_step;
+
+    frames++;
+
+    const auto delta = delta_time - frame_time_mean;
+
+    frame_time_mean += delta / frames;
+    frame_time_m2   += delta * (delta_time - frame_time_mean);
+    frame_time_max   = std::max(frame_time_max, delta_time);
+
+    return delta_time * time_scale;
+}
+
+auto frame_pacer::end_frame(const std::optional<double> input_latency) -> void
+{
+    if (!input_latency)
+    {
+        return;
+    }
+
+    input_frames++;
+
+    input_latency_sum += *input_latency;
+    input_latency_max  = std::max(input_latency_max, *input_latency);
+}
+
+auto frame_pacer::current_statistics() const -> statistics
+{
+    const auto duration = std::chrono::duration<double>(clock::now() - statistics_start).count();
+
+    statistics result;
+
+    result.duration = duration;
+    result.frames   = frames;
+
+    result.frame_time_mean      = frame_time_mean;
+    result.frame_time_deviation = frames > 0 ? std::sqrt(frame_time_m2 / frames) : 0.0;
+    result.frame_time_max       = frame_time_max;
+
+    result.input_frames       = input_frames;
+    result.input_latency_mean = input_frames > 0 ? input_latency_sum / input_frames : 0.0;
+    result.input_latency_max  = input_latency_max;
+
+    result.cpu_usage = duration > 0.0 ? 1.0 - std::chrono::duration<double>(slept).count() / duration : 0.0;
+
+    return result;
+}
+
+auto frame_pacer::reset_statistics() -> void
+{
+    statistics_start = clock::now();
+    slept            = { };
+
+    frames          = 0;
+    frame_time_mean = 0.0;
+    frame_time_m2   = 0.0;
+    frame_time_max  = 0.0;
+
+    input_frames      = 0;
+    input_latency_sum = 0.0;
+    input_latency_max = 0.0;
+}
@@ -0,0 +1,80 @@
+#pragma once
+
+// paces the frame thread to a target frame rate on the steady clock, and turns the time between frames in to fixed simulation steps
+// a frame waits by sleeping for most of the time left and spinning the rest - the os wakes a sleep up late by up to a scheduler tick,
+// so the spin margin follows a moving average of how late the sleeps wake up
+class frame_pacer
+{
+public:
+    using clock = std::chrono::steady_clock;
+
+    struct statistics
+    {
+        double  duration { }; // the seconds the statistics cover
+        int32_t frames   { };
+
+        double frame_time_mean      { };
+        double frame_time_deviation { };
+        double frame_time_max       { };
+
+        int32_t input_frames         { }; // the frames that handled input
+        double  input_latency_mean   { };
+        double  input_latency_max    { };
+
+        double cpu_usage { }; // the part of the time the frame thread was not sleeping, spinning counts as busy
+    };
+
+    // the simulation runs time_scale times faster than the steady clock, replays are run accelerated with it
+    frame_pacer(double frame_rate, double step_rate, double time_scale = 1.0);
+
+    // waits until the next frame is due and starts it, returns the simulated seconds since the previous frame started
+    auto begin_frame() -> double;
+
+    // ends the frame once it was presented, with the seconds since the oldest input event the frame handled
+    auto end_frame(std::optional<double> input_latency = std::nullopt) -> void;
+
+    // the statistics of the frames since the last reset
+    [[nodiscard]] auto current_statistics() const -> statistics;
+
+    auto reset_statistics() -> void;
+
+    // the fixed steps the simulation advances this frame, the rest of the time is kept for the next frames
+    [[nodiscard]] auto steps() const -> int32_t
+    {
+        return frame_steps;
+    }
+
+    [[nodiscard]] auto step() const -> double
+    {
+        return fixed_step;
+    }
+
+private:
+    clock::duration frame_period;
+    clock::duration spin_margin;
+
+    // the exponentially weighted mean and variance of the oversleep, in seconds
+    double oversleep_mean;
+    double oversleep_variance { };
+
+    clock::time_point frame_start;
+    clock::time_point next_frame;
+
+    double  fixed_step;
+    double  time_scale;
+    double  accumulator { };
+    int32_t frame_steps { };
+
+    // the statistics since the last reset, the frame times are accumulated with welford's method
+    clock::time_point statistics_start;
+    clock::duration   slept { };
+
+    int32_t frames { };
+    double  frame_time_mean { };
+    double  frame_time_m2   { };
+    double  frame_time_max  { };
+
+    int32_t input_frames { };
+    double  input_latency_sum { };
+    double  input_latency_max { };
+};
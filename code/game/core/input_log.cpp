@@ -0,0 +1,339 @@
+#include "input_log.hpp"
+
+static constexpr std::array<char, 4> log_magic { 'M', '2', 'I', 'L' };
+
+static constexpr uint8_t log_version = 1;
+
+// the record types of the log, an event record is followed by the fields its input event type uses
+enum record_type : uint8_t
+{
+    end_record,
+    key_record,
+    mouse_button_record,
+    cursor_pos_record,
+    cursor_enter_record,
+    scroll_record
+};
+
+static constexpr uint64_t microseconds_per_second = 1000000;
+
+// the log is little endian, the times are unsigned leb128 and the positions are floats, the cursor is at whole pixels
+static auto write_u8(std::ofstream& file, const uint8_t value) -> void
+{
+    file.put(static_cast<char>(value));
+}
+
+static auto write_u32(std::ofstream& file, const uint32_t value) -> void
+{
+    for (auto i = 0; i < 4; i++)
+    {
+        write_u8(file, static_cast<uint8_t>(value >> (8 * i)));
+    }
+}
+
+static auto write_varint(std::ofstream& file, uint64_t value) -> void
+{
+    while (value >= 0x80)
+    {
+        write_u8(file, static_cast<uint8_t>(value | 0x80));
+        value >>= 7;
+    }
+
+    write_u8(file, static_cast<uint8_t>(value));
+}
+
+static auto write_i16(std::ofstream& file, const int32_t value) -> void
+{
+    const auto bits = static_cast<uint16_t>(value);
+
+    write_u8(file, static_cast<uint8_t>(bits));
+    write_u8(file, static_cast<uint8_t>(bits >> 8));
+}
+
+static auto write_f32(std::ofstream& file, const double value) -> void
+{
+    const auto f32 = static_cast<float>(value);
+
+    uint32_t bits;
+    std::memcpy(&bits, &f32, sizeof(bits));
+
+    write_u32(file, bits);
+}
+
+// reads the log, and throws at its end, so a truncated log isn't replayed in part
+class log_reader
+{
+public:
+    explicit log_reader(std::vector<uint8_t> data) : data(std::move(data)) { }
+
+    auto u8() -> uint8_t
+    {
+        if (position == data.size())
+        {
+            throw std::runtime_error("the input log is truncated");
+        }
+
+        return data[position++];
+    }
+
+    auto u32() -> uint32_t
+    {
+        uint32_t value = 0;
+
+        for (auto i = 0; i < 4; i++)
+        {
+            value |= static_cast<uint32_t>(u8()) << (8 * i);
+        }
+
+        return value;
+    }
+
+    auto varint() -> uint64_t
+    {
+        uint64_t value = 0;
+
+        for (auto shift = 0; shift < 64; shift += 7)
+        {
+            const auto byte = u8();
+
+            value |= static_cast<uint64_t>(byte & 0x7f) << shift;
+
+            if ((byte & 0x80) == 0)
+            {
+                return value;
+            }
+        }
+
+        throw std::runtime_error("the input log has an invalid time");
+    }
+
+    auto i16() -> int32_t
+    {
+        const auto low  = u8();
+        const auto high = u8();
+
+        return static_cast<int16_t>(static_cast<uint16_t>(low | high << 8));
+    }
+
+    auto f32() -> double
+    {
+        const auto bits = u32();
+
+        float value;
+        std::memcpy(&value, &bits, sizeof(value));
+
+        return value;
+    }
+
+private:
+    std::vector<uint8_t> data;
+    size_t position { };
+};
+
+input_recorder::input_recorder(const std::filesystem::path& path, const uint32_t seed) : file(path, std::ios::binary | std::ios::trunc)
+{
+    if (!file)
+    {
+        throw std::runtime_error("can't write the input log " + path.string());
+    }
+
+    file.write(log_magic.data(), log_magic.size());
+
+    write_u8(file, log_version);
+    write_u32(file, seed);
+
+    // the clock runs from here until the session starts, so a session that ends before it starts still has an end time
+    start();
+}
+
+input_recorder::~input_recorder()
+{
+    // glfw may be terminated by now, so the timer isn't read
+    if (!finished)
+    {
+        write_varint(file, 0);
+        write_u8(file, end_record);
+    }
+}
+
+auto input_recorder::start() -> void
+{
+    start_time = glfwGetTimerValue();
+    frequency  = glfwGetTimerFrequency();
+}
+
+auto input_recorder::finish() -> void
+{
+    if (finished)
+    {
+        return;
+    }
+
+    write_time(glfwGetTimerValue());
+    write_u8(file, end_record);
+
+    file.flush();
+
+    finished = true;
+}
+
+auto input_recorder::write_time(const uint64_t time) -> void
+{
+    // the events that were queued before the session started are at its start
+    const auto elapsed      = time > start_time ? time - start_time : 0;
+    const auto session_time = std::max(elapsed / frequency * microseconds_per_second + elapsed % frequency * microseconds_per_second / frequency, last_time);
+
+    write_varint(file, session_time - last_time);
+
+    last_time = session_time;
+}
+
+auto input_recorder::record(const GLFWinputevent& event) -> void
+{
+    write_time(event.time);
+
+    switch (event.type)
+    {
+        case GLFW_KEY_EVENT:
+            write_u8(file, key_record);
+            write_i16(file, event.key);
+            write_i16(file, event.scancode);
+            write_u8(file, static_cast<uint8_t>(event.action));
+            write_u8(file, static_cast<uint8_t>(event.mods));
+            break;
+        case GLFW_MOUSE_BUTTON_EVENT:
+            write_u8(file, mouse_button_record);
+            write_u8(file, static_cast<uint8_t>(event.button));
+            write_u8(file, static_cast<uint8_t>(event.action));
+            write_u8(file, static_cast<uint8_t>(event.mods));
+            break;
+        case GLFW_CURSOR_POS_EVENT:
+            write_u8(file, cursor_pos_record);
+            write_f32(file, event.xpos);
+            write_f32(file, event.ypos);
+            break;
+        case GLFW_CURSOR_ENTER_EVENT:
+            write_u8(file, cursor_enter_record);
+            write_u8(file, static_cast<uint8_t>(event.action));
+            break;
+        case GLFW_SCROLL_EVENT:
+            write_u8(file, scroll_record);
+            write_f32(file, event.xpos);
+            write_f32(file, event.ypos);
+            break;
+        default:
+            break;
+    }
+}
+
+input_replayer::input_replayer(const std::filesystem::path& path, const double speed) : speed(speed)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file)
+    {
+        throw std::runtime_error("can't read the input log " + path.string());
+    }
+
+    log_reader reader({ std::istreambuf_iterator(file), std::istreambuf_iterator<char>() });
+
+    for (const auto magic : log_magic)
+    {
+        if (reader.u8() != static_cast<uint8_t>(magic))
+        {
+            throw std::runtime_error(path.string() + " is not an input log");
+        }
+    }
+
+    if (reader.u8() != log_version)
+    {
+        throw std::runtime_error(path.string() + " is an input log of another version");
+    }
+
+    session_seed = reader.u32();
+
+    uint64_t time = 0;
+
+    while (true)
+    {
+        time += reader.varint();
+
+        const auto type = reader.u8();
+
+        if (type == end_record)
+        {
+            end_time = time;
+            break;
+        }
+
+        GLFWinputevent input { };
+
+        switch (type)
+        {
+            case key_record:
+                input.type     = GLFW_KEY_EVENT;
+                input.key      = reader.i16();
+                input.scancode = reader.i16();
+                input.action   = reader.u8();
+                input.mods     = reader.u8();
+                break;
+            case mouse_button_record:
+                input.type   = GLFW_MOUSE_BUTTON_EVENT;
+                input.button = reader.u8();
+                input.action = reader.u8();
+                input.mods   = reader.u8();
+                break;
+            case cursor_pos_record:
+                input.type = GLFW_CURSOR_POS_EVENT;
+                input.xpos = reader.f32();
+                input.ypos = reader.f32();
+                break;
+            case cursor_enter_record:
+                input.type   = GLFW_CURSOR_ENTER_EVENT;
+                input.action = reader.u8();
+                break;
+            case scroll_record:
+                input.type = GLFW_SCROLL_EVENT;
+                input.xpos = reader.f32();
+                input.ypos = reader.f32();
+                break;
+            default:
+                throw std::runtime_error(path.string() + " has an unknown record");
+        }
+
+        events.push_back({ time, input });
+    }
+}
+
+auto input_replayer::start() -> void
+{
+    start_time = glfwGetTimerValue();
+    frequency  = glfwGetTimerFrequency();
+}
+
+auto input_replayer::session_time() const -> uint64_t
+{
+    const auto elapsed = static_cast<double>(glfwGetTimerValue() - start_time) / static_cast<double>(frequency);
+
+    return static_cast<uint64_t>(elapsed * speed * microseconds_per_second);
+}
+
+auto input_replayer::poll(std::vector<GLFWinputevent>& due_events) -> void
+{
+    const auto time = session_time();
+
+    for (; next < events.size() && events[next].time <= time; next++)
+    {
+        auto input = events[next].input;
+
+        // the time the event would have been received at, on the clock of the replay
+        input.time = start_time + static_cast<uint64_t>(static_cast<double>(events[next].time) / speed / microseconds_per_second * static_cast<double>(frequency));
+
+        due_events.push_back(input);
+    }
+}
+
+auto input_replayer::finished() const -> bool
+{
+    return next == events.size() && session_time() >= end_time;
+}
@@ -0,0 +1,82 @@
+#pragma once
+
+// a session of input, kept in a compact binary log so the same session can be replayed to compare the frame times of builds
+// the log starts with the seed of the random number generator, then has the events of the session, each with the microseconds since
+// the previous one, and ends with the end of the session - the events are replayed through the same path as the live input
+class input_recorder
+{
+public:
+    // glfw has to be initialized, the recorder times the events with its timer
+    input_recorder(const std::filesystem::path& path, uint32_t seed);
+    ~input_recorder();
+
+    input_recorder(const input_recorder&) = delete;
+
+    auto operator=(const input_recorder&) -> input_recorder& = delete;
+
+    // starts the session clock, the events are timed from here
+    auto start() -> void;
+
+    auto record(const GLFWinputevent& event) -> void;
+
+    // ends the session with its length, glfw has to be initialized still - a recorder destroyed without it ends at its last event
+    auto finish() -> void;
+
+private:
+    std::ofstream file;
+
+    bool finished { };
+
+    uint64_t start_time { };
+    uint64_t last_time  { }; // in microseconds of the session
+    uint64_t frequency  { };
+
+    auto write_time(uint64_t time) -> void;
+};
+
+class input_replayer
+{
+public:
+    // the session is replayed speed times faster than it was recorded
+    input_replayer(const std::filesystem::path& path, double speed);
+
+    [[nodiscard]] auto seed() const -> uint32_t
+    {
+        return session_seed;
+    }
+
+    // starts the session clock, the events are replayed from here
+    auto start() -> void;
+
+    // appends the events that are due, with their time on the clock of the replay
+    auto poll(std::vector<GLFWinputevent>& events) -> void;
+
+    // the whole session was replayed
+    [[nodiscard]] auto finished() const -> bool;
+
+    // the length of the recorded session, in microseconds
+    [[nodiscard]] auto length() const -> uint64_t
+    {
+        return end_time;
+    }
+
+private:
+    struct event
+    {
+        uint64_t time; // in microseconds of the session
+        GLFWinputevent input;
+    };
+
+    std::vector<event> events;
+
+    uint64_t end_time { }; // in microseconds of the session
+    size_t   next     { };
+
+    uint32_t session_seed { };
+    double   speed;
+
+    uint64_t start_time { };
+    uint64_t frequency  { };
+
+    [[nodiscard]] auto session_time() const -> uint64_t;
+};
@@ -15,12 +15,20 @@
 #include <shaders/converter.hpp>
 
 #include "card.hpp"
+#include "cascade.hpp"
+#include "frame_pacer.hpp"
+#include "input_log.hpp"
+#include "random.hpp"
 
 btCollisionWorld* world;
 
+cascade* card_cascade;
+
 glm::mat4 view;
 glm::mat4 proj;
 
+glm::mat4 inverse_proj_view; // picking rays are generated from it, the camera doesn't move
+
 card cards[4][13] { }; // TODO have a board class
 
 card* last_card { };
@@ -31,36 +39,44 @@ static auto card_is_reversing = false;
 
 static constexpr auto card_columns_count = 13;
 
-auto main() -> int32_t
-{
-    shaders::Converter::convert("../../resources/shaders", "./");
+static constexpr auto window_width  = 1920;
+static constexpr auto window_height = 980;
 
-    constexpr auto window_width  = 1920;
-    constexpr auto window_height = 980;
-    static    auto window_closed = false;
+static std::atomic window_closed { false }; // set by the event thread, or by the frame thread when it ends the session
 
-    static auto cursor_x = 0.0f;
-    static auto cursor_y = 0.0f;
+static auto cursor_x = 0.0f;
+static auto cursor_y = 0.0f;
 
-    if (glfwInit() != GLFW_TRUE)
-    {
-        return -1;
-    }
+// a session is recorded with --record <log>, and replayed with --replay <log> [--speed <times>] instead of the live input
+struct session_options
+{
+    std::optional<std::filesystem::path> record_path;
+    std::optional<std::filesystem::path> replay_path;
 
-    const auto window = glfwCreateWindow(window_width, window_height, "Match Two", nullptr);
+    double replay_speed { 1.0 };
+};
 
-    glfwSetWindowCloseCallback(window, []
-    {
-        window_closed = true;
-    });
+// the logs and the seed of a session, the logs are opened before the frame thread starts, so a log that can't be read or written
+// is reported before the window opens
+struct session
+{
+    std::optional<input_replayer> replayer;
+    std::optional<input_recorder> recorder;
 
-    glfwSetCursorPosCallback(window, [](const double x, const double y) -> void
+    uint32_t seed { };
+    double   replay_speed { 1.0 };
+};
+
+// simulates and renders the frames, and handles the input events the main thread receives, until the window is closed
+static auto play_frames(GLFWwindow* window, const int32_t frame_rate, session& game_session) -> void
+{
+    const auto on_cursor_pos = [](const double x, const double y) -> void
     {
         cursor_x = x;
         cursor_y = y;
-    });
+    };
 
-    glfwSetKeyCallback(window, [](const int key, const int, const int action, const int) -> void
+    const auto on_key = [](const int key, const int action) -> void
     {
         if (key == GLFW_KEY_SPACE && action == GLFW_PRESS)
         {
@@ -82,18 +98,26 @@ auto main() -> int32_t
                     last_card         = nullptr;
                 }
             }
+
+            card_cascade->clear();
         }
-    });
+    };
 
-    glfwSetMouseButtonCallback(window, [](const int button, const int action, const int) -> void
+    const auto on_mouse_button = [](const int button, const int action) -> void
     {
         if (button == GLFW_MOUSE_BUTTON_LEFT && action == GLFW_PRESS)
         {
-            constexpr glm::vec4 viewport { 0.0f, 0.0f, window_width, window_height };
+            const glm::vec4 viewport { 0.0f, 0.0f, window_width, window_height };
+
+            const auto window_x = cursor_x;
+            const auto window_y = window_height - cursor_y;
+
+            glm::vec3 start;
+            glm::vec3 direction;
 
-            auto start = glm::unProject(glm::vec3(cursor_x, window_height - cursor_y, -1.0f), view, proj, viewport);
-            auto end   = glm::unProject(glm::vec3(cursor_x, window_height - cursor_y,  1.0f), view, proj, viewport);
-                 end   = start + glm::normalize(end - start) * 1000.0f;
+            glm::unProjectRays(1, &window_x, &window_y, inverse_proj_view, viewport, &start, &direction);
+
+            const auto end = start + direction * 1000.0f;
 
             const btVector3 from(start.x, start.y, start.z);
             const btVector3   to(  end.x,   end.y,   end.z);
@@ -141,9 +165,7 @@ auto main() -> int32_t
                 // TODO refactor to here
             }
         }
-    });
-
-    glfwMakeContextCurrent(window);
+    };
 
     opengl::Functions::init();
 
@@ -212,11 +234,18 @@ auto main() -> int32_t
     proj = glm::ortho(0.0f,  static_cast<float>(window_width), 0.0f, static_cast<float>(window_height), -1.0f, 1.0f);
     view = glm::mat4(1.0f);
 
+    inverse_proj_view = glm::inverse(proj * view);
+
     const std::vector camera_uniforms
     {
         view, proj
     };
 
+    // the uniform blocks are std140, glm types are uploaded as is, packed or simd aligned
+    static_assert(sizeof(glm::mat4) == 64 && alignof(glm::mat4) <= 16, "mat4 has to be four std140 columns");
+    static_assert(sizeof(glm::vec3) == 12 || sizeof(glm::vec3) == 16, "vec3 has to fit a std140 vec3");
+    static_assert(sizeof(glm::vec4) == 16, "vec4 has to be a std140 vec4");
+
     opengl::Buffer transform_ubo; // TODO have like an uniform buffer manager
     transform_ubo.create();
     transform_ubo.storage(core::buffer::make_data(&model), opengl::constants::dynamic_draw);
@@ -239,21 +268,32 @@ auto main() -> int32_t
 
     glm::vec3 card_background_color { 0.97647058f, 0.47843137254901963f, 0.0f };
 
+    auto& replayer = game_session.replayer;
+    auto& recorder = game_session.recorder;
+
+    random_generator board_random(game_session.seed);
+
     std::vector<glm::vec3> card_colors; // TODO colors should not be that random
 
     for (auto i = 0; i < 26; i++)
     {
-        card_colors.emplace_back(glm::linearRand(glm::vec3(0.0f), glm::vec3(1.0f)));
+        card_colors.emplace_back(board_random.uniform(glm::vec3(0.0f), glm::vec3(1.0f)));
     }
 
     constexpr auto tile_width_size  = 145.5f;
     constexpr auto tile_height_size = 212.0f;
 
-    const auto bt_world_configuration = new btDefaultCollisionConfiguration;
+    // the world, its objects and shapes are released together with the arena,
+    // the narrowphase runs multithreaded and gives the same contacts in every replay
+    btCollisionWorldArena collision_arena(64 * 1024, true);
 
-    world = new btCollisionWorld(new btCollisionDispatcher(bt_world_configuration), new btDbvtBroadphase(), bt_world_configuration);
+    world = collision_arena.getCollisionWorld();
 
-    auto card_shape = new btBoxShape(btVector3(65.0f, 97.0f, 0.2f));
+    auto card_shape = collision_arena.createBoxShape(btVector3(65.0f, 97.0f, 0.2f));
+
+    cascade cascade_effect(window_width, window_height, board_random.stream(1));
+
+    card_cascade = &cascade_effect;
 
     auto card_pairing = false;
     auto card_type    = 0;
@@ -269,15 +309,11 @@ auto main() -> int32_t
             transform.setIdentity();
             transform.setOrigin(btVector3(x, y, 0.0f));
 
-            auto card_object = new btCollisionObject();
-            card_object->setCollisionShape(card_shape);
-            card_object->setWorldTransform(transform);
+            auto card_object = collision_arena.createCollisionObject(card_shape, transform);
 
             card_object->setUserIndex(row);
             card_object->setUserIndex2(col);
 
-            world->addCollisionObject(card_object);
-
             cards[row][col].type = card_type;
 
             if (card_pairing)
@@ -294,21 +330,7 @@ auto main() -> int32_t
 
     // TODO merge this in to in board class from here
 
-    for (auto row = 0; row < 4; row++)
-    {
-        for (auto col = 0; col < card_columns_count; col++)
-        {
-            auto new_row = glm::linearRand(0, 3);
-            auto new_col = glm::linearRand(0, card_columns_count - 1);
-
-            auto&     card = cards[row][col];
-            auto& new_card = cards[new_row][new_col];
-
-            const auto type = card.type;
-                card.type = new_card.type;
-            new_card.type = type;
-        }
-    }
+    board_random.shuffle(&cards[0][0], 4 * card_columns_count);
 
     for (auto row = 0; row < 4; row++)
     {
@@ -327,16 +349,97 @@ auto main() -> int32_t
 
     constexpr auto card_scale = 130.0f;
 
-    auto starting_time = glfwGetTime();
+    constexpr auto cascade_cards_per_card = 32; // 1664 rigid bodies for the 52 cards
+
+    constexpr auto cards_count = 4 * card_columns_count;
+
+    // the visible cards of a frame, their models are built in one batch before drawing them
+    std::vector<float> card_xs(cards_count);
+    std::vector<float> card_ys(cards_count);
+    std::vector<float> card_zs(cards_count, 0.0f);
+    std::vector<float> card_angles(cards_count);
+    std::vector<float> card_scales(cards_count, card_scale);
+    std::vector<float> card_depths(cards_count, 1.0f);
+
+    std::vector<glm::mat4> card_models(cards_count);
+    std::vector<const glm::vec3*> card_materials(cards_count);
+
+    constexpr auto input_events_count = 64;
+
+    std::array<GLFWinputevent, input_events_count> input_events { };
+
+    std::vector<GLFWinputevent> frame_events; // the live or the replayed events of a frame
+
+    // the cards turn in fixed steps of the simulation rate, whatever the frame rate is
+    constexpr auto simulation_rate = 120.0;
+
+    constexpr auto statistics_interval = 5.0;
+
+    // the simulation of a replay runs as fast as its events, so they meet the cards in the same state
+    frame_pacer pacer(frame_rate, simulation_rate, replayer ? game_session.replay_speed : 1.0);
+
+    if (replayer)
+    {
+        replayer->start();
+    }
+
+    if (recorder)
+    {
+        recorder->start();
+    }
 
     while (!window_closed)
     {
-        glfwPollEvents();
+        const auto delta_time      = pacer.begin_frame();
+        const auto simulation_time = pacer.steps() * pacer.step();
+
+        frame_events.clear();
 
-        auto current_time = glfwGetTime(); // TODO use time Time.delta_time
+        // the live events are still received while replaying, so the window keeps responding, but they are dropped
+        for (auto count = glfwGetInputEvents(window, input_events.data(), input_events_count); count > 0;
+                  count = glfwGetInputEvents(window, input_events.data(), input_events_count))
+        {
+            if (!replayer)
+            {
+                frame_events.insert(frame_events.end(), input_events.begin(), input_events.begin() + count);
+            }
+        }
+
+        if (replayer)
+        {
+            replayer->poll(frame_events);
 
-        auto delta_time = current_time - starting_time;
-          starting_time = current_time;
+            if (replayer->finished())
+            {
+                window_closed = true;
+
+                glfwPostEmptyEvent();
+            }
+        }
+
+        // the oldest key or button event of the frame, its latency is measured when the frame is presented
+        std::optional<uint64_t> input_time;
+
+        for (const auto& event : frame_events)
+        {
+            if (recorder)
+            {
+                recorder->record(event);
+            }
+
+            if (!input_time && event.type != GLFW_CURSOR_POS_EVENT)
+            {
+                input_time = event.time;
+            }
+
+            switch (event.type)
+            {
+                case GLFW_CURSOR_POS_EVENT:   on_cursor_pos(event.xpos, event.ypos);       break;
+                case GLFW_KEY_EVENT:          on_key(event.key, event.action);             break;
+                case GLFW_MOUSE_BUTTON_EVENT: on_mouse_button(event.button, event.action); break;
+                default: break;
+            }
+        }
 
         opengl::Commands::clear(opengl::constants::color_buffer | opengl::constants::depth_buffer);
 
@@ -344,6 +447,8 @@ auto main() -> int32_t
 
         card_vao.bind();
 
+        auto visible_cards = 0;
+
         for (auto row = 0; row < 4; row++)
         {
             for (auto col = 0; col < card_columns_count; col++)
@@ -355,29 +460,28 @@ auto main() -> int32_t
                     continue;
                 }
 
-                material_ubo.update(core::buffer::make_data(&card_background_color));
+                const glm::vec3* material = &card_background_color;
 
                 const auto x = tile_width_size  * col - 6.0f * tile_width_size  + static_cast<float>(window_width)  / 2.0f;
                 const auto y = tile_height_size * row - 1.5f * tile_height_size + static_cast<float>(window_height) / 2.0f;
 
-                model = glm::translate(glm::mat4(1.0f), glm::vec3(x, y, 0.0f));
-                model = glm::scale(model, glm::vec3(card_scale, card_scale, 1.0f));
+                auto angle = 0.0f;
 
                 // TODO clean the states
                 // TODO update the color in a more simple way
 
                 if (card.turning)
                 {
-                    card.angle += delta_time * card_rotation_speed;
+                    card.angle += simulation_time * card_rotation_speed;
 
                     auto a = glm::smoothstep(0.0f, card_rotation_max_angle, card.angle);
 
                     if (a >= 0.5f)
                     {
-                        material_ubo.update(core::buffer::make_data(&card.color));
+                        material = &card.color;
                     }
 
-                    model = glm::rotate(model, glm::radians(a * card_rotation_max_angle), glm::vec3(0.0f, 1.0f, 0.0f));
+                    angle = glm::radians(a * card_rotation_max_angle);
 
                     if (card.angle >= card_rotation_max_angle)
                     {
@@ -399,20 +503,16 @@ auto main() -> int32_t
                 }
                 else if (card.reversing && !card_is_turning)
                 {
-                    card.angle -= delta_time * card_rotation_speed;
+                    card.angle -= simulation_time * card_rotation_speed;
 
                     auto a = glm::smoothstep(0.0f, card_rotation_max_angle, card.angle);
 
-                    if (a <= 0.5f)
+                    if (a > 0.5f)
                     {
-                        material_ubo.update(core::buffer::make_data(&card_background_color));
-                    }
-                    else
-                    {
-                        material_ubo.update(core::buffer::make_data(&card.color));
+                        material = &card.color;
                     }
 
-                    model = glm::rotate(model, glm::radians(a * card_rotation_max_angle), glm::vec3(0.0f, 1.0f, 0.0f));
+                    angle = glm::radians(a * card_rotation_max_angle);
 
                     if (card.angle <= 0.0f)
                     {
@@ -432,17 +532,206 @@ auto main() -> int32_t
                 }
                 else if (card.turned)
                 {
-                    material_ubo.update(core::buffer::make_data(&card.color));
+                    material = &card.color;
                 }
 
-                transform_ubo.update(core::buffer::make_data(&model));
+                card_xs[visible_cards]        = x;
+                card_ys[visible_cards]        = y;
+                card_angles[visible_cards]    = angle;
+                card_materials[visible_cards] = material;
+
+                visible_cards++;
+            }
+        }
+
+        glm::translateScaleRotateY(visible_cards, card_xs.data(), card_ys.data(), card_zs.data(), card_scales.data(), card_scales.data(), card_depths.data(), card_angles.data(), card_models.data());
+
+        for (auto i = 0; i < visible_cards; i++)
+        {
+            material_ubo.update(core::buffer::make_data(card_materials[i]));
+            transform_ubo.update(core::buffer::make_data(&card_models[i]));
+
+            opengl::Commands::draw_elements(opengl::constants::triangles, card_elements.size());
+        }
+
+        // TODO move the end of round check in to the board class
 
-                opengl::Commands::draw_elements(opengl::constants::triangles, card_elements.size());
+        auto round_finished = true;
+
+        for (auto row = 0; row < 4; row++)
+        {
+            for (auto col = 0; col < card_columns_count; col++)
+            {
+                round_finished = round_finished && cards[row][col].flipped;
+            }
+        }
+
+        if (round_finished && card_cascade->empty())
+        {
+            for (auto row = 0; row < 4; row++)
+            {
+                for (auto col = 0; col < card_columns_count; col++)
+                {
+                    const auto x = tile_width_size  * col - 6.0f * tile_width_size  + static_cast<float>(window_width)  / 2.0f;
+                    const auto y = tile_height_size * row - 1.5f * tile_height_size + static_cast<float>(window_height) / 2.0f;
+
+                    card_cascade->spawn(glm::vec3(x, y, 0.0f), cards[row][col].color, cascade_cards_per_card);
+                }
             }
         }
 
+        card_cascade->update(delta_time);
+
+        const auto& cascade_models = card_cascade->models();
+        const auto& cascade_colors = card_cascade->colors();
+
+        for (size_t i = 0; i < cascade_models.size(); i++)
+        {
+            material_ubo.update(core::buffer::make_data(&cascade_colors[i]));
+            transform_ubo.update(core::buffer::make_data(&cascade_models[i]));
+
+            opengl::Commands::draw_elements(opengl::constants::triangles, card_elements.size());
+        }
+
         glfwSwapBuffers(window);
+
+        if (input_time)
+        {
+            pacer.end_frame(static_cast<double>(glfwGetTimerValue() - *input_time) / static_cast<double>(glfwGetTimerFrequency()));
+        }
+        else
+        {
+            pacer.end_frame();
+        }
+
+        if (const auto statistics = pacer.current_statistics(); statistics.duration >= statistics_interval)
+        {
+            std::cout << "frames: "          << statistics.frames
+                      << ", frame time: "    << statistics.frame_time_mean      * 1000.0 << " ms"
+                      << ", deviation: "     << statistics.frame_time_deviation * 1000.0 << " ms"
+                      << ", max: "           << statistics.frame_time_max       * 1000.0 << " ms"
+                      << ", input latency: " << statistics.input_latency_mean   * 1000.0 << " ms"
+                      << ", max: "           << statistics.input_latency_max    * 1000.0 << " ms"
+                      << ", cpu: "           << statistics.cpu_usage            * 100.0  << " %" << std::endl;
+
+            pacer.reset_statistics();
+        }
+    }
+}
+
+// the frame thread, an error ends the session and closes the window, instead of terminating the game from this thread
+static auto run_frames(GLFWwindow* window, const int32_t frame_rate, session& game_session) -> void
+{
+    const std::unique_ptr<btITaskScheduler> task_scheduler { btCreateDefaultTaskScheduler() }; // set before any bullet world is created, they size their per thread data by it
+
+    btSetTaskScheduler(task_scheduler ? task_scheduler.get() : btGetSequentialTaskScheduler());
+
+    glfwMakeContextCurrent(window);
+
+    try
+    {
+        play_frames(window, frame_rate, game_session);
     }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+    }
+
+    // the end of the session is timed here, while glfw is still initialized
+    if (game_session.recorder)
+    {
+        game_session.recorder->finish();
+    }
+
+    glfwMakeContextCurrent(nullptr);
+
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+
+    window_closed = true;
+
+    glfwPostEmptyEvent();
+}
+
+auto main(const int32_t argc, char** argv) -> int32_t
+{
+    session_options options;
+
+    for (auto i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string_view option = argv[i];
+
+        if (option == "--record")
+        {
+            options.record_path = argv[i + 1];
+        }
+        else if (option == "--replay")
+        {
+            options.replay_path = argv[i + 1];
+        }
+        else if (option == "--speed")
+        {
+            options.replay_speed = std::max(std::atof(argv[i + 1]), 0.01);
+        }
+    }
+
+    shaders::Converter::convert("../../resources/shaders", "./");
+
+    if (glfwInit() != GLFW_TRUE)
+    {
+        return -1;
+    }
+
+    session game_session;
+
+    game_session.replay_speed = options.replay_speed;
+
+    try
+    {
+        if (options.replay_path)
+        {
+            game_session.replayer.emplace(*options.replay_path, options.replay_speed);
+        }
+
+        // the colors, the shuffle and the cascade come from one seed, a replay takes the seed of the recorded session
+        game_session.seed = game_session.replayer ? game_session.replayer->seed() : std::random_device()();
+
+        if (options.record_path)
+        {
+            game_session.recorder.emplace(*options.record_path, game_session.seed);
+        }
+    }
+    catch (const std::exception& exception)
+    {
+        std::cerr << exception.what() << std::endl;
+
+        glfwTerminate();
+
+        return -1;
+    }
+
+    const auto window = glfwCreateWindow(window_width, window_height, "Match Two", nullptr);
+
+    glfwSetWindowCloseCallback(window, []
+    {
+        window_closed = true;
+    });
+
+    // input events are buffered by glfw and handled at the start of a frame by the frame thread,
+    // this thread only receives them, so a slow frame doesn't delay when they are timestamped
+    glfwSetInputMode(window, GLFW_BUFFERED_EVENTS, GLFW_TRUE);
+
+    // the frames are paced to the refresh rate of the monitor
+    const auto video_mode = glfwGetVideoMode(glfwGetPrimaryMonitor());
+    const auto frame_rate = video_mode != nullptr && video_mode->refreshRate > 0 ? video_mode->refreshRate : 60;
+
+    std::thread frame_thread(run_frames, window, frame_rate, std::ref(game_session));
+
+    while (!window_closed)
+    {
+        glfwWaitEvents();
+    }
+
+    frame_thread.join();
 
     glfwDestroyWindow(window);
     glfwTerminate();
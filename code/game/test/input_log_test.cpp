@@ -0,0 +1,56 @@
+#include "input_log.hpp"
+
+static constexpr auto idle_tail = std::chrono::milliseconds(100);
+
+// a session that goes on after its last event keeps that idle tail through the log, so its replay doesn't end at the last event
+static auto idle_tail_survives_round_trip(const std::filesystem::path& path) -> bool
+{
+    {
+        input_recorder recorder(path, 7);
+
+        recorder.start();
+
+        GLFWinputevent event { };
+
+        event.type   = GLFW_KEY_EVENT;
+        event.key    = GLFW_KEY_SPACE;
+        event.action = GLFW_PRESS;
+        event.time   = glfwGetTimerValue();
+
+        recorder.record(event);
+
+        std::this_thread::sleep_for(idle_tail);
+
+        recorder.finish();
+    }
+
+    const input_replayer replayer(path, 1.0);
+
+    const auto length = std::chrono::microseconds(replayer.length());
+
+    if (replayer.seed() != 7 || length < idle_tail)
+    {
+        std::cerr << "the replayed session is " << length.count() << " us long, the idle tail is " << std::chrono::microseconds(idle_tail).count() << " us" << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+auto main() -> int32_t
+{
+    if (glfwInit() != GLFW_TRUE)
+    {
+        return -1;
+    }
+
+    const auto path = std::filesystem::temp_directory_path() / "input_log_test.log";
+
+    const auto passed = idle_tail_survives_round_trip(path);
+
+    std::filesystem::remove(path);
+
+    glfwTerminate();
+
+    return passed ? 0 : 1;
+}
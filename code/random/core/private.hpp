@@ -0,0 +1,7 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+
+#include <glm/glm.hpp>
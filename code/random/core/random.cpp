@@ -0,0 +1,59 @@
+#include "random.hpp"
+
+// the state is filled from the seed by splitmix64, so close seeds still give unrelated states, and the state is never all zeros
+static auto split_mix(uint64_t& value) -> uint64_t
+{
+    value += 0x9e3779b97f4a7c15;
+
+    auto z = value;
+
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111eb;
+
+    return z ^ (z >> 31);
+}
+
+random_generator::random_generator(uint64_t seed)
+{
+    for (auto& value : state)
+    {
+        value = split_mix(seed);
+    }
+}
+
+auto random_generator::stream(const uint64_t index) const -> random_generator
+{
+    auto generator = *this;
+
+    for (uint64_t i = 0; i < index; i++)
+    {
+        generator.jump();
+    }
+
+    return generator;
+}
+
+auto random_generator::jump() -> void
+{
+    static constexpr std::array<uint64_t, 4> jump_polynomial { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+
+    std::array<uint64_t, 4> jumped { };
+
+    for (const auto word : jump_polynomial)
+    {
+        for (auto bit = 0; bit < 64; bit++)
+        {
+            if (word & uint64_t(1) << bit)
+            {
+                for (auto i = 0; i < 4; i++)
+                {
+                    jumped[i] ^= state[i];
+                }
+            }
+
+            operator()();
+        }
+    }
+
+    state = jumped;
+}
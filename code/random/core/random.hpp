@@ -0,0 +1,119 @@
+#pragma once
+
+// the random numbers of the game, a xoshiro256** generator with an explicit seed, so a board and its cascade can be generated again
+// a generator is used by one thread only, the other threads take their own streams of the same seed - each stream starts 2^128 numbers
+// after the previous one, so the streams never overlap
+class random_generator
+{
+public:
+    using result_type = uint64_t;
+
+    explicit random_generator(uint64_t seed);
+
+    // the generator of the given stream of this generator, stream 0 is a copy of it
+    [[nodiscard]] auto stream(uint64_t index) const -> random_generator;
+
+    auto operator()() -> uint64_t
+    {
+        const auto result = rotate_left(state[1] * 5, 7) * 9;
+        const auto t      = state[1] << 17;
+
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+
+        state[2] ^= t;
+        state[3]  = rotate_left(state[3], 45);
+
+        return result;
+    }
+
+    // a uniform integer in [0, range), with lemire's multiply and shift - the product is only rejected in the rare case it would be biased
+    auto bounded(const uint32_t range) -> uint32_t
+    {
+        auto product = (operator()() >> 32) * range;
+        auto low     = static_cast<uint32_t>(product);
+
+        if (low < range)
+        {
+            const auto threshold = (0u - range) % range;
+
+            while (low < threshold)
+            {
+                product = (operator()() >> 32) * range;
+                low     = static_cast<uint32_t>(product);
+            }
+        }
+
+        return static_cast<uint32_t>(product >> 32);
+    }
+
+    // a uniform integer in [min, max], the range is taken in unsigned so it can't overflow
+    auto uniform(const int32_t min, const int32_t max) -> int32_t
+    {
+        const auto range = static_cast<uint32_t>(max) - static_cast<uint32_t>(min);
+
+        // the whole range of int32_t has 2^32 integers, one more than a bound of bounded can be
+        if (range == UINT32_MAX)
+        {
+            return static_cast<int32_t>(operator()() >> 32);
+        }
+
+        return static_cast<int32_t>(static_cast<uint32_t>(min) + bounded(range + 1));
+    }
+
+    // a uniform float in [min, max), from the 24 high bits, as many as a float has for its mantissa
+    auto uniform(const float min, const float max) -> float
+    {
+        return min + (max - min) * static_cast<float>(operator()() >> 40) * 0x1.0p-24f;
+    }
+
+    auto uniform(const glm::vec2& min, const glm::vec2& max) -> glm::vec2
+    {
+        const auto x = uniform(min.x, max.x);
+        const auto y = uniform(min.y, max.y);
+
+        return { x, y };
+    }
+
+    auto uniform(const glm::vec3& min, const glm::vec3& max) -> glm::vec3
+    {
+        const auto x = uniform(min.x, max.x);
+        const auto y = uniform(min.y, max.y);
+        const auto z = uniform(min.z, max.z);
+
+        return { x, y, z };
+    }
+
+    // a fisher-yates shuffle, every permutation is as likely
+    template <typename T>
+    auto shuffle(T* values, const size_t count) -> void
+    {
+        for (auto i = count; i > 1; i--)
+        {
+            std::swap(values[i - 1], values[bounded(static_cast<uint32_t>(i))]);
+        }
+    }
+
+    static constexpr auto min() -> uint64_t
+    {
+        return 0;
+    }
+
+    static constexpr auto max() -> uint64_t
+    {
+        return UINT64_MAX;
+    }
+
+private:
+    std::array<uint64_t, 4> state;
+
+    static constexpr auto rotate_left(const uint64_t value, const int32_t bits) -> uint64_t
+    {
+        return value << bits | value >> (64 - bits);
+    }
+
+    // advances the generator by 2^128 numbers
+    auto jump() -> void;
+};
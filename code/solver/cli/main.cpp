@@ -0,0 +1,134 @@
+#include "solver.hpp"
+
+// plays rounds with simulated players to balance the board, and to measure how many rounds the cores play in a second
+// solver-cli [--rounds <count>] [--memory perfect|random|recall:<cards>] [--seed <seed>] [--threads <count>]
+auto main(const int32_t argc, char** argv) -> int32_t
+{
+    uint64_t rounds          = 1000000;
+    int32_t  memory_capacity = board::cards_count;
+    uint64_t seed            = std::random_device()();
+    int32_t  threads         = 0;
+
+    std::string_view memory_model = "perfect";
+
+    for (auto i = 1; i + 1 < argc; i += 2)
+    {
+        const std::string_view option = argv[i];
+
+        if (option == "--rounds")
+        {
+            rounds = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (option == "--memory")
+        {
+            memory_model = argv[i + 1];
+        }
+        else if (option == "--seed")
+        {
+            seed = std::strtoull(argv[i + 1], nullptr, 10);
+        }
+        else if (option == "--threads")
+        {
+            threads = std::atoi(argv[i + 1]);
+        }
+    }
+
+    auto valid_memory_model = true;
+
+    if (memory_model == "random")
+    {
+        memory_capacity = 0;
+    }
+    else if (memory_model.substr(0, 7) == "recall:")
+    {
+        // the whole count has to be a number, a count atoi can't read would be 0 and silently make the random player
+        const auto cards = memory_model.substr(7);
+        const auto end   = cards.data() + cards.size();
+
+        const auto [last, error] = std::from_chars(cards.data(), end, memory_capacity);
+
+        valid_memory_model = error == std::errc() && last == end && memory_capacity >= 0;
+    }
+    else if (memory_model != "perfect")
+    {
+        valid_memory_model = false;
+    }
+
+    if (!valid_memory_model)
+    {
+        std::cerr << "unknown memory model " << memory_model << std::endl;
+        return -1;
+    }
+
+    const std::unique_ptr<btITaskScheduler> task_scheduler { btCreateDefaultTaskScheduler() };
+
+    if (task_scheduler)
+    {
+        task_scheduler->setNumThreads(threads > 0 ? threads : task_scheduler->getMaxNumThreads());
+    }
+
+    btSetTaskScheduler(task_scheduler ? task_scheduler.get() : btGetSequentialTaskScheduler());
+
+    const solver round_solver(memory_capacity, seed);
+
+    const auto start   = std::chrono::steady_clock::now();
+    const auto results = round_solver.run(rounds);
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+    const auto thread_count = btGetTaskScheduler()->getNumThreads(); // the rounds ran on these, before the scheduler is reset
+
+    btSetTaskScheduler(btGetSequentialTaskScheduler());
+
+    if (results.rounds == 0)
+    {
+        return 0;
+    }
+
+    const auto attempts_mean = static_cast<double>(results.attempts) / static_cast<double>(results.rounds);
+
+    std::cout << "memory: "     << memory_model
+              << ", seed: "     << seed
+              << ", threads: "  << thread_count << std::endl;
+
+    std::cout << "rounds: "          << results.rounds
+              << ", time: "          << seconds << " s"
+              << ", rounds/s: "      << static_cast<double>(results.rounds)   / seconds
+              << ", attempts/s: "    << static_cast<double>(results.attempts) / seconds << std::endl;
+
+    std::cout << "attempts per round: " << attempts_mean
+              << ", deviation: "        << results.attempts_deviation()
+              << ", min: "              << results.attempts_percentile(0.0)
+              << ", p10: "              << results.attempts_percentile(0.1)
+              << ", p50: "              << results.attempts_percentile(0.5)
+              << ", p90: "              << results.attempts_percentile(0.9)
+              << ", p99: "              << results.attempts_percentile(0.99)
+              << ", max: "              << results.attempts_histogram.size() - 1 << std::endl;
+
+    // a round matches every pair, so its matches per attempt are the pairs over its attempts
+    constexpr auto bins_count = 20;
+
+    std::array<uint64_t, bins_count> bins { };
+
+    for (size_t attempts = board::pairs_count; attempts < results.attempts_histogram.size(); attempts++)
+    {
+        const auto matches_per_attempt = static_cast<double>(board::pairs_count) / static_cast<double>(attempts);
+
+        bins[std::min(static_cast<int32_t>(matches_per_attempt * bins_count), bins_count - 1)] += results.attempts_histogram[attempts];
+    }
+
+    std::cout << "matches per attempt: " << board::pairs_count / attempts_mean << std::endl;
+
+    for (auto bin = 0; bin < bins_count; bin++)
+    {
+        if (bins[bin] == 0)
+        {
+            continue;
+        }
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "  " << static_cast<double>(bin) / bins_count << " - " << static_cast<double>(bin + 1) / bins_count << ": "
+                  << std::setprecision(4) << 100.0 * static_cast<double>(bins[bin]) / static_cast<double>(results.rounds) << " %" << std::endl;
+    }
+
+    return 0;
+}
@@ -0,0 +1,17 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <charconv>
+#include <chrono>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string_view>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <LinearMath/btThreads.h>
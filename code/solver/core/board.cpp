@@ -0,0 +1,29 @@
+#include "board.hpp"
+
+board::board(random_generator& random)
+{
+    for (auto card = 0; card < cards_count; card++)
+    {
+        types[card] = static_cast<int8_t>(card / 2);
+    }
+
+    random.shuffle(types.data(), types.size());
+
+    std::array<int8_t, pairs_count> first_cards;
+    first_cards.fill(-1);
+
+    for (auto card = 0; card < cards_count; card++)
+    {
+        auto& first = first_cards[types[card]];
+
+        if (first < 0)
+        {
+            first = static_cast<int8_t>(card);
+        }
+        else
+        {
+            partners[card]  = first;
+            partners[first] = static_cast<int8_t>(card);
+        }
+    }
+}
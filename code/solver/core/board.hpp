@@ -0,0 +1,29 @@
+#pragma once
+
+#include "random.hpp"
+
+// the cards of a round and the rules they are matched by, without anything to draw them - a card is matched with the other card of its type
+class board
+{
+public:
+    static constexpr auto pairs_count = 26;
+    static constexpr auto cards_count = 2 * pairs_count;
+
+    // deals the pairs in a random order, with the same fisher-yates shuffle as the board of the game
+    explicit board(random_generator& random);
+
+    [[nodiscard]] auto type(const int32_t card) const -> int32_t
+    {
+        return types[card];
+    }
+
+    // the other card of the same type
+    [[nodiscard]] auto partner(const int32_t card) const -> int32_t
+    {
+        return partners[card];
+    }
+
+private:
+    std::array<int8_t, cards_count> types;
+    std::array<int8_t, cards_count> partners;
+};
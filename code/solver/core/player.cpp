@@ -0,0 +1,125 @@
+#include "player.hpp"
+
+player::player(const int32_t memory_capacity) : memory_capacity(std::clamp(memory_capacity, 0, board::cards_count))
+{
+}
+
+auto player::play(const board& cards, random_generator& random) -> int32_t
+{
+    unknown_count     = 0;
+    memory_count      = 0;
+    known_pairs_count = 0;
+
+    remembered.fill(false);
+
+    for (auto card = 0; card < board::cards_count; card++)
+    {
+        add_unknown(card);
+    }
+
+    auto attempts   = 0;
+    auto pairs_left = board::pairs_count;
+
+    while (pairs_left > 0)
+    {
+        attempts++;
+
+        if (const auto card = pop_known_pair(cards); card >= 0)
+        {
+            forget(card);
+            forget(cards.partner(card));
+
+            pairs_left--;
+            continue;
+        }
+
+        // there is an unknown card whenever no pair is known, the partners of the cards on the board are on it too
+        const auto first  = pick_unknown(random);
+        const auto second = remembered[cards.partner(first)] ? cards.partner(first) : pick_unknown(random);
+
+        if (second == cards.partner(first))
+        {
+            forget(second);
+
+            pairs_left--;
+            continue;
+        }
+
+        remember(cards, first);
+        remember(cards, second);
+    }
+
+    return attempts;
+}
+
+auto player::add_unknown(const int32_t card) -> void
+{
+    unknown_cards[unknown_count++] = static_cast<int8_t>(card);
+}
+
+auto player::pick_unknown(random_generator& random) -> int32_t
+{
+    const auto index = random.bounded(static_cast<uint32_t>(unknown_count));
+    const auto card  = unknown_cards[index];
+
+    unknown_cards[index] = unknown_cards[--unknown_count];
+
+    return card;
+}
+
+auto player::remember(const board& cards, const int32_t card) -> void
+{
+    if (memory_capacity == 0)
+    {
+        add_unknown(card);
+        return;
+    }
+
+    if (memory_count == memory_capacity)
+    {
+        const auto oldest = memory[0];
+
+        forget(oldest);
+        add_unknown(oldest);
+    }
+
+    memory[memory_count++] = static_cast<int8_t>(card);
+    remembered[card]       = true;
+
+    if (remembered[cards.partner(card)])
+    {
+        known_pairs[known_pairs_count++] = static_cast<int8_t>(card);
+    }
+}
+
+auto player::forget(const int32_t card) -> void
+{
+    if (!remembered[card])
+    {
+        return;
+    }
+
+    remembered[card] = false;
+
+    const auto end      = memory.begin() + memory_count;
+    const auto position = std::find(memory.begin(), end, card);
+
+    std::copy(position + 1, end, position);
+
+    memory_count--;
+}
+
+auto player::pop_known_pair(const board& cards) -> int32_t
+{
+    while (known_pairs_count > 0)
+    {
+        const auto card = known_pairs[--known_pairs_count];
+
+        if (remembered[card] && remembered[cards.partner(card)])
+        {
+            return card;
+        }
+    }
+
+    return -1;
+}
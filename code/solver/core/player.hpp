@@ -0,0 +1,39 @@
+#pragma once
+
+#include "board.hpp"
+
+// a simulated player, every attempt turns two cards: a pair it remembers both cards of, or an unknown card and then the card it remembers
+// of the same type, or another unknown card - the player remembers the last memory_capacity cards it saw, the oldest is forgotten first
+// a capacity of board::cards_count is a perfect memory, and a capacity of 0 is a player that turns random cards
+class player
+{
+public:
+    explicit player(int32_t memory_capacity);
+
+    // plays a whole round on the board, returns the attempts it took to match every pair
+    auto play(const board& cards, random_generator& random) -> int32_t;
+
+private:
+    int32_t memory_capacity;
+
+    // the cards on the board that aren't remembered, in no order, a card is picked by moving the last card in to its place
+    std::array<int8_t, board::cards_count> unknown_cards;
+    int32_t unknown_count { };
+
+    // the remembered cards, the oldest first
+    std::array<int8_t, board::cards_count> memory;
+    std::array<bool,   board::cards_count> remembered;
+    int32_t memory_count { };
+
+    // the cards that were remembered after their partner, some may have been forgotten or matched since
+    std::array<int8_t, board::cards_count> known_pairs;
+    int32_t known_pairs_count { };
+
+    auto add_unknown(int32_t card) -> void;
+    auto pick_unknown(random_generator& random) -> int32_t;
+
+    auto remember(const board& cards, int32_t card) -> void;
+    auto forget(int32_t card) -> void;
+
+    [[nodiscard]] auto pop_known_pair(const board& cards) -> int32_t;
+};
@@ -0,0 +1,142 @@
+#include "solver.hpp"
+
+// a batch is large enough to outweigh the cost of being stolen, and small enough to keep every thread busy until the end
+static constexpr uint64_t rounds_per_batch = 4096;
+
+class solver_batches final : public btIParallelForBody
+{
+public:
+    solver_batches(const std::vector<random_generator>& generators, std::vector<solver::results>& batch_results, const uint64_t rounds, const int32_t memory_capacity)
+        : generators(generators)
+        , batch_results(batch_results)
+        , rounds(rounds)
+        , memory_capacity(memory_capacity)
+    {
+    }
+
+    auto forLoop(const int begin, const int end) const -> void override
+    {
+        player simulated_player(memory_capacity);
+
+        for (auto batch = begin; batch < end; batch++)
+        {
+            auto  random  = generators[batch];
+            auto& results = batch_results[batch];
+
+            const auto batch_rounds = std::min(rounds_per_batch, rounds - batch * rounds_per_batch);
+
+            for (uint64_t round = 0; round < batch_rounds; round++)
+            {
+                const board cards(random);
+
+                const auto attempts = simulated_player.play(cards, random);
+
+                if (static_cast<size_t>(attempts) >= results.attempts_histogram.size())
+                {
+                    results.attempts_histogram.resize(attempts + 1);
+                }
+
+                results.attempts_histogram[attempts]++;
+                results.attempts += attempts;
+            }
+
+            results.rounds = batch_rounds;
+        }
+    }
+
+private:
+    const std::vector<random_generator>& generators;
+    std::vector<solver::results>&        batch_results;
+
+    uint64_t rounds;
+    int32_t  memory_capacity;
+};
+
+auto solver::results::merge(const results& other) -> void
+{
+    rounds   += other.rounds;
+    attempts += other.attempts;
+
+    if (attempts_histogram.size() < other.attempts_histogram.size())
+    {
+        attempts_histogram.resize(other.attempts_histogram.size());
+    }
+
+    for (size_t i = 0; i < other.attempts_histogram.size(); i++)
+    {
+        attempts_histogram[i] += other.attempts_histogram[i];
+    }
+}
+
+auto solver::results::attempts_percentile(const double fraction) const -> int32_t
+{
+    const auto target = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(rounds)));
+
+    uint64_t counted = 0;
+
+    for (size_t i = 0; i < attempts_histogram.size(); i++)
+    {
+        counted += attempts_histogram[i];
+
+        if (counted >= target && counted > 0)
+        {
+            return static_cast<int32_t>(i);
+        }
+    }
+
+    return 0;
+}
+
+auto solver::results::attempts_deviation() const -> double
+{
+    if (rounds == 0)
+    {
+        return 0.0;
+    }
+
+    const auto mean = static_cast<double>(attempts) / static_cast<double>(rounds);
+
+    auto sum = 0.0;
+
+    for (size_t i = 0; i < attempts_histogram.size(); i++)
+    {
+        sum += static_cast<double>(attempts_histogram[i]) * (static_cast<double>(i) - mean) * (static_cast<double>(i) - mean);
+    }
+
+    return std::sqrt(sum / static_cast<double>(rounds));
+}
+
+solver::solver(const int32_t memory_capacity, const uint64_t seed) : memory_capacity(memory_capacity), seed(seed)
+{
+}
+
+auto solver::run(const uint64_t rounds) const -> results
+{
+    const auto batches = static_cast<int32_t>((rounds + rounds_per_batch - 1) / rounds_per_batch);
+
+    // the streams are taken one after the other, taking stream n of the seed jumps n times
+    std::vector<random_generator> generators;
+    generators.reserve(batches);
+
+    random_generator random(seed);
+
+    for (auto batch = 0; batch < batches; batch++)
+    {
+        generators.push_back(random);
+
+        random = random.stream(1);
+    }
+
+    std::vector<results> batch_results(batches);
+
+    btParallelForIfScheduled(0, batches, 1, solver_batches(generators, batch_results, rounds, memory_capacity));
+
+    results merged;
+
+    for (const auto& batch : batch_results)
+    {
+        merged.merge(batch);
+    }
+
+    return merged;
+}
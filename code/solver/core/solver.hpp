@@ -0,0 +1,33 @@
+#pragma once
+
+#include "player.hpp"
+
+// plays rounds on random boards with every thread of the bullet task scheduler, which steals batches of rounds between its threads
+// every batch has its own stream of the seed, so the results of a seed are the same whatever the number of threads
+// without a task scheduler the rounds are played on the calling thread
+class solver
+{
+public:
+    struct results
+    {
+        uint64_t rounds   { };
+        uint64_t attempts { };
+
+        std::vector<uint64_t> attempts_histogram; // the rounds that took each number of attempts
+
+        auto merge(const results& other) -> void;
+
+        // the attempts of the given fraction of the rounds were at most this
+        [[nodiscard]] auto attempts_percentile(double fraction) const -> int32_t;
+
+        [[nodiscard]] auto attempts_deviation() const -> double;
+    };
+
+    solver(int32_t memory_capacity, uint64_t seed);
+
+    [[nodiscard]] auto run(uint64_t rounds) const -> results;
+
+private:
+    int32_t  memory_capacity;
+    uint64_t seed;
+};
@@ -56,6 +56,14 @@ public:
 	virtual void setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax, btDispatcher* dispatcher) = 0;
 	virtual void getAabb(btBroadphaseProxy* proxy, btVector3& aabbMin, btVector3& aabbMax) const = 0;
 
+	///sleepProxy tells the broadphase that the object of the proxy was deactivated, and won't move until the next setAabb of the proxy.
+	///Broadphases can skip pair generation between sleeping proxies, the pairs they already have are kept.
+	virtual void sleepProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher)
+	{
+		(void)proxy;
+		(void)dispatcher;
+	}
+
 	virtual void rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback, const btVector3& aabbMin = btVector3(0, 0, 0), const btVector3& aabbMax = btVector3(0, 0, 0)) = 0;
 
 	virtual void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback) = 0;
@@ -72,6 +72,13 @@ static void getmaxdepth(const btDbvtNode* node, int depth, int& maxdepth)
 static DBVT_INLINE void deletenode(btDbvt* pdbvt,
 								   btDbvtNode* node)
 {
+	if (pdbvt->isExternalNode(node)) return;
+	if (pdbvt->m_arena)
+	{
+		node->parent = pdbvt->m_free;
+		pdbvt->m_free = node;
+		return;
+	}
 	btAlignedFree(pdbvt->m_free);
 	pdbvt->m_free = node;
 }
@@ -99,7 +106,11 @@ static DBVT_INLINE btDbvtNode* createnode(btDbvt* pdbvt,
 	if (pdbvt->m_free)
 	{
 		node = pdbvt->m_free;
-		pdbvt->m_free = 0;
+		pdbvt->m_free = pdbvt->m_arena ? node->parent : 0;
+	}
+	else if (pdbvt->m_arena)
+	{
+		node = new (pdbvt->m_arena->allocate(sizeof(btDbvtNode), 16)) btDbvtNode();
 	}
 	else
 	{
@@ -465,6 +476,9 @@ btDbvt::btDbvt()
 	m_lkhd = -1;
 	m_leaves = 0;
 	m_opath = 0;
+	m_externalBegin = 0;
+	m_externalEnd = 0;
+	m_arena = 0;
 }
 
 //
@@ -476,9 +490,17 @@ btDbvt::~btDbvt()
 //
 void btDbvt::clear()
 {
-	if (m_root)
-		recursedeletenode(this, m_root);
-	btAlignedFree(m_free);
+	if (m_arena)
+	{
+		//the nodes are owned by the arena
+		m_root = 0;
+	}
+	else
+	{
+		if (m_root)
+			recursedeletenode(this, m_root);
+		btAlignedFree(m_free);
+	}
 	m_free = 0;
 	m_lkhd = -1;
 	m_stkStack.clear();
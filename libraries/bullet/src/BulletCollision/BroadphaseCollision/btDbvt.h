@@ -21,6 +21,7 @@ subject to the following restrictions:
 #include "LinearMath/btVector3.h"
 #include "LinearMath/btTransform.h"
 #include "LinearMath/btAabbUtil2.h"
+#include "LinearMath/btArenaAllocator.h"
 //
 // Compile time configuration
 //
@@ -59,6 +60,12 @@ subject to the following restrictions:
 #define DBVT_SELECT_IMPL DBVT_IMPL_SSE
 #define DBVT_MERGE_IMPL DBVT_IMPL_SSE
 #define DBVT_INT0_IMPL DBVT_IMPL_SSE
+#elif defined(BT_HAS_SSE2_INTRINSICS) && !defined(BT_USE_DOUBLE_PRECISION)
+//every x86-64 cpu has SSE2, so the overlap test is vectorized also when btVector3 doesn't use SSE. It is called too often
+//for an indirect call to a wider kernel to pay off.
+#define DBVT_SELECT_IMPL DBVT_IMPL_GENERIC
+#define DBVT_MERGE_IMPL DBVT_IMPL_GENERIC
+#define DBVT_INT0_IMPL DBVT_IMPL_SSE
 #else
 #define DBVT_SELECT_IMPL DBVT_IMPL_GENERIC
 #define DBVT_MERGE_IMPL DBVT_IMPL_GENERIC
@@ -304,6 +311,9 @@ struct btDbvt
 	int m_lkhd;
 	int m_leaves;
 	unsigned m_opath;
+	const void* m_externalBegin;  // Nodes in [m_externalBegin,m_externalEnd) are not owned by the tree
+	const void* m_externalEnd;
+	btArenaAllocator* m_arena;    // Optional node arena, m_free is then a list linked through parent
 
 	btAlignedObjectArray<sStkNN> m_stkStack;
 
@@ -312,6 +322,24 @@ struct btDbvt
 	~btDbvt();
 	void clear();
 	bool empty() const { return (0 == m_root); }
+	///nodes inside the given memory block (e.g. a loaded btCollisionWorldSnapshot) are never released by the tree
+	void setExternalNodes(const void* begin, const void* end)
+	{
+		m_externalBegin = begin;
+		m_externalEnd = end;
+	}
+	bool isExternalNode(const btDbvtNode* node) const
+	{
+		return ((const void*)node >= m_externalBegin) && ((const void*)node < m_externalEnd);
+	}
+	///allocate nodes from arena instead of btAlignedAlloc. Removed nodes are recycled, and clear drops the whole tree without
+	///visiting it: the arena owns the memory. Can only be changed while the tree is empty.
+	void setArena(btArenaAllocator* arena)
+	{
+		btAssert(!m_root);
+		clear();
+		m_arena = arena;
+	}
 	void optimizeBottomUp();
 	void optimizeTopDown(int bu_treshold = 128);
 	void optimizeIncremental(int passes);
@@ -622,14 +650,10 @@ DBVT_INLINE bool Intersect(const btDbvtAabbMm& a,
 						   const btDbvtAabbMm& b)
 {
 #if DBVT_INT0_IMPL == DBVT_IMPL_SSE
-	const __m128 rt(_mm_or_ps(_mm_cmplt_ps(_mm_load_ps(b.mx), _mm_load_ps(a.mi)),
-							  _mm_cmplt_ps(_mm_load_ps(a.mx), _mm_load_ps(b.mi))));
-#if defined(_WIN32)
-	const __int32* pu((const __int32*)&rt);
-#else
-	const int* pu((const int*)&rt);
-#endif
-	return ((pu[0] | pu[1] | pu[2]) == 0);
+	//unaligned loads, the volumes are only 16 byte aligned when btVector3 is, and the same comparisons as the generic version
+	const __m128 rt(_mm_and_ps(_mm_cmple_ps(_mm_loadu_ps(a.mi), _mm_loadu_ps(b.mx)),
+							   _mm_cmple_ps(_mm_loadu_ps(b.mi), _mm_loadu_ps(a.mx))));
+	return ((_mm_movemask_ps(rt) & 7) == 7);
 #else
 	return ((a.mi.x() <= b.mx.x()) &&
 			(a.mx.x() >= b.mi.x()) &&
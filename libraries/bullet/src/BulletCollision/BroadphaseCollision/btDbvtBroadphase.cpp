@@ -147,7 +147,11 @@ btDbvtBroadphase::btDbvtBroadphase(btOverlappingPairCache* paircache)
 	m_gid = 0;
 	m_pid = 0;
 	m_cid = 0;
-	for (int i = 0; i <= STAGECOUNT; ++i)
+	m_externalBegin = 0;
+	m_externalEnd = 0;
+	m_arena = 0;
+	m_freeProxies = 0;
+	for (int i = 0; i <= SLEEPING_STAGE; ++i)
 	{
 		m_stageRoots[i] = 0;
 	}
@@ -171,6 +175,16 @@ btDbvtBroadphase::~btDbvtBroadphase()
 	}
 }
 
+//the set that holds the leaf of a proxy in the given stage
+static inline int btDbvtSetOfStage(int stage)
+{
+	if (stage == btDbvtBroadphase::STAGECOUNT)
+		return btDbvtBroadphase::FIXED_SET;
+	if (stage == btDbvtBroadphase::SLEEPING_STAGE)
+		return btDbvtBroadphase::SLEEPING_SET;
+	return btDbvtBroadphase::DYNAMIC_SET;
+}
+
 //
 btBroadphaseProxy* btDbvtBroadphase::createProxy(const btVector3& aabbMin,
 												 const btVector3& aabbMax,
@@ -180,9 +194,19 @@ btBroadphaseProxy* btDbvtBroadphase::createProxy(const btVector3& aabbMin,
 												 int collisionFilterMask,
 												 btDispatcher* /*dispatcher*/)
 {
-	btDbvtProxy* proxy = new (btAlignedAlloc(sizeof(btDbvtProxy), 16)) btDbvtProxy(aabbMin, aabbMax, userPtr,
-																				   collisionFilterGroup,
-																				   collisionFilterMask);
+	void* mem;
+	if (m_freeProxies)
+	{
+		mem = m_freeProxies;
+		m_freeProxies = m_freeProxies->links[1];
+	}
+	else
+	{
+		mem = m_arena ? m_arena->allocate(sizeof(btDbvtProxy), 16) : btAlignedAlloc(sizeof(btDbvtProxy), 16);
+	}
+	btDbvtProxy* proxy = new (mem) btDbvtProxy(aabbMin, aabbMax, userPtr,
+											   collisionFilterGroup,
+											   collisionFilterMask);
 
 	btDbvtAabbMm aabb = btDbvtVolume::FromMM(aabbMin, aabbMax);
 
@@ -197,6 +221,7 @@ btBroadphaseProxy* btDbvtBroadphase::createProxy(const btVector3& aabbMin,
 		collider.proxy = proxy;
 		m_sets[0].collideTV(m_sets[0].m_root, aabb, collider);
 		m_sets[1].collideTV(m_sets[1].m_root, aabb, collider);
+		m_sets[2].collideTV(m_sets[2].m_root, aabb, collider);
 	}
 	return (proxy);
 }
@@ -206,16 +231,47 @@ void btDbvtBroadphase::destroyProxy(btBroadphaseProxy* absproxy,
 									btDispatcher* dispatcher)
 {
 	btDbvtProxy* proxy = (btDbvtProxy*)absproxy;
-	if (proxy->stage == STAGECOUNT)
-		m_sets[1].remove(proxy->leaf);
-	else
-		m_sets[0].remove(proxy->leaf);
+	m_sets[btDbvtSetOfStage(proxy->stage)].remove(proxy->leaf);
 	listremove(proxy, m_stageRoots[proxy->stage]);
 	m_paircache->removeOverlappingPairsContainingProxy(proxy, dispatcher);
-	btAlignedFree(proxy);
+	if (((const void*)proxy < m_externalBegin) || ((const void*)proxy >= m_externalEnd))
+	{
+		if (m_arena)
+		{
+			proxy->links[1] = m_freeProxies;
+			m_freeProxies = proxy;
+		}
+		else
+		{
+			btAlignedFree(proxy);
+		}
+	}
 	m_needcleanup = true;
 }
 
+//
+void btDbvtBroadphase::setExternalMemory(const void* begin, const void* end)
+{
+	m_externalBegin = begin;
+	m_externalEnd = end;
+	for (int i = 0; i < SETCOUNT; ++i)
+	{
+		m_sets[i].setExternalNodes(begin, end);
+	}
+}
+
+//
+void btDbvtBroadphase::setArena(btArenaAllocator* arena)
+{
+	btAssert(!m_stageRoots[0] && !m_stageRoots[1] && !m_stageRoots[STAGECOUNT] && !m_stageRoots[SLEEPING_STAGE]);
+	m_arena = arena;
+	m_freeProxies = 0;
+	for (int i = 0; i < SETCOUNT; ++i)
+	{
+		m_sets[i].setArena(arena);
+	}
+}
+
 void btDbvtBroadphase::getAabb(btBroadphaseProxy* absproxy, btVector3& aabbMin, btVector3& aabbMax) const
 {
 	btDbvtProxy* proxy = (btDbvtProxy*)absproxy;
@@ -281,6 +337,17 @@ void btDbvtBroadphase::rayTest(const btVector3& rayFrom, const btVector3& rayTo,
 							  aabbMax,
 							  *stack,
 							  callback);
+
+	m_sets[2].rayTestInternal(m_sets[2].m_root,
+							  rayFrom,
+							  rayTo,
+							  rayCallback.m_rayDirectionInverse,
+							  rayCallback.m_signs,
+							  rayCallback.m_lambda_max,
+							  aabbMin,
+							  aabbMax,
+							  *stack,
+							  callback);
 }
 
 struct BroadphaseAabbTester : btDbvt::ICollide
@@ -305,6 +372,7 @@ void btDbvtBroadphase::aabbTest(const btVector3& aabbMin, const btVector3& aabbM
 	//process all children, that overlap with  the given AABB bounds
 	m_sets[0].collideTV(m_sets[0].m_root, bounds, callback);
 	m_sets[1].collideTV(m_sets[1].m_root, bounds, callback);
+	m_sets[2].collideTV(m_sets[2].m_root, bounds, callback);
 }
 
 //
@@ -321,9 +389,9 @@ void btDbvtBroadphase::setAabb(btBroadphaseProxy* absproxy,
 #endif
 	{
 		bool docollide = false;
-		if (proxy->stage == STAGECOUNT)
-		{ /* fixed -> dynamic set	*/
-			m_sets[1].remove(proxy->leaf);
+		if (proxy->stage >= STAGECOUNT)
+		{ /* fixed or sleeping -> dynamic set	*/
+			m_sets[btDbvtSetOfStage(proxy->stage)].remove(proxy->leaf);
 			proxy->leaf = m_sets[0].insert(aabb, proxy);
 			docollide = true;
 		}
@@ -366,6 +434,7 @@ void btDbvtBroadphase::setAabb(btBroadphaseProxy* absproxy,
 			{
 				btDbvtTreeCollider collider(this);
 				m_sets[1].collideTTpersistentStack(m_sets[1].m_root, proxy->leaf, collider);
+				m_sets[2].collideTTpersistentStack(m_sets[2].m_root, proxy->leaf, collider);
 				m_sets[0].collideTTpersistentStack(m_sets[0].m_root, proxy->leaf, collider);
 			}
 		}
@@ -382,9 +451,9 @@ void btDbvtBroadphase::setAabbForceUpdate(btBroadphaseProxy* absproxy,
 	ATTRIBUTE_ALIGNED16(btDbvtVolume)
 	aabb = btDbvtVolume::FromMM(aabbMin, aabbMax);
 	bool docollide = false;
-	if (proxy->stage == STAGECOUNT)
-	{ /* fixed -> dynamic set	*/
-		m_sets[1].remove(proxy->leaf);
+	if (proxy->stage >= STAGECOUNT)
+	{ /* fixed or sleeping -> dynamic set	*/
+		m_sets[btDbvtSetOfStage(proxy->stage)].remove(proxy->leaf);
 		proxy->leaf = m_sets[0].insert(aabb, proxy);
 		docollide = true;
 	}
@@ -408,11 +477,29 @@ void btDbvtBroadphase::setAabbForceUpdate(btBroadphaseProxy* absproxy,
 		{
 			btDbvtTreeCollider collider(this);
 			m_sets[1].collideTTpersistentStack(m_sets[1].m_root, proxy->leaf, collider);
+			m_sets[2].collideTTpersistentStack(m_sets[2].m_root, proxy->leaf, collider);
 			m_sets[0].collideTTpersistentStack(m_sets[0].m_root, proxy->leaf, collider);
 		}
 	}
 }
 
+//
+void btDbvtBroadphase::sleepProxy(btBroadphaseProxy* absproxy,
+								  btDispatcher* /*dispatcher*/)
+{
+	btDbvtProxy* proxy = (btDbvtProxy*)absproxy;
+	if (proxy->stage == SLEEPING_STAGE)
+		return;
+	/* dynamic or fixed -> sleeping set, the pairs of the proxy stay, the cleanup removes them when the other proxy moves away	*/
+	m_sets[btDbvtSetOfStage(proxy->stage)].remove(proxy->leaf);
+	ATTRIBUTE_ALIGNED16(btDbvtVolume)
+	aabb = btDbvtVolume::FromMM(proxy->m_aabbMin, proxy->m_aabbMax);
+	proxy->leaf = m_sets[2].insert(aabb, proxy);
+	listremove(proxy, m_stageRoots[proxy->stage]);
+	proxy->stage = SLEEPING_STAGE;
+	listappend(proxy, m_stageRoots[SLEEPING_STAGE]);
+}
+
 //
 void btDbvtBroadphase::calculateOverlappingPairs(btDispatcher* dispatcher)
 {
@@ -553,6 +640,7 @@ void btDbvtBroadphase::collide(btDispatcher* dispatcher)
 			collider.proxy = current;
 			btDbvt::collideTV(m_sets[0].m_root, current->aabb, collider);
 			btDbvt::collideTV(m_sets[1].m_root, current->aabb, collider);
+			btDbvt::collideTV(m_sets[2].m_root, current->aabb, collider);
 #endif
 			m_sets[0].remove(current->leaf);
 			ATTRIBUTE_ALIGNED16(btDbvtVolume)
@@ -571,6 +659,7 @@ void btDbvtBroadphase::collide(btDispatcher* dispatcher)
 		{
 			SPC(m_profiling.m_fdcollide);
 			m_sets[0].collideTTpersistentStack(m_sets[0].m_root, m_sets[1].m_root, collider);
+			m_sets[0].collideTTpersistentStack(m_sets[0].m_root, m_sets[2].m_root, collider);
 		}
 		if (m_deferedcollide)
 		{
@@ -626,8 +715,10 @@ void btDbvtBroadphase::collide(btDispatcher* dispatcher)
 //
 void btDbvtBroadphase::optimize()
 {
-	m_sets[0].optimizeTopDown();
-	m_sets[1].optimizeTopDown();
+	for (int i = 0; i < SETCOUNT; ++i)
+	{
+		m_sets[i].optimizeTopDown();
+	}
 }
 
 //
@@ -658,18 +749,26 @@ void btDbvtBroadphase::getBroadphaseAabb(btVector3& aabbMin, btVector3& aabbMax)
 		bounds = m_sets[1].m_root->volume;
 	else
 		bounds = btDbvtVolume::FromCR(btVector3(0, 0, 0), 0);
+	if (!m_sets[2].empty())
+	{
+		if (m_sets[0].empty() && m_sets[1].empty())
+			bounds = m_sets[2].m_root->volume;
+		else
+			Merge(bounds, m_sets[2].m_root->volume, bounds);
+	}
 	aabbMin = bounds.Mins();
 	aabbMax = bounds.Maxs();
 }
 
 void btDbvtBroadphase::resetPool(btDispatcher* dispatcher)
 {
-	int totalObjects = m_sets[0].m_leaves + m_sets[1].m_leaves;
+	int totalObjects = m_sets[0].m_leaves + m_sets[1].m_leaves + m_sets[2].m_leaves;
 	if (!totalObjects)
 	{
 		//reset internal dynamic tree data structures
 		m_sets[0].clear();
 		m_sets[1].clear();
+		m_sets[2].clear();
 
 		m_deferedcollide = false;
 		m_needcleanup = true;
@@ -686,7 +785,7 @@ void btDbvtBroadphase::resetPool(btDispatcher* dispatcher)
 		m_gid = 0;
 		m_pid = 0;
 		m_cid = 0;
-		for (int i = 0; i <= STAGECOUNT; ++i)
+		for (int i = 0; i <= SLEEPING_STAGE; ++i)
 		{
 			m_stageRoots[i] = 0;
 		}
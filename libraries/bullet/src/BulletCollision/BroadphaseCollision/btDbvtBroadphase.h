@@ -59,18 +59,23 @@ typedef btAlignedObjectArray<btDbvtProxy*> btDbvtProxyArray;
 ///The btDbvtBroadphase implements a broadphase using two dynamic AABB bounding volume hierarchies/trees (see btDbvt).
 ///One tree is used for static/non-moving objects, and another tree is used for dynamic objects. Objects can move from one tree to the other.
 ///This is a very fast broadphase, especially for very dynamic worlds where many objects are moving. Its insert/add and remove of objects is generally faster than the sweep and prune broadphases btAxisSweep3 and bt32BitAxisSweep3.
+///A third tree holds the proxies of deactivated objects, see sleepProxy. Those are only tested against moving proxies, not against
+///the fixed tree or each other, so the cost of the broadphase scales with the active objects.
 struct btDbvtBroadphase : btBroadphaseInterface
 {
 	/* Config		*/
 	enum
 	{
-		DYNAMIC_SET = 0, /* Dynamic set index	*/
-		FIXED_SET = 1,   /* Fixed set index		*/
-		STAGECOUNT = 2   /* Number of stages		*/
+		DYNAMIC_SET = 0,                 /* Dynamic set index	*/
+		FIXED_SET = 1,                   /* Fixed set index		*/
+		SLEEPING_SET = 2,                /* Sleeping set index	*/
+		SETCOUNT = 3,                    /* Number of sets		*/
+		STAGECOUNT = 2,                  /* Number of stages		*/
+		SLEEPING_STAGE = STAGECOUNT + 1  /* Stage of sleeping proxies	*/
 	};
 	/* Fields		*/
-	btDbvt m_sets[2];                           // Dbvt sets
-	btDbvtProxy* m_stageRoots[STAGECOUNT + 1];  // Stages list
+	btDbvt m_sets[SETCOUNT];                    // Dbvt sets
+	btDbvtProxy* m_stageRoots[STAGECOUNT + 2];  // Stages list, then the fixed and the sleeping list
 	btOverlappingPairCache* m_paircache;        // Pair cache
 	btScalar m_prediction;                      // Velocity prediction
 	int m_stageCurrent;                         // Current stage
@@ -88,6 +93,10 @@ struct btDbvtBroadphase : btBroadphaseInterface
 	bool m_releasepaircache;                    // Release pair cache on delete
 	bool m_deferedcollide;                      // Defere dynamic/static collision to collide call
 	bool m_needcleanup;                         // Need to run cleanup?
+	const void* m_externalBegin;                // Proxies and nodes in [m_externalBegin,m_externalEnd)
+	const void* m_externalEnd;                  // are owned by a loaded snapshot
+	btArenaAllocator* m_arena;                  // Optional proxy and node arena
+	btDbvtProxy* m_freeProxies;                 // Recycled arena proxies, linked through links[1]
 	btAlignedObjectArray<btAlignedObjectArray<const btDbvtNode*> > m_rayTestStacks;
 #if DBVT_BP_PROFILE
 	btClock m_clock;
@@ -110,6 +119,7 @@ struct btDbvtBroadphase : btBroadphaseInterface
 	btBroadphaseProxy* createProxy(const btVector3& aabbMin, const btVector3& aabbMax, int shapeType, void* userPtr, int collisionFilterGroup, int collisionFilterMask, btDispatcher* dispatcher);
 	virtual void destroyProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher);
 	virtual void setAabb(btBroadphaseProxy* proxy, const btVector3& aabbMin, const btVector3& aabbMax, btDispatcher* dispatcher);
+	virtual void sleepProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher);
 	virtual void rayTest(const btVector3& rayFrom, const btVector3& rayTo, btBroadphaseRayCallback& rayCallback, const btVector3& aabbMin = btVector3(0, 0, 0), const btVector3& aabbMax = btVector3(0, 0, 0));
 	virtual void aabbTest(const btVector3& aabbMin, const btVector3& aabbMax, btBroadphaseAabbCallback& callback);
 
@@ -125,6 +135,19 @@ struct btDbvtBroadphase : btBroadphaseInterface
 
 	void performDeferredRemoval(btDispatcher* dispatcher);
 
+	int getNumSleepingProxies() const
+	{
+		return m_sets[SLEEPING_SET].m_leaves;
+	}
+
+	///proxies and tree nodes inside the given memory block are never released by the broadphase.
+	///used by btCollisionWorldSnapshot, whose proxies and nodes live in the (memory-mapped) snapshot itself.
+	void setExternalMemory(const void* begin, const void* end);
+
+	///allocate proxies and tree nodes from arena. Destroyed proxies and nodes are recycled, and destroying the broadphase
+	///releases them without visiting the trees. Can only be changed while the broadphase is empty.
+	void setArena(btArenaAllocator* arena);
+
 	void setVelocityPrediction(btScalar prediction)
 	{
 		m_prediction = prediction;
@@ -47,7 +47,9 @@ struct btDispatcherInfo
 		  m_allowedCcdPenetration(btScalar(0.04)),
 		  m_useConvexConservativeDistanceUtil(false),
 		  m_convexConservativeDistanceThreshold(0.0f),
-		  m_deterministicOverlappingPairs(false)
+		  m_deterministicOverlappingPairs(false),
+		  m_useGjkWarmStart(false),
+		  m_gjkWarmStartMotionThreshold(btScalar(0.1))
 	{
 	}
 	btScalar m_timeStep;
@@ -63,6 +65,10 @@ struct btDispatcherInfo
 	bool m_useConvexConservativeDistanceUtil;
 	btScalar m_convexConservativeDistanceThreshold;
 	bool m_deterministicOverlappingPairs;
+	///convex pairs start GJK from the simplex of their last query, stored on the manifold, see btGjkWarmStartCache
+	bool m_useGjkWarmStart;
+	///the cache is dropped when the pair moved more than this relative to each other between queries
+	btScalar m_gjkWarmStartMotionThreshold;
 };
 
 enum ebtDispatcherQueryType
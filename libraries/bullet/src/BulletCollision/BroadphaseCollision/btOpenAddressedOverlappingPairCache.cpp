@@ -0,0 +1,409 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "btOpenAddressedOverlappingPairCache.h"
+
+#include "btDispatcher.h"
+#include "btCollisionAlgorithm.h"
+#include "LinearMath/btQuickprof.h"
+
+#include <string.h>  //memset
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+#define BT_PAIR_CACHE_USE_SSE2 1
+#include <emmintrin.h>
+#endif
+
+//bit i is set when control byte i of the group equals value
+static SIMD_FORCE_INLINE unsigned int btMatchControlGroup(const unsigned char* group, unsigned char value)
+{
+#ifdef BT_PAIR_CACHE_USE_SSE2
+	__m128i control = _mm_loadu_si128((const __m128i*)group);
+	return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(control, _mm_set1_epi8((char)value)));
+#else
+	unsigned int mask = 0;
+	for (int i = 0; i < BT_PAIR_CACHE_GROUP_SIZE; i++)
+	{
+		mask |= (unsigned int)(group[i] == value) << i;
+	}
+	return mask;
+#endif
+}
+
+//bit i is set when control byte i of the group is empty or deleted (both have the high bit set)
+static SIMD_FORCE_INLINE unsigned int btMatchFreeControlGroup(const unsigned char* group)
+{
+#ifdef BT_PAIR_CACHE_USE_SSE2
+	return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)group));
+#else
+	unsigned int mask = 0;
+	for (int i = 0; i < BT_PAIR_CACHE_GROUP_SIZE; i++)
+	{
+		mask |= (unsigned int)(group[i] >> 7) << i;
+	}
+	return mask;
+#endif
+}
+
+static SIMD_FORCE_INLINE int btLowestBit(unsigned int mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return __builtin_ctz(mask);
+#else
+	int bit = 0;
+	while (!(mask & 1))
+	{
+		mask >>= 1;
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+static SIMD_FORCE_INLINE int btHighestBit(unsigned int mask)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	return 31 - __builtin_clz(mask);
+#else
+	int bit = 0;
+	while (mask >>= 1)
+	{
+		bit++;
+	}
+	return bit;
+#endif
+}
+
+static SIMD_FORCE_INLINE unsigned char btControlHash(unsigned int hash)
+{
+	return (unsigned char)(hash >> 25);
+}
+
+btOpenAddressedOverlappingPairCache::btOpenAddressedOverlappingPairCache()
+	: m_overlapFilterCallback(0),
+	  m_ghostPairCallback(0),
+	  m_capacity(0),
+	  m_numDeleted(0)
+{
+	m_overlappingPairArray.reserve(2);
+	rehash(BT_PAIR_CACHE_GROUP_SIZE);
+}
+
+btOpenAddressedOverlappingPairCache::~btOpenAddressedOverlappingPairCache()
+{
+}
+
+void btOpenAddressedOverlappingPairCache::cleanOverlappingPair(btBroadphasePair& pair, btDispatcher* dispatcher)
+{
+	if (pair.m_algorithm && dispatcher)
+	{
+		pair.m_algorithm->~btCollisionAlgorithm();
+		dispatcher->freeCollisionAlgorithm(pair.m_algorithm);
+		pair.m_algorithm = 0;
+	}
+}
+
+void btOpenAddressedOverlappingPairCache::cleanProxyFromPairs(btBroadphaseProxy* proxy, btDispatcher* dispatcher)
+{
+	for (int i = 0; i < m_overlappingPairArray.size(); i++)
+	{
+		btBroadphasePair& pair = m_overlappingPairArray[i];
+		if ((pair.m_pProxy0 == proxy) || (pair.m_pProxy1 == proxy))
+		{
+			cleanOverlappingPair(pair, dispatcher);
+		}
+	}
+}
+
+void btOpenAddressedOverlappingPairCache::removeOverlappingPairsContainingProxy(btBroadphaseProxy* proxy, btDispatcher* dispatcher)
+{
+	for (int i = 0; i < m_overlappingPairArray.size();)
+	{
+		btBroadphasePair& pair = m_overlappingPairArray[i];
+		if ((pair.m_pProxy0 == proxy) || (pair.m_pProxy1 == proxy))
+		{
+			//the last pair is moved into slot i
+			removeOverlappingPair(pair.m_pProxy0, pair.m_pProxy1, dispatcher);
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+int btOpenAddressedOverlappingPairCache::findSlot(int uid0, int uid1, unsigned int hash) const
+{
+	const int mask = m_capacity - 1;
+	const unsigned char control = btControlHash(hash);
+	const unsigned char* controlBytes = &m_control[0];
+	const btPairSlot* slots = &m_slots[0];
+
+	int pos = int(hash) & mask;
+	for (int probe = 1; probe <= m_capacity / BT_PAIR_CACHE_GROUP_SIZE; probe++)
+	{
+		const unsigned char* group = controlBytes + pos;
+		unsigned int matches = btMatchControlGroup(group, control);
+		while (matches)
+		{
+			int slot = (pos + btLowestBit(matches)) & mask;
+			if (slots[slot].m_uid0 == uid0 && slots[slot].m_uid1 == uid1)
+			{
+				return slot;
+			}
+			matches &= matches - 1;
+		}
+		//an empty slot ends the probe sequence
+		if (btMatchControlGroup(group, CONTROL_EMPTY))
+		{
+			return -1;
+		}
+		pos = (pos + probe * BT_PAIR_CACHE_GROUP_SIZE) & mask;
+	}
+	return -1;
+}
+
+int btOpenAddressedOverlappingPairCache::findInsertSlot(unsigned int hash) const
+{
+	const int mask = m_capacity - 1;
+	int pos = int(hash) & mask;
+	for (int probe = 1;; probe++)
+	{
+		unsigned int free = btMatchFreeControlGroup(&m_control[pos]);
+		if (free)
+		{
+			return (pos + btLowestBit(free)) & mask;
+		}
+		pos = (pos + probe * BT_PAIR_CACHE_GROUP_SIZE) & mask;
+	}
+}
+
+void btOpenAddressedOverlappingPairCache::rehash(int newCapacity)
+{
+	btAssert(newCapacity >= BT_PAIR_CACHE_GROUP_SIZE && (newCapacity & (newCapacity - 1)) == 0);
+	m_capacity = newCapacity;
+	m_numDeleted = 0;
+	m_control.resize(newCapacity + BT_PAIR_CACHE_GROUP_SIZE);
+	m_slots.resize(newCapacity);
+	memset(&m_control[0], CONTROL_EMPTY, newCapacity + BT_PAIR_CACHE_GROUP_SIZE);
+
+	for (int i = 0; i < m_overlappingPairArray.size(); i++)
+	{
+		const btBroadphasePair& pair = m_overlappingPairArray[i];
+		int uid0 = pair.m_pProxy0->getUid();
+		int uid1 = pair.m_pProxy1->getUid();
+		unsigned int hash = getHash(static_cast<unsigned int>(uid0), static_cast<unsigned int>(uid1));
+		int slot = findInsertSlot(hash);
+		setControl(slot, btControlHash(hash));
+		m_slots[slot].m_pairIndex = i;
+		m_slots[slot].m_uid0 = uid0;
+		m_slots[slot].m_uid1 = uid1;
+	}
+}
+
+btBroadphasePair* btOpenAddressedOverlappingPairCache::findPair(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1)
+{
+	if (proxy0->m_uniqueId > proxy1->m_uniqueId)
+		btSwap(proxy0, proxy1);
+
+	int uid0 = proxy0->getUid();
+	int uid1 = proxy1->getUid();
+	unsigned int hash = getHash(static_cast<unsigned int>(uid0), static_cast<unsigned int>(uid1));
+	int slot = findSlot(uid0, uid1, hash);
+	if (slot < 0)
+	{
+		return NULL;
+	}
+	return &m_overlappingPairArray[m_slots[slot].m_pairIndex];
+}
+
+btBroadphasePair* btOpenAddressedOverlappingPairCache::internalAddPair(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1)
+{
+	if (proxy0->m_uniqueId > proxy1->m_uniqueId)
+		btSwap(proxy0, proxy1);
+
+	int uid0 = proxy0->getUid();
+	int uid1 = proxy1->getUid();
+	unsigned int hash = getHash(static_cast<unsigned int>(uid0), static_cast<unsigned int>(uid1));
+	int slot = findSlot(uid0, uid1, hash);
+	if (slot >= 0)
+	{
+		return &m_overlappingPairArray[m_slots[slot].m_pairIndex];
+	}
+
+	//keep the load, including deleted slots, below 7/8
+	int count = m_overlappingPairArray.size();
+	if ((count + m_numDeleted + 1) * 8 > m_capacity * 7)
+	{
+		rehash((count + 1) * 2 > m_capacity ? m_capacity * 2 : m_capacity);
+	}
+
+	void* mem = &m_overlappingPairArray.expandNonInitializing();
+
+	//this is where we add an actual pair, so also call the 'ghost'
+	if (m_ghostPairCallback)
+		m_ghostPairCallback->addOverlappingPair(proxy0, proxy1);
+
+	btBroadphasePair* pair = new (mem) btBroadphasePair(*proxy0, *proxy1);
+	pair->m_algorithm = 0;
+	pair->m_internalTmpValue = 0;
+
+	slot = findInsertSlot(hash);
+	if (m_control[slot] == CONTROL_DELETED)
+	{
+		m_numDeleted--;
+	}
+	setControl(slot, btControlHash(hash));
+	m_slots[slot].m_pairIndex = count;
+	m_slots[slot].m_uid0 = uid0;
+	m_slots[slot].m_uid1 = uid1;
+
+	return pair;
+}
+
+void* btOpenAddressedOverlappingPairCache::removeOverlappingPair(btBroadphaseProxy* proxy0, btBroadphaseProxy* proxy1, btDispatcher* dispatcher)
+{
+	if (proxy0->m_uniqueId > proxy1->m_uniqueId)
+		btSwap(proxy0, proxy1);
+
+	int uid0 = proxy0->getUid();
+	int uid1 = proxy1->getUid();
+	unsigned int hash = getHash(static_cast<unsigned int>(uid0), static_cast<unsigned int>(uid1));
+	int slot = findSlot(uid0, uid1, hash);
+	if (slot < 0)
+	{
+		return 0;
+	}
+
+	int pairIndex = m_slots[slot].m_pairIndex;
+	btBroadphasePair& pair = m_overlappingPairArray[pairIndex];
+	cleanOverlappingPair(pair, dispatcher);
+	void* userData = pair.m_internalInfo1;
+
+	//a slot can become empty again if no group probed so far was full around it, otherwise probe sequences must continue past it
+	const int mask = m_capacity - 1;
+	unsigned int emptyAfter = btMatchControlGroup(&m_control[slot], CONTROL_EMPTY);
+	unsigned int emptyBefore = btMatchControlGroup(&m_control[(slot - BT_PAIR_CACHE_GROUP_SIZE) & mask], CONTROL_EMPTY);
+	if (emptyAfter && emptyBefore && btLowestBit(emptyAfter) + (BT_PAIR_CACHE_GROUP_SIZE - 1 - btHighestBit(emptyBefore)) < BT_PAIR_CACHE_GROUP_SIZE)
+	{
+		setControl(slot, CONTROL_EMPTY);
+	}
+	else
+	{
+		setControl(slot, CONTROL_DELETED);
+		m_numDeleted++;
+	}
+
+	if (m_ghostPairCallback)
+		m_ghostPairCallback->removeOverlappingPair(proxy0, proxy1, dispatcher);
+
+	// Move the last pair into the spot of the removed pair, and point its slot at the new index.
+	int lastPairIndex = m_overlappingPairArray.size() - 1;
+	if (lastPairIndex != pairIndex)
+	{
+		const btBroadphasePair& last = m_overlappingPairArray[lastPairIndex];
+		int lastUid0 = last.m_pProxy0->getUid();
+		int lastUid1 = last.m_pProxy1->getUid();
+		int lastSlot = findSlot(lastUid0, lastUid1, getHash(static_cast<unsigned int>(lastUid0), static_cast<unsigned int>(lastUid1)));
+		btAssert(lastSlot >= 0);
+		m_slots[lastSlot].m_pairIndex = pairIndex;
+		m_overlappingPairArray[pairIndex] = last;
+	}
+	m_overlappingPairArray.pop_back();
+
+	return userData;
+}
+
+void btOpenAddressedOverlappingPairCache::processAllOverlappingPairs(btOverlapCallback* callback, btDispatcher* dispatcher)
+{
+	BT_PROFILE("btOpenAddressedOverlappingPairCache::processAllOverlappingPairs");
+	for (int i = 0; i < m_overlappingPairArray.size();)
+	{
+		btBroadphasePair* pair = &m_overlappingPairArray[i];
+		if (callback->processOverlap(*pair))
+		{
+			removeOverlappingPair(pair->m_pProxy0, pair->m_pProxy1, dispatcher);
+		}
+		else
+		{
+			i++;
+		}
+	}
+}
+
+struct btOpenAddressedPairIndex
+{
+	int m_orgIndex;
+	int m_uidA0;
+	int m_uidA1;
+};
+
+class btOpenAddressedPairIndexSortPredicate
+{
+public:
+	bool operator()(const btOpenAddressedPairIndex& a, const btOpenAddressedPairIndex& b) const
+	{
+		return a.m_uidA0 > b.m_uidA0 || (a.m_uidA0 == b.m_uidA0 && a.m_uidA1 > b.m_uidA1);
+	}
+};
+
+void btOpenAddressedOverlappingPairCache::processAllOverlappingPairs(btOverlapCallback* callback, btDispatcher* dispatcher, const struct btDispatcherInfo& dispatchInfo)
+{
+	if (!dispatchInfo.m_deterministicOverlappingPairs)
+	{
+		processAllOverlappingPairs(callback, dispatcher);
+		return;
+	}
+
+	//same order as btHashedOverlappingPairCache: descending unique ids
+	btAlignedObjectArray<btOpenAddressedPairIndex> indices;
+	{
+		BT_PROFILE("sortOverlappingPairs");
+		indices.resize(m_overlappingPairArray.size());
+		for (int i = 0; i < indices.size(); i++)
+		{
+			const btBroadphasePair& p = m_overlappingPairArray[i];
+			indices[i].m_uidA0 = p.m_pProxy0 ? p.m_pProxy0->m_uniqueId : -1;
+			indices[i].m_uidA1 = p.m_pProxy1 ? p.m_pProxy1->m_uniqueId : -1;
+			indices[i].m_orgIndex = i;
+		}
+		indices.quickSort(btOpenAddressedPairIndexSortPredicate());
+	}
+	{
+		BT_PROFILE("btOpenAddressedOverlappingPairCache::processAllOverlappingPairs");
+		//a removal moves the last pair into the removed slot, which would make the sorted indices stale,
+		//so the pairs the callback removes are only collected here and removed after every pair was visited
+		btAlignedObjectArray<btBroadphasePair> removedPairs;
+		for (int i = 0; i < indices.size(); i++)
+		{
+			btBroadphasePair& pair = m_overlappingPairArray[indices[i].m_orgIndex];
+			if (callback->processOverlap(pair))
+			{
+				removedPairs.push_back(pair);
+			}
+		}
+		for (int i = 0; i < removedPairs.size(); i++)
+		{
+			removeOverlappingPair(removedPairs[i].m_pProxy0, removedPairs[i].m_pProxy1, dispatcher);
+		}
+	}
+}
+
+void btOpenAddressedOverlappingPairCache::sortOverlappingPairs(btDispatcher* dispatcher)
+{
+	//the table only stores pair indices, so sorting the array and rebuilding the table keeps the pairs and their algorithms
+	m_overlappingPairArray.quickSort(btBroadphasePairSortPredicate());
+	rehash(m_capacity);
+}
@@ -0,0 +1,169 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_OPEN_ADDRESSED_OVERLAPPING_PAIR_CACHE_H
+#define BT_OPEN_ADDRESSED_OVERLAPPING_PAIR_CACHE_H
+
+#include "btOverlappingPairCache.h"
+
+///Number of control bytes that are probed at once
+#define BT_PAIR_CACHE_GROUP_SIZE 16
+
+///The btOpenAddressedOverlappingPairCache is a drop-in replacement for btHashedOverlappingPairCache.
+///Like the hashed cache it keeps the pairs in one contiguous array, but it looks them up in an open-addressed table instead of hash chains.
+///Every table slot has a control byte holding 7 bits of the pair hash (or an empty/deleted marker), and a lookup compares a group of
+///16 control bytes against the hash at once (SSE2 when available), and only slots with a matching hash byte compare the proxy ids.
+ATTRIBUTE_ALIGNED16(class)
+btOpenAddressedOverlappingPairCache : public btOverlappingPairCache
+{
+	btBroadphasePairArray m_overlappingPairArray;
+	btOverlapFilterCallback* m_overlapFilterCallback;
+	btOverlappingPairCallback* m_ghostPairCallback;
+
+	//m_capacity control bytes, followed by a copy of the first group so a group can always be loaded in one go
+	btAlignedObjectArray<unsigned char> m_control;
+	//pair index and proxy ids of each slot, so probing doesn't touch the pair array
+	struct btPairSlot
+	{
+		int m_pairIndex;
+		int m_uid0;
+		int m_uid1;
+	};
+	btAlignedObjectArray<btPairSlot> m_slots;
+	int m_capacity;
+	int m_numDeleted;
+
+public:
+	BT_DECLARE_ALIGNED_ALLOCATOR();
+
+	btOpenAddressedOverlappingPairCache();
+	virtual ~btOpenAddressedOverlappingPairCache();
+
+	void removeOverlappingPairsContainingProxy(btBroadphaseProxy * proxy, btDispatcher * dispatcher);
+
+	virtual void* removeOverlappingPair(btBroadphaseProxy * proxy0, btBroadphaseProxy * proxy1, btDispatcher * dispatcher);
+
+	SIMD_FORCE_INLINE bool needsBroadphaseCollision(btBroadphaseProxy * proxy0, btBroadphaseProxy * proxy1) const
+	{
+		if (m_overlapFilterCallback)
+			return m_overlapFilterCallback->needBroadphaseCollision(proxy0, proxy1);
+
+		bool collides = (proxy0->m_collisionFilterGroup & proxy1->m_collisionFilterMask) != 0;
+		collides = collides && (proxy1->m_collisionFilterGroup & proxy0->m_collisionFilterMask);
+
+		return collides;
+	}
+
+	// Add a pair and return the new pair. If the pair already exists,
+	// no new pair is created and the old one is returned.
+	virtual btBroadphasePair* addOverlappingPair(btBroadphaseProxy * proxy0, btBroadphaseProxy * proxy1)
+	{
+		if (!needsBroadphaseCollision(proxy0, proxy1))
+			return 0;
+
+		return internalAddPair(proxy0, proxy1);
+	}
+
+	void cleanProxyFromPairs(btBroadphaseProxy * proxy, btDispatcher * dispatcher);
+
+	virtual void processAllOverlappingPairs(btOverlapCallback*, btDispatcher * dispatcher);
+
+	virtual void processAllOverlappingPairs(btOverlapCallback * callback, btDispatcher * dispatcher, const struct btDispatcherInfo& dispatchInfo);
+
+	virtual btBroadphasePair* getOverlappingPairArrayPtr()
+	{
+		return &m_overlappingPairArray[0];
+	}
+
+	const btBroadphasePair* getOverlappingPairArrayPtr() const
+	{
+		return &m_overlappingPairArray[0];
+	}
+
+	btBroadphasePairArray& getOverlappingPairArray()
+	{
+		return m_overlappingPairArray;
+	}
+
+	const btBroadphasePairArray& getOverlappingPairArray() const
+	{
+		return m_overlappingPairArray;
+	}
+
+	void cleanOverlappingPair(btBroadphasePair & pair, btDispatcher * dispatcher);
+
+	btBroadphasePair* findPair(btBroadphaseProxy * proxy0, btBroadphaseProxy * proxy1);
+
+	btOverlapFilterCallback* getOverlapFilterCallback()
+	{
+		return m_overlapFilterCallback;
+	}
+
+	void setOverlapFilterCallback(btOverlapFilterCallback * callback)
+	{
+		m_overlapFilterCallback = callback;
+	}
+
+	int getNumOverlappingPairs() const
+	{
+		return m_overlappingPairArray.size();
+	}
+
+	virtual bool hasDeferredRemoval()
+	{
+		return false;
+	}
+
+	virtual void setInternalGhostPairCallback(btOverlappingPairCallback * ghostPairCallback)
+	{
+		m_ghostPairCallback = ghostPairCallback;
+	}
+
+	virtual void sortOverlappingPairs(btDispatcher * dispatcher);
+
+private:
+	enum
+	{
+		CONTROL_EMPTY = 0x80,
+		CONTROL_DELETED = 0xfe
+	};
+
+	btBroadphasePair* internalAddPair(btBroadphaseProxy * proxy0, btBroadphaseProxy * proxy1);
+
+	//returns the slot holding the pair, or -1
+	int findSlot(int uid0, int uid1, unsigned int hash) const;
+
+	//returns the first empty or deleted slot in the probe sequence of hash
+	int findInsertSlot(unsigned int hash) const;
+
+	void rehash(int newCapacity);
+
+	SIMD_FORCE_INLINE void setControl(int slot, unsigned char control)
+	{
+		m_control[slot] = control;
+		if (slot < BT_PAIR_CACHE_GROUP_SIZE)
+			m_control[m_capacity + slot] = control;
+	}
+
+	SIMD_FORCE_INLINE static unsigned int getHash(unsigned int proxyId1, unsigned int proxyId2)
+	{
+		//64 bit multiplicative mix of both ids, the top bits are the best mixed
+		unsigned long long int key = ((unsigned long long int)proxyId1 << 32) | proxyId2;
+		key *= 0x9E3779B97F4A7C15ull;
+		return (unsigned int)(key >> 32);
+	}
+};
+
+#endif  //BT_OPEN_ADDRESSED_OVERLAPPING_PAIR_CACHE_H
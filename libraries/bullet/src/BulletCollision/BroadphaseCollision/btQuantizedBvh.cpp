@@ -18,6 +18,7 @@ subject to the following restrictions:
 #include "LinearMath/btAabbUtil2.h"
 #include "LinearMath/btIDebugDraw.h"
 #include "LinearMath/btSerializer.h"
+#include "LinearMath/btThreads.h"
 
 #define RAYAABB2
 
@@ -28,6 +29,8 @@ btQuantizedBvh::btQuantizedBvh() : m_bulletVersion(BT_BULLET_VERSION),
 								   //m_traversalMode(TRAVERSAL_RECURSIVE)
 								   ,
 								   m_subtreeHeaderCount(0)  //PCK: add this line
+								   ,
+								   m_buildMode(BUILD_MEDIAN_SPLIT)
 {
 	m_bvhAabbMin.setValue(-SIMD_INFINITY, -SIMD_INFINITY, -SIMD_INFINITY);
 	m_bvhAabbMax.setValue(SIMD_INFINITY, SIMD_INFINITY, SIMD_INFINITY);
@@ -47,9 +50,7 @@ void btQuantizedBvh::buildInternal()
 		m_quantizedContiguousNodes.resize(2 * numLeafNodes);
 	}
 
-	m_curNodeIndex = 0;
-
-	buildTree(0, numLeafNodes);
+	buildTreeFromLeafNodes(numLeafNodes);
 
 	///if the entire tree is small then subtree size, we need to create a header info for the tree
 	if (m_useQuantization && !m_SubtreeHeaders.size())
@@ -309,6 +310,564 @@ int btQuantizedBvh::calcSplittingAxis(int startIndex, int endIndex)
 	return variance.maxAxis();
 }
 
+///number of centroid bins per axis used by the binned SAH build
+#define BT_BVH_SAH_BIN_COUNT 16
+///ranges with fewer leaf nodes are only binned along the axis of largest centroid extent
+#define BT_BVH_SAH_ALL_AXES_LEAF_COUNT 1024
+///ranges with at most this many leaf nodes are built recursively by a single task
+#define BT_BVH_SAH_MIN_SUBTREE_LEAF_COUNT 2048
+///number of leaf nodes binned per task while the upper levels of the tree are split
+#define BT_BVH_SAH_BIN_CHUNK_SIZE 16384
+///beyond this depth the SAH build falls back to the balanced median split, this bounds the recursion depth
+#define BT_BVH_SAH_MAX_DEPTH 48
+
+static btScalar btBvhHalfSurfaceArea(const btVector3& aabbMin, const btVector3& aabbMax)
+{
+	btVector3 extent = aabbMax - aabbMin;
+	return extent.x() * extent.y() + extent.y() * extent.z() + extent.z() * extent.x();
+}
+
+ATTRIBUTE_ALIGNED16(struct)
+btBvhSahBounds
+{
+	BT_DECLARE_ALIGNED_ALLOCATOR();
+
+	btVector3 m_aabbMin;
+	btVector3 m_aabbMax;
+	btVector3 m_centroidMin;
+	btVector3 m_centroidMax;
+
+	void reset()
+	{
+		m_aabbMin.setValue(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+		m_aabbMax.setValue(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+		m_centroidMin = m_aabbMin;
+		m_centroidMax = m_aabbMax;
+	}
+
+	void add(const btVector3& aabbMin, const btVector3& aabbMax, const btVector3& centroid)
+	{
+		m_aabbMin.setMin(aabbMin);
+		m_aabbMax.setMax(aabbMax);
+		m_centroidMin.setMin(centroid);
+		m_centroidMax.setMax(centroid);
+	}
+
+	void merge(const btBvhSahBounds& other)
+	{
+		m_aabbMin.setMin(other.m_aabbMin);
+		m_aabbMax.setMax(other.m_aabbMax);
+		m_centroidMin.setMin(other.m_centroidMin);
+		m_centroidMax.setMax(other.m_centroidMax);
+	}
+};
+
+ATTRIBUTE_ALIGNED16(struct)
+btBvhSahBins
+{
+	BT_DECLARE_ALIGNED_ALLOCATOR();
+
+	btVector3 m_aabbMin[3][BT_BVH_SAH_BIN_COUNT];
+	btVector3 m_aabbMax[3][BT_BVH_SAH_BIN_COUNT];
+	int m_count[3][BT_BVH_SAH_BIN_COUNT];
+
+	void reset()
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (int bin = 0; bin < BT_BVH_SAH_BIN_COUNT; bin++)
+			{
+				m_aabbMin[axis][bin].setValue(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+				m_aabbMax[axis][bin].setValue(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+				m_count[axis][bin] = 0;
+			}
+		}
+	}
+
+	void merge(const btBvhSahBins& other)
+	{
+		for (int axis = 0; axis < 3; axis++)
+		{
+			for (int bin = 0; bin < BT_BVH_SAH_BIN_COUNT; bin++)
+			{
+				m_aabbMin[axis][bin].setMin(other.m_aabbMin[axis][bin]);
+				m_aabbMax[axis][bin].setMax(other.m_aabbMax[axis][bin]);
+				m_count[axis][bin] += other.m_count[axis][bin];
+			}
+		}
+	}
+};
+
+ATTRIBUTE_ALIGNED16(struct)
+btBvhBuildTask
+{
+	BT_DECLARE_ALIGNED_ALLOCATOR();
+
+	btBvhSahBounds m_bounds;
+	int m_startIndex;
+	int m_endIndex;
+	int m_nodeIndex;
+	int m_depth;
+};
+
+///btQuantizedBvhSahBuilder builds the tree top-down with a binned surface area heuristic.
+///The node layout is identical to buildTree: the left child directly follows its parent and a subtree over n leaf nodes
+///occupies exactly 2n-1 nodes. This fixes the node index of every subtree up front, so the upper levels are split
+///(with chunked parallel binning) and the remaining subtrees are built concurrently into disjoint node ranges.
+///Bounds and bin counts are merged in a fixed order, so the resulting tree does not depend on the number of threads.
+struct btQuantizedBvhSahBuilder
+{
+	btQuantizedBvh* m_bvh;
+
+	///unquantized leaf node bounds, kept in the same order as the leaf nodes
+	btAlignedObjectArray<btVector3> m_aabbMin;
+	btAlignedObjectArray<btVector3> m_aabbMax;
+
+	struct LeafBoundsLoop : public btIParallelForBody
+	{
+		btQuantizedBvhSahBuilder* m_builder;
+
+		void forLoop(int iBegin, int iEnd) const BT_OVERRIDE
+		{
+			for (int i = iBegin; i < iEnd; i++)
+			{
+				m_builder->m_aabbMin[i] = m_builder->m_bvh->getAabbMin(i);
+				m_builder->m_aabbMax[i] = m_builder->m_bvh->getAabbMax(i);
+			}
+		}
+	};
+
+	struct BoundsLoop : public btIParallelForBody
+	{
+		const btQuantizedBvhSahBuilder* m_builder;
+		int m_startIndex;
+		int m_endIndex;
+		btAlignedObjectArray<btBvhSahBounds>* m_chunks;
+
+		void forLoop(int iBegin, int iEnd) const BT_OVERRIDE
+		{
+			for (int chunk = iBegin; chunk < iEnd; chunk++)
+			{
+				int startIndex = m_startIndex + chunk * BT_BVH_SAH_BIN_CHUNK_SIZE;
+				int endIndex = btMin(startIndex + BT_BVH_SAH_BIN_CHUNK_SIZE, m_endIndex);
+				m_builder->calcBounds(startIndex, endIndex, (*m_chunks)[chunk]);
+			}
+		}
+	};
+
+	struct BinningLoop : public btIParallelForBody
+	{
+		const btQuantizedBvhSahBuilder* m_builder;
+		int m_startIndex;
+		int m_endIndex;
+		btVector3 m_centroidMin;
+		btVector3 m_binScale;
+		btAlignedObjectArray<btBvhSahBins>* m_chunks;
+
+		void forLoop(int iBegin, int iEnd) const BT_OVERRIDE
+		{
+			for (int chunk = iBegin; chunk < iEnd; chunk++)
+			{
+				int startIndex = m_startIndex + chunk * BT_BVH_SAH_BIN_CHUNK_SIZE;
+				int endIndex = btMin(startIndex + BT_BVH_SAH_BIN_CHUNK_SIZE, m_endIndex);
+				m_builder->calcBins(startIndex, endIndex, m_centroidMin, m_binScale, (*m_chunks)[chunk]);
+			}
+		}
+	};
+
+	struct SubtreeLoop : public btIParallelForBody
+	{
+		btQuantizedBvhSahBuilder* m_builder;
+		const btAlignedObjectArray<btBvhBuildTask>* m_subtrees;
+
+		void forLoop(int iBegin, int iEnd) const BT_OVERRIDE
+		{
+			for (int i = iBegin; i < iEnd; i++)
+			{
+				const btBvhBuildTask& task = (*m_subtrees)[i];
+				m_builder->buildSubtree(task.m_startIndex, task.m_endIndex, task.m_nodeIndex, task.m_depth, task.m_bounds);
+			}
+		}
+	};
+
+	btQuantizedBvhSahBuilder(btQuantizedBvh* bvh)
+		: m_bvh(bvh)
+	{
+	}
+
+	btVector3 getCentroid(int leafIndex) const
+	{
+		return btScalar(0.5) * (m_aabbMax[leafIndex] + m_aabbMin[leafIndex]);
+	}
+
+	void swapLeafNodes(int firstIndex, int secondIndex)
+	{
+		m_bvh->swapLeafNodes(firstIndex, secondIndex);
+		m_aabbMin.swap(firstIndex, secondIndex);
+		m_aabbMax.swap(firstIndex, secondIndex);
+	}
+
+	static int getBin(const btVector3& centroid, const btVector3& centroidMin, const btVector3& binScale, int axis)
+	{
+		int bin = int((centroid[axis] - centroidMin[axis]) * binScale[axis]);
+		return bin < BT_BVH_SAH_BIN_COUNT ? bin : BT_BVH_SAH_BIN_COUNT - 1;
+	}
+
+	void calcBounds(int startIndex, int endIndex, btBvhSahBounds& bounds) const
+	{
+		bounds.reset();
+		for (int i = startIndex; i < endIndex; i++)
+		{
+			bounds.add(m_aabbMin[i], m_aabbMax[i], getCentroid(i));
+		}
+	}
+
+	void calcBins(int startIndex, int endIndex, const btVector3& centroidMin, const btVector3& binScale, btBvhSahBins& bins) const
+	{
+		bins.reset();
+		for (int i = startIndex; i < endIndex; i++)
+		{
+			const btVector3& aabbMin = m_aabbMin[i];
+			const btVector3& aabbMax = m_aabbMax[i];
+			btVector3 centroid = btScalar(0.5) * (aabbMax + aabbMin);
+			for (int axis = 0; axis < 3; axis++)
+			{
+				if (binScale[axis] == btScalar(0.))
+				{
+					continue;
+				}
+				int bin = getBin(centroid, centroidMin, binScale, axis);
+				bins.m_aabbMin[axis][bin].setMin(aabbMin);
+				bins.m_aabbMax[axis][bin].setMax(aabbMax);
+				bins.m_count[axis][bin]++;
+			}
+		}
+	}
+
+	void calcBoundsParallel(int startIndex, int endIndex, btBvhSahBounds& bounds) const
+	{
+		int numChunks = (endIndex - startIndex + BT_BVH_SAH_BIN_CHUNK_SIZE - 1) / BT_BVH_SAH_BIN_CHUNK_SIZE;
+		btAlignedObjectArray<btBvhSahBounds> chunks;
+		chunks.resize(numChunks);
+
+		BoundsLoop loop;
+		loop.m_builder = this;
+		loop.m_startIndex = startIndex;
+		loop.m_endIndex = endIndex;
+		loop.m_chunks = &chunks;
+		btParallelForIfScheduled(0, numChunks, 1, loop);
+
+		bounds.reset();
+		for (int chunk = 0; chunk < numChunks; chunk++)
+		{
+			bounds.merge(chunks[chunk]);
+		}
+	}
+
+	void calcBinsParallel(int startIndex, int endIndex, const btVector3& centroidMin, const btVector3& binScale, btBvhSahBins& bins) const
+	{
+		int numChunks = (endIndex - startIndex + BT_BVH_SAH_BIN_CHUNK_SIZE - 1) / BT_BVH_SAH_BIN_CHUNK_SIZE;
+		btAlignedObjectArray<btBvhSahBins> chunks;
+		chunks.resize(numChunks);
+
+		BinningLoop loop;
+		loop.m_builder = this;
+		loop.m_startIndex = startIndex;
+		loop.m_endIndex = endIndex;
+		loop.m_centroidMin = centroidMin;
+		loop.m_binScale = binScale;
+		loop.m_chunks = &chunks;
+		btParallelForIfScheduled(0, numChunks, 1, loop);
+
+		bins.reset();
+		for (int chunk = 0; chunk < numChunks; chunk++)
+		{
+			bins.merge(chunks[chunk]);
+		}
+	}
+
+	///returns the split index, or -1 when no bin boundary separates the centroids.
+	///The bounds of both halves are gathered while partitioning, so children never need a separate bounds pass.
+	int partitionSah(int startIndex, int endIndex, const btBvhSahBounds& bounds, bool parallel, btBvhSahBounds& leftBounds, btBvhSahBounds& rightBounds)
+	{
+		btVector3 centroidExtent = bounds.m_centroidMax - bounds.m_centroidMin;
+		btVector3 binScale(btScalar(0.), btScalar(0.), btScalar(0.));
+		//small ranges are only binned along the largest centroid extent, a zero scale disables an axis
+		int largestAxis = centroidExtent.maxAxis();
+		bool allAxes = (endIndex - startIndex) >= BT_BVH_SAH_ALL_AXES_LEAF_COUNT;
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (centroidExtent[axis] > SIMD_EPSILON && (allAxes || axis == largestAxis))
+			{
+				binScale[axis] = btScalar(BT_BVH_SAH_BIN_COUNT) / centroidExtent[axis];
+			}
+		}
+
+		btBvhSahBins bins;
+		if (parallel)
+		{
+			calcBinsParallel(startIndex, endIndex, bounds.m_centroidMin, binScale, bins);
+		}
+		else
+		{
+			calcBins(startIndex, endIndex, bounds.m_centroidMin, binScale, bins);
+		}
+
+		int bestAxis = -1;
+		int bestBin = -1;
+		btScalar bestCost = SIMD_INFINITY;
+
+		for (int axis = 0; axis < 3; axis++)
+		{
+			if (binScale[axis] == btScalar(0.))
+			{
+				continue;
+			}
+
+			//sweep from the right to gather the cost of everything above each bin boundary
+			btScalar rightCost[BT_BVH_SAH_BIN_COUNT];
+			btVector3 aabbMin(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+			btVector3 aabbMax(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+			int count = 0;
+			for (int bin = BT_BVH_SAH_BIN_COUNT - 1; bin > 0; bin--)
+			{
+				aabbMin.setMin(bins.m_aabbMin[axis][bin]);
+				aabbMax.setMax(bins.m_aabbMax[axis][bin]);
+				count += bins.m_count[axis][bin];
+				rightCost[bin] = count ? btScalar(count) * btBvhHalfSurfaceArea(aabbMin, aabbMax) : btScalar(-1.);
+			}
+
+			aabbMin.setValue(BT_LARGE_FLOAT, BT_LARGE_FLOAT, BT_LARGE_FLOAT);
+			aabbMax.setValue(-BT_LARGE_FLOAT, -BT_LARGE_FLOAT, -BT_LARGE_FLOAT);
+			count = 0;
+			for (int bin = 0; bin < BT_BVH_SAH_BIN_COUNT - 1; bin++)
+			{
+				aabbMin.setMin(bins.m_aabbMin[axis][bin]);
+				aabbMax.setMax(bins.m_aabbMax[axis][bin]);
+				count += bins.m_count[axis][bin];
+				if (!count || rightCost[bin + 1] < btScalar(0.))
+				{
+					continue;
+				}
+				btScalar cost = btScalar(count) * btBvhHalfSurfaceArea(aabbMin, aabbMax) + rightCost[bin + 1];
+				if (cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = bin;
+				}
+			}
+		}
+
+		if (bestAxis < 0)
+		{
+			return -1;
+		}
+
+		//move all leaf nodes in bins up to and including bestBin to the front of the range
+		leftBounds.reset();
+		rightBounds.reset();
+		int i = startIndex;
+		int j = endIndex - 1;
+		while (i <= j)
+		{
+			btVector3 centroid = getCentroid(i);
+			if (getBin(centroid, bounds.m_centroidMin, binScale, bestAxis) <= bestBin)
+			{
+				leftBounds.add(m_aabbMin[i], m_aabbMax[i], centroid);
+				i++;
+			}
+			else
+			{
+				rightBounds.add(m_aabbMin[i], m_aabbMax[i], centroid);
+				swapLeafNodes(i, j);
+				j--;
+			}
+		}
+		return i;
+	}
+
+	///same strategy as sortAndCalcSplittingIndex, but splitting at the center of the centroid bounds along their largest extent
+	int partitionMedian(int startIndex, int endIndex, const btBvhSahBounds& bounds, btBvhSahBounds& leftBounds, btBvhSahBounds& rightBounds)
+	{
+		int numIndices = endIndex - startIndex;
+		int splitAxis = (bounds.m_centroidMax - bounds.m_centroidMin).maxAxis();
+		btScalar splitValue = btScalar(0.5) * (bounds.m_centroidMax[splitAxis] + bounds.m_centroidMin[splitAxis]);
+
+		int splitIndex = startIndex;
+		for (int i = startIndex; i < endIndex; i++)
+		{
+			if (getCentroid(i)[splitAxis] > splitValue)
+			{
+				swapLeafNodes(i, splitIndex);
+				splitIndex++;
+			}
+		}
+
+		int rangeBalancedIndices = numIndices / 3;
+		bool unbalanced = ((splitIndex <= (startIndex + rangeBalancedIndices)) || (splitIndex >= (endIndex - 1 - rangeBalancedIndices)));
+		if (unbalanced)
+		{
+			splitIndex = startIndex + (numIndices >> 1);
+		}
+
+		calcBounds(startIndex, splitIndex, leftBounds);
+		calcBounds(splitIndex, endIndex, rightBounds);
+		return splitIndex;
+	}
+
+	///writes the internal node for range startIndex/endIndex and returns the split index of its children
+	int buildInternalNode(int startIndex, int endIndex, int nodeIndex, int depth, bool parallel, const btBvhSahBounds& bounds, btBvhSahBounds& leftBounds, btBvhSahBounds& rightBounds)
+	{
+		int numIndices = endIndex - startIndex;
+		btAssert(numIndices > 1);
+
+		//quantization is monotonic, so quantizing the merged bounds equals merging the quantized leaf bounds in buildTree
+		m_bvh->setInternalNodeAabbMin(nodeIndex, bounds.m_aabbMin);
+		m_bvh->setInternalNodeAabbMax(nodeIndex, bounds.m_aabbMax);
+		m_bvh->setInternalNodeEscapeIndex(nodeIndex, 2 * numIndices - 1);
+
+		int splitIndex = -1;
+		if (depth < BT_BVH_SAH_MAX_DEPTH)
+		{
+			splitIndex = partitionSah(startIndex, endIndex, bounds, parallel && numIndices > BT_BVH_SAH_BIN_CHUNK_SIZE, leftBounds, rightBounds);
+		}
+		if (splitIndex <= startIndex || splitIndex >= endIndex)
+		{
+			splitIndex = partitionMedian(startIndex, endIndex, bounds, leftBounds, rightBounds);
+		}
+		return splitIndex;
+	}
+
+	void buildSubtree(int startIndex, int endIndex, int nodeIndex, int depth, const btBvhSahBounds& bounds)
+	{
+		if (endIndex - startIndex == 1)
+		{
+			m_bvh->assignInternalNodeFromLeafNode(nodeIndex, startIndex);
+			return;
+		}
+
+		btBvhSahBounds leftBounds;
+		btBvhSahBounds rightBounds;
+		int splitIndex = buildInternalNode(startIndex, endIndex, nodeIndex, depth, false, bounds, leftBounds, rightBounds);
+
+		buildSubtree(startIndex, splitIndex, nodeIndex + 1, depth + 1, leftBounds);
+		buildSubtree(splitIndex, endIndex, nodeIndex + 2 * (splitIndex - startIndex), depth + 1, rightBounds);
+	}
+
+	///adds the subtree headers in the same (post-)order as buildTree/updateSubtreeHeaders
+	void buildSubtreeHeaders(int nodeIndex)
+	{
+		const btQuantizedBvhNode& node = m_bvh->m_quantizedContiguousNodes[nodeIndex];
+		if (node.isLeafNode())
+		{
+			return;
+		}
+
+		int treeSizeInBytes = node.getEscapeIndex() * static_cast<int>(sizeof(btQuantizedBvhNode));
+		if (treeSizeInBytes <= MAX_SUBTREE_SIZE_IN_BYTES)
+		{
+			return;
+		}
+
+		int leftChildNodeIndex = nodeIndex + 1;
+		const btQuantizedBvhNode& leftChildNode = m_bvh->m_quantizedContiguousNodes[leftChildNodeIndex];
+		int rightChildNodeIndex = leftChildNodeIndex + (leftChildNode.isLeafNode() ? 1 : leftChildNode.getEscapeIndex());
+
+		buildSubtreeHeaders(leftChildNodeIndex);
+		buildSubtreeHeaders(rightChildNodeIndex);
+
+		m_bvh->updateSubtreeHeaders(leftChildNodeIndex, rightChildNodeIndex);
+	}
+
+	void build(int numLeafNodes)
+	{
+		btAssert(numLeafNodes > 0);
+
+		int numThreads = 1;
+#if BT_THREADSAFE
+		if (btGetTaskScheduler())
+		{
+			numThreads = btGetTaskScheduler()->getNumThreads();
+		}
+#endif
+		//unquantize the leaf bounds once, instead of at every level of the tree
+		m_aabbMin.resize(numLeafNodes);
+		m_aabbMax.resize(numLeafNodes);
+		LeafBoundsLoop leafBounds;
+		leafBounds.m_builder = this;
+		btParallelForIfScheduled(0, numLeafNodes, BT_BVH_SAH_BIN_CHUNK_SIZE, leafBounds);
+		//split the upper levels until there are enough independent subtrees to keep all threads busy
+		int subtreeLeafCount = btMax(BT_BVH_SAH_MIN_SUBTREE_LEAF_COUNT, numLeafNodes / (16 * numThreads));
+
+		btAlignedObjectArray<btBvhBuildTask> subtrees;
+		btAlignedObjectArray<btBvhBuildTask> pending;
+
+		btBvhBuildTask root;
+		root.m_startIndex = 0;
+		root.m_endIndex = numLeafNodes;
+		root.m_nodeIndex = 0;
+		root.m_depth = 0;
+		calcBoundsParallel(0, numLeafNodes, root.m_bounds);
+		pending.push_back(root);
+
+		while (pending.size())
+		{
+			btBvhBuildTask task = pending[pending.size() - 1];
+			pending.pop_back();
+
+			if (task.m_endIndex - task.m_startIndex <= subtreeLeafCount)
+			{
+				subtrees.push_back(task);
+				continue;
+			}
+
+			btBvhBuildTask left;
+			btBvhBuildTask right;
+			int splitIndex = buildInternalNode(task.m_startIndex, task.m_endIndex, task.m_nodeIndex, task.m_depth, true, task.m_bounds, left.m_bounds, right.m_bounds);
+
+			right.m_startIndex = splitIndex;
+			right.m_endIndex = task.m_endIndex;
+			right.m_nodeIndex = task.m_nodeIndex + 2 * (splitIndex - task.m_startIndex);
+			right.m_depth = task.m_depth + 1;
+			pending.push_back(right);
+
+			left.m_startIndex = task.m_startIndex;
+			left.m_endIndex = splitIndex;
+			left.m_nodeIndex = task.m_nodeIndex + 1;
+			left.m_depth = task.m_depth + 1;
+			pending.push_back(left);
+		}
+
+		SubtreeLoop loop;
+		loop.m_builder = this;
+		loop.m_subtrees = &subtrees;
+		btParallelForIfScheduled(0, subtrees.size(), 1, loop);
+
+		m_bvh->m_curNodeIndex = 2 * numLeafNodes - 1;
+
+		if (m_bvh->m_useQuantization)
+		{
+			buildSubtreeHeaders(0);
+		}
+	}
+};
+
+void btQuantizedBvh::buildTreeFromLeafNodes(int numLeafNodes)
+{
+	m_curNodeIndex = 0;
+
+	if (m_buildMode == BUILD_BINNED_SAH)
+	{
+		btQuantizedBvhSahBuilder builder(this);
+		builder.build(numLeafNodes);
+	}
+	else
+	{
+		buildTree(0, numLeafNodes);
+	}
+}
+
 void btQuantizedBvh::reportAabbOverlappingNodex(btNodeOverlapCallback* nodeCallback, const btVector3& aabbMin, const btVector3& aabbMax) const
 {
 	//either choose recursive traversal (walkTree) or stackless (walkStacklessTree)
@@ -176,6 +176,12 @@ public:
 		TRAVERSAL_RECURSIVE
 	};
 
+	enum btBuildMode
+	{
+		BUILD_MEDIAN_SPLIT = 0,
+		BUILD_BINNED_SAH
+	};
+
 protected:
 	btVector3 m_bvhAabbMin;
 	btVector3 m_bvhAabbMax;
@@ -198,6 +204,8 @@ protected:
 	//This is only used for serialization so we don't have to add serialization directly to btAlignedObjectArray
 	mutable int m_subtreeHeaderCount;
 
+	btBuildMode m_buildMode;
+
 	///two versions, one for quantized and normal nodes. This allows code-reuse while maintaining readability (no template/macro!)
 	///this might be refactored into a virtual, it is usually not calculated at run-time
 	void setInternalNodeAabbMin(int nodeIndex, const btVector3& aabbMin)
@@ -286,6 +294,11 @@ protected:
 protected:
 	void buildTree(int startIndex, int endIndex);
 
+	///builds the tree over all leaf nodes, using the splitting strategy selected by m_buildMode
+	void buildTreeFromLeafNodes(int numLeafNodes);
+
+	friend struct btQuantizedBvhSahBuilder;
+
 	int calcSplittingAxis(int startIndex, int endIndex);
 
 	int sortAndCalcSplittingIndex(int startIndex, int endIndex, int splitAxis);
@@ -411,6 +424,18 @@ public:
 		return vecOut;
 	}
 
+	///setBuildMode chooses between the original median split and a binned surface area heuristic (SAH) build.
+	///The SAH build produces trees with fewer node visits per query and builds subtrees concurrently through btParallelFor.
+	void setBuildMode(btBuildMode buildMode)
+	{
+		m_buildMode = buildMode;
+	}
+
+	btBuildMode getBuildMode() const
+	{
+		return m_buildMode;
+	}
+
 	///setTraversalMode let's you choose between stackless, recursive or stackless cache friendly tree traversal. Note this is only implemented for quantized trees.
 	void setTraversalMode(btTraversalMode traversalMode)
 	{
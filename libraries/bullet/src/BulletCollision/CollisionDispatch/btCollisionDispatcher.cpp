@@ -15,6 +15,7 @@ subject to the following restrictions:
 
 #include "btCollisionDispatcher.h"
 #include "LinearMath/btQuickprof.h"
+#include "LinearMath/btAllocationTracker.h"
 
 #include "BulletCollision/BroadphaseCollision/btCollisionAlgorithm.h"
 
@@ -67,6 +68,7 @@ btCollisionDispatcher::~btCollisionDispatcher()
 
 btPersistentManifold* btCollisionDispatcher::getNewManifold(const btCollisionObject* body0, const btCollisionObject* body1)
 {
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_MANIFOLDS);
 	//btAssert(gNumManifold < 65535);
 
 	//optional relative contact breaking threshold, turned on by default (use setDispatcherFlags to switch off feature for improved performance)
@@ -25,11 +25,23 @@ subject to the following restrictions:
 #include "BulletCollision/CollisionDispatch/btCollisionConfiguration.h"
 #include "BulletCollision/CollisionDispatch/btCollisionObjectWrapper.h"
 
+//without BT_THREADSAFE all pairs are processed on the calling thread, which doesn't have a thread index
+static unsigned int btDispatcherThreadIndex()
+{
+#if BT_THREADSAFE
+	return btGetCurrentThreadIndex();
+#else
+	return 0;
+#endif
+}
+
 btCollisionDispatcherMt::btCollisionDispatcherMt(btCollisionConfiguration* config, int grainSize)
 	: btCollisionDispatcher(config)
 {
-	m_batchManifoldsPtr.resize(btGetTaskScheduler()->getNumThreads());
-	m_batchReleasePtr.resize(btGetTaskScheduler()->getNumThreads());
+	// collision-only worlds may not have set a task scheduler, the pairs are processed on the calling thread then
+	int numThreads = btGetTaskScheduler() ? btGetTaskScheduler()->getNumThreads() : 1;
+	m_batchManifoldsPtr.resize(numThreads);
+	m_batchReleasePtr.resize(numThreads);
 
 	m_batchUpdating = false;
 	m_grainSize = grainSize;  // iterations per task
@@ -70,7 +82,7 @@ btPersistentManifold* btCollisionDispatcherMt::getNewManifold(const btCollisionO
 	}
 	else
 	{
-		m_batchManifoldsPtr[btGetCurrentThreadIndex()].push_back(manifold);
+		m_batchManifoldsPtr[btDispatcherThreadIndex()].push_back(manifold);
 	}
 
 	return manifold;
@@ -91,7 +103,7 @@ void btCollisionDispatcherMt::releaseManifold(btPersistentManifold* manifold)
 		m_manifoldsPtr[findIndex]->m_index1a = findIndex;
 		m_manifoldsPtr.pop_back();
 	} else {
-		m_batchReleasePtr[btGetCurrentThreadIndex()].push_back(manifold);
+		m_batchReleasePtr[btDispatcherThreadIndex()].push_back(manifold);
 		return;
 	}
 
@@ -130,6 +142,33 @@ struct CollisionDispatcherUpdater : public btIParallelForBody
 	}
 };
 
+struct btManifoldSortKey
+{
+	int m_uid0;
+	int m_uid1;
+	int m_index;
+	btPersistentManifold* m_manifold;
+};
+
+//same order as btHashedOverlappingPairCache::processAllOverlappingPairs uses for deterministic pairs, manifolds of the same pair keep their order
+class btManifoldSortPredicate
+{
+public:
+	bool operator()(const btManifoldSortKey& a, const btManifoldSortKey& b) const
+	{
+		if (a.m_uid0 != b.m_uid0)
+			return a.m_uid0 > b.m_uid0;
+		if (a.m_uid1 != b.m_uid1)
+			return a.m_uid1 > b.m_uid1;
+		return a.m_index < b.m_index;
+	}
+};
+
+static int btManifoldBodyUid(const btCollisionObject* body)
+{
+	return body->getBroadphaseHandle() ? body->getBroadphaseHandle()->m_uniqueId : -1;
+}
+
 void btCollisionDispatcherMt::dispatchAllCollisionPairs(btOverlappingPairCache* pairCache, const btDispatcherInfo& info, btDispatcher* dispatcher)
 {
 	const int pairCount = pairCache->getNumOverlappingPairs();
@@ -144,9 +183,19 @@ void btCollisionDispatcherMt::dispatchAllCollisionPairs(btOverlappingPairCache*
 	updater.mInfo = &info;
 
 	m_batchUpdating = true;
-	btParallelFor(0, pairCount, m_grainSize, updater);
+	btParallelForIfScheduled(0, pairCount, m_grainSize, updater);
 	m_batchUpdating = false;
 
+	mergeBatchManifolds(info.m_deterministicOverlappingPairs);
+
+	if (info.m_deterministicOverlappingPairs)
+	{
+		sortManifolds();
+	}
+}
+
+void btCollisionDispatcherMt::mergeBatchManifolds(bool deterministic)
+{
 	// merge new manifolds, if any
 	for (int i = 0; i < m_batchManifoldsPtr.size(); ++i)
 	{
@@ -154,12 +203,52 @@ void btCollisionDispatcherMt::dispatchAllCollisionPairs(btOverlappingPairCache*
 
 		for (int j = 0; j < batchManifoldsPtr.size(); ++j)
 		{
+			// index is needed if the manifold is released in the same batch
+			batchManifoldsPtr[j]->m_index1a = m_manifoldsPtr.size();
 			m_manifoldsPtr.push_back(batchManifoldsPtr[j]);
 		}
 
 		batchManifoldsPtr.resizeNoInitialize(0);
 	}
 
+	if (deterministic)
+	{
+		// move the released manifolds to the end, keeping the order of the others,
+		// so the swaps done by releaseManifold don't depend on the order of the releases
+		btAlignedObjectArray<bool> released;
+		released.resize(m_manifoldsPtr.size(), false);
+		int numReleased = 0;
+		for (int i = 0; i < m_batchReleasePtr.size(); ++i)
+		{
+			btAlignedObjectArray<btPersistentManifold*>& batchManifoldsPtr = m_batchReleasePtr[i];
+			for (int j = 0; j < batchManifoldsPtr.size(); ++j)
+			{
+				released[batchManifoldsPtr[j]->m_index1a] = true;
+			}
+			numReleased += batchManifoldsPtr.size();
+		}
+		if (numReleased)
+		{
+			btAlignedObjectArray<btPersistentManifold*> releasedPtr;
+			int kept = 0;
+			for (int i = 0; i < m_manifoldsPtr.size(); ++i)
+			{
+				if (released[i])
+					releasedPtr.push_back(m_manifoldsPtr[i]);
+				else
+					m_manifoldsPtr[kept++] = m_manifoldsPtr[i];
+			}
+			for (int i = 0; i < releasedPtr.size(); ++i)
+			{
+				m_manifoldsPtr[kept + i] = releasedPtr[i];
+			}
+			for (int i = 0; i < m_manifoldsPtr.size(); ++i)
+			{
+				m_manifoldsPtr[i]->m_index1a = i;
+			}
+		}
+	}
+
 	// remove batched remove manifolds.
 	for (int i = 0; i < m_batchReleasePtr.size(); ++i)
 	{
@@ -177,3 +266,28 @@ void btCollisionDispatcherMt::dispatchAllCollisionPairs(btOverlappingPairCache*
 		m_manifoldsPtr[i]->m_index1a = i;
 	}
 }
+
+void btCollisionDispatcherMt::sortManifolds()
+{
+	// all manifolds of one pair are created by the same thread in a fixed order, and the batched
+	// releases keep the order of the remaining manifolds, so the sorted array doesn't depend on the thread count
+	BT_PROFILE("sortManifolds");
+	btAlignedObjectArray<btManifoldSortKey> keys;
+	keys.resize(m_manifoldsPtr.size());
+	for (int i = 0; i < m_manifoldsPtr.size(); ++i)
+	{
+		btPersistentManifold* manifold = m_manifoldsPtr[i];
+		int uid0 = btManifoldBodyUid(manifold->getBody0());
+		int uid1 = btManifoldBodyUid(manifold->getBody1());
+		keys[i].m_uid0 = btMin(uid0, uid1);
+		keys[i].m_uid1 = btMax(uid0, uid1);
+		keys[i].m_index = i;
+		keys[i].m_manifold = manifold;
+	}
+	keys.quickSort(btManifoldSortPredicate());
+	for (int i = 0; i < keys.size(); ++i)
+	{
+		m_manifoldsPtr[i] = keys[i].m_manifold;
+		m_manifoldsPtr[i]->m_index1a = i;
+	}
+}
@@ -19,6 +19,10 @@ subject to the following restrictions:
 #include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
 #include "LinearMath/btThreads.h"
 
+///The btCollisionDispatcherMt runs the narrowphase of all overlapping pairs in parallel with btParallelFor.
+///When btDispatcherInfo::m_deterministicOverlappingPairs is set, the manifolds created by the worker threads are merged and
+///the manifold array is sorted by the proxy unique ids of its bodies, so the manifold order (and every contact in it) is the
+///same bit for bit regardless of the number of threads, the pair scheduling and the order of the overlapping pair array.
 class btCollisionDispatcherMt : public btCollisionDispatcher
 {
 public:
@@ -30,6 +34,9 @@ public:
 	virtual void dispatchAllCollisionPairs(btOverlappingPairCache* pairCache, const btDispatcherInfo& info, btDispatcher* dispatcher) BT_OVERRIDE;
 
 protected:
+	void mergeBatchManifolds(bool deterministic);
+	void sortManifolds();
+
 	btAlignedObjectArray<btAlignedObjectArray<btPersistentManifold*> > m_batchManifoldsPtr;
 	btAlignedObjectArray<btAlignedObjectArray<btPersistentManifold*> > m_batchReleasePtr;
 	bool m_batchUpdating;
@@ -33,6 +33,7 @@ subject to the following restrictions:
 #include "BulletCollision/BroadphaseCollision/btDbvt.h"
 #include "LinearMath/btAabbUtil2.h"
 #include "LinearMath/btQuickprof.h"
+#include "LinearMath/btAllocationTracker.h"
 #include "LinearMath/btSerializer.h"
 #include "BulletCollision/CollisionShapes/btConvexPolyhedron.h"
 #include "BulletCollision/CollisionDispatch/btCollisionObjectWrapper.h"
@@ -68,7 +69,8 @@ btCollisionWorld::btCollisionWorld(btDispatcher* dispatcher, btBroadphaseInterfa
 	: m_dispatcher1(dispatcher),
 	  m_broadphasePairCache(pairCache),
 	  m_debugDrawer(0),
-	  m_forceUpdateAllAabbs(true)
+	  m_forceUpdateAllAabbs(true),
+	  m_useBroadphaseSleeping(false)
 {
 }
 
@@ -139,6 +141,7 @@ void btCollisionWorld::addCollisionObject(btCollisionObject* collisionObject, in
 	btVector3 maxAabb;
 	collisionObject->getCollisionShape()->getAabb(trans, minAabb, maxAabb);
 
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_BROADPHASE);
 	int type = collisionObject->getCollisionShape()->getShapeType();
 	collisionObject->setBroadphaseHandle(getBroadphase()->createProxy(
 		minAabb,
@@ -150,6 +153,17 @@ void btCollisionWorld::addCollisionObject(btCollisionObject* collisionObject, in
 		m_dispatcher1));
 }
 
+void btCollisionWorld::addCollisionObjectWithProxy(btCollisionObject* collisionObject, btBroadphaseProxy* proxy)
+{
+	btAssert(collisionObject);
+	btAssert(proxy && proxy->m_clientObject == collisionObject);
+	btAssert(collisionObject->getWorldArrayIndex() == -1);  // do not add the same object to more than one collision world
+
+	collisionObject->setWorldArrayIndex(m_collisionObjects.size());
+	m_collisionObjects.push_back(collisionObject);
+	collisionObject->setBroadphaseHandle(proxy);
+}
+
 void btCollisionWorld::updateSingleAabb(btCollisionObject* colObj)
 {
 	btVector3 minAabb, maxAabb;
@@ -197,12 +211,19 @@ void btCollisionWorld::updateSingleAabb(btCollisionObject* colObj)
 void btCollisionWorld::updateAabbs()
 {
 	BT_PROFILE("updateAabbs");
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_BROADPHASE);
 
 	for (int i = 0; i < m_collisionObjects.size(); i++)
 	{
 		btCollisionObject* colObj = m_collisionObjects[i];
 		btAssert(colObj->getWorldArrayIndex() == i);
 
+		if (m_useBroadphaseSleeping && !colObj->isActive() && !colObj->isStaticOrKinematicObject() && colObj->getBroadphaseHandle())
+		{
+			m_broadphasePairCache->sleepProxy(colObj->getBroadphaseHandle(), m_dispatcher1);
+			continue;
+		}
+
 		//only update aabb of active objects
 		if (m_forceUpdateAllAabbs || colObj->isActive())
 		{
@@ -214,6 +235,7 @@ void btCollisionWorld::updateAabbs()
 void btCollisionWorld::computeOverlappingPairs()
 {
 	BT_PROFILE("calculateOverlappingPairs");
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_BROADPHASE);
 	m_broadphasePairCache->calculateOverlappingPairs(m_dispatcher1);
 }
 
@@ -230,6 +252,7 @@ void btCollisionWorld::performDiscreteCollisionDetection()
 	btDispatcher* dispatcher = getDispatcher();
 	{
 		BT_PROFILE("dispatchAllCollisionPairs");
+		BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_NARROWPHASE);
 		if (dispatcher)
 			dispatcher->dispatchAllCollisionPairs(m_broadphasePairCache->getOverlappingPairCache(), dispatchInfo, m_dispatcher1);
 	}
@@ -99,6 +99,10 @@ protected:
 	///it is true by default, because it is error-prone (setting the position of static objects wouldn't update their AABB)
 	bool m_forceUpdateAllAabbs;
 
+	///m_useBroadphaseSleeping moves the proxies of deactivated dynamic objects to the sleeping set of the broadphase, see btBroadphaseInterface::sleepProxy,
+	///instead of updating their AABB. It is false by default, like m_forceUpdateAllAabbs=false a sleeping object has to be activated when it is moved.
+	bool m_useBroadphaseSleeping;
+
 	void serializeCollisionObjects(btSerializer* serializer);
 
 	void serializeContactManifolds(btSerializer* serializer);
@@ -471,6 +475,10 @@ public:
 
 	virtual void addCollisionObject(btCollisionObject* collisionObject, int collisionFilterGroup = btBroadphaseProxy::DefaultFilter, int collisionFilterMask = btBroadphaseProxy::AllFilter);
 
+	///adds an object whose broadphase proxy already exists in the broadphase, without creating a new one.
+	///used by btCollisionWorldSnapshot to restore a world without re-inserting its objects.
+	void addCollisionObjectWithProxy(btCollisionObject* collisionObject, btBroadphaseProxy* proxy);
+
 	virtual void refreshBroadphaseProxy(btCollisionObject* collisionObject);
 
 	btCollisionObjectArray& getCollisionObjectArray()
@@ -506,6 +514,15 @@ public:
 		m_forceUpdateAllAabbs = forceUpdateAllAabbs;
 	}
 
+	bool getUseBroadphaseSleeping() const
+	{
+		return m_useBroadphaseSleeping;
+	}
+	void setUseBroadphaseSleeping(bool useBroadphaseSleeping)
+	{
+		m_useBroadphaseSleeping = useBroadphaseSleeping;
+	}
+
 	///Preliminary serialization test for Bullet 2.76. Loading those files requires a separate parser (Bullet/Demos/SerializeDemo)
 	virtual void serialize(btSerializer* serializer);
 };
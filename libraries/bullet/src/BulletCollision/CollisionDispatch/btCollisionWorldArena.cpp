@@ -0,0 +1,91 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2014 Erwin Coumans  http://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "btCollisionWorldArena.h"
+#include "btCollisionWorld.h"
+#include "btCollisionDispatcher.h"
+#include "btCollisionDispatcherMt.h"
+#include "btDefaultCollisionConfiguration.h"
+#include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
+#include "BulletCollision/CollisionShapes/btBoxShape.h"
+#include "BulletCollision/CollisionShapes/btSphereShape.h"
+
+btCollisionWorldArena::btCollisionWorldArena(int slabSize, bool multithreaded)
+	: m_arena(slabSize),
+	  m_multithreaded(multithreaded)
+{
+	createWorld();
+}
+
+btCollisionWorldArena::~btCollisionWorldArena()
+{
+	destroyWorld();
+}
+
+void btCollisionWorldArena::createWorld()
+{
+	m_collisionConfiguration = new (m_arena.allocate(sizeof(btDefaultCollisionConfiguration))) btDefaultCollisionConfiguration();
+	if (m_multithreaded)
+		m_dispatcher = new (m_arena.allocate(sizeof(btCollisionDispatcherMt))) btCollisionDispatcherMt(m_collisionConfiguration);
+	else
+		m_dispatcher = new (m_arena.allocate(sizeof(btCollisionDispatcher))) btCollisionDispatcher(m_collisionConfiguration);
+	m_broadphase = new (m_arena.allocate(sizeof(btDbvtBroadphase))) btDbvtBroadphase();
+	m_broadphase->setArena(&m_arena);
+	m_collisionWorld = new (m_arena.allocate(sizeof(btCollisionWorld))) btCollisionWorld(m_dispatcher, m_broadphase, m_collisionConfiguration);
+	m_collisionWorld->getDispatchInfo().m_deterministicOverlappingPairs = m_multithreaded;
+}
+
+void btCollisionWorldArena::destroyWorld()
+{
+	//the collision algorithms live in the dispatcher pools, but may own memory of their own
+	btBroadphasePairArray& pairs = m_broadphase->getOverlappingPairCache()->getOverlappingPairArray();
+	for (int i = 0; i < pairs.size(); i++)
+	{
+		m_broadphase->getOverlappingPairCache()->cleanOverlappingPair(pairs[i], m_dispatcher);
+	}
+
+	//objects, proxies and tree nodes are released together with the arena
+	m_collisionWorld->getCollisionObjectArray().clear();
+	m_collisionWorld->~btCollisionWorld();
+	m_broadphase->~btDbvtBroadphase();
+	m_dispatcher->~btCollisionDispatcher();
+	m_collisionConfiguration->~btDefaultCollisionConfiguration();
+	m_arena.reset();
+}
+
+void btCollisionWorldArena::reset()
+{
+	destroyWorld();
+	createWorld();
+}
+
+btBoxShape* btCollisionWorldArena::createBoxShape(const btVector3& boxHalfExtents)
+{
+	return new (m_arena.allocate(sizeof(btBoxShape))) btBoxShape(boxHalfExtents);
+}
+
+btSphereShape* btCollisionWorldArena::createSphereShape(btScalar radius)
+{
+	return new (m_arena.allocate(sizeof(btSphereShape))) btSphereShape(radius);
+}
+
+btCollisionObject* btCollisionWorldArena::createCollisionObject(btCollisionShape* shape, const btTransform& worldTransform, int collisionFilterGroup, int collisionFilterMask)
+{
+	btCollisionObject* object = new (m_arena.allocate(sizeof(btCollisionObject), BT_ARENA_CACHE_LINE_SIZE)) btCollisionObject();
+	object->setCollisionShape(shape);
+	object->setWorldTransform(worldTransform);
+	m_collisionWorld->addCollisionObject(object, collisionFilterGroup, collisionFilterMask);
+	return object;
+}
@@ -0,0 +1,78 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2014 Erwin Coumans  http://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_COLLISION_WORLD_ARENA_H
+#define BT_COLLISION_WORLD_ARENA_H
+
+#include "LinearMath/btArenaAllocator.h"
+#include "LinearMath/btTransform.h"
+#include "BulletCollision/BroadphaseCollision/btBroadphaseProxy.h"
+
+class btCollisionWorld;
+class btCollisionObject;
+class btCollisionShape;
+class btBoxShape;
+class btSphereShape;
+class btCollisionDispatcher;
+class btDefaultCollisionConfiguration;
+struct btDbvtBroadphase;
+
+///The btCollisionWorldArena owns a btCollisionWorld that allocates everything from one btArenaAllocator:
+///the collision configuration, dispatcher and btDbvtBroadphase, the broadphase proxies and tree nodes, and the collision objects and shapes created through it.
+///Tearing the world down (reset or the destructor) releases all of it at once: objects are not removed one by one and their destructors are not run,
+///so objects and shapes must only own memory from the arena. Only the cached collision algorithms of the overlapping pairs are released separately.
+class btCollisionWorldArena
+{
+	btArenaAllocator m_arena;
+	btDefaultCollisionConfiguration* m_collisionConfiguration;
+	btCollisionDispatcher* m_dispatcher;
+	btDbvtBroadphase* m_broadphase;
+	btCollisionWorld* m_collisionWorld;
+	bool m_multithreaded;
+
+	void createWorld();
+	void destroyWorld();
+
+public:
+	///multithreaded worlds run the narrowphase with a btCollisionDispatcherMt in its deterministic mode
+	btCollisionWorldArena(int slabSize = 64 * 1024, bool multithreaded = false);
+	~btCollisionWorldArena();
+
+	///tears down the world and creates an empty one, reusing the arena memory
+	void reset();
+
+	btBoxShape* createBoxShape(const btVector3& boxHalfExtents);
+	btSphereShape* createSphereShape(btScalar radius);
+
+	///creates a collision object in a cache line of its own and adds it to the world
+	btCollisionObject* createCollisionObject(btCollisionShape* shape, const btTransform& worldTransform, int collisionFilterGroup = btBroadphaseProxy::DefaultFilter, int collisionFilterMask = btBroadphaseProxy::AllFilter);
+
+	btCollisionWorld* getCollisionWorld()
+	{
+		return m_collisionWorld;
+	}
+
+	btDbvtBroadphase* getBroadphase()
+	{
+		return m_broadphase;
+	}
+
+	btArenaAllocator& getArena()
+	{
+		return m_arena;
+	}
+};
+
+#endif  //BT_COLLISION_WORLD_ARENA_H
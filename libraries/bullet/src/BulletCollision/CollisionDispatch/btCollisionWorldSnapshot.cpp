@@ -0,0 +1,596 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2014 Erwin Coumans  http://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "btCollisionWorldSnapshot.h"
+#include "btCollisionWorld.h"
+#include "btCollisionObject.h"
+#include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.h"
+#include "BulletCollision/CollisionShapes/btBoxShape.h"
+#include "BulletCollision/CollisionShapes/btSphereShape.h"
+#include "LinearMath/btHashMap.h"
+
+#include <string.h>  //memcpy/memset
+
+static const char btSnapshotMagic[8] = {'B', 'T', 'C', 'W', 'S', 'N', 'A', 'P'};
+static const int btSnapshotEndianTest = 0x01020304;
+
+//pointers inside the snapshot are stored as byte offsets from its start, 0 stands for a null pointer
+template <class T>
+static T* btSnapshotEncode(int offset)
+{
+	return (T*)(size_t)offset;
+}
+
+template <class T>
+static T* btSnapshotFixup(char* base, T* encoded)
+{
+	return encoded ? (T*)(base + (size_t)encoded) : 0;
+}
+
+static int btSnapshotAlign(int offset)
+{
+	return (offset + 15) & ~15;
+}
+
+static int btSnapshotCountNodes(const btDbvtNode* node)
+{
+	if (!node) return 0;
+	if (node->isinternal())
+		return 1 + btSnapshotCountNodes(node->childs[0]) + btSnapshotCountNodes(node->childs[1]);
+	return 1;
+}
+
+struct btSnapshotTreeWriter
+{
+	char* m_base;
+	const btCollisionWorldSnapshotHeader* m_header;
+	const btHashMap<btHashPtr, int>& m_proxyIndices;
+	int m_numNodes;
+	bool m_valid;
+
+	btSnapshotTreeWriter(char* base, const btCollisionWorldSnapshotHeader* header, const btHashMap<btHashPtr, int>& proxyIndices)
+		: m_base(base), m_header(header), m_proxyIndices(proxyIndices), m_numNodes(0), m_valid(true)
+	{
+	}
+
+	int proxyOffset(const btDbvtProxy* proxy)
+	{
+		if (!proxy) return 0;
+		const int* index = m_proxyIndices.find(proxy);
+		if (!index)
+		{
+			m_valid = false;
+			return 0;
+		}
+		return m_header->m_proxiesOffset + *index * int(sizeof(btDbvtProxy));
+	}
+
+	///writes the subtree in pre-order and returns the offset of its root
+	int writeNode(const btDbvtNode* node, int parentOffset)
+	{
+		if (!node) return 0;
+		int offset = m_header->m_nodesOffset + m_numNodes++ * int(sizeof(btDbvtNode));
+		btDbvtNode* dst = (btDbvtNode*)(m_base + offset);
+		dst->volume = node->volume;
+		dst->parent = btSnapshotEncode<btDbvtNode>(parentOffset);
+		if (node->isinternal())
+		{
+			int child0 = writeNode(node->childs[0], offset);
+			int child1 = writeNode(node->childs[1], offset);
+			dst->childs[0] = btSnapshotEncode<btDbvtNode>(child0);
+			dst->childs[1] = btSnapshotEncode<btDbvtNode>(child1);
+		}
+		else
+		{
+			const btDbvtProxy* proxy = (const btDbvtProxy*)node->data;
+			int proxyOfs = proxyOffset(proxy);
+			dst->childs[1] = 0;
+			dst->data = btSnapshotEncode<void>(proxyOfs);
+			if (proxyOfs)
+			{
+				btDbvtProxy* dstProxy = (btDbvtProxy*)(m_base + proxyOfs);
+				dstProxy->leaf = btSnapshotEncode<btDbvtNode>(offset);
+			}
+		}
+		return offset;
+	}
+};
+
+///checks a snapshot before anything is fixed up or created from it, so a corrupt or foreign buffer is rejected instead of being
+///read or written out of bounds: every section has to lie within the snapshot, every encoded pointer has to be the start of a record
+///of its section, the trees have to be proper trees whose leaves and proxies point at each other, and the stage lists proper lists
+struct btSnapshotValidator
+{
+	const char* m_base;
+	const btCollisionWorldSnapshotHeader* m_header;
+	btAlignedObjectArray<int> m_nodeSets;   // the set each node was reached from, -1 before it is reached
+	btAlignedObjectArray<int> m_proxySets;  // the set the leaf of each proxy was reached from
+	btAlignedObjectArray<char> m_listed;    // whether each proxy was reached from its stage list
+
+	btSnapshotValidator(const char* base, const btCollisionWorldSnapshotHeader* header)
+		: m_base(base), m_header(header)
+	{
+	}
+
+	bool isSection(int offset, int count, int recordSize) const
+	{
+		if (count < 0 || offset < int(sizeof(btCollisionWorldSnapshotHeader)) || (offset & 15))
+			return false;
+		return (long long)offset + (long long)count * recordSize <= (long long)m_header->m_totalSize;
+	}
+
+	///returns the index of the record that starts at the encoded offset, or -1 if it isn't the start of one
+	static int recordIndex(size_t encoded, int sectionOffset, int count, int recordSize)
+	{
+		if (encoded < size_t(sectionOffset))
+			return -1;
+		size_t relative = encoded - size_t(sectionOffset);
+		if (relative % recordSize || relative / recordSize >= size_t(count))
+			return -1;
+		return int(relative / recordSize);
+	}
+
+	int nodeIndex(const void* encoded) const
+	{
+		return recordIndex((size_t)encoded, m_header->m_nodesOffset, m_header->m_numNodes, int(sizeof(btDbvtNode)));
+	}
+
+	int proxyIndex(const void* encoded) const
+	{
+		return recordIndex((size_t)encoded, m_header->m_proxiesOffset, m_header->m_numProxies, int(sizeof(btDbvtProxy)));
+	}
+
+	const btDbvtNode& node(int index) const
+	{
+		return ((const btDbvtNode*)(m_base + m_header->m_nodesOffset))[index];
+	}
+
+	const btDbvtProxy& proxy(int index) const
+	{
+		return ((const btDbvtProxy*)(m_base + m_header->m_proxiesOffset))[index];
+	}
+
+	///walks a tree without recursion, every node may only be reached once
+	bool validateTree(int set)
+	{
+		int rootOffset = m_header->m_rootOffsets[set];
+		if (!rootOffset)
+			return m_header->m_leaves[set] == 0;
+		int root = nodeIndex(btSnapshotEncode<void>(rootOffset));
+		if (root < 0 || node(root).parent)
+			return false;
+
+		int leaves = 0;
+		btAlignedObjectArray<int> stack;
+		stack.push_back(root);
+		while (stack.size())
+		{
+			int index = stack[stack.size() - 1];
+			stack.pop_back();
+			if (m_nodeSets[index] >= 0)
+				return false;
+			m_nodeSets[index] = set;
+
+			const btDbvtNode& current = node(index);
+			size_t currentOffset = size_t(m_header->m_nodesOffset) + size_t(index) * sizeof(btDbvtNode);
+			if (current.childs[1])
+			{
+				for (int i = 0; i < 2; i++)
+				{
+					int child = nodeIndex(current.childs[i]);
+					if (child < 0 || (size_t)node(child).parent != currentOffset)
+						return false;
+					stack.push_back(child);
+				}
+			}
+			else
+			{
+				int leafProxy = proxyIndex(current.data);
+				if (leafProxy < 0 || (size_t)proxy(leafProxy).leaf != currentOffset || m_proxySets[leafProxy] >= 0)
+					return false;
+				m_proxySets[leafProxy] = set;
+				leaves++;
+			}
+		}
+		return leaves == m_header->m_leaves[set];
+	}
+
+	///walks a stage list, every proxy has to be in the list of its stage
+	bool validateList(int stage)
+	{
+		int rootOffset = m_header->m_stageRootOffsets[stage];
+		if (!rootOffset)
+			return true;
+		int current = proxyIndex(btSnapshotEncode<void>(rootOffset));
+		if (current < 0 || proxy(current).links[0])
+			return false;
+		while (current >= 0)
+		{
+			if (m_listed[current] || proxy(current).stage != stage)
+				return false;
+			m_listed[current] = 1;
+
+			const btDbvtProxy* next = proxy(current).links[1];
+			if (!next)
+				break;
+			int nextIndex = proxyIndex(next);
+			if (nextIndex < 0 || (size_t)proxy(nextIndex).links[0] != size_t(m_header->m_proxiesOffset) + size_t(current) * sizeof(btDbvtProxy))
+				return false;
+			current = nextIndex;
+		}
+		return true;
+	}
+
+	bool validate()
+	{
+		const btCollisionWorldSnapshotHeader& header = *m_header;
+		if (!isSection(header.m_shapesOffset, header.m_numShapes, int(sizeof(btCollisionWorldSnapshotShape))) ||
+			!isSection(header.m_objectsOffset, header.m_numObjects, int(sizeof(btCollisionWorldSnapshotObject))) ||
+			!isSection(header.m_nodesOffset, header.m_numNodes, int(sizeof(btDbvtNode))) ||
+			!isSection(header.m_proxiesOffset, header.m_numProxies, int(sizeof(btDbvtProxy))) ||
+			!isSection(header.m_pairsOffset, header.m_numPairs, int(2 * sizeof(int))) ||
+			header.m_numProxies != header.m_numObjects)
+			return false;
+		if (header.m_stageCurrent < 0 || header.m_stageCurrent >= btDbvtBroadphase::STAGECOUNT)
+			return false;
+
+		const btCollisionWorldSnapshotShape* shapes = (const btCollisionWorldSnapshotShape*)(m_base + header.m_shapesOffset);
+		for (int i = 0; i < header.m_numShapes; i++)
+		{
+			if (shapes[i].m_shapeType != BOX_SHAPE_PROXYTYPE && shapes[i].m_shapeType != SPHERE_SHAPE_PROXYTYPE)
+				return false;
+		}
+
+		const btCollisionWorldSnapshotObject* objects = (const btCollisionWorldSnapshotObject*)(m_base + header.m_objectsOffset);
+		for (int i = 0; i < header.m_numObjects; i++)
+		{
+			if (objects[i].m_shapeIndex < 0 || objects[i].m_shapeIndex >= header.m_numShapes)
+				return false;
+		}
+
+		m_nodeSets.resize(header.m_numNodes, -1);
+		m_proxySets.resize(header.m_numProxies, -1);
+		m_listed.resize(header.m_numProxies, 0);
+		for (int i = 0; i < btDbvtBroadphase::SETCOUNT; i++)
+		{
+			if (!validateTree(i))
+				return false;
+		}
+		for (int i = 0; i <= btDbvtBroadphase::SLEEPING_STAGE; i++)
+		{
+			if (!validateList(i))
+				return false;
+		}
+
+		//every node belongs to a tree, and every proxy to the tree and the list of its stage
+		for (int i = 0; i < header.m_numNodes; i++)
+		{
+			if (m_nodeSets[i] < 0)
+				return false;
+		}
+		for (int i = 0; i < header.m_numProxies; i++)
+		{
+			int stage = proxy(i).stage;
+			int set = stage == btDbvtBroadphase::STAGECOUNT ? btDbvtBroadphase::FIXED_SET : stage == btDbvtBroadphase::SLEEPING_STAGE ? btDbvtBroadphase::SLEEPING_SET : btDbvtBroadphase::DYNAMIC_SET;
+			if (!m_listed[i] || m_proxySets[i] != set)
+				return false;
+		}
+
+		const int* pairs = (const int*)(m_base + header.m_pairsOffset);
+		for (int i = 0; i < 2 * header.m_numPairs; i++)
+		{
+			if (pairs[i] < 0 || pairs[i] >= header.m_numProxies)
+				return false;
+		}
+		return true;
+	}
+};
+
+btCollisionWorldSnapshot::btCollisionWorldSnapshot()
+	: m_collisionObjects(0),
+	  m_numCollisionObjects(0),
+	  m_world(0),
+	  m_broadphase(0)
+{
+}
+
+btCollisionWorldSnapshot::~btCollisionWorldSnapshot()
+{
+	unload();
+}
+
+bool btCollisionWorldSnapshot::write(const btCollisionWorld* world, const btDbvtBroadphase* broadphase, btAlignedObjectArray<char>& buffer)
+{
+	btAssert(world->getBroadphase() == broadphase);
+
+	const btCollisionObjectArray& objects = world->getCollisionObjectArray();
+	btHashMap<btHashPtr, int> shapeIndices;
+	btHashMap<btHashPtr, int> proxyIndices;
+	btAlignedObjectArray<const btCollisionShape*> shapes;
+
+	for (int i = 0; i < objects.size(); i++)
+	{
+		const btCollisionObject* object = objects[i];
+		const btCollisionShape* shape = object->getCollisionShape();
+		if (!object->getBroadphaseHandle())
+			return false;
+		if (shape->getShapeType() != BOX_SHAPE_PROXYTYPE && shape->getShapeType() != SPHERE_SHAPE_PROXYTYPE)
+			return false;
+		if (shape->getLocalScaling() != btVector3(1, 1, 1))
+			return false;
+		if (!shapeIndices.find(shape))
+		{
+			shapeIndices.insert(shape, shapes.size());
+			shapes.push_back(shape);
+		}
+		proxyIndices.insert(object->getBroadphaseHandle(), i);
+	}
+
+	const btBroadphasePairArray& pairs = broadphase->m_paircache->getOverlappingPairArray();
+	int numNodes = btSnapshotCountNodes(broadphase->m_sets[0].m_root) + btSnapshotCountNodes(broadphase->m_sets[1].m_root) + btSnapshotCountNodes(broadphase->m_sets[2].m_root);
+
+	btCollisionWorldSnapshotHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.m_magic, btSnapshotMagic, sizeof(btSnapshotMagic));
+	header.m_version = BT_COLLISION_WORLD_SNAPSHOT_VERSION;
+	header.m_endianTest = btSnapshotEndianTest;
+	header.m_sizeofScalar = sizeof(btScalar);
+	header.m_sizeofPointer = sizeof(void*);
+	header.m_sizeofNode = sizeof(btDbvtNode);
+	header.m_sizeofProxy = sizeof(btDbvtProxy);
+
+	int offset = btSnapshotAlign(sizeof(btCollisionWorldSnapshotHeader));
+	header.m_numShapes = shapes.size();
+	header.m_shapesOffset = offset;
+	offset = btSnapshotAlign(offset + header.m_numShapes * sizeof(btCollisionWorldSnapshotShape));
+	header.m_numObjects = objects.size();
+	header.m_objectsOffset = offset;
+	offset = btSnapshotAlign(offset + header.m_numObjects * sizeof(btCollisionWorldSnapshotObject));
+	header.m_numNodes = numNodes;
+	header.m_nodesOffset = offset;
+	offset = btSnapshotAlign(offset + header.m_numNodes * sizeof(btDbvtNode));
+	header.m_numProxies = objects.size();
+	header.m_proxiesOffset = offset;
+	offset = btSnapshotAlign(offset + header.m_numProxies * sizeof(btDbvtProxy));
+	header.m_numPairs = pairs.size();
+	header.m_pairsOffset = offset;
+	offset = btSnapshotAlign(offset + header.m_numPairs * 2 * sizeof(int));
+	header.m_totalSize = offset;
+
+	buffer.resize(0);
+	buffer.resize(header.m_totalSize, 0);
+	char* base = &buffer[0];
+
+	btCollisionWorldSnapshotShape* dstShapes = (btCollisionWorldSnapshotShape*)(base + header.m_shapesOffset);
+	for (int i = 0; i < shapes.size(); i++)
+	{
+		btCollisionWorldSnapshotShape& dst = dstShapes[i];
+		dst.m_shapeType = shapes[i]->getShapeType();
+		dst.m_margin = shapes[i]->getMargin();
+		if (dst.m_shapeType == BOX_SHAPE_PROXYTYPE)
+		{
+			dst.m_halfExtentsWithMargin = ((const btBoxShape*)shapes[i])->getHalfExtentsWithMargin();
+		}
+		else
+		{
+			btScalar radius = ((const btSphereShape*)shapes[i])->getRadius();
+			dst.m_halfExtentsWithMargin.setValue(radius, radius, radius);
+		}
+	}
+
+	btCollisionWorldSnapshotObject* dstObjects = (btCollisionWorldSnapshotObject*)(base + header.m_objectsOffset);
+	btDbvtProxy* dstProxies = (btDbvtProxy*)(base + header.m_proxiesOffset);
+	btSnapshotTreeWriter writer(base, &header, proxyIndices);
+	for (int i = 0; i < objects.size(); i++)
+	{
+		const btCollisionObject* object = objects[i];
+		btCollisionWorldSnapshotObject& dst = dstObjects[i];
+		dst.m_worldTransform = object->getWorldTransform();
+		dst.m_shapeIndex = *shapeIndices.find(object->getCollisionShape());
+		dst.m_collisionFlags = object->getCollisionFlags();
+		dst.m_userIndex = object->getUserIndex();
+		dst.m_userIndex2 = object->getUserIndex2();
+
+		//the client object is restored from the proxy index, leaf is set while writing the trees
+		const btDbvtProxy* proxy = (const btDbvtProxy*)object->getBroadphaseHandle();
+		memcpy((void*)&dstProxies[i], (const void*)proxy, sizeof(btDbvtProxy));
+		dstProxies[i].m_clientObject = 0;
+		dstProxies[i].leaf = 0;
+		dstProxies[i].links[0] = btSnapshotEncode<btDbvtProxy>(writer.proxyOffset(proxy->links[0]));
+		dstProxies[i].links[1] = btSnapshotEncode<btDbvtProxy>(writer.proxyOffset(proxy->links[1]));
+	}
+
+	for (int i = 0; i < btDbvtBroadphase::SETCOUNT; i++)
+	{
+		header.m_rootOffsets[i] = writer.writeNode(broadphase->m_sets[i].m_root, 0);
+		header.m_leaves[i] = broadphase->m_sets[i].m_leaves;
+	}
+	for (int i = 0; i <= btDbvtBroadphase::SLEEPING_STAGE; i++)
+	{
+		header.m_stageRootOffsets[i] = writer.proxyOffset(broadphase->m_stageRoots[i]);
+	}
+	header.m_stageCurrent = broadphase->m_stageCurrent;
+	header.m_fixedLeft = broadphase->m_fixedleft;
+	header.m_gid = broadphase->m_gid;
+
+	int* dstPairs = (int*)(base + header.m_pairsOffset);
+	for (int i = 0; i < pairs.size(); i++)
+	{
+		const int* index0 = proxyIndices.find(pairs[i].m_pProxy0);
+		const int* index1 = proxyIndices.find(pairs[i].m_pProxy1);
+		if (!index0 || !index1)
+			return false;
+		dstPairs[i * 2] = *index0;
+		dstPairs[i * 2 + 1] = *index1;
+	}
+
+	//every leaf has to belong to one of the world objects
+	if (!writer.m_valid || writer.m_numNodes != numNodes)
+		return false;
+
+	memcpy(base, &header, sizeof(header));
+	return true;
+}
+
+bool btCollisionWorldSnapshot::load(void* buffer, int size, btCollisionWorld* world, btDbvtBroadphase* broadphase)
+{
+	btAssert(world->getBroadphase() == broadphase);
+	btAssert(!m_world);
+
+	char* base = (char*)buffer;
+	const btCollisionWorldSnapshotHeader* header = (const btCollisionWorldSnapshotHeader*)base;
+	if (((size_t)base & 15) || size < int(sizeof(btCollisionWorldSnapshotHeader)))
+		return false;
+	if (memcmp(header->m_magic, btSnapshotMagic, sizeof(btSnapshotMagic)) != 0 ||
+		header->m_version != BT_COLLISION_WORLD_SNAPSHOT_VERSION ||
+		header->m_endianTest != btSnapshotEndianTest ||
+		header->m_sizeofScalar != int(sizeof(btScalar)) ||
+		header->m_sizeofPointer != int(sizeof(void*)) ||
+		header->m_sizeofNode != int(sizeof(btDbvtNode)) ||
+		header->m_sizeofProxy != int(sizeof(btDbvtProxy)) ||
+		header->m_totalSize > size ||
+		header->m_totalSize < int(sizeof(btCollisionWorldSnapshotHeader)))
+		return false;
+
+	btSnapshotValidator validator(base, header);
+	if (!validator.validate())
+		return false;
+
+	//the snapshot replaces the broadphase trees, so they have to be empty
+	if (broadphase->m_sets[0].m_root || broadphase->m_sets[1].m_root || broadphase->m_sets[2].m_root)
+		return false;
+
+	const btCollisionWorldSnapshotShape* shapes = (const btCollisionWorldSnapshotShape*)(base + header->m_shapesOffset);
+	m_collisionShapes.reserve(header->m_numShapes);
+	for (int i = 0; i < header->m_numShapes; i++)
+	{
+		if (shapes[i].m_shapeType == BOX_SHAPE_PROXYTYPE)
+		{
+			btBoxShape* box = new btBoxShape(shapes[i].m_halfExtentsWithMargin);
+			box->setMargin(shapes[i].m_margin);
+			m_collisionShapes.push_back(box);
+		}
+		else if (shapes[i].m_shapeType == SPHERE_SHAPE_PROXYTYPE)
+		{
+			m_collisionShapes.push_back(new btSphereShape(shapes[i].m_halfExtentsWithMargin.getX()));
+		}
+	}
+
+	//fix up the tree nodes in place
+	btDbvtNode* nodes = (btDbvtNode*)(base + header->m_nodesOffset);
+	for (int i = 0; i < header->m_numNodes; i++)
+	{
+		btDbvtNode& node = nodes[i];
+		node.parent = btSnapshotFixup(base, node.parent);
+		if (node.childs[1])
+		{
+			node.childs[0] = btSnapshotFixup(base, node.childs[0]);
+			node.childs[1] = btSnapshotFixup(base, node.childs[1]);
+		}
+		else
+		{
+			node.data = btSnapshotFixup(base, node.data);
+		}
+	}
+
+	//objects can't live in the snapshot itself, they carry a virtual table
+	const btCollisionWorldSnapshotObject* objects = (const btCollisionWorldSnapshotObject*)(base + header->m_objectsOffset);
+	btDbvtProxy* proxies = (btDbvtProxy*)(base + header->m_proxiesOffset);
+	m_numCollisionObjects = header->m_numObjects;
+	m_collisionObjects = (btCollisionObject*)btAlignedAlloc(sizeof(btCollisionObject) * m_numCollisionObjects, 16);
+	for (int i = 0; i < m_numCollisionObjects; i++)
+	{
+		btCollisionObject* object = new (&m_collisionObjects[i]) btCollisionObject();
+		object->setCollisionShape(m_collisionShapes[objects[i].m_shapeIndex]);
+		object->setWorldTransform(objects[i].m_worldTransform);
+		object->setCollisionFlags(objects[i].m_collisionFlags);
+		object->setUserIndex(objects[i].m_userIndex);
+		object->setUserIndex2(objects[i].m_userIndex2);
+
+		btDbvtProxy& proxy = proxies[i];
+		proxy.m_clientObject = object;
+		proxy.leaf = btSnapshotFixup(base, proxy.leaf);
+		proxy.links[0] = btSnapshotFixup(base, proxy.links[0]);
+		proxy.links[1] = btSnapshotFixup(base, proxy.links[1]);
+	}
+
+	broadphase->setExternalMemory(base, base + header->m_totalSize);
+	for (int i = 0; i < btDbvtBroadphase::SETCOUNT; i++)
+	{
+		broadphase->m_sets[i].m_root = header->m_rootOffsets[i] ? (btDbvtNode*)(base + header->m_rootOffsets[i]) : 0;
+		broadphase->m_sets[i].m_leaves = header->m_leaves[i];
+	}
+	for (int i = 0; i <= btDbvtBroadphase::SLEEPING_STAGE; i++)
+	{
+		broadphase->m_stageRoots[i] = header->m_stageRootOffsets[i] ? (btDbvtProxy*)(base + header->m_stageRootOffsets[i]) : 0;
+	}
+	broadphase->m_stageCurrent = header->m_stageCurrent;
+	broadphase->m_fixedleft = header->m_fixedLeft;
+	broadphase->m_gid = btMax(broadphase->m_gid, header->m_gid);
+
+	const int* pairs = (const int*)(base + header->m_pairsOffset);
+	for (int i = 0; i < header->m_numPairs; i++)
+	{
+		broadphase->m_paircache->addOverlappingPair(&proxies[pairs[i * 2]], &proxies[pairs[i * 2 + 1]]);
+	}
+
+	world->getCollisionObjectArray().reserve(world->getNumCollisionObjects() + m_numCollisionObjects);
+	for (int i = 0; i < m_numCollisionObjects; i++)
+	{
+		world->addCollisionObjectWithProxy(&m_collisionObjects[i], &proxies[i]);
+	}
+
+	m_world = world;
+	m_broadphase = broadphase;
+	return true;
+}
+
+btCollisionObject* btCollisionWorldSnapshot::getCollisionObject(int index)
+{
+	btAssert(index >= 0 && index < m_numCollisionObjects);
+	return &m_collisionObjects[index];
+}
+
+void btCollisionWorldSnapshot::unload()
+{
+	if (m_world)
+	{
+		for (int i = m_numCollisionObjects - 1; i >= 0; i--)
+		{
+			m_world->removeCollisionObject(&m_collisionObjects[i]);
+		}
+		//nodes of the snapshot may still be in use when other objects were added to the broadphase after loading
+		if (m_broadphase->m_sets[0].empty() && m_broadphase->m_sets[1].empty() && m_broadphase->m_sets[2].empty())
+		{
+			m_broadphase->setExternalMemory(0, 0);
+		}
+		m_world = 0;
+		m_broadphase = 0;
+	}
+
+	for (int i = 0; i < m_numCollisionObjects; i++)
+	{
+		m_collisionObjects[i].~btCollisionObject();
+	}
+	btAlignedFree(m_collisionObjects);
+	m_collisionObjects = 0;
+	m_numCollisionObjects = 0;
+
+	for (int i = 0; i < m_collisionShapes.size(); i++)
+	{
+		delete m_collisionShapes[i];
+	}
+	m_collisionShapes.clear();
+}
@@ -0,0 +1,127 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2014 Erwin Coumans  http://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_COLLISION_WORLD_SNAPSHOT_H
+#define BT_COLLISION_WORLD_SNAPSHOT_H
+
+#include "LinearMath/btAlignedObjectArray.h"
+#include "LinearMath/btTransform.h"
+
+class btCollisionShape;
+class btCollisionObject;
+class btCollisionWorld;
+struct btDbvtBroadphase;
+
+#define BT_COLLISION_WORLD_SNAPSHOT_VERSION 2
+
+///Header at the start of a collision world snapshot. All offsets are in bytes from the start of the snapshot.
+struct btCollisionWorldSnapshotHeader
+{
+	char m_magic[8];
+	int m_version;
+	int m_endianTest;
+	int m_sizeofScalar;
+	int m_sizeofPointer;
+	int m_sizeofNode;
+	int m_sizeofProxy;
+	int m_totalSize;
+
+	int m_numShapes;
+	int m_shapesOffset;
+	int m_numObjects;
+	int m_objectsOffset;
+	int m_numNodes;
+	int m_nodesOffset;
+	int m_numProxies;
+	int m_proxiesOffset;
+	int m_numPairs;
+	int m_pairsOffset;
+
+	int m_rootOffsets[3];  // dynamic, fixed and sleeping set
+	int m_leaves[3];
+	int m_stageRootOffsets[4];
+	int m_stageCurrent;
+	int m_fixedLeft;
+	int m_gid;
+};
+
+///Collision shape record. Only box and sphere shapes with unit local scaling are supported.
+struct btCollisionWorldSnapshotShape
+{
+	btVector3 m_halfExtentsWithMargin;
+	btScalar m_margin;
+	int m_shapeType;
+	int m_padding[2];
+};
+
+///Collision object record, the broadphase proxy of the object is stored separately.
+struct btCollisionWorldSnapshotObject
+{
+	btTransform m_worldTransform;
+	int m_shapeIndex;
+	int m_collisionFlags;
+	int m_userIndex;
+	int m_userIndex2;
+};
+
+///The btCollisionWorldSnapshot writes a fully built btCollisionWorld, including the btDbvtBroadphase trees, to a flat memory block.
+///The block is laid out so that it can be memory-mapped (or read in one go) and loaded with pointer fix-ups only:
+///the broadphase proxies and tree nodes are used in place, no proxy is re-inserted and no tree is rebuilt at load time.
+///Snapshots are only valid for the same btScalar precision, pointer size and endianness they were written with.
+class btCollisionWorldSnapshot
+{
+	btAlignedObjectArray<btCollisionShape*> m_collisionShapes;
+	btCollisionObject* m_collisionObjects;
+	int m_numCollisionObjects;
+	btCollisionWorld* m_world;
+	btDbvtBroadphase* m_broadphase;
+
+public:
+	btCollisionWorldSnapshot();
+
+	///removes the loaded objects from their world (if still attached) and releases them
+	~btCollisionWorldSnapshot();
+
+	///writes all objects of the world to buffer. The world must use the given broadphase, and all its objects must use a box or sphere shape.
+	///returns false if the world contains an object that can't be stored.
+	static bool write(const btCollisionWorld* world, const btDbvtBroadphase* broadphase, btAlignedObjectArray<char>& buffer);
+
+	///restores the objects of a snapshot into world, whose broadphase must be empty.
+	///buffer must be 16 byte aligned and writable (e.g. a private copy-on-write mapping): its pointers are fixed up in place.
+	///it must stay valid until the objects are removed again, or as long as the broadphase is used if other objects were added to it.
+	bool load(void* buffer, int size, btCollisionWorld* world, btDbvtBroadphase* broadphase);
+
+	///removes the loaded objects from the world and releases them
+	void unload();
+
+	int getNumCollisionObjects() const
+	{
+		return m_numCollisionObjects;
+	}
+
+	btCollisionObject* getCollisionObject(int index);
+
+	int getNumCollisionShapes() const
+	{
+		return m_collisionShapes.size();
+	}
+
+	btCollisionShape* getCollisionShape(int index)
+	{
+		return m_collisionShapes[index];
+	}
+};
+
+#endif  //BT_COLLISION_WORLD_SNAPSHOT_H
@@ -372,6 +372,11 @@ void btConvexConvexAlgorithm ::processCollision(const btCollisionObjectWrapper*
 		//TODO: if (dispatchInfo.m_useContinuous)
 		gjkPairDetector.setMinkowskiA(min0);
 		gjkPairDetector.setMinkowskiB(min1);
+		//a shared manifold collects the contacts of many child shapes or triangles, so it can't keep the state of a single pair
+		if (dispatchInfo.m_useGjkWarmStart && m_ownManifold)
+		{
+			gjkPairDetector.setWarmStartCache(&m_manifoldPtr->m_gjkWarmStartCache, dispatchInfo.m_gjkWarmStartMotionThreshold);
+		}
 
 #ifdef USE_SEPDISTANCE_UTIL2
 		if (dispatchInfo.m_useConvexConservativeDistanceUtil)
@@ -697,6 +702,8 @@ void btConvexConvexAlgorithm ::processCollision(const btCollisionObjectWrapper*
 		}
 
 		gjkPairDetector.getClosestPoints(input, *resultOut, dispatchInfo.m_debugDraw);
+		//the perturbed queries would overwrite the cache with rotated shapes
+		gjkPairDetector.setWarmStartCache(0, btScalar(0.));
 
 		//now perform 'm_numPerturbationIterations' collision queries with the perturbated collision objects
 
@@ -18,6 +18,7 @@ subject to the following restrictions:
 #include "BulletCollision/CollisionShapes/btBvhTriangleMeshShape.h"
 #include "BulletCollision/CollisionShapes/btOptimizedBvh.h"
 #include "LinearMath/btSerializer.h"
+#include "LinearMath/btAllocationTracker.h"
 
 ///Bvh Concave triangle mesh is a static-triangle mesh shape with Bounding Volume Hierarchy optimization.
 ///Uses an interface to access the triangles to allow for sharing graphics/physics triangles.
@@ -339,6 +340,7 @@ void btBvhTriangleMeshShape::setLocalScaling(const btVector3& scaling)
 
 void btBvhTriangleMeshShape::buildOptimizedBvh()
 {
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SHAPES);
 	if (m_ownsBvh)
 	{
 		m_bvh->~btOptimizedBvh();
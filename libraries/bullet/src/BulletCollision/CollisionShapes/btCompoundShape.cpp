@@ -17,6 +17,7 @@ subject to the following restrictions:
 #include "btCollisionShape.h"
 #include "BulletCollision/BroadphaseCollision/btDbvt.h"
 #include "LinearMath/btSerializer.h"
+#include "LinearMath/btAllocationTracker.h"
 
 btCompoundShape::btCompoundShape(bool enableDynamicAabbTree, const int initialChildCapacity)
 	: m_localAabbMin(btScalar(BT_LARGE_FLOAT), btScalar(BT_LARGE_FLOAT), btScalar(BT_LARGE_FLOAT)),
@@ -49,6 +50,7 @@ btCompoundShape::~btCompoundShape()
 
 void btCompoundShape::addChildShape(const btTransform& localTransform, btCollisionShape* shape)
 {
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SHAPES);
 	m_updateRevision++;
 	//m_childTransforms.push_back(localTransform);
 	//m_childShapes.push_back(shape);
@@ -24,9 +24,11 @@ subject to the following restrictions:
 #include "LinearMath/btSerializer.h"
 #include "btConvexPolyhedron.h"
 #include "LinearMath/btConvexHullComputer.h"
+#include "LinearMath/btAllocationTracker.h"
 
 btConvexHullShape ::btConvexHullShape(const btScalar* points, int numPoints, int stride) : btPolyhedralConvexAabbCachingShape()
 {
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SHAPES);
 	m_shapeType = CONVEX_HULL_SHAPE_PROXYTYPE;
 	m_unscaledPoints.resize(numPoints);
 
@@ -50,6 +52,7 @@ void btConvexHullShape::setLocalScaling(const btVector3& scaling)
 
 void btConvexHullShape::addPoint(const btVector3& point, bool recalculateLocalAabb)
 {
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SHAPES);
 	m_unscaledPoints.push_back(point);
 	if (recalculateLocalAabb)
 		recalcLocalAabb();
@@ -22,6 +22,7 @@ subject to the following restrictions:
 #include <new>
 #include "LinearMath/btGeometryUtil.h"
 #include "LinearMath/btGrahamScan2dConvexHull.h"
+#include "LinearMath/btAllocationTracker.h"
 
 btPolyhedralConvexShape::btPolyhedralConvexShape() : btConvexInternalShape(),
 													 m_polyhedron(0)
@@ -52,6 +53,7 @@ void btPolyhedralConvexShape::setPolyhedralFeatures(btConvexPolyhedron& polyhedr
 
 bool btPolyhedralConvexShape::initializePolyhedralFeatures(int shiftVerticesByMargin)
 {
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SHAPES);
 	if (m_polyhedron)
 	{
 		m_polyhedron->~btConvexPolyhedron();
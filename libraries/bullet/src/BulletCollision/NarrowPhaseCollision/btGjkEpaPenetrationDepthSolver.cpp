@@ -27,7 +27,6 @@ bool btGjkEpaPenetrationDepthSolver::calcPenDepth(btSimplexSolverInterface& simp
 												  class btIDebugDraw* debugDraw)
 {
 	(void)debugDraw;
-	(void)v;
 	(void)simplexSolver;
 
 	btVector3 guessVectors[] = {
@@ -44,10 +43,14 @@ bool btGjkEpaPenetrationDepthSolver::calcPenDepth(btSimplexSolverInterface& simp
 
 	int numVectors = sizeof(guessVectors) / sizeof(btVector3);
 
-	for (int i = 0; i < numVectors; i++)
+	//a non zero v is the penetration normal of the last query of the pair, try it first
+	btVector3 warmStartGuess = v;
+	int firstVector = warmStartGuess.fuzzyZero() ? 0 : -1;
+
+	for (int i = firstVector; i < numVectors; i++)
 	{
 		simplexSolver.reset();
-		btVector3 guessVector = guessVectors[i];
+		btVector3 guessVector = i < 0 ? warmStartGuess.normalized() : guessVectors[i];
 
 		btGjkEpaSolver2::sResults results;
 
@@ -48,7 +48,11 @@ btGjkPairDetector::btGjkPairDetector(const btConvexShape *objectA, const btConve
 	  m_marginA(objectA->getMargin()),
 	  m_marginB(objectB->getMargin()),
 	  m_ignoreMargin(false),
+	  m_warmStartCache(0),
+	  m_warmStartMotionThreshold(btScalar(0.)),
 	  m_lastUsedMethod(-1),
+	  m_curIter(0),
+	  m_curIntersectIter(0),
 	  m_catchDegeneracies(1),
 	  m_fixContactNormalDirection(1)
 {
@@ -64,12 +68,43 @@ btGjkPairDetector::btGjkPairDetector(const btConvexShape *objectA, const btConve
 	  m_marginA(marginA),
 	  m_marginB(marginB),
 	  m_ignoreMargin(false),
+	  m_warmStartCache(0),
+	  m_warmStartMotionThreshold(btScalar(0.)),
 	  m_lastUsedMethod(-1),
+	  m_curIter(0),
+	  m_curIntersectIter(0),
 	  m_catchDegeneracies(1),
 	  m_fixContactNormalDirection(1)
 {
 }
 
+//returns true when the cache of the last query can be used for the current relative transform of the shapes
+static bool btCheckWarmStartCache(btGjkWarmStartCache *cache, const btConvexShape *convexA, const btConvexShape *convexB, const btTransform &relativeTransform, btScalar motionThreshold)
+{
+	if (!cache->m_valid)
+	{
+		return false;
+	}
+	bool valid = (cache->m_shapeA == convexA) && (cache->m_shapeB == convexB);
+	//the simplex vertices move with A, so their displacement relative to B bounds the motion that matters to GJK
+	btScalar motionThreshold2 = motionThreshold * motionThreshold;
+	if (valid && !cache->m_numVertices)
+	{
+		valid = (relativeTransform.getOrigin() - cache->m_relativeTransform.getOrigin()).length2() <= motionThreshold2;
+	}
+	for (int i = 0; valid && i < cache->m_numVertices; i++)
+	{
+		btVector3 motion = relativeTransform(cache->m_supportInA[i]) - cache->m_relativeTransform(cache->m_supportInA[i]);
+		valid = motion.length2() <= motionThreshold2;
+	}
+	if (!valid)
+	{
+		cache->invalidate();
+		cache->m_numInvalidations++;
+	}
+	return valid;
+}
+
 void btGjkPairDetector::getClosestPoints(const ClosestPointInput &input, Result &output, class btIDebugDraw *debugDraw, bool swapResults)
 {
 	(void)swapResults;
@@ -714,9 +749,24 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 	}
 
 	m_curIter = 0;
+	m_curIntersectIter = 0;
 	int gGjkMaxIter = 1000;  //this is to catch invalid input, perhaps check for #NaN?
 	m_cachedSeparatingAxis.setValue(0, 1, 0);
 
+	//the support points of 2d shapes are flattened, so they can't be moved along with the shapes
+	btGjkWarmStartCache *cache = check2d ? 0 : m_warmStartCache;
+	btTransform relativeTransform;
+	bool warmStart = false;
+	if (cache)
+	{
+		relativeTransform = localTransB.inverseTimes(localTransA);
+		warmStart = btCheckWarmStartCache(cache, m_minkowskiA, m_minkowskiB, relativeTransform, m_warmStartMotionThreshold);
+		cache->m_numQueries++;
+		cache->m_numWarmStarts += warmStart;
+	}
+	btVector3 warmStartAxis = warmStart ? localTransB.getBasis() * cache->m_separatingAxisInB : btVector3(0, 0, 0);
+	btVector3 warmStartPenetrationAxis = warmStart ? localTransB.getBasis() * cache->m_penetrationAxisInB : btVector3(0, 0, 0);
+
 	bool isValid = false;
 	bool checkSimplex = false;
 	bool checkPenetration = true;
@@ -742,6 +792,11 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 		btSimplexInit(simplex);
 
 		btVector3 dir(1, 0, 0);
+		bool separated = false;
+		if (!warmStartAxis.fuzzyZero())
+		{
+			dir = -warmStartAxis;
+		}
 
 		{
 			btVector3 lastSupV;
@@ -749,6 +804,13 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 			btVector3 supBworld;
 			btComputeSupport(m_minkowskiA, localTransA, m_minkowskiB, localTransB, dir, check2d, supAworld, supBworld, lastSupV);
 
+			//the last separating axis still separates the shapes
+			if (warmStart && lastSupV.dot(dir) < 0)
+			{
+				status = -1;
+				separated = true;
+			}
+
 			btSupportVector last;
 			last.v = lastSupV;
 			last.v1 = supAworld;
@@ -759,8 +821,10 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 			dir = -lastSupV;
 
 			// start iterations
-			for (int iterations = 0; iterations < gGjkMaxIter; iterations++)
+			for (int iterations = 0; !separated && iterations < gGjkMaxIter; iterations++)
 			{
+				m_curIntersectIter++;
+
 				// obtain support point
 				btComputeSupport(m_minkowskiA, localTransA, m_minkowskiB, localTransB, dir, check2d, supAworld, supBworld, lastSupV);
 
@@ -834,6 +898,35 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 			//printf("not intersect\n");
 		}
 		//printf("dir=%f,%f,%f\n",dir[0],dir[1],dir[2]);
+		if (warmStart)
+		{
+			//restart from the last simplex, its vertices moved along with the shapes
+			for (int i = 0; i < cache->m_numVertices; i++)
+			{
+				btVector3 pWorld = localTransA(cache->m_supportInA[i]);
+				btVector3 qWorld = localTransB(cache->m_supportInB[i]);
+				btVector3 w = pWorld - qWorld;
+				if (!m_simplexSolver->inSimplex(w))
+				{
+					m_simplexSolver->addVertex(w, pWorld, qWorld);
+				}
+			}
+			btVector3 v;
+			if (m_simplexSolver->numVertices() && m_simplexSolver->closest(v) && v.length2() >= REL_ERROR2)
+			{
+				m_cachedSeparatingAxis = v;
+				squaredDistance = v.length2();
+			}
+			else
+			{
+				//the origin is (nearly) inside the last simplex, only keep the direction
+				m_simplexSolver->reset();
+				if (!warmStartAxis.fuzzyZero())
+				{
+					m_cachedSeparatingAxis = warmStartAxis;
+				}
+			}
+		}
 		if (1)
 		{
 			for (;;)
@@ -1003,6 +1096,22 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 			}
 		}
 
+		if (cache)
+		{
+			//the simplex solver can hold one more vertex while it reduces
+			btVector3 pBuf[BT_GJK_WARM_START_MAX_VERTICES + 1];
+			btVector3 qBuf[BT_GJK_WARM_START_MAX_VERTICES + 1];
+			btVector3 yBuf[BT_GJK_WARM_START_MAX_VERTICES + 1];
+			cache->m_numVertices = btMin(m_simplexSolver->getSimplex(pBuf, qBuf, yBuf), int(BT_GJK_WARM_START_MAX_VERTICES));
+			for (int i = 0; i < cache->m_numVertices; i++)
+			{
+				cache->m_supportInA[i] = localTransA.invXform(pBuf[i]);
+				cache->m_supportInB[i] = localTransB.invXform(qBuf[i]);
+			}
+			cache->m_separatingAxisInB = m_cachedSeparatingAxis * localTransB.getBasis();
+			cache->m_penetrationAxisInB.setZero();
+		}
+
 		bool catchDegeneratePenetrationCase =
 			(m_catchDegeneracies && m_penetrationDepthSolver && m_degenerateSimplex && ((distance + margin) < gGjkEpaPenetrationTolerance));
 
@@ -1018,6 +1127,11 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 				btVector3 tmpPointOnA, tmpPointOnB;
 
 				m_cachedSeparatingAxis.setZero();
+				//a non zero axis is the guess of the penetration depth solver
+				if (!warmStartPenetrationAxis.fuzzyZero())
+				{
+					m_cachedSeparatingAxis = warmStartPenetrationAxis;
+				}
 
 				bool isValid2 = m_penetrationDepthSolver->calcPenDepth(
 					*m_simplexSolver,
@@ -1026,6 +1140,11 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 					m_cachedSeparatingAxis, tmpPointOnA, tmpPointOnB,
 					debugDraw);
 
+				if (cache && isValid2)
+				{
+					cache->m_penetrationAxisInB = m_cachedSeparatingAxis * localTransB.getBasis();
+				}
+
 				if (m_cachedSeparatingAxis.length2())
 				{
 					if (isValid2)
@@ -1103,6 +1222,16 @@ void btGjkPairDetector::getClosestPointsNonVirtual(const ClosestPointInput &inpu
 		}
 	}
 
+	if (cache)
+	{
+		cache->m_relativeTransform = relativeTransform;
+		cache->m_shapeA = m_minkowskiA;
+		cache->m_shapeB = m_minkowskiB;
+		cache->m_valid = true;
+		cache->m_lastIterations = getNumIterations();
+		cache->m_numIterations += cache->m_lastIterations;
+	}
+
 	if (isValid && ((distance < 0) || (distance * distance < input.m_maximumDistanceSquared)))
 	{
 		m_cachedSeparatingAxis = normalInB;
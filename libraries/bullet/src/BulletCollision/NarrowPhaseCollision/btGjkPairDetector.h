@@ -21,6 +21,7 @@ subject to the following restrictions:
 
 class btConvexShape;
 #include "btSimplexSolverInterface.h"
+#include "btGjkWarmStartCache.h"
 class btConvexPenetrationDepthSolver;
 
 /// btGjkPairDetector uses GJK to implement the btDiscreteCollisionDetectorInterface
@@ -39,10 +40,14 @@ class btGjkPairDetector : public btDiscreteCollisionDetectorInterface
 	bool m_ignoreMargin;
 	btScalar m_cachedSeparatingDistance;
 
+	btGjkWarmStartCache* m_warmStartCache;
+	btScalar m_warmStartMotionThreshold;
+
 public:
 	//some debugging to fix degeneracy problems
 	int m_lastUsedMethod;
-	int m_curIter;
+	int m_curIter;           // iterations of the distance loop in the last query
+	int m_curIntersectIter;  // iterations of the intersection test in the last query
 	int m_degenerateSimplex;
 	int m_catchDegeneracies;
 	int m_fixContactNormalDirection;
@@ -88,6 +93,26 @@ public:
 	{
 		m_ignoreMargin = ignoreMargin;
 	}
+
+	///start the queries from the state of the last query of the pair, and write the state of each query back to the cache.
+	///The cache is dropped when a support point of the last simplex moved more than motionThreshold relative to B since then.
+	///Pass 0 to query from scratch.
+	void setWarmStartCache(btGjkWarmStartCache* cache, btScalar motionThreshold)
+	{
+		m_warmStartCache = cache;
+		m_warmStartMotionThreshold = motionThreshold;
+	}
+
+	btGjkWarmStartCache* getWarmStartCache() const
+	{
+		return m_warmStartCache;
+	}
+
+	///GJK iterations of the last query
+	int getNumIterations() const
+	{
+		return m_curIntersectIter + m_curIter;
+	}
 };
 
 #endif  //BT_GJK_PAIR_DETECTOR_H
@@ -0,0 +1,78 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_GJK_WARM_START_CACHE_H
+#define BT_GJK_WARM_START_CACHE_H
+
+#include "LinearMath/btTransform.h"
+
+#define BT_GJK_WARM_START_MAX_VERTICES 4
+
+///btGjkWarmStartCache keeps the state of the last btGjkPairDetector query of a persistent convex pair, so the next query
+///starts from the last separating axis and simplex instead of from scratch. It lives on the btPersistentManifold of the pair
+///and is only used when btDispatcherInfo::m_useGjkWarmStart is set.
+///The simplex is stored as pairs of local support points, that are moved along with the shapes, so a reused vertex is always
+///a point of the current Minkowski difference and the result of GJK doesn't depend on the cache, only its iteration count does.
+///The cache is dropped when the relative transform of the shapes moved more than the motion threshold since it was written.
+ATTRIBUTE_ALIGNED16(struct)
+btGjkWarmStartCache
+{
+	btTransform m_relativeTransform;  // transform of A in the local space of B when the cache was written
+	btVector3 m_separatingAxisInB;     // the last closest point of the Minkowski difference to the origin, in the local space of B
+	btVector3 m_penetrationAxisInB;    // the last penetration normal found by the penetration depth solver, zero if there was none
+	btVector3 m_supportInA[BT_GJK_WARM_START_MAX_VERTICES];  // the local support points of the last simplex on A
+	btVector3 m_supportInB[BT_GJK_WARM_START_MAX_VERTICES];  // and on B
+	const void* m_shapeA;
+	const void* m_shapeB;
+	int m_numVertices;
+	bool m_valid;
+
+	//counters, for profiling the narrowphase
+	int m_lastIterations;   // GJK iterations of the last query, of the intersection test and the distance loop together
+	int m_numQueries;       // queries since the manifold was created
+	int m_numWarmStarts;    // queries that started from the cache
+	int m_numIterations;    // GJK iterations since the manifold was created
+	int m_numInvalidations; // times the cache was dropped because of large relative motion
+
+	btGjkWarmStartCache()
+		: m_shapeA(0),
+		  m_shapeB(0),
+		  m_numVertices(0),
+		  m_valid(false),
+		  m_lastIterations(0),
+		  m_numQueries(0),
+		  m_numWarmStarts(0),
+		  m_numIterations(0),
+		  m_numInvalidations(0)
+	{
+	}
+
+	void invalidate()
+	{
+		m_valid = false;
+		m_numVertices = 0;
+	}
+
+	void resetCounters()
+	{
+		m_lastIterations = 0;
+		m_numQueries = 0;
+		m_numWarmStarts = 0;
+		m_numIterations = 0;
+		m_numInvalidations = 0;
+	}
+};
+
+#endif  //BT_GJK_WARM_START_CACHE_H
@@ -19,6 +19,7 @@ subject to the following restrictions:
 #include "LinearMath/btVector3.h"
 #include "LinearMath/btTransform.h"
 #include "btManifoldPoint.h"
+#include "btGjkWarmStartCache.h"
 class btCollisionObject;
 #include "LinearMath/btAlignedAllocator.h"
 
@@ -87,6 +88,9 @@ public:
 
 	int m_index1a;
 
+	///the GJK state of the last query of the pair, used when btDispatcherInfo::m_useGjkWarmStart is set
+	btGjkWarmStartCache m_gjkWarmStartCache;
+
 	btPersistentManifold();
 
 	btPersistentManifold(const btCollisionObject* body0, const btCollisionObject* body1, int, btScalar contactBreakingThreshold, btScalar contactProcessingThreshold)
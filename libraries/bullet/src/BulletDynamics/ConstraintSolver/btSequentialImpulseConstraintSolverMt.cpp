@@ -28,12 +28,14 @@ int btSequentialImpulseConstraintSolverMt::s_minBatchSize = 50;
 int btSequentialImpulseConstraintSolverMt::s_maxBatchSize = 100;
 btBatchedConstraints::BatchingMethod btSequentialImpulseConstraintSolverMt::s_contactBatchingMethod = btBatchedConstraints::BATCHING_METHOD_SPATIAL_GRID_2D;
 btBatchedConstraints::BatchingMethod btSequentialImpulseConstraintSolverMt::s_jointBatchingMethod = btBatchedConstraints::BATCHING_METHOD_SPATIAL_GRID_2D;
+btSoaContactConstraints::Kernel btSequentialImpulseConstraintSolverMt::s_soaContactKernel = btSoaContactConstraints::getBestKernel();
 
 btSequentialImpulseConstraintSolverMt::btSequentialImpulseConstraintSolverMt()
 {
 	m_numFrictionDirections = 1;
 	m_useBatching = false;
 	m_useObsoleteJointConstraints = false;
+	m_useSoaContactConstraints = false;
 }
 
 btSequentialImpulseConstraintSolverMt::~btSequentialImpulseConstraintSolverMt()
@@ -852,6 +854,18 @@ btScalar btSequentialImpulseConstraintSolverMt::solveGroupCacheFriendlySetup(
 																	  numConstraints,
 																	  infoGlobal,
 																	  debugDrawer);
+	// the packed rows keep the order of the batches, and the contact and friction passes apart
+	m_useSoaContactConstraints = m_useBatching && s_soaContactKernel != btSoaContactConstraints::KERNEL_NONE &&
+								 (infoGlobal.m_solverMode & (SOLVER_RANDMIZE_ORDER | SOLVER_INTERLEAVE_CONTACT_AND_FRICTION_CONSTRAINTS)) == 0;
+	if (m_useSoaContactConstraints)
+	{
+		m_soaContactConstraints.setup(m_batchedContactConstraints,
+									  m_tmpSolverContactConstraintPool,
+									  m_tmpSolverContactFrictionConstraintPool,
+									  m_numFrictionDirections,
+									  m_tmpSolverBodyPool,
+									  s_soaContactKernel);
+	}
 	return 0.0f;
 }
 
@@ -1056,6 +1070,17 @@ btScalar btSequentialImpulseConstraintSolverMt::resolveMultipleContactFrictionCo
 	return leastSquaresResidual;
 }
 
+btScalar btSequentialImpulseConstraintSolverMt::resolveMultipleSoaContactGroups(int groupBegin, int groupEnd)
+{
+	return m_soaContactConstraints.resolveContactGroups(groupBegin, groupEnd, &m_tmpSolverBodyPool[0], &m_tmpSolverContactConstraintPool[0]);
+}
+
+btScalar btSequentialImpulseConstraintSolverMt::resolveMultipleSoaFrictionGroups(int groupBegin, int groupEnd)
+{
+	// like resolveMultipleContactFrictionConstraints, only the first friction direction of each contact is resolved
+	return m_soaContactConstraints.resolveFrictionGroups(groupBegin, groupEnd, &m_tmpSolverBodyPool[0], &m_tmpSolverContactFrictionConstraintPool[0]);
+}
+
 btScalar btSequentialImpulseConstraintSolverMt::resolveMultipleContactRollingFrictionConstraints(const btAlignedObjectArray<int>& consIndices, int batchBegin, int batchEnd)
 {
 	btScalar leastSquaresResidual = 0.f;
@@ -1265,10 +1290,38 @@ struct ContactSolverLoop : public btIParallelSumBody
 	}
 };
 
+struct SoaContactSolverLoop : public btIParallelSumBody
+{
+	btSequentialImpulseConstraintSolverMt* m_solver;
+
+	SoaContactSolverLoop(btSequentialImpulseConstraintSolverMt* solver)
+	{
+		m_solver = solver;
+	}
+	btScalar sumLoop(int iBegin, int iEnd) const BT_OVERRIDE
+	{
+		BT_PROFILE("SoaContactSolverLoop");
+		return m_solver->resolveMultipleSoaContactGroups(iBegin, iEnd);
+	}
+};
+
 btScalar btSequentialImpulseConstraintSolverMt::resolveAllContactConstraints()
 {
 	BT_PROFILE("resolveAllContactConstraints");
 	const btBatchedConstraints& batchedCons = m_batchedContactConstraints;
+	if (m_useSoaContactConstraints)
+	{
+		SoaContactSolverLoop loop(this);
+		btScalar leastSquaresResidual = 0.f;
+		for (int iiPhase = 0; iiPhase < batchedCons.m_phases.size(); ++iiPhase)
+		{
+			int iPhase = batchedCons.m_phaseOrder[iiPhase];
+			const btBatchedConstraints::Range& phase = m_soaContactConstraints.m_phases[iPhase];
+			int grainSize = m_soaContactConstraints.m_phaseGrainSize[iPhase];
+			leastSquaresResidual += btParallelSum(phase.begin, phase.end, grainSize, loop);
+		}
+		return leastSquaresResidual;
+	}
 	ContactSolverLoop loop(this, &batchedCons);
 	btScalar leastSquaresResidual = 0.f;
 	for (int iiPhase = 0; iiPhase < batchedCons.m_phases.size(); ++iiPhase)
@@ -1304,10 +1357,38 @@ struct ContactFrictionSolverLoop : public btIParallelSumBody
 	}
 };
 
+struct SoaContactFrictionSolverLoop : public btIParallelSumBody
+{
+	btSequentialImpulseConstraintSolverMt* m_solver;
+
+	SoaContactFrictionSolverLoop(btSequentialImpulseConstraintSolverMt* solver)
+	{
+		m_solver = solver;
+	}
+	btScalar sumLoop(int iBegin, int iEnd) const BT_OVERRIDE
+	{
+		BT_PROFILE("SoaContactFrictionSolverLoop");
+		return m_solver->resolveMultipleSoaFrictionGroups(iBegin, iEnd);
+	}
+};
+
 btScalar btSequentialImpulseConstraintSolverMt::resolveAllContactFrictionConstraints()
 {
 	BT_PROFILE("resolveAllContactFrictionConstraints");
 	const btBatchedConstraints& batchedCons = m_batchedContactConstraints;
+	if (m_useSoaContactConstraints)
+	{
+		SoaContactFrictionSolverLoop loop(this);
+		btScalar leastSquaresResidual = 0.f;
+		for (int iiPhase = 0; iiPhase < batchedCons.m_phases.size(); ++iiPhase)
+		{
+			int iPhase = batchedCons.m_phaseOrder[iiPhase];
+			const btBatchedConstraints::Range& phase = m_soaContactConstraints.m_phases[iPhase];
+			int grainSize = m_soaContactConstraints.m_phaseGrainSize[iPhase];
+			leastSquaresResidual += btParallelSum(phase.begin, phase.end, grainSize, loop);
+		}
+		return leastSquaresResidual;
+	}
 	ContactFrictionSolverLoop loop(this, &batchedCons);
 	btScalar leastSquaresResidual = 0.f;
 	for (int iiPhase = 0; iiPhase < batchedCons.m_phases.size(); ++iiPhase)
@@ -18,6 +18,7 @@ subject to the following restrictions:
 
 #include "btSequentialImpulseConstraintSolver.h"
 #include "btBatchedConstraints.h"
+#include "btSoaContactConstraints.h"
 #include "LinearMath/btThreads.h"
 
 ///
@@ -48,6 +49,10 @@ subject to the following restrictions:
 ///  is randomized, however it does not swap constraints between batches.
 ///  This is to avoid regenerating the batches for each solver iteration which would be quite costly in performance.
 ///
+///  The contact and friction rows of the batches are packed into btSoaContactConstraints, and resolved 8 batches at a time
+///  with the kernel selected by s_soaContactKernel (the fastest one the cpu supports by default). It is not used with
+///  SOLVER_RANDMIZE_ORDER or SOLVER_INTERLEAVE_CONTACT_AND_FRICTION_CONSTRAINTS.
+///
 ///  Note that a non-zero leastSquaresResidualThreshold could possibly affect the determinism of the simulation
 ///  if the task scheduler's parallelSum operation is non-deterministic. The parallelSum operation can be non-deterministic
 ///  because floating point addition is not associative due to rounding errors.
@@ -91,15 +96,18 @@ public:
 	static btBatchedConstraints::BatchingMethod s_jointBatchingMethod;
 	static int s_minBatchSize;  // desired number of constraints per batch
 	static int s_maxBatchSize;
+	static btSoaContactConstraints::Kernel s_soaContactKernel;  // KERNEL_NONE resolves the batched contacts one row at a time
 
 protected:
 	static const int CACHE_LINE_SIZE = 64;
 
 	btBatchedConstraints m_batchedContactConstraints;
 	btBatchedConstraints m_batchedJointConstraints;
+	btSoaContactConstraints m_soaContactConstraints;
 	int m_numFrictionDirections;
 	bool m_useBatching;
 	bool m_useObsoleteJointConstraints;
+	bool m_useSoaContactConstraints;
 	btAlignedObjectArray<btContactManifoldCachedInfo> m_manifoldCachedInfoArray;
 	btAlignedObjectArray<int> m_rollingFrictionIndexTable;  // lookup table mapping contact index to rolling friction index
 	btSpinMutex m_bodySolverArrayMutex;
@@ -137,6 +145,8 @@ public:
 	btScalar resolveMultipleContactFrictionConstraints(const btAlignedObjectArray<int>& consIndices, int batchBegin, int batchEnd);
 	btScalar resolveMultipleContactRollingFrictionConstraints(const btAlignedObjectArray<int>& consIndices, int batchBegin, int batchEnd);
 	btScalar resolveMultipleContactConstraintsInterleaved(const btAlignedObjectArray<int>& contactIndices, int batchBegin, int batchEnd);
+	btScalar resolveMultipleSoaContactGroups(int groupBegin, int groupEnd);
+	btScalar resolveMultipleSoaFrictionGroups(int groupBegin, int groupEnd);
 
 	void internalCollectContactManifoldCachedInfo(btContactManifoldCachedInfo * cachedInfoArray, btPersistentManifold * *manifoldPtr, int numManifolds, const btContactSolverInfo& infoGlobal);
 	void internalAllocContactConstraints(const btContactManifoldCachedInfo* cachedInfoArray, int numManifolds);
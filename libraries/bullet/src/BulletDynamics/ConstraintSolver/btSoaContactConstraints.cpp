@@ -0,0 +1,578 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "btSoaContactConstraints.h"
+
+#include "LinearMath/btQuickprof.h"
+#include "LinearMath/btThreads.h"
+
+#include "LinearMath/btCpuFeatureUtility.h"
+
+#if !defined(BT_USE_DOUBLE_PRECISION) && defined(BT_HAS_SSE2_INTRINSICS)
+#define BT_SOA_USE_SSE2 1
+#include <emmintrin.h>
+#ifdef BT_HAS_AVX2_INTRINSICS
+#define BT_SOA_USE_AVX2 1
+#include <immintrin.h>
+#endif
+#endif
+
+btSoaContactConstraints::Kernel btSoaContactConstraints::getBestKernel()
+{
+	return getSupportedKernel(KERNEL_AVX2);
+}
+
+btSoaContactConstraints::Kernel btSoaContactConstraints::getSupportedKernel(Kernel kernel)
+{
+#ifdef BT_SOA_USE_AVX2
+	if (kernel == KERNEL_AVX2 && (btCpuFeatureUtility::getCpuFeatures() & btCpuFeatureUtility::CPU_FEATURE_AVX2) == 0)
+#else
+	if (kernel == KERNEL_AVX2)
+#endif
+		kernel = KERNEL_SSE2;
+#ifndef BT_SOA_USE_SSE2
+	if (kernel == KERNEL_SSE2)
+		kernel = KERNEL_SCALAR;
+#endif
+	return kernel;
+}
+
+static void btSoaClearRow(btSoaContactConstraints::Block& block, int lane)
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		block.m_contactNormal1[i][lane] = btScalar(0);
+		block.m_relpos1CrossNormal[i][lane] = btScalar(0);
+		block.m_contactNormal2[i][lane] = btScalar(0);
+		block.m_relpos2CrossNormal[i][lane] = btScalar(0);
+		block.m_linearComponentA[i][lane] = btScalar(0);
+		block.m_angularComponentA[i][lane] = btScalar(0);
+		block.m_linearComponentB[i][lane] = btScalar(0);
+		block.m_angularComponentB[i][lane] = btScalar(0);
+		block.m_linearFactorA[i][lane] = btScalar(0);
+		block.m_angularFactorA[i][lane] = btScalar(0);
+		block.m_linearFactorB[i][lane] = btScalar(0);
+		block.m_angularFactorB[i][lane] = btScalar(0);
+	}
+	block.m_rhs[lane] = btScalar(0);
+	block.m_cfm[lane] = btScalar(0);
+	block.m_jacDiagABInv[lane] = btScalar(0);
+	block.m_jacDiagAB[lane] = btScalar(0);
+	block.m_lowerLimit[lane] = btScalar(0);
+	block.m_friction[lane] = btScalar(0);
+	block.m_appliedImpulse[lane] = btScalar(0);
+	block.m_solverBodyIdA[lane] = -1;
+	block.m_solverBodyIdB[lane] = -1;
+	block.m_constraintIndex[lane] = -1;
+}
+
+static void btSoaPackRow(btSoaContactConstraints::Block& block, int lane, const btSolverConstraint& c, int constraintIndex, const btAlignedObjectArray<btSolverBody>& bodies)
+{
+	const btSolverBody& bodyA = bodies[c.m_solverBodyIdA];
+	const btSolverBody& bodyB = bodies[c.m_solverBodyIdB];
+	//internalApplyImpulse only moves bodies with an original body, the others keep their zero delta velocities
+	const bool movesA = bodyA.m_originalBody != NULL;
+	const bool movesB = bodyB.m_originalBody != NULL;
+	for (int i = 0; i < 3; ++i)
+	{
+		block.m_contactNormal1[i][lane] = c.m_contactNormal1[i];
+		block.m_relpos1CrossNormal[i][lane] = c.m_relpos1CrossNormal[i];
+		block.m_contactNormal2[i][lane] = c.m_contactNormal2[i];
+		block.m_relpos2CrossNormal[i][lane] = c.m_relpos2CrossNormal[i];
+		block.m_linearComponentA[i][lane] = movesA ? c.m_contactNormal1[i] * bodyA.m_invMass[i] : btScalar(0);
+		block.m_angularComponentA[i][lane] = movesA ? c.m_angularComponentA[i] : btScalar(0);
+		block.m_linearComponentB[i][lane] = movesB ? c.m_contactNormal2[i] * bodyB.m_invMass[i] : btScalar(0);
+		block.m_angularComponentB[i][lane] = movesB ? c.m_angularComponentB[i] : btScalar(0);
+		block.m_linearFactorA[i][lane] = movesA ? bodyA.m_linearFactor[i] : btScalar(0);
+		block.m_angularFactorA[i][lane] = movesA ? bodyA.m_angularFactor[i] : btScalar(0);
+		block.m_linearFactorB[i][lane] = movesB ? bodyB.m_linearFactor[i] : btScalar(0);
+		block.m_angularFactorB[i][lane] = movesB ? bodyB.m_angularFactor[i] : btScalar(0);
+	}
+	block.m_rhs[lane] = c.m_rhs;
+	block.m_cfm[lane] = c.m_cfm;
+	block.m_jacDiagABInv[lane] = c.m_jacDiagABInv;
+	block.m_jacDiagAB[lane] = c.m_jacDiagABInv != btScalar(0) ? btScalar(1) / c.m_jacDiagABInv : btScalar(0);
+	block.m_lowerLimit[lane] = c.m_lowerLimit;
+	block.m_friction[lane] = c.m_friction;
+	block.m_appliedImpulse[lane] = c.m_appliedImpulse;
+	block.m_solverBodyIdA[lane] = movesA ? c.m_solverBodyIdA : -1;
+	block.m_solverBodyIdB[lane] = movesB ? c.m_solverBodyIdB : -1;
+	block.m_constraintIndex[lane] = constraintIndex;
+}
+
+void btSoaContactConstraints::packGroups(int iBegin, int iEnd, const btBatchedConstraints& batchedConstraints, const btConstraintArray& contactConstraints, const btConstraintArray& frictionConstraints, int numFrictionDirections, const btAlignedObjectArray<btSolverBody>& bodies)
+{
+	for (int iGroup = iBegin; iGroup < iEnd; ++iGroup)
+	{
+		const btBatchedConstraints::Range& group = m_groups[iGroup];
+		const btBatchedConstraints::Range& groupBatches = m_groupBatches[iGroup];
+		for (int iBlock = group.begin; iBlock < group.end; ++iBlock)
+		{
+			int iRow = iBlock - group.begin;
+			for (int lane = 0; lane < BT_SOA_CONTACT_LANES; ++lane)
+			{
+				int iBatch = groupBatches.begin + lane;
+				int iContact = -1;
+				if (iBatch < groupBatches.end)
+				{
+					const btBatchedConstraints::Range& batch = batchedConstraints.m_batches[iBatch];
+					if (batch.begin + iRow < batch.end)
+						iContact = batchedConstraints.m_constraintIndices[batch.begin + iRow];
+				}
+				if (iContact >= 0)
+				{
+					int iFriction = iContact * numFrictionDirections;
+					btAssert(frictionConstraints[iFriction].m_frictionIndex == iContact);
+					btSoaPackRow(m_contactBlocks[iBlock], lane, contactConstraints[iContact], iContact, bodies);
+					btSoaPackRow(m_frictionBlocks[iBlock], lane, frictionConstraints[iFriction], iFriction, bodies);
+				}
+				else
+				{
+					btSoaClearRow(m_contactBlocks[iBlock], lane);
+					btSoaClearRow(m_frictionBlocks[iBlock], lane);
+				}
+			}
+		}
+	}
+}
+
+struct btSoaPackGroupsLoop : public btIParallelForBody
+{
+	btSoaContactConstraints* m_soa;
+	const btBatchedConstraints* m_bc;
+	const btConstraintArray* m_contactConstraints;
+	const btConstraintArray* m_frictionConstraints;
+	int m_numFrictionDirections;
+	const btAlignedObjectArray<btSolverBody>* m_bodies;
+
+	void forLoop(int iBegin, int iEnd) const BT_OVERRIDE
+	{
+		m_soa->packGroups(iBegin, iEnd, *m_bc, *m_contactConstraints, *m_frictionConstraints, m_numFrictionDirections, *m_bodies);
+	}
+};
+
+void btSoaContactConstraints::setup(const btBatchedConstraints& batchedConstraints,
+									const btConstraintArray& contactConstraints,
+									const btConstraintArray& frictionConstraints,
+									int numFrictionDirections,
+									const btAlignedObjectArray<btSolverBody>& bodies,
+									Kernel kernel)
+{
+	BT_PROFILE("btSoaContactConstraints::setup");
+	m_kernel = getSupportedKernel(kernel);
+
+	//every BT_SOA_CONTACT_LANES batches of a phase make a group, with one block per row of its longest batch
+	int numPhases = batchedConstraints.m_phases.size();
+	m_phases.resizeNoInitialize(numPhases);
+	m_phaseGrainSize.resizeNoInitialize(numPhases);
+	m_groups.resizeNoInitialize(0);
+	m_groupBatches.resizeNoInitialize(0);
+	int numBlocks = 0;
+	for (int iPhase = 0; iPhase < numPhases; ++iPhase)
+	{
+		const btBatchedConstraints::Range& phase = batchedConstraints.m_phases[iPhase];
+		int groupBegin = m_groups.size();
+		for (int iBatch = phase.begin; iBatch < phase.end; iBatch += BT_SOA_CONTACT_LANES)
+		{
+			int batchEnd = btMin(iBatch + BT_SOA_CONTACT_LANES, phase.end);
+			int numRows = 0;
+			for (int i = iBatch; i < batchEnd; ++i)
+			{
+				const btBatchedConstraints::Range& batch = batchedConstraints.m_batches[i];
+				numRows = btMax(numRows, batch.end - batch.begin);
+			}
+			m_groups.push_back(btBatchedConstraints::Range(numBlocks, numBlocks + numRows));
+			m_groupBatches.push_back(btBatchedConstraints::Range(iBatch, batchEnd));
+			numBlocks += numRows;
+		}
+		m_phases[iPhase] = btBatchedConstraints::Range(groupBegin, m_groups.size());
+		m_phaseGrainSize[iPhase] = char(btMax(1, (int(batchedConstraints.m_phaseGrainSize[iPhase]) + BT_SOA_CONTACT_LANES - 1) / BT_SOA_CONTACT_LANES));
+	}
+	m_contactBlocks.resizeNoInitialize(numBlocks);
+	m_frictionBlocks.resizeNoInitialize(numBlocks);
+
+	btSoaPackGroupsLoop loop;
+	loop.m_soa = this;
+	loop.m_bc = &batchedConstraints;
+	loop.m_contactConstraints = &contactConstraints;
+	loop.m_frictionConstraints = &frictionConstraints;
+	loop.m_numFrictionDirections = numFrictionDirections;
+	loop.m_bodies = &bodies;
+	btParallelFor(0, m_groups.size(), 1, loop);
+}
+
+//the kernels below resolve a range of blocks exactly like gResolveSingleConstraintRowLowerLimit_scalar_reference (contacts)
+//and gResolveSingleConstraintRowGeneric_scalar_reference (friction) resolve each of their rows, in the same order of operations
+
+template <bool friction>
+static btScalar btSoaResolveBlocksScalar(btSoaContactConstraints::Block* blocks, const btSoaContactConstraints::Block* contactBlocks, int iBegin, int iEnd, btSolverBody* bodies, btSolverConstraint* constraints)
+{
+	const btVector3 zero(btScalar(0), btScalar(0), btScalar(0));
+	btScalar leastSquaresResidual = btScalar(0);
+	for (int iBlock = iBegin; iBlock < iEnd; ++iBlock)
+	{
+		btSoaContactConstraints::Block& block = blocks[iBlock];
+		for (int lane = 0; lane < BT_SOA_CONTACT_LANES; ++lane)
+		{
+			int iConstraint = block.m_constraintIndex[lane];
+			if (iConstraint < 0)
+				continue;
+			btScalar lowerLimit = block.m_lowerLimit[lane];
+			btScalar upperLimit = SIMD_INFINITY;
+			if (friction)
+			{
+				btScalar totalImpulse = contactBlocks[iBlock].m_appliedImpulse[lane];
+				if (!(totalImpulse > btScalar(0)))
+					continue;
+				lowerLimit = -(block.m_friction[lane] * totalImpulse);
+				upperLimit = block.m_friction[lane] * totalImpulse;
+			}
+			int idA = block.m_solverBodyIdA[lane];
+			int idB = block.m_solverBodyIdB[lane];
+			const btVector3& linearA = idA >= 0 ? bodies[idA].m_deltaLinearVelocity : zero;
+			const btVector3& angularA = idA >= 0 ? bodies[idA].m_deltaAngularVelocity : zero;
+			const btVector3& linearB = idB >= 0 ? bodies[idB].m_deltaLinearVelocity : zero;
+			const btVector3& angularB = idB >= 0 ? bodies[idB].m_deltaAngularVelocity : zero;
+
+			btScalar appliedImpulse = block.m_appliedImpulse[lane];
+			btScalar deltaImpulse = block.m_rhs[lane] - appliedImpulse * block.m_cfm[lane];
+			btScalar deltaVel1Dotn = (block.m_contactNormal1[0][lane] * linearA[0] + block.m_contactNormal1[1][lane] * linearA[1] + block.m_contactNormal1[2][lane] * linearA[2]) +
+									 (block.m_relpos1CrossNormal[0][lane] * angularA[0] + block.m_relpos1CrossNormal[1][lane] * angularA[1] + block.m_relpos1CrossNormal[2][lane] * angularA[2]);
+			btScalar deltaVel2Dotn = (block.m_contactNormal2[0][lane] * linearB[0] + block.m_contactNormal2[1][lane] * linearB[1] + block.m_contactNormal2[2][lane] * linearB[2]) +
+									 (block.m_relpos2CrossNormal[0][lane] * angularB[0] + block.m_relpos2CrossNormal[1][lane] * angularB[1] + block.m_relpos2CrossNormal[2][lane] * angularB[2]);
+			deltaImpulse -= deltaVel1Dotn * block.m_jacDiagABInv[lane];
+			deltaImpulse -= deltaVel2Dotn * block.m_jacDiagABInv[lane];
+			btScalar sum = appliedImpulse + deltaImpulse;
+			if (sum < lowerLimit)
+			{
+				deltaImpulse = lowerLimit - appliedImpulse;
+				appliedImpulse = lowerLimit;
+			}
+			else if (sum > upperLimit)
+			{
+				deltaImpulse = upperLimit - appliedImpulse;
+				appliedImpulse = upperLimit;
+			}
+			else
+			{
+				appliedImpulse = sum;
+			}
+			block.m_appliedImpulse[lane] = appliedImpulse;
+			constraints[iConstraint].m_appliedImpulse = appliedImpulse;
+
+			for (int i = 0; i < 3; ++i)
+			{
+				if (idA >= 0)
+				{
+					bodies[idA].m_deltaLinearVelocity[i] += block.m_linearComponentA[i][lane] * deltaImpulse * block.m_linearFactorA[i][lane];
+					bodies[idA].m_deltaAngularVelocity[i] += block.m_angularComponentA[i][lane] * (deltaImpulse * block.m_angularFactorA[i][lane]);
+				}
+				if (idB >= 0)
+				{
+					bodies[idB].m_deltaLinearVelocity[i] += block.m_linearComponentB[i][lane] * deltaImpulse * block.m_linearFactorB[i][lane];
+					bodies[idB].m_deltaAngularVelocity[i] += block.m_angularComponentB[i][lane] * (deltaImpulse * block.m_angularFactorB[i][lane]);
+				}
+			}
+			btScalar residual = deltaImpulse * block.m_jacDiagAB[lane];
+			leastSquaresResidual += residual * residual;
+		}
+	}
+	return leastSquaresResidual;
+}
+
+static void btSoaWriteAppliedImpulses(const btSoaContactConstraints::Block& block, btSolverConstraint* constraints)
+{
+	for (int lane = 0; lane < BT_SOA_CONTACT_LANES; ++lane)
+	{
+		int iConstraint = block.m_constraintIndex[lane];
+		if (iConstraint >= 0)
+			constraints[iConstraint].m_appliedImpulse = block.m_appliedImpulse[lane];
+	}
+}
+
+#ifdef BT_SOA_USE_SSE2
+
+//reads for bodies that don't move, and empty lanes
+static const btScalar s_soaZeroVelocity[4] = {btScalar(0), btScalar(0), btScalar(0), btScalar(0)};
+
+//the delta velocities of the bodies of 4 lanes, transposed to x, y, z and w registers.
+//btSolverBody is only 16 byte aligned when BT_USE_SSE is defined, so all loads and stores are unaligned
+struct btSoaVelocities4
+{
+	const btScalar* m_read[4];
+	btScalar* m_write[4];
+	__m128 m_v[4];
+};
+
+static SIMD_FORCE_INLINE void btSoaGather4(btSoaVelocities4& velocities, btSolverBody* bodies, const int* ids, bool angular, btScalar* scratch)
+{
+	for (int i = 0; i < 4; ++i)
+	{
+		int id = ids[i];
+		if (id >= 0)
+		{
+			btScalar* velocity = angular ? bodies[id].m_deltaAngularVelocity.m_floats : bodies[id].m_deltaLinearVelocity.m_floats;
+			velocities.m_read[i] = velocity;
+			velocities.m_write[i] = velocity;
+		}
+		else
+		{
+			velocities.m_read[i] = s_soaZeroVelocity;
+			velocities.m_write[i] = scratch;
+		}
+	}
+	velocities.m_v[0] = _mm_loadu_ps(velocities.m_read[0]);
+	velocities.m_v[1] = _mm_loadu_ps(velocities.m_read[1]);
+	velocities.m_v[2] = _mm_loadu_ps(velocities.m_read[2]);
+	velocities.m_v[3] = _mm_loadu_ps(velocities.m_read[3]);
+	_MM_TRANSPOSE4_PS(velocities.m_v[0], velocities.m_v[1], velocities.m_v[2], velocities.m_v[3]);
+}
+
+static SIMD_FORCE_INLINE void btSoaScatter4(btSoaVelocities4& velocities)
+{
+	_MM_TRANSPOSE4_PS(velocities.m_v[0], velocities.m_v[1], velocities.m_v[2], velocities.m_v[3]);
+	_mm_storeu_ps(velocities.m_write[0], velocities.m_v[0]);
+	_mm_storeu_ps(velocities.m_write[1], velocities.m_v[1]);
+	_mm_storeu_ps(velocities.m_write[2], velocities.m_v[2]);
+	_mm_storeu_ps(velocities.m_write[3], velocities.m_v[3]);
+}
+
+static SIMD_FORCE_INLINE __m128 btSoaSelect4(__m128 mask, __m128 a, __m128 b)
+{
+	return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static SIMD_FORCE_INLINE __m128 btSoaDot4(const btScalar (*a)[BT_SOA_CONTACT_LANES], int lane, const __m128* v)
+{
+	return _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_loadu_ps(&a[0][lane]), v[0]), _mm_mul_ps(_mm_loadu_ps(&a[1][lane]), v[1])), _mm_mul_ps(_mm_loadu_ps(&a[2][lane]), v[2]));
+}
+
+//v += component * deltaImpulse * factor, like the linear part of btSolverBody::internalApplyImpulse
+static SIMD_FORCE_INLINE void btSoaApplyLinear4(const btScalar (*component)[BT_SOA_CONTACT_LANES], const btScalar (*factor)[BT_SOA_CONTACT_LANES], int lane, __m128 deltaImpulse, __m128* v)
+{
+	for (int i = 0; i < 3; ++i)
+		v[i] = _mm_add_ps(v[i], _mm_mul_ps(_mm_mul_ps(_mm_loadu_ps(&component[i][lane]), deltaImpulse), _mm_loadu_ps(&factor[i][lane])));
+}
+
+//v += component * (deltaImpulse * factor), like the angular part of btSolverBody::internalApplyImpulse
+static SIMD_FORCE_INLINE void btSoaApplyAngular4(const btScalar (*component)[BT_SOA_CONTACT_LANES], const btScalar (*factor)[BT_SOA_CONTACT_LANES], int lane, __m128 deltaImpulse, __m128* v)
+{
+	for (int i = 0; i < 3; ++i)
+		v[i] = _mm_add_ps(v[i], _mm_mul_ps(_mm_loadu_ps(&component[i][lane]), _mm_mul_ps(deltaImpulse, _mm_loadu_ps(&factor[i][lane]))));
+}
+
+template <bool friction>
+static btScalar btSoaResolveBlocksSse2(btSoaContactConstraints::Block* blocks, const btSoaContactConstraints::Block* contactBlocks, int iBegin, int iEnd, btSolverBody* bodies, btSolverConstraint* constraints)
+{
+	btScalar scratch[4];
+	__m128 leastSquaresResidual = _mm_setzero_ps();
+	for (int iBlock = iBegin; iBlock < iEnd; ++iBlock)
+	{
+		btSoaContactConstraints::Block& block = blocks[iBlock];
+		//the two halves of a block are independent rows, like the lanes
+		for (int lane = 0; lane < BT_SOA_CONTACT_LANES; lane += 4)
+		{
+			btSoaVelocities4 linearA, angularA, linearB, angularB;
+			btSoaGather4(linearA, bodies, &block.m_solverBodyIdA[lane], false, scratch);
+			btSoaGather4(angularA, bodies, &block.m_solverBodyIdA[lane], true, scratch);
+			btSoaGather4(linearB, bodies, &block.m_solverBodyIdB[lane], false, scratch);
+			btSoaGather4(angularB, bodies, &block.m_solverBodyIdB[lane], true, scratch);
+
+			__m128 appliedImpulse = _mm_loadu_ps(&block.m_appliedImpulse[lane]);
+			__m128 jacDiagABInv = _mm_loadu_ps(&block.m_jacDiagABInv[lane]);
+			__m128 lowerLimit = _mm_loadu_ps(&block.m_lowerLimit[lane]);
+			__m128 upperLimit = _mm_set1_ps(SIMD_INFINITY);
+			__m128 active = _mm_castsi128_ps(_mm_set1_epi32(-1));
+			if (friction)
+			{
+				__m128 totalImpulse = _mm_loadu_ps(&contactBlocks[iBlock].m_appliedImpulse[lane]);
+				__m128 frictionCoefficient = _mm_loadu_ps(&block.m_friction[lane]);
+				active = _mm_cmpgt_ps(totalImpulse, _mm_setzero_ps());
+				upperLimit = _mm_mul_ps(frictionCoefficient, totalImpulse);
+				lowerLimit = _mm_xor_ps(upperLimit, _mm_set1_ps(btScalar(-0.0)));
+			}
+
+			__m128 deltaImpulse = _mm_sub_ps(_mm_loadu_ps(&block.m_rhs[lane]), _mm_mul_ps(appliedImpulse, _mm_loadu_ps(&block.m_cfm[lane])));
+			__m128 deltaVel1Dotn = _mm_add_ps(btSoaDot4(block.m_contactNormal1, lane, linearA.m_v), btSoaDot4(block.m_relpos1CrossNormal, lane, angularA.m_v));
+			__m128 deltaVel2Dotn = _mm_add_ps(btSoaDot4(block.m_contactNormal2, lane, linearB.m_v), btSoaDot4(block.m_relpos2CrossNormal, lane, angularB.m_v));
+			deltaImpulse = _mm_sub_ps(deltaImpulse, _mm_mul_ps(deltaVel1Dotn, jacDiagABInv));
+			deltaImpulse = _mm_sub_ps(deltaImpulse, _mm_mul_ps(deltaVel2Dotn, jacDiagABInv));
+			__m128 sum = _mm_add_ps(appliedImpulse, deltaImpulse);
+			__m128 upperMask = _mm_cmpgt_ps(sum, upperLimit);
+			__m128 lowerMask = _mm_cmplt_ps(sum, lowerLimit);
+			deltaImpulse = btSoaSelect4(upperMask, _mm_sub_ps(upperLimit, appliedImpulse), deltaImpulse);
+			sum = btSoaSelect4(upperMask, upperLimit, sum);
+			deltaImpulse = btSoaSelect4(lowerMask, _mm_sub_ps(lowerLimit, appliedImpulse), deltaImpulse);
+			sum = btSoaSelect4(lowerMask, lowerLimit, sum);
+			//friction rows of contacts that don't push are skipped
+			deltaImpulse = _mm_and_ps(active, deltaImpulse);
+			_mm_storeu_ps(&block.m_appliedImpulse[lane], btSoaSelect4(active, sum, appliedImpulse));
+
+			btSoaApplyLinear4(block.m_linearComponentA, block.m_linearFactorA, lane, deltaImpulse, linearA.m_v);
+			btSoaApplyAngular4(block.m_angularComponentA, block.m_angularFactorA, lane, deltaImpulse, angularA.m_v);
+			btSoaApplyLinear4(block.m_linearComponentB, block.m_linearFactorB, lane, deltaImpulse, linearB.m_v);
+			btSoaApplyAngular4(block.m_angularComponentB, block.m_angularFactorB, lane, deltaImpulse, angularB.m_v);
+			btSoaScatter4(linearA);
+			btSoaScatter4(angularA);
+			btSoaScatter4(linearB);
+			btSoaScatter4(angularB);
+
+			__m128 residual = _mm_mul_ps(deltaImpulse, _mm_loadu_ps(&block.m_jacDiagAB[lane]));
+			leastSquaresResidual = _mm_add_ps(leastSquaresResidual, _mm_mul_ps(residual, residual));
+		}
+		btSoaWriteAppliedImpulses(block, constraints);
+	}
+	btScalar residuals[4];
+	_mm_storeu_ps(residuals, leastSquaresResidual);
+	return (residuals[0] + residuals[1]) + (residuals[2] + residuals[3]);
+}
+
+#endif  //BT_SOA_USE_SSE2
+
+#ifdef BT_SOA_USE_AVX2
+
+static BT_AVX2_TARGET SIMD_FORCE_INLINE void btSoaGather8(btSoaVelocities4* velocities, __m256* v, btSolverBody* bodies, const int* ids, bool angular, btScalar* scratch)
+{
+	btSoaGather4(velocities[0], bodies, ids, angular, scratch);
+	btSoaGather4(velocities[1], bodies, ids + 4, angular, scratch);
+	for (int i = 0; i < 3; ++i)
+		v[i] = _mm256_insertf128_ps(_mm256_castps128_ps256(velocities[0].m_v[i]), velocities[1].m_v[i], 1);
+}
+
+static BT_AVX2_TARGET SIMD_FORCE_INLINE void btSoaScatter8(btSoaVelocities4* velocities, const __m256* v)
+{
+	for (int i = 0; i < 3; ++i)
+	{
+		velocities[0].m_v[i] = _mm256_castps256_ps128(v[i]);
+		velocities[1].m_v[i] = _mm256_extractf128_ps(v[i], 1);
+	}
+	btSoaScatter4(velocities[0]);
+	btSoaScatter4(velocities[1]);
+}
+
+static BT_AVX2_TARGET SIMD_FORCE_INLINE __m256 btSoaDot8(const btScalar (*a)[BT_SOA_CONTACT_LANES], const __m256* v)
+{
+	return _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(_mm256_loadu_ps(a[0]), v[0]), _mm256_mul_ps(_mm256_loadu_ps(a[1]), v[1])), _mm256_mul_ps(_mm256_loadu_ps(a[2]), v[2]));
+}
+
+static BT_AVX2_TARGET SIMD_FORCE_INLINE void btSoaApplyLinear8(const btScalar (*component)[BT_SOA_CONTACT_LANES], const btScalar (*factor)[BT_SOA_CONTACT_LANES], __m256 deltaImpulse, __m256* v)
+{
+	for (int i = 0; i < 3; ++i)
+		v[i] = _mm256_add_ps(v[i], _mm256_mul_ps(_mm256_mul_ps(_mm256_loadu_ps(component[i]), deltaImpulse), _mm256_loadu_ps(factor[i])));
+}
+
+static BT_AVX2_TARGET SIMD_FORCE_INLINE void btSoaApplyAngular8(const btScalar (*component)[BT_SOA_CONTACT_LANES], const btScalar (*factor)[BT_SOA_CONTACT_LANES], __m256 deltaImpulse, __m256* v)
+{
+	for (int i = 0; i < 3; ++i)
+		v[i] = _mm256_add_ps(v[i], _mm256_mul_ps(_mm256_loadu_ps(component[i]), _mm256_mul_ps(deltaImpulse, _mm256_loadu_ps(factor[i]))));
+}
+
+template <bool friction>
+static BT_AVX2_TARGET btScalar btSoaResolveBlocksAvx2(btSoaContactConstraints::Block* blocks, const btSoaContactConstraints::Block* contactBlocks, int iBegin, int iEnd, btSolverBody* bodies, btSolverConstraint* constraints)
+{
+	btScalar scratch[4];
+	__m256 leastSquaresResidual = _mm256_setzero_ps();
+	for (int iBlock = iBegin; iBlock < iEnd; ++iBlock)
+	{
+		btSoaContactConstraints::Block& block = blocks[iBlock];
+		btSoaVelocities4 linearAHalves[2], angularAHalves[2], linearBHalves[2], angularBHalves[2];
+		__m256 linearA[3], angularA[3], linearB[3], angularB[3];
+		btSoaGather8(linearAHalves, linearA, bodies, block.m_solverBodyIdA, false, scratch);
+		btSoaGather8(angularAHalves, angularA, bodies, block.m_solverBodyIdA, true, scratch);
+		btSoaGather8(linearBHalves, linearB, bodies, block.m_solverBodyIdB, false, scratch);
+		btSoaGather8(angularBHalves, angularB, bodies, block.m_solverBodyIdB, true, scratch);
+
+		__m256 appliedImpulse = _mm256_loadu_ps(block.m_appliedImpulse);
+		__m256 jacDiagABInv = _mm256_loadu_ps(block.m_jacDiagABInv);
+		__m256 lowerLimit = _mm256_loadu_ps(block.m_lowerLimit);
+		__m256 upperLimit = _mm256_set1_ps(SIMD_INFINITY);
+		__m256 active = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+		if (friction)
+		{
+			__m256 totalImpulse = _mm256_loadu_ps(contactBlocks[iBlock].m_appliedImpulse);
+			__m256 frictionCoefficient = _mm256_loadu_ps(block.m_friction);
+			active = _mm256_cmp_ps(totalImpulse, _mm256_setzero_ps(), _CMP_GT_OQ);
+			upperLimit = _mm256_mul_ps(frictionCoefficient, totalImpulse);
+			lowerLimit = _mm256_xor_ps(upperLimit, _mm256_set1_ps(btScalar(-0.0)));
+		}
+
+		__m256 deltaImpulse = _mm256_sub_ps(_mm256_loadu_ps(block.m_rhs), _mm256_mul_ps(appliedImpulse, _mm256_loadu_ps(block.m_cfm)));
+		__m256 deltaVel1Dotn = _mm256_add_ps(btSoaDot8(block.m_contactNormal1, linearA), btSoaDot8(block.m_relpos1CrossNormal, angularA));
+		__m256 deltaVel2Dotn = _mm256_add_ps(btSoaDot8(block.m_contactNormal2, linearB), btSoaDot8(block.m_relpos2CrossNormal, angularB));
+		deltaImpulse = _mm256_sub_ps(deltaImpulse, _mm256_mul_ps(deltaVel1Dotn, jacDiagABInv));
+		deltaImpulse = _mm256_sub_ps(deltaImpulse, _mm256_mul_ps(deltaVel2Dotn, jacDiagABInv));
+		__m256 sum = _mm256_add_ps(appliedImpulse, deltaImpulse);
+		__m256 upperMask = _mm256_cmp_ps(sum, upperLimit, _CMP_GT_OQ);
+		__m256 lowerMask = _mm256_cmp_ps(sum, lowerLimit, _CMP_LT_OQ);
+		deltaImpulse = _mm256_blendv_ps(deltaImpulse, _mm256_sub_ps(upperLimit, appliedImpulse), upperMask);
+		sum = _mm256_blendv_ps(sum, upperLimit, upperMask);
+		deltaImpulse = _mm256_blendv_ps(deltaImpulse, _mm256_sub_ps(lowerLimit, appliedImpulse), lowerMask);
+		sum = _mm256_blendv_ps(sum, lowerLimit, lowerMask);
+		deltaImpulse = _mm256_and_ps(active, deltaImpulse);
+		_mm256_storeu_ps(block.m_appliedImpulse, _mm256_blendv_ps(appliedImpulse, sum, active));
+
+		btSoaApplyLinear8(block.m_linearComponentA, block.m_linearFactorA, deltaImpulse, linearA);
+		btSoaApplyAngular8(block.m_angularComponentA, block.m_angularFactorA, deltaImpulse, angularA);
+		btSoaApplyLinear8(block.m_linearComponentB, block.m_linearFactorB, deltaImpulse, linearB);
+		btSoaApplyAngular8(block.m_angularComponentB, block.m_angularFactorB, deltaImpulse, angularB);
+		btSoaScatter8(linearAHalves, linearA);
+		btSoaScatter8(angularAHalves, angularA);
+		btSoaScatter8(linearBHalves, linearB);
+		btSoaScatter8(angularBHalves, angularB);
+
+		__m256 residual = _mm256_mul_ps(deltaImpulse, _mm256_loadu_ps(block.m_jacDiagAB));
+		leastSquaresResidual = _mm256_add_ps(leastSquaresResidual, _mm256_mul_ps(residual, residual));
+		btSoaWriteAppliedImpulses(block, constraints);
+	}
+	__m128 residual4 = _mm_add_ps(_mm256_castps256_ps128(leastSquaresResidual), _mm256_extractf128_ps(leastSquaresResidual, 1));
+	btScalar residuals[4];
+	_mm_storeu_ps(residuals, residual4);
+	return (residuals[0] + residuals[1]) + (residuals[2] + residuals[3]);
+}
+
+#endif  //BT_SOA_USE_AVX2
+
+template <bool friction>
+static btScalar btSoaResolveBlocks(btSoaContactConstraints::Kernel kernel, btSoaContactConstraints::Block* blocks, const btSoaContactConstraints::Block* contactBlocks, int iBegin, int iEnd, btSolverBody* bodies, btSolverConstraint* constraints)
+{
+	switch (kernel)
+	{
+#ifdef BT_SOA_USE_AVX2
+		case btSoaContactConstraints::KERNEL_AVX2:
+			return btSoaResolveBlocksAvx2<friction>(blocks, contactBlocks, iBegin, iEnd, bodies, constraints);
+#endif
+#ifdef BT_SOA_USE_SSE2
+		case btSoaContactConstraints::KERNEL_SSE2:
+			return btSoaResolveBlocksSse2<friction>(blocks, contactBlocks, iBegin, iEnd, bodies, constraints);
+#endif
+		default:
+			return btSoaResolveBlocksScalar<friction>(blocks, contactBlocks, iBegin, iEnd, bodies, constraints);
+	}
+}
+
+btScalar btSoaContactConstraints::resolveContactGroups(int iBegin, int iEnd, btSolverBody* bodies, btSolverConstraint* contactConstraints)
+{
+	if (iBegin >= iEnd || m_contactBlocks.size() == 0)
+		return btScalar(0);
+	//the blocks of consecutive groups are consecutive
+	return btSoaResolveBlocks<false>(m_kernel, &m_contactBlocks[0], &m_contactBlocks[0], m_groups[iBegin].begin, m_groups[iEnd - 1].end, bodies, contactConstraints);
+}
+
+btScalar btSoaContactConstraints::resolveFrictionGroups(int iBegin, int iEnd, btSolverBody* bodies, btSolverConstraint* frictionConstraints)
+{
+	if (iBegin >= iEnd || m_frictionBlocks.size() == 0)
+		return btScalar(0);
+	return btSoaResolveBlocks<true>(m_kernel, &m_frictionBlocks[0], &m_contactBlocks[0], m_groups[iBegin].begin, m_groups[iEnd - 1].end, bodies, frictionConstraints);
+}
@@ -0,0 +1,100 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_SOA_CONTACT_CONSTRAINTS_H
+#define BT_SOA_CONTACT_CONSTRAINTS_H
+
+#include "btBatchedConstraints.h"
+
+///Number of contact rows that are solved at once, one from each of 8 batches of a phase
+#define BT_SOA_CONTACT_LANES 8
+
+///The btSoaContactConstraints packs the contact and friction rows of a btBatchedConstraints into structure of arrays blocks.
+///The batches of a phase never share a dynamic body, so 8 batches of a phase form a group, and the rows of the group are
+///packed lane by lane: lane k of block j holds row j of batch k. A block resolves its 8 rows at once (AVX2, or 2 x SSE2),
+///and the blocks of a group are resolved in order, so every batch still sees its rows in the same Gauss-Seidel order
+///as resolveSingleConstraintRowLowerLimit and resolveSingleConstraintRowGeneric, and converges the same way.
+///The rows are packed once per solve, the kernels only gather and scatter the delta velocities of the bodies.
+struct btSoaContactConstraints
+{
+	enum Kernel
+	{
+		KERNEL_NONE,  // rows are resolved one at a time by the solver
+		KERNEL_SCALAR,
+		KERNEL_SSE2,
+		KERNEL_AVX2,
+		KERNEL_COUNT
+	};
+
+	ATTRIBUTE_ALIGNED16(struct)
+	Block
+	{
+		btScalar m_contactNormal1[3][BT_SOA_CONTACT_LANES];
+		btScalar m_relpos1CrossNormal[3][BT_SOA_CONTACT_LANES];
+		btScalar m_contactNormal2[3][BT_SOA_CONTACT_LANES];
+		btScalar m_relpos2CrossNormal[3][BT_SOA_CONTACT_LANES];
+		// contactNormal * invMass and angularComponent of each body, zero for bodies that don't move
+		btScalar m_linearComponentA[3][BT_SOA_CONTACT_LANES];
+		btScalar m_angularComponentA[3][BT_SOA_CONTACT_LANES];
+		btScalar m_linearComponentB[3][BT_SOA_CONTACT_LANES];
+		btScalar m_angularComponentB[3][BT_SOA_CONTACT_LANES];
+		// the factors are applied after the multiply by the impulse, in the order of btSolverBody::internalApplyImpulse
+		btScalar m_linearFactorA[3][BT_SOA_CONTACT_LANES];
+		btScalar m_angularFactorA[3][BT_SOA_CONTACT_LANES];
+		btScalar m_linearFactorB[3][BT_SOA_CONTACT_LANES];
+		btScalar m_angularFactorB[3][BT_SOA_CONTACT_LANES];
+		btScalar m_rhs[BT_SOA_CONTACT_LANES];
+		btScalar m_cfm[BT_SOA_CONTACT_LANES];
+		btScalar m_jacDiagABInv[BT_SOA_CONTACT_LANES];
+		btScalar m_jacDiagAB[BT_SOA_CONTACT_LANES];  // 1 / m_jacDiagABInv, zero for empty lanes
+		btScalar m_lowerLimit[BT_SOA_CONTACT_LANES];
+		btScalar m_friction[BT_SOA_CONTACT_LANES];
+		btScalar m_appliedImpulse[BT_SOA_CONTACT_LANES];
+		int m_solverBodyIdA[BT_SOA_CONTACT_LANES];  // -1 for bodies that don't move and for empty lanes
+		int m_solverBodyIdB[BT_SOA_CONTACT_LANES];
+		int m_constraintIndex[BT_SOA_CONTACT_LANES];  // -1 for empty lanes
+	};
+
+	btAlignedObjectArray<Block> m_contactBlocks;
+	btAlignedObjectArray<Block> m_frictionBlocks;  // the first friction direction of each row of m_contactBlocks
+	btAlignedObjectArray<btBatchedConstraints::Range> m_groups;        // each group is a range of blocks
+	btAlignedObjectArray<btBatchedConstraints::Range> m_groupBatches;  // the range of batches packed into each group
+	btAlignedObjectArray<btBatchedConstraints::Range> m_phases;        // each phase is a range of groups, indexed like btBatchedConstraints::m_phases
+	btAlignedObjectArray<char> m_phaseGrainSize;                 // max grain size for each phase, in groups
+	Kernel m_kernel;
+
+	btSoaContactConstraints() { m_kernel = KERNEL_NONE; }
+
+	///returns the fastest kernel the cpu supports
+	static Kernel getBestKernel();
+	///returns kernel, or the fastest supported kernel that is slower than it
+	static Kernel getSupportedKernel(Kernel kernel);
+
+	void setup(const btBatchedConstraints& batchedConstraints,
+			   const btConstraintArray& contactConstraints,
+			   const btConstraintArray& frictionConstraints,
+			   int numFrictionDirections,
+			   const btAlignedObjectArray<btSolverBody>& bodies,
+			   Kernel kernel);
+
+	///resolves the contact rows of groups [iBegin, iEnd), and writes the applied impulses through to contactConstraints
+	btScalar resolveContactGroups(int iBegin, int iEnd, btSolverBody* bodies, btSolverConstraint* contactConstraints);
+	///resolves the friction rows of groups [iBegin, iEnd), with limits from the applied impulses of the contact rows
+	btScalar resolveFrictionGroups(int iBegin, int iEnd, btSolverBody* bodies, btSolverConstraint* frictionConstraints);
+
+	void packGroups(int iBegin, int iEnd, const btBatchedConstraints& batchedConstraints, const btConstraintArray& contactConstraints, const btConstraintArray& frictionConstraints, int numFrictionDirections, const btAlignedObjectArray<btSolverBody>& bodies);
+};
+
+#endif  //BT_SOA_CONTACT_CONSTRAINTS_H
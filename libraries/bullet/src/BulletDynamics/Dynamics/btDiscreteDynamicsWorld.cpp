@@ -23,6 +23,7 @@ subject to the following restrictions:
 #include "BulletCollision/CollisionDispatch/btSimulationIslandManager.h"
 #include "LinearMath/btTransformUtil.h"
 #include "LinearMath/btQuickprof.h"
+#include "LinearMath/btAllocationTracker.h"
 
 //rigidbody & constraints
 #include "BulletDynamics/Dynamics/btRigidBody.h"
@@ -39,6 +40,9 @@ subject to the following restrictions:
 
 #include "LinearMath/btIDebugDraw.h"
 #include "BulletCollision/CollisionShapes/btSphereShape.h"
+#include "BulletCollision/NarrowPhaseCollision/btContinuousConvexCollision.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h"
 
 #include "BulletDynamics/Dynamics/btActionInterface.h"
 #include "LinearMath/btQuickprof.h"
@@ -199,7 +203,8 @@ btDiscreteDynamicsWorld::btDiscreteDynamicsWorld(btDispatcher* dispatcher, btBro
 	  m_synchronizeAllMotionStates(false),
 	  m_applySpeculativeContactRestitution(false),
 	  m_profileTimings(0),
-	  m_latencyMotionStateInterpolation(true)
+	  m_latencyMotionStateInterpolation(true),
+	  m_useSweptPairCcd(false)
 
 {
 	if (!m_constraintSolver)
@@ -483,6 +488,11 @@ void btDiscreteDynamicsWorld::internalSingleStepSimulation(btScalar timeStep)
 
 	///integrate transforms
 
+	if (m_useSweptPairCcd)
+	{
+		computeSweptPairTimesOfImpact(timeStep);
+	}
+
 	integrateTransforms(timeStep);
 
 	///update vehicle simulation
@@ -681,6 +691,7 @@ void btDiscreteDynamicsWorld::removeCharacter(btActionInterface* character)
 void btDiscreteDynamicsWorld::solveConstraints(btContactSolverInfo& solverInfo)
 {
 	BT_PROFILE("solveConstraints");
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SOLVER);
 
 	m_sortedConstraints.resize(m_constraints.size());
 	int i;
@@ -860,7 +871,7 @@ void btDiscreteDynamicsWorld::createPredictiveContactsInternal(btRigidBody** bod
 
 			btScalar squareMotion = (predictedTrans.getOrigin() - body->getWorldTransform().getOrigin()).length2();
 
-			if (getDispatchInfo().m_useContinuous && body->getCcdSquareMotionThreshold() && body->getCcdSquareMotionThreshold() < squareMotion)
+			if (!m_useSweptPairCcd && getDispatchInfo().m_useContinuous && body->getCcdSquareMotionThreshold() && body->getCcdSquareMotionThreshold() < squareMotion)
 			{
 				BT_PROFILE("predictive convexSweepTest");
 				if (body->getCollisionShape()->isConvex())
@@ -948,12 +959,176 @@ void btDiscreteDynamicsWorld::createPredictiveContacts(btScalar timeStep)
 	}
 }
 
+bool btDiscreteDynamicsWorld::isSweptPairCcdMover(const btCollisionObject* colObj, btScalar timeStep) const
+{
+	const btRigidBody* body = btRigidBody::upcast(colObj);
+	if (!body || !body->isActive() || body->isStaticOrKinematicObject() || !body->getCcdSquareMotionThreshold())
+		return false;
+	btTransform predictedTrans;
+	btTransformUtil::integrateTransform(body->getWorldTransform(), body->getLinearVelocity(), body->getAngularVelocity(), timeStep, predictedTrans);
+	btScalar squareMotion = (predictedTrans.getOrigin() - body->getWorldTransform().getOrigin()).length2();
+	return body->getCcdSquareMotionThreshold() < squareMotion;
+}
+
+static void btSweptPairCcdTargetTransform(const btCollisionObject* colObj, btScalar timeStep, btTransform& predictedTrans)
+{
+	const btRigidBody* body = btRigidBody::upcast(colObj);
+	if (body && body->isActive() && !body->isStaticOrKinematicObject())
+		btTransformUtil::integrateTransform(body->getWorldTransform(), body->getLinearVelocity(), body->getAngularVelocity(), timeStep, predictedTrans);
+	else
+		predictedTrans = colObj->getWorldTransform();
+}
+
+struct btSweptPairCcdAabbCallback : public btBroadphaseAabbCallback
+{
+	btAlignedObjectArray<btCollisionObject*> m_objects;
+
+	virtual bool process(const btBroadphaseProxy* proxy)
+	{
+		m_objects.push_back((btCollisionObject*)proxy->m_clientObject);
+		return true;
+	}
+};
+
+static bool btSweptPairCcdNeedsPair(btOverlappingPairCache* pairCache, btDispatcher* dispatcher, btCollisionObject* colObj0, btCollisionObject* colObj1)
+{
+	if (!colObj0->getCollisionShape()->isConvex() || !colObj1->getCollisionShape()->isConvex())
+		return false;
+	if (!colObj0->hasContactResponse() || !colObj1->hasContactResponse())
+		return false;
+	return pairCache->needsBroadphaseCollision(colObj0->getBroadphaseHandle(), colObj1->getBroadphaseHandle()) && dispatcher->needsCollision(colObj0, colObj1);
+}
+
+void btDiscreteDynamicsWorld::findSweptPairCcdPairs(btScalar timeStep)
+{
+	m_sweptPairCcdPairs.resize(0);
+	for (int i = 0; i < m_nonStaticRigidBodies.size(); i++)
+	{
+		m_nonStaticRigidBodies[i]->setHitFraction(1.f);
+	}
+	if (!getDispatchInfo().m_useContinuous)
+		return;
+
+	//the AABBs in the broadphase were swept with the velocities from before the solver, which can speed a body up,
+	//so the AABB of each fast body is swept again with its velocity after the solver
+	m_sweptPairCcdMovers.resize(0);
+	m_sweptPairCcdMoverAabbs.resize(0);
+	for (int i = 0; i < m_nonStaticRigidBodies.size(); i++)
+	{
+		btRigidBody* body = m_nonStaticRigidBodies[i];
+		if (!isSweptPairCcdMover(body, timeStep))
+			continue;
+		btTransform predictedTrans;
+		btSweptPairCcdTargetTransform(body, timeStep, predictedTrans);
+		btVector3 aabbMin, aabbMax, predictedMin, predictedMax;
+		body->getCollisionShape()->getAabb(body->getWorldTransform(), aabbMin, aabbMax);
+		body->getCollisionShape()->getAabb(predictedTrans, predictedMin, predictedMax);
+		aabbMin.setMin(predictedMin);
+		aabbMax.setMax(predictedMax);
+		m_sweptPairCcdMovers.push_back(body);
+		m_sweptPairCcdMoverAabbs.push_back(aabbMin);
+		m_sweptPairCcdMoverAabbs.push_back(aabbMax);
+	}
+
+	btOverlappingPairCache* pairCache = getBroadphase()->getOverlappingPairCache();
+	btSweptPairCcdAabbCallback callback;
+	for (int i = 0; i < m_sweptPairCcdMovers.size(); i++)
+	{
+		btCollisionObject* mover = m_sweptPairCcdMovers[i];
+		const btVector3& aabbMin = m_sweptPairCcdMoverAabbs[2 * i];
+		const btVector3& aabbMax = m_sweptPairCcdMoverAabbs[2 * i + 1];
+
+		//the objects that don't move fast stay in their broadphase AABBs during the step
+		callback.m_objects.resize(0);
+		getBroadphase()->aabbTest(aabbMin, aabbMax, callback);
+		for (int j = 0; j < callback.m_objects.size(); j++)
+		{
+			btCollisionObject* other = callback.m_objects[j];
+			if (other != mover && !isSweptPairCcdMover(other, timeStep) && btSweptPairCcdNeedsPair(pairCache, m_dispatcher1, mover, other))
+			{
+				m_sweptPairCcdPairs.push_back(btBroadphasePair(*mover->getBroadphaseHandle(), *other->getBroadphaseHandle()));
+			}
+		}
+
+		//two fast bodies can both leave their broadphase AABBs, so their swept AABBs are tested against each other
+		for (int j = i + 1; j < m_sweptPairCcdMovers.size(); j++)
+		{
+			btCollisionObject* other = m_sweptPairCcdMovers[j];
+			if (TestAabbAgainstAabb2(aabbMin, aabbMax, m_sweptPairCcdMoverAabbs[2 * j], m_sweptPairCcdMoverAabbs[2 * j + 1]) && btSweptPairCcdNeedsPair(pairCache, m_dispatcher1, mover, other))
+			{
+				m_sweptPairCcdPairs.push_back(btBroadphasePair(*mover->getBroadphaseHandle(), *other->getBroadphaseHandle()));
+			}
+		}
+	}
+	m_sweptPairCcdFractions.resize(m_sweptPairCcdPairs.size());
+}
+
+void btDiscreteDynamicsWorld::computeSweptPairTimesOfImpactInternal(int iBegin, int iEnd, btScalar timeStep)
+{
+	btVoronoiSimplexSolver simplexSolver;
+	btGjkEpaPenetrationDepthSolver penetrationDepthSolver;
+	for (int i = iBegin; i < iEnd; i++)
+	{
+		const btBroadphasePair& pair = m_sweptPairCcdPairs[i];
+		const btCollisionObject* colObj0 = (const btCollisionObject*)pair.m_pProxy0->m_clientObject;
+		const btCollisionObject* colObj1 = (const btCollisionObject*)pair.m_pProxy1->m_clientObject;
+		btTransform predictedTrans0, predictedTrans1;
+		btSweptPairCcdTargetTransform(colObj0, timeStep, predictedTrans0);
+		btSweptPairCcdTargetTransform(colObj1, timeStep, predictedTrans1);
+
+		//conservative advancement
+		btContinuousConvexCollision convexCast((const btConvexShape*)colObj0->getCollisionShape(), (const btConvexShape*)colObj1->getCollisionShape(), &simplexSolver, &penetrationDepthSolver);
+		btConvexCast::CastResult result;
+		result.m_allowedPenetration = getDispatchInfo().m_allowedCcdPenetration;
+		m_sweptPairCcdFractions[i] = btScalar(1.);
+		if (convexCast.calcTimeOfImpact(colObj0->getWorldTransform(), predictedTrans0, colObj1->getWorldTransform(), predictedTrans1, result))
+		{
+			//pairs that already touch at the start of the step are left to the contact solver
+			if (result.m_fraction > btScalar(0.) && result.m_fraction < btScalar(1.))
+				m_sweptPairCcdFractions[i] = result.m_fraction;
+		}
+	}
+}
+
+void btDiscreteDynamicsWorld::clampSweptPairCcdMotion(btScalar timeStep)
+{
+	for (int i = 0; i < m_sweptPairCcdPairs.size(); i++)
+	{
+		btScalar fraction = m_sweptPairCcdFractions[i];
+		if (fraction >= btScalar(1.))
+			continue;
+		btCollisionObject* colObj0 = (btCollisionObject*)m_sweptPairCcdPairs[i].m_pProxy0->m_clientObject;
+		btCollisionObject* colObj1 = (btCollisionObject*)m_sweptPairCcdPairs[i].m_pProxy1->m_clientObject;
+		if (isSweptPairCcdMover(colObj0, timeStep) && fraction < colObj0->getHitFraction())
+			colObj0->setHitFraction(fraction);
+		if (isSweptPairCcdMover(colObj1, timeStep) && fraction < colObj1->getHitFraction())
+			colObj1->setHitFraction(fraction);
+	}
+}
+
+void btDiscreteDynamicsWorld::computeSweptPairTimesOfImpact(btScalar timeStep)
+{
+	BT_PROFILE("computeSweptPairTimesOfImpact");
+	findSweptPairCcdPairs(timeStep);
+	computeSweptPairTimesOfImpactInternal(0, m_sweptPairCcdPairs.size(), timeStep);
+	clampSweptPairCcdMotion(timeStep);
+}
+
 void btDiscreteDynamicsWorld::integrateTransformsInternal(btRigidBody** bodies, int numBodies, btScalar timeStep)
 {
 	btTransform predictedTrans;
 	for (int i = 0; i < numBodies; i++)
 	{
 		btRigidBody* body = bodies[i];
+		//with swept pair CCD the time of impact of the body was found by computeSweptPairTimesOfImpact
+		if (m_useSweptPairCcd && body->isActive() && !body->isStaticOrKinematicObject() && body->getHitFraction() < btScalar(1.))
+		{
+			gNumClampedCcdMotions++;
+			body->predictIntegratedTransform(timeStep * body->getHitFraction(), predictedTrans);
+			body->setHitFraction(0.f);
+			body->proceedToTransform(predictedTrans);
+			continue;
+		}
 		body->setHitFraction(1.f);
 
 		if (body->isActive() && (!body->isStaticOrKinematicObject()))
@@ -962,7 +1137,7 @@ void btDiscreteDynamicsWorld::integrateTransformsInternal(btRigidBody** bodies,
 
 			btScalar squareMotion = (predictedTrans.getOrigin() - body->getWorldTransform().getOrigin()).length2();
 
-			if (getDispatchInfo().m_useContinuous && body->getCcdSquareMotionThreshold() && body->getCcdSquareMotionThreshold() < squareMotion)
+			if (!m_useSweptPairCcd && getDispatchInfo().m_useContinuous && body->getCcdSquareMotionThreshold() && body->getCcdSquareMotionThreshold() < squareMotion)
 			{
 				BT_PROFILE("CCD motion clamping");
 				if (body->getCollisionShape()->isConvex())
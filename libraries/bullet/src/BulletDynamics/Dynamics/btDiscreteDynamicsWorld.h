@@ -69,6 +69,12 @@ protected:
 	btAlignedObjectArray<btPersistentManifold*> m_predictiveManifolds;
 	btSpinMutex m_predictiveManifoldsMutex;  // used to synchronize threads creating predictive contacts
 
+	bool m_useSweptPairCcd;
+	btAlignedObjectArray<btBroadphasePair> m_sweptPairCcdPairs;
+	btAlignedObjectArray<btCollisionObject*> m_sweptPairCcdMovers;
+	btAlignedObjectArray<btVector3> m_sweptPairCcdMoverAabbs;  // the min and max of the AABB of each mover, swept over the step
+	btAlignedObjectArray<btScalar> m_sweptPairCcdFractions;
+
 	virtual void predictUnconstraintMotion(btScalar timeStep);
 
 	void integrateTransformsInternal(btRigidBody * *bodies, int numBodies, btScalar timeStep);  // can be called in parallel
@@ -92,6 +98,12 @@ protected:
 
 	virtual void saveKinematicState(btScalar timeStep);
 
+	bool isSweptPairCcdMover(const btCollisionObject* colObj, btScalar timeStep) const;
+	void findSweptPairCcdPairs(btScalar timeStep);
+	void computeSweptPairTimesOfImpactInternal(int iBegin, int iEnd, btScalar timeStep);  // can be called in parallel
+	void clampSweptPairCcdMotion(btScalar timeStep);
+	virtual void computeSweptPairTimesOfImpact(btScalar timeStep);
+
 	void serializeRigidBodies(btSerializer * serializer);
 
 	void serializeDynamicsWorldInfo(btSerializer * serializer);
@@ -216,6 +228,27 @@ public:
 		return m_applySpeculativeContactRestitution;
 	}
 
+	///Swept pair CCD replaces the convexSweepTest of each fast body (above its CCD motion threshold) by a conservative advancement
+	///of the pairs that contain a fast body. After the solver, the AABB of each fast body is swept with its new velocity and the
+	///broadphase is queried with it, and the swept AABBs of the fast bodies are tested against each other (see btDispatcherInfo::m_useContinuous).
+	///The motion of a fast body is clamped to the earliest time of impact of its pairs, predictive contacts are not created for it.
+	///Only pairs of convex shapes are tested, the cost is one broadphase query per fast body and one time of impact per pair.
+	void setUseSweptPairCcd(bool useSweptPairCcd)
+	{
+		m_useSweptPairCcd = useSweptPairCcd;
+	}
+
+	bool getUseSweptPairCcd() const
+	{
+		return m_useSweptPairCcd;
+	}
+
+	///The number of pairs that were tested in the last step with swept pair CCD
+	int getNumSweptPairCcdQueries() const
+	{
+		return m_sweptPairCcdPairs.size();
+	}
+
 	///Preliminary serialization test for Bullet 2.76. Loading those files requires a separate parser (see Bullet/Demos/SerializeDemo)
 	virtual void serialize(btSerializer * serializer);
 
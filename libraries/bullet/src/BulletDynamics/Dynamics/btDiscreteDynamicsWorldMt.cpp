@@ -23,6 +23,7 @@ subject to the following restrictions:
 #include "btSimulationIslandManagerMt.h"
 #include "LinearMath/btTransformUtil.h"
 #include "LinearMath/btQuickprof.h"
+#include "LinearMath/btAllocationTracker.h"
 
 //rigidbody & constraints
 #include "BulletDynamics/Dynamics/btRigidBody.h"
@@ -173,6 +174,7 @@ btDiscreteDynamicsWorldMt::~btDiscreteDynamicsWorldMt()
 void btDiscreteDynamicsWorldMt::solveConstraints(btContactSolverInfo& solverInfo)
 {
 	BT_PROFILE("solveConstraints");
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SOLVER);
 
 	m_constraintSolver->prepareSolve(getCollisionWorld()->getNumCollisionObjects(), getCollisionWorld()->getDispatcher()->getNumManifolds());
 
@@ -251,6 +253,21 @@ void btDiscreteDynamicsWorldMt::integrateTransforms(btScalar timeStep)
 	}
 }
 
+void btDiscreteDynamicsWorldMt::computeSweptPairTimesOfImpact(btScalar timeStep)
+{
+	BT_PROFILE("computeSweptPairTimesOfImpact");
+	findSweptPairCcdPairs(timeStep);
+	if (m_sweptPairCcdPairs.size() > 0)
+	{
+		UpdaterSweptPairTimesOfImpact update;
+		update.world = this;
+		update.timeStep = timeStep;
+		int grainSize = 16;  // num of iterations per task for task scheduler
+		btParallelFor(0, m_sweptPairCcdPairs.size(), grainSize, update);
+	}
+	clampSweptPairCcdMotion(timeStep);
+}
+
 int btDiscreteDynamicsWorldMt::stepSimulation(btScalar timeStep, int maxSubSteps, btScalar fixedTimeStep)
 {
 	int numSubSteps = btDiscreteDynamicsWorld::stepSimulation(timeStep, maxSubSteps, fixedTimeStep);
@@ -74,10 +74,11 @@ private:
 ///                              solving simulation islands on multiple threads.
 ///
 ///  Should function exactly like btDiscreteDynamicsWorld.
-///  Also 3 methods that iterate over all of the rigidbodies can run in parallel:
+///  Also 4 methods that iterate over all of the rigidbodies or overlapping pairs can run in parallel:
 ///     - predictUnconstraintMotion
 ///     - integrateTransforms
 ///     - createPredictiveContacts
+///     - computeSweptPairTimesOfImpact
 ///
 ATTRIBUTE_ALIGNED16(class)
 btDiscreteDynamicsWorldMt : public btDiscreteDynamicsWorld
@@ -115,6 +116,18 @@ protected:
 	};
 	virtual void integrateTransforms(btScalar timeStep) BT_OVERRIDE;
 
+	struct UpdaterSweptPairTimesOfImpact : public btIParallelForBody
+	{
+		btScalar timeStep;
+		btDiscreteDynamicsWorldMt* world;
+
+		void forLoop(int iBegin, int iEnd) const BT_OVERRIDE
+		{
+			world->computeSweptPairTimesOfImpactInternal(iBegin, iEnd, timeStep);
+		}
+	};
+	virtual void computeSweptPairTimesOfImpact(btScalar timeStep) BT_OVERRIDE;
+
 public:
 	BT_DECLARE_ALIGNED_ALLOCATOR();
 
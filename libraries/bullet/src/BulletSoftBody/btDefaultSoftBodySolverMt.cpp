@@ -0,0 +1,252 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose, 
+including commercial applications, and to alter it and redistribute it freely, 
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "btDefaultSoftBodySolverMt.h"
+#include "btSoftBodyInternals.h"
+
+struct SoftBodyPredictMotionLoop : public btIParallelForBody
+{
+	btSoftBody* const* m_softBodies;
+	btScalar m_timeStep;
+
+	void forLoop(int iBegin, int iEnd) const
+	{
+		for (int i = iBegin; i < iEnd; ++i)
+		{
+			btSoftBody* psb = m_softBodies[i];
+			if (psb->isActive())
+			{
+				psb->predictMotion(m_timeStep);
+				psb->batchLinks();
+			}
+		}
+	}
+};
+
+struct SoftBodySolveConstraintsLoop : public btIParallelForBody
+{
+	btSoftBody* const* m_softBodies;
+	const int* m_groupBodies;
+	const int* m_groupOffsets;
+
+	void forLoop(int iBegin, int iEnd) const
+	{
+		for (int i = iBegin; i < iEnd; ++i)
+		{
+			for (int j = m_groupOffsets[i]; j < m_groupOffsets[i + 1]; ++j)
+			{
+				m_softBodies[m_groupBodies[j]]->solveConstraints();
+			}
+		}
+	}
+};
+
+struct SoftBodyIntegrateMotionLoop : public btIParallelForBody
+{
+	btSoftBody* const* m_softBodies;
+
+	void forLoop(int iBegin, int iEnd) const
+	{
+		for (int i = iBegin; i < iEnd; ++i)
+		{
+			btSoftBody* psb = m_softBodies[i];
+			if (psb->isActive())
+			{
+				psb->integrateMotion();
+			}
+		}
+	}
+};
+
+btDefaultSoftBodySolverMt::btDefaultSoftBodySolverMt(int grainSize)
+{
+	m_grainSize = grainSize;  // soft bodies per task
+}
+
+void btDefaultSoftBodySolverMt::predictMotion(btScalar timeStep)
+{
+	if (m_softBodySet.size() == 0)
+	{
+		return;
+	}
+	SoftBodyPredictMotionLoop loop;
+	loop.m_softBodies = &m_softBodySet[0];
+	loop.m_timeStep = timeStep;
+	btParallelForIfScheduled(0, m_softBodySet.size(), m_grainSize, loop);
+}
+
+void btDefaultSoftBodySolverMt::solveConstraints(btScalar solverdt)
+{
+	groupSoftBodies();
+	if (m_groupBodies.size() == 0)
+	{
+		return;
+	}
+	SoftBodySolveConstraintsLoop loop;
+	loop.m_softBodies = &m_softBodySet[0];
+	loop.m_groupBodies = &m_groupBodies[0];
+	loop.m_groupOffsets = &m_groupOffsets[0];
+	btParallelForIfScheduled(0, m_groupOffsets.size() - 1, m_grainSize, loop);
+}
+
+void btDefaultSoftBodySolverMt::updateSoftBodies()
+{
+	if (m_softBodySet.size() == 0)
+	{
+		return;
+	}
+	SoftBodyIntegrateMotionLoop loop;
+	loop.m_softBodies = &m_softBodySet[0];
+	btParallelForIfScheduled(0, m_softBodySet.size(), m_grainSize, loop);
+}
+
+int btDefaultSoftBodySolverMt::findGroup(int softBody)
+{
+	while (m_groupParents[softBody] != softBody)
+	{
+		m_groupParents[softBody] = m_groupParents[m_groupParents[softBody]];
+		softBody = m_groupParents[softBody];
+	}
+	return softBody;
+}
+
+void btDefaultSoftBodySolverMt::joinGroups(int softBody0, int softBody1)
+{
+	int a = findGroup(softBody0);
+	int b = findGroup(softBody1);
+	//the root is always the first soft body of the group
+	if (a < b)
+		m_groupParents[b] = a;
+	else
+		m_groupParents[a] = b;
+}
+
+void btDefaultSoftBodySolverMt::joinObject(int softBody, const void* object)
+{
+	const int* other = m_objectSoftBody.find(btHashPtr(object));
+	if (other == NULL)
+	{
+		m_objectSoftBody.insert(btHashPtr(object), softBody);
+	}
+	else
+	{
+		joinGroups(softBody, *other);
+	}
+}
+
+int btDefaultSoftBodySolverMt::findFaceOwner(const btSoftBody::Face* face, int hint) const
+{
+	//the contacts of a pair of soft bodies are next to each other, so the owner of the last face is tried first
+	for (int i = 0; i < m_softBodySet.size(); ++i)
+	{
+		const btSoftBody* psb = m_softBodySet[(hint + i) % m_softBodySet.size()];
+		if (psb->m_faces.size() && face >= &psb->m_faces[0] && face < &psb->m_faces[0] + psb->m_faces.size())
+		{
+			return (hint + i) % m_softBodySet.size();
+		}
+	}
+	return -1;
+}
+
+void btDefaultSoftBodySolverMt::groupSoftBodies()
+{
+	BT_PROFILE("groupSoftBodies");
+	const int numSoftBodies = m_softBodySet.size();
+	m_groupParents.resize(numSoftBodies);
+	for (int i = 0; i < numSoftBodies; ++i)
+	{
+		m_groupParents[i] = i;
+	}
+	m_objectSoftBody.clear();
+
+	//static and kinematic bodies are only read by the soft body solver, everything else it pushes is shared
+	for (int i = 0; i < numSoftBodies; ++i)
+	{
+		const btSoftBody* psb = m_softBodySet[i];
+		if (!psb->isActive())
+		{
+			continue;
+		}
+		for (int j = 0; j < psb->m_anchors.size(); ++j)
+		{
+			const btRigidBody* body = psb->m_anchors[j].m_body;
+			if (!body->isStaticOrKinematicObject())
+			{
+				joinObject(i, body);
+			}
+		}
+		for (int j = 0; j < psb->m_rcontacts.size(); ++j)
+		{
+			const btCollisionObject* colObj = psb->m_rcontacts[j].m_cti.m_colObj;
+			if (colObj->getInternalType() == btCollisionObject::CO_FEATHERSTONE_LINK)
+			{
+				const btMultiBodyLinkCollider* multibodyLinkCol = btMultiBodyLinkCollider::upcast(colObj);
+				if (multibodyLinkCol)
+				{
+					joinObject(i, multibodyLinkCol->m_multiBody);
+				}
+			}
+			else if (!colObj->isStaticOrKinematicObject())
+			{
+				joinObject(i, colObj);
+			}
+		}
+		int hint = i;
+		for (int j = 0; j < psb->m_scontacts.size(); ++j)
+		{
+			const int owner = findFaceOwner(psb->m_scontacts[j].m_face, hint);
+			if (owner >= 0)
+			{
+				joinGroups(i, owner);
+				hint = owner;
+			}
+		}
+	}
+
+	//the groups are ordered by their first soft body, and the soft bodies of a group keep their order
+	m_groupOffsets.resize(0);
+	m_groupBodies.resize(0);
+	btAlignedObjectArray<int> groupIndex;
+	btAlignedObjectArray<int> groupSize;
+	groupIndex.resize(numSoftBodies, -1);
+	for (int i = 0; i < numSoftBodies; ++i)
+	{
+		if (m_softBodySet[i]->isActive())
+		{
+			const int root = findGroup(i);
+			if (groupIndex[root] < 0)
+			{
+				groupIndex[root] = groupSize.size();
+				groupSize.push_back(0);
+			}
+			groupSize[groupIndex[root]]++;
+		}
+	}
+	m_groupOffsets.resize(groupSize.size() + 1);
+	m_groupOffsets[0] = 0;
+	for (int i = 0; i < groupSize.size(); ++i)
+	{
+		m_groupOffsets[i + 1] = m_groupOffsets[i] + groupSize[i];
+		groupSize[i] = m_groupOffsets[i];
+	}
+	m_groupBodies.resize(m_groupOffsets[groupSize.size()]);
+	for (int i = 0; i < numSoftBodies; ++i)
+	{
+		if (m_softBodySet[i]->isActive())
+		{
+			m_groupBodies[groupSize[groupIndex[findGroup(i)]]++] = i;
+		}
+	}
+}
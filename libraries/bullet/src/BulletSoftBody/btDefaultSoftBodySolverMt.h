@@ -0,0 +1,53 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose, 
+including commercial applications, and to alter it and redistribute it freely, 
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_SOFT_BODY_DEFAULT_SOLVER_MT_H
+#define BT_SOFT_BODY_DEFAULT_SOLVER_MT_H
+
+#include "btDefaultSoftBodySolver.h"
+#include "btSoftBody.h"
+#include "LinearMath/btHashMap.h"
+#include "LinearMath/btThreads.h"
+
+///The btDefaultSoftBodySolverMt steps the soft bodies in parallel with btParallelFor.
+///Soft bodies that push the same dynamic rigid body, multibody or soft body through their anchors and contacts are
+///grouped, and the groups are solved in parallel, each one in the order of the soft body array. Within a soft body the
+///links are solved batch by batch (see btSoftBody::batchLinks), so the results don't depend on the number of threads.
+class btDefaultSoftBodySolverMt : public btDefaultSoftBodySolver
+{
+public:
+	btDefaultSoftBodySolverMt(int grainSize = 1);
+
+	virtual void updateSoftBodies() BT_OVERRIDE;
+
+	virtual void solveConstraints(btScalar solverdt) BT_OVERRIDE;
+
+	virtual void predictMotion(btScalar solverdt) BT_OVERRIDE;
+
+protected:
+	void groupSoftBodies();
+	void joinGroups(int softBody0, int softBody1);
+	void joinObject(int softBody, const void* object);
+	int findGroup(int softBody);
+	int findFaceOwner(const btSoftBody::Face* face, int hint) const;
+
+	btAlignedObjectArray<int> m_groupParents;     // union-find forest over m_softBodySet
+	btAlignedObjectArray<int> m_groupBodies;      // active soft bodies sorted by group
+	btAlignedObjectArray<int> m_groupOffsets;     // group i is m_groupBodies[m_groupOffsets[i], m_groupOffsets[i + 1])
+	btHashMap<btHashPtr, int> m_objectSoftBody;  // the first soft body that pushes an object
+	int m_grainSize;
+};
+
+#endif  //BT_SOFT_BODY_DEFAULT_SOLVER_MT_H
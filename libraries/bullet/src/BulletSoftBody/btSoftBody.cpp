@@ -400,6 +400,7 @@ void btSoftBody::appendLink(int model, Material* mat)
 		l.m_material = mat ? mat : m_materials[0];
 	}
 	m_links.push_back(l);
+	clearLinkBatches();
 }
 
 //
@@ -1471,6 +1472,7 @@ int btSoftBody::generateBendingConstraints(int distance, Material* mat)
 //
 void btSoftBody::randomizeConstraints()
 {
+	clearLinkBatches();
 	unsigned long seed = 243703;
 #define NEXTRAND (seed = (1664525L * seed + 1013904223L) & 0xffffffff)
 	int i, ni;
@@ -1486,6 +1488,58 @@ void btSoftBody::randomizeConstraints()
 #undef NEXTRAND
 }
 
+//
+void btSoftBody::batchLinks()
+{
+	if (hasLinkBatches())
+	{
+		return;
+	}
+	BT_PROFILE("batchLinks");
+	m_linkBatches.resize(0);
+	m_linkBatchOffsets.resize(0);
+	m_linkBatchOffsets.push_back(0);
+	/* Every pass takes the remaining links, in order, that don't share a node with a link taken before in the pass	*/
+	btAlignedObjectArray<int> nodeBatch;
+	nodeBatch.resize(m_nodes.size(), -1);
+	btAlignedObjectArray<int> remaining;
+	btAlignedObjectArray<int> next;
+	remaining.resize(m_links.size());
+	for (int i = 0; i < remaining.size(); ++i)
+	{
+		remaining[i] = i;
+	}
+	for (int batch = 0; remaining.size() > 0; ++batch)
+	{
+		next.resize(0);
+		for (int i = 0; i < remaining.size(); ++i)
+		{
+			const Link& l = m_links[remaining[i]];
+			const int n0 = int(l.m_n[0] - &m_nodes[0]);
+			const int n1 = int(l.m_n[1] - &m_nodes[0]);
+			if (nodeBatch[n0] != batch && nodeBatch[n1] != batch)
+			{
+				nodeBatch[n0] = batch;
+				nodeBatch[n1] = batch;
+				m_linkBatches.push_back(remaining[i]);
+			}
+			else
+			{
+				next.push_back(remaining[i]);
+			}
+		}
+		m_linkBatchOffsets.push_back(m_linkBatches.size());
+		remaining.copyFromArray(next);
+	}
+}
+
+//
+void btSoftBody::clearLinkBatches()
+{
+	m_linkBatches.resize(0);
+	m_linkBatchOffsets.resize(0);
+}
+
 void btSoftBody::updateState(const btAlignedObjectArray<btVector3>& q, const btAlignedObjectArray<btVector3>& v)
 {
 	int node_count = m_nodes.size();
@@ -1718,6 +1772,7 @@ void btSoftBody::refine(ImplicitFn* ifn, btScalar accurary, bool cut)
 	btSymMatrix<int> edges(ncount, -2);
 	int newnodes = 0;
 	int i, j, k, ni;
+	clearLinkBatches();
 
 	/* Filter out		*/
 	for (i = 0; i < m_links.size(); ++i)
@@ -1985,6 +2040,7 @@ bool btSoftBody::cutLink(int node0, int node1, btScalar position)
 {
 	bool done = false;
 	int i, ni;
+	clearLinkBatches();
 	//	const btVector3	d=m_nodes[node0].m_x-m_nodes[node1].m_x;
 	const btVector3 x = Lerp(m_nodes[node0].m_x, m_nodes[node1].m_x, position);
 	const btVector3 v = Lerp(m_nodes[node0].m_v, m_nodes[node1].m_v, position);
@@ -4000,26 +4056,78 @@ void btSoftBody::PSolve_SContacts(btSoftBody* psb, btScalar, btScalar ti)
 	}
 }
 
+//
+static SIMD_FORCE_INLINE void PSolve_Link(btSoftBody::Link& l, btScalar kst)
+{
+	if (l.m_c0 > 0)
+	{
+		btSoftBody::Node& a = *l.m_n[0];
+		btSoftBody::Node& b = *l.m_n[1];
+		const btVector3 del = b.m_x - a.m_x;
+		const btScalar len = del.length2();
+		if (l.m_c1 + len > SIMD_EPSILON)
+		{
+			const btScalar k = ((l.m_c1 - len) / (l.m_c0 * (l.m_c1 + len))) * kst;
+			a.m_x -= del * (k * a.m_im);
+			b.m_x += del * (k * b.m_im);
+		}
+	}
+}
+
+//
+static SIMD_FORCE_INLINE void VSolve_Link(btSoftBody::Link& l, btScalar kst)
+{
+	btSoftBody::Node** n = l.m_n;
+	const btScalar j = -btDot(l.m_c3, n[0]->m_v - n[1]->m_v) * l.m_c2 * kst;
+	n[0]->m_v += l.m_c3 * (j * n[0]->m_im);
+	n[1]->m_v -= l.m_c3 * (j * n[1]->m_im);
+}
+
+//
+struct SolveLinkBatchLoop : public btIParallelForBody
+{
+	btSoftBody* m_psb;
+	btScalar m_kst;
+	bool m_velocities;
+
+	SolveLinkBatchLoop(btSoftBody* psb, btScalar kst, bool velocities) : m_psb(psb), m_kst(kst), m_velocities(velocities) {}
+
+	void forLoop(int iBegin, int iEnd) const
+	{
+		const int* links = &m_psb->m_linkBatches[0];
+		for (int i = iBegin; i < iEnd; ++i)
+		{
+			btSoftBody::Link& l = m_psb->m_links[links[i]];
+			if (m_velocities)
+				VSolve_Link(l, m_kst);
+			else
+				PSolve_Link(l, m_kst);
+		}
+	}
+};
+
+//
+static void SolveLinkBatches(btSoftBody* psb, btScalar kst, bool velocities)
+{
+	const SolveLinkBatchLoop loop(psb, kst, velocities);
+	for (int i = 1; i < psb->m_linkBatchOffsets.size(); ++i)
+	{
+		btParallelForIfScheduled(psb->m_linkBatchOffsets[i - 1], psb->m_linkBatchOffsets[i], 256, loop);
+	}
+}
+
 //
 void btSoftBody::PSolve_Links(btSoftBody* psb, btScalar kst, btScalar ti)
 {
 	BT_PROFILE("PSolve_Links");
+	if (psb->hasLinkBatches())
+	{
+		SolveLinkBatches(psb, kst, false);
+		return;
+	}
 	for (int i = 0, ni = psb->m_links.size(); i < ni; ++i)
 	{
-		Link& l = psb->m_links[i];
-		if (l.m_c0 > 0)
-		{
-			Node& a = *l.m_n[0];
-			Node& b = *l.m_n[1];
-			const btVector3 del = b.m_x - a.m_x;
-			const btScalar len = del.length2();
-			if (l.m_c1 + len > SIMD_EPSILON)
-			{
-				const btScalar k = ((l.m_c1 - len) / (l.m_c0 * (l.m_c1 + len))) * kst;
-				a.m_x -= del * (k * a.m_im);
-				b.m_x += del * (k * b.m_im);
-			}
-		}
+		PSolve_Link(psb->m_links[i], kst);
 	}
 }
 
@@ -4027,13 +4135,14 @@ void btSoftBody::PSolve_Links(btSoftBody* psb, btScalar kst, btScalar ti)
 void btSoftBody::VSolve_Links(btSoftBody* psb, btScalar kst)
 {
 	BT_PROFILE("VSolve_Links");
+	if (psb->hasLinkBatches())
+	{
+		SolveLinkBatches(psb, kst, true);
+		return;
+	}
 	for (int i = 0, ni = psb->m_links.size(); i < ni; ++i)
 	{
-		Link& l = psb->m_links[i];
-		Node** n = l.m_n;
-		const btScalar j = -btDot(l.m_c3, n[0]->m_v - n[1]->m_v) * l.m_c2 * kst;
-		n[0]->m_v += l.m_c3 * (j * n[0]->m_im);
-		n[1]->m_v -= l.m_c3 * (j * n[1]->m_im);
+		VSolve_Link(psb->m_links[i], kst);
 	}
 }
 
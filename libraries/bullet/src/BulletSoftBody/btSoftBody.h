@@ -816,6 +816,8 @@ public:
 	tNodeArray m_nodes;                // Nodes
 	tRenderNodeArray m_renderNodes;    // Render Nodes
 	tLinkArray m_links;                // Links
+	btAlignedObjectArray<int> m_linkBatches;       // Link indices sorted by batch, see batchLinks
+	btAlignedObjectArray<int> m_linkBatchOffsets;  // Batch i is m_linkBatches[m_linkBatchOffsets[i], m_linkBatchOffsets[i + 1])
 	tFaceArray m_faces;                // Faces
 	tRenderFaceArray m_renderFaces;    // Faces
 	tTetraArray m_tetras;              // Tetras
@@ -1058,6 +1060,16 @@ public:
 								   Material* mat = 0);
 	/* Randomize constraints to reduce solver bias							*/
 	void randomizeConstraints();
+	/* Sort the links into batches that share no node. The links of a batch	*/
+	/* are solved in parallel, and the batches one after another, in an		*/
+	/* order that doesn't depend on the number of threads. Changing the		*/
+	/* links drops the batches, and they are solved in order again			*/
+	void batchLinks();
+	void clearLinkBatches();
+	bool hasLinkBatches() const
+	{
+		return m_linkBatchOffsets.size() > 1 && m_linkBatches.size() == m_links.size();
+	}
 
 	void updateState(const btAlignedObjectArray<btVector3>& qs, const btAlignedObjectArray<btVector3>& vs);
 
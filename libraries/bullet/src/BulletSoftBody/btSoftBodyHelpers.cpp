@@ -550,6 +550,8 @@ void btSoftBodyHelpers::ReoptimizeLinkOrder(btSoftBody* psb /* This can be repla
 	LinkDepsPtr_t linkDep;
 	int readyListHead, readyListTail, linkNum, linkDepFrees, depLink;
 
+	psb->clearLinkBatches();
+
 	// Allocate temporary buffers
 	int* nodeWrittenAt = new int[nNodes + 1];  // What link calculation produced this node's current values?
 	int* linkDepA = new int[nLinks];           // Link calculation input is dependent upon prior calculation #N
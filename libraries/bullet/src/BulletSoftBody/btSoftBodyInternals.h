@@ -19,6 +19,7 @@ subject to the following restrictions:
 
 #include "btSoftBody.h"
 #include "LinearMath/btQuickprof.h"
+#include "LinearMath/btThreads.h"
 #include "LinearMath/btPolarDecomposition.h"
 #include "BulletCollision/BroadphaseCollision/btBroadphaseInterface.h"
 #include "BulletCollision/CollisionDispatch/btCollisionDispatcher.h"
@@ -102,6 +102,12 @@ void btAlignedAllocSetCustomAligned(btAlignedAllocFunc *allocFunc, btAlignedFree
 	sAlignedFreeFunc = freeFunc ? freeFunc : btAlignedFreeDefault;
 }
 
+void btAlignedAllocGetCustomAligned(btAlignedAllocFunc **allocFunc, btAlignedFreeFunc **freeFunc)
+{
+	*allocFunc = sAlignedAllocFunc;
+	*freeFunc = sAlignedFreeFunc;
+}
+
 void btAlignedAllocSetCustom(btAllocFunc *allocFunc, btFreeFunc *freeFunc)
 {
 	sAllocFunc = allocFunc ? allocFunc : btAllocDefault;
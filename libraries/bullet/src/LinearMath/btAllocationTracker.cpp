@@ -0,0 +1,228 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#include "btAllocationTracker.h"
+#include "btMinMax.h"
+#include "btThreads.h"
+#include <string.h>
+
+//the header in front of each tracked allocation, it is at the end of the padding, right before the returned pointer
+struct btAllocationHeader
+{
+	size_t m_size;
+	int m_tag;
+	int m_offset;  // from the start of the allocation of the underlying allocator
+};
+
+#define BT_ALLOCATION_HEADER_SIZE 16
+
+//the counters of a tag, each with its own lock, so threads that allocate for different subsystems don't contend
+ATTRIBUTE_ALIGNED64(struct)
+btAllocationCounters
+{
+	btAllocationStats m_stats;
+	btSpinMutex m_mutex;
+};
+
+static btAllocationCounters sCounters[BT_MAX_ALLOCATION_TAGS];
+static btAllocationCounters sTotalCounters;
+static int sNumTicks = 0;
+
+static const char* sTagNames[BT_MAX_ALLOCATION_TAGS] = {"untagged", "broadphase", "narrowphase", "manifolds", "solver", "shapes", "user"};
+
+#if BT_THREADSAFE
+static int sCurrentTags[BT_MAX_THREAD_COUNT];
+#else
+static int sCurrentTag = BT_ALLOCATION_TAG_UNTAGGED;
+#endif
+
+static bool sInstalled = false;
+static btAlignedAllocFunc* sForwardAllocFunc = 0;
+static btAlignedFreeFunc* sForwardFreeFunc = 0;
+
+static void btAddAllocation(btAllocationCounters& counters, size_t size)
+{
+	btMutexLock(&counters.m_mutex);
+	btAllocationStats& stats = counters.m_stats;
+	stats.m_numAllocations++;
+	stats.m_bytesAllocated += size;
+	stats.m_bytesInUse += size;
+	stats.m_peakBytesInUse = btMax(stats.m_peakBytesInUse, stats.m_bytesInUse);
+	stats.m_numLiveAllocations++;
+	stats.m_numAllocationsThisTick++;
+	stats.m_bytesAllocatedThisTick += size;
+	btMutexUnlock(&counters.m_mutex);
+}
+
+static void btAddFree(btAllocationCounters& counters, size_t size)
+{
+	btMutexLock(&counters.m_mutex);
+	btAllocationStats& stats = counters.m_stats;
+	stats.m_numFrees++;
+	stats.m_bytesInUse -= size;
+	stats.m_numLiveAllocations--;
+	stats.m_numFreesThisTick++;
+	btMutexUnlock(&counters.m_mutex);
+}
+
+static void* btTrackedAlloc(size_t size, int alignment)
+{
+	int headerSize = btMax(alignment, BT_ALLOCATION_HEADER_SIZE);
+	char* real = (char*)sForwardAllocFunc(size + headerSize, alignment);
+	if (!real)
+	{
+		return 0;
+	}
+	int tag = btAllocationTrackerGetCurrentTag();
+	btAllocationHeader* header = (btAllocationHeader*)(real + headerSize) - 1;
+	header->m_size = size;
+	header->m_tag = tag;
+	header->m_offset = headerSize;
+	btAddAllocation(sCounters[tag], size);
+	btAddAllocation(sTotalCounters, size);
+	return real + headerSize;
+}
+
+static void btTrackedFree(void* ptr)
+{
+	if (!ptr)
+	{
+		return;
+	}
+	btAllocationHeader* header = (btAllocationHeader*)ptr - 1;
+	btAddFree(sCounters[header->m_tag], header->m_size);
+	btAddFree(sTotalCounters, header->m_size);
+	sForwardFreeFunc((char*)ptr - header->m_offset);
+}
+
+void btAllocationTrackerInstall()
+{
+	if (sInstalled)
+	{
+		return;
+	}
+	btAlignedAllocGetCustomAligned(&sForwardAllocFunc, &sForwardFreeFunc);
+	btAlignedAllocSetCustomAligned(btTrackedAlloc, btTrackedFree);
+	sInstalled = true;
+}
+
+void btAllocationTrackerUninstall()
+{
+	if (!sInstalled)
+	{
+		return;
+	}
+	btAlignedAllocSetCustomAligned(sForwardAllocFunc, sForwardFreeFunc);
+	sInstalled = false;
+}
+
+bool btAllocationTrackerIsInstalled()
+{
+	return sInstalled;
+}
+
+static void btTickCounters(btAllocationCounters& counters)
+{
+	btMutexLock(&counters.m_mutex);
+	btAllocationStats& stats = counters.m_stats;
+	stats.m_numAllocationsLastTick = stats.m_numAllocationsThisTick;
+	stats.m_numFreesLastTick = stats.m_numFreesThisTick;
+	stats.m_bytesAllocatedLastTick = stats.m_bytesAllocatedThisTick;
+	stats.m_numAllocationsThisTick = 0;
+	stats.m_numFreesThisTick = 0;
+	stats.m_bytesAllocatedThisTick = 0;
+	btMutexUnlock(&counters.m_mutex);
+}
+
+void btAllocationTrackerTick()
+{
+	for (int i = 0; i < BT_MAX_ALLOCATION_TAGS; i++)
+	{
+		btTickCounters(sCounters[i]);
+	}
+	btTickCounters(sTotalCounters);
+	sNumTicks++;
+}
+
+int btAllocationTrackerGetNumTicks()
+{
+	return sNumTicks;
+}
+
+void btAllocationTrackerGetStats(int tag, btAllocationStats& stats)
+{
+	btAssert(tag >= -1 && tag < BT_MAX_ALLOCATION_TAGS);
+	btAllocationCounters& counters = (tag < 0) ? sTotalCounters : sCounters[tag];
+	btMutexLock(&counters.m_mutex);
+	stats = counters.m_stats;
+	btMutexUnlock(&counters.m_mutex);
+}
+
+static void btResetCounters(btAllocationCounters& counters)
+{
+	btMutexLock(&counters.m_mutex);
+	btAllocationStats& stats = counters.m_stats;
+	size_t bytesInUse = stats.m_bytesInUse;
+	int numLiveAllocations = stats.m_numLiveAllocations;
+	memset(&stats, 0, sizeof(stats));
+	stats.m_bytesInUse = bytesInUse;
+	stats.m_peakBytesInUse = bytesInUse;
+	stats.m_numLiveAllocations = numLiveAllocations;
+	btMutexUnlock(&counters.m_mutex);
+}
+
+void btAllocationTrackerResetStats()
+{
+	for (int i = 0; i < BT_MAX_ALLOCATION_TAGS; i++)
+	{
+		btResetCounters(sCounters[i]);
+	}
+	btResetCounters(sTotalCounters);
+	sNumTicks = 0;
+}
+
+const char* btAllocationTrackerGetTagName(int tag)
+{
+	btAssert(tag >= 0 && tag < BT_MAX_ALLOCATION_TAGS);
+	return sTagNames[tag] ? sTagNames[tag] : "";
+}
+
+void btAllocationTrackerSetTagName(int tag, const char* name)
+{
+	btAssert(tag >= 0 && tag < BT_MAX_ALLOCATION_TAGS);
+	sTagNames[tag] = name;
+}
+
+int btAllocationTrackerSetCurrentTag(int tag)
+{
+	btAssert(tag >= 0 && tag < BT_MAX_ALLOCATION_TAGS);
+#if BT_THREADSAFE
+	int& currentTag = sCurrentTags[btGetCurrentThreadIndex()];
+#else
+	int& currentTag = sCurrentTag;
+#endif
+	int previousTag = currentTag;
+	currentTag = tag;
+	return previousTag;
+}
+
+int btAllocationTrackerGetCurrentTag()
+{
+#if BT_THREADSAFE
+	return sCurrentTags[btGetCurrentThreadIndex()];
+#else
+	return sCurrentTag;
+#endif
+}
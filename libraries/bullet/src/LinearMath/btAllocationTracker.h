@@ -0,0 +1,109 @@
+/*
+Bullet Continuous Collision Detection and Physics Library
+Copyright (c) 2003-2006 Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef BT_ALLOCATION_TRACKER_H
+#define BT_ALLOCATION_TRACKER_H
+
+#include "btAlignedAllocator.h"
+
+///The subsystems that allocations are attributed to. Applications can use the tags from BT_ALLOCATION_TAG_USER on.
+enum btAllocationTag
+{
+	BT_ALLOCATION_TAG_UNTAGGED = 0,
+	BT_ALLOCATION_TAG_BROADPHASE,
+	BT_ALLOCATION_TAG_NARROWPHASE,
+	BT_ALLOCATION_TAG_MANIFOLDS,
+	BT_ALLOCATION_TAG_SOLVER,
+	BT_ALLOCATION_TAG_SHAPES,
+	BT_ALLOCATION_TAG_USER,
+	BT_MAX_ALLOCATION_TAGS = 16
+};
+
+///Allocation statistics of one tag. A free counts for the tag of its allocation, whatever the current tag is.
+struct btAllocationStats
+{
+	unsigned long long int m_numAllocations;  // since btAllocationTrackerInstall or btAllocationTrackerResetStats
+	unsigned long long int m_numFrees;
+	unsigned long long int m_bytesAllocated;
+	size_t m_bytesInUse;      // bytes of the live allocations, also of the ones before the last reset
+	size_t m_peakBytesInUse;  // since the last reset
+	int m_numLiveAllocations;
+
+	//the allocations of the last complete tick, see btAllocationTrackerTick. Non zero counts in a steady state are churn.
+	int m_numAllocationsLastTick;
+	int m_numFreesLastTick;
+	size_t m_bytesAllocatedLastTick;
+
+	//the tick that is running
+	int m_numAllocationsThisTick;
+	int m_numFreesThisTick;
+	size_t m_bytesAllocatedThisTick;
+};
+
+///btAllocationTrackerInstall installs an aligned allocator that attributes each allocation to the current tag of the
+///allocating thread, see BT_ALLOCATION_TAG, and forwards it to the aligned allocator that was installed before.
+///It adds a small header to each allocation, so it has to be installed before Bullet allocates anything, and removed after
+///everything is freed, the same as btAlignedAllocSetCustomAligned. It doesn't see allocations with BT_DEBUG_MEMORY_ALLOCATIONS.
+void btAllocationTrackerInstall();
+void btAllocationTrackerUninstall();
+bool btAllocationTrackerIsInstalled();
+
+///btAllocationTrackerTick ends a tick, usually a simulation step or a frame: the counters of the tick become the last tick counters.
+void btAllocationTrackerTick();
+int btAllocationTrackerGetNumTicks();
+
+///Returns a copy of the statistics of a tag, or of all tags together for tag -1.
+void btAllocationTrackerGetStats(int tag, btAllocationStats& stats);
+///Clears the counters and peaks, but keeps the bytes in use, so frees of older allocations are still counted right.
+void btAllocationTrackerResetStats();
+
+const char* btAllocationTrackerGetTagName(int tag);
+///The name has to stay valid while the tracker is in use.
+void btAllocationTrackerSetTagName(int tag, const char* name);
+
+///Sets the current tag of the calling thread and returns the previous one. Tasks of btParallelFor don't inherit the tag of
+///the thread that started them, their allocations are untagged unless they set a tag themselves.
+int btAllocationTrackerSetCurrentTag(int tag);
+int btAllocationTrackerGetCurrentTag();
+
+///btAllocationTagScope sets the current tag of the thread for its scope, use the BT_ALLOCATION_TAG macro at the start of a scope.
+class btAllocationTagScope
+{
+	int m_previousTag;
+
+public:
+	btAllocationTagScope(int tag)
+	{
+		m_previousTag = btAllocationTrackerSetCurrentTag(tag);
+	}
+
+	~btAllocationTagScope()
+	{
+		btAllocationTrackerSetCurrentTag(m_previousTag);
+	}
+};
+
+///the scope variable is named after the line, so a scope can set more than one tag
+#define BT_ALLOCATION_TAG_CAT_I(a, b) a##b
+#define BT_ALLOCATION_TAG_CAT(a, b) BT_ALLOCATION_TAG_CAT_I(a, b)
+#define BT_ALLOCATION_TAG_NAME(line) BT_ALLOCATION_TAG_CAT(allocationTagScope, line)
+
+#ifdef BT_NO_ALLOCATION_TAGS
+#define BT_ALLOCATION_TAG(tag)
+#else
+#define BT_ALLOCATION_TAG(tag) btAllocationTagScope BT_ALLOCATION_TAG_NAME(__LINE__)(tag)
+#endif
+
+#endif  //BT_ALLOCATION_TRACKER_H
@@ -0,0 +1,126 @@
+/*
+Copyright (c) 2003-2006 Gino van den Bergen / Erwin Coumans  https://bulletphysics.org
+
+This software is provided 'as-is', without any express or implied warranty.
+In no event will the authors be held liable for any damages arising from the use of this software.
+Permission is granted to anyone to use this software for any purpose,
+including commercial applications, and to alter it and redistribute it freely,
+subject to the following restrictions:
+
+1. The origin of this software must not be misrepresented; you must not claim that you wrote the original software. If you use this software in a product, an acknowledgment in the product documentation would be appreciated but is not required.
+2. Altered source versions must be plainly marked as such, and must not be misrepresented as being the original software.
+3. This notice may not be removed or altered from any source distribution.
+*/
+
+#ifndef _BT_ARENA_ALLOCATOR_H
+#define _BT_ARENA_ALLOCATOR_H
+
+#include "btScalar.h"
+#include "btAlignedAllocator.h"
+#include "btMinMax.h"
+
+#define BT_ARENA_CACHE_LINE_SIZE 64
+
+///The btArenaAllocator hands out memory from large, cache line aligned slabs by bumping a pointer.
+///Single allocations are never freed: all memory is released at once by reset, clear or the destructor, in time proportional to the number of slabs.
+///Destructors of objects constructed in the arena are not run.
+class btArenaAllocator
+{
+	struct btArenaSlab
+	{
+		btArenaSlab* m_next;
+		int m_size;
+		int m_used;
+	};
+
+	btArenaSlab* m_slabs;
+	int m_slabSize;
+	int m_usedSize;
+
+	static int slabHeaderSize()
+	{
+		return (int(sizeof(btArenaSlab)) + BT_ARENA_CACHE_LINE_SIZE - 1) & ~(BT_ARENA_CACHE_LINE_SIZE - 1);
+	}
+
+	btArenaSlab* allocateSlab(int size)
+	{
+		btArenaSlab* slab = (btArenaSlab*)btAlignedAlloc(size, BT_ARENA_CACHE_LINE_SIZE);
+		slab->m_size = size;
+		slab->m_used = slabHeaderSize();
+		return slab;
+	}
+
+public:
+	btArenaAllocator(int slabSize = 64 * 1024)
+		: m_slabs(0),
+		  m_slabSize(slabSize),
+		  m_usedSize(0)
+	{
+	}
+
+	~btArenaAllocator()
+	{
+		clear();
+	}
+
+	///returns size bytes aligned to alignment, which must be a power of two not larger than the cache line size
+	void* allocate(int size, int alignment = 16)
+	{
+		btAssert(alignment > 0 && alignment <= BT_ARENA_CACHE_LINE_SIZE && (alignment & (alignment - 1)) == 0);
+		int offset = m_slabs ? (m_slabs->m_used + alignment - 1) & ~(alignment - 1) : 0;
+		if (!m_slabs || offset + size > m_slabs->m_size)
+		{
+			//oversized requests get a slab of their own
+			int slabSize = btMax(m_slabSize, slabHeaderSize() + size);
+			btArenaSlab* slab = allocateSlab(slabSize);
+			slab->m_next = m_slabs;
+			m_slabs = slab;
+			offset = slab->m_used;
+		}
+		m_slabs->m_used = offset + size;
+		m_usedSize += size;
+		return (char*)m_slabs + offset;
+	}
+
+	///releases all allocations, but keeps the most recent slab for reuse
+	void reset()
+	{
+		if (!m_slabs)
+			return;
+		btArenaSlab* slab = m_slabs->m_next;
+		while (slab)
+		{
+			btArenaSlab* next = slab->m_next;
+			btAlignedFree(slab);
+			slab = next;
+		}
+		m_slabs->m_next = 0;
+		m_slabs->m_used = slabHeaderSize();
+		m_usedSize = 0;
+	}
+
+	///releases all allocations and slabs
+	void clear()
+	{
+		while (m_slabs)
+		{
+			btArenaSlab* next = m_slabs->m_next;
+			btAlignedFree(m_slabs);
+			m_slabs = next;
+		}
+		m_usedSize = 0;
+	}
+
+	///number of bytes handed out since the last reset, without alignment padding
+	int getUsedSize() const
+	{
+		return m_usedSize;
+	}
+
+	int getSlabSize() const
+	{
+		return m_slabSize;
+	}
+};
+
+#endif  //_BT_ARENA_ALLOCATOR_H
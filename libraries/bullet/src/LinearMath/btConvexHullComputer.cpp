@@ -18,6 +18,7 @@ subject to the following restrictions:
 #include "btAlignedObjectArray.h"
 #include "btMinMax.h"
 #include "btVector3.h"
+#include "btThreads.h"
 
 #ifdef __GNUC__
 #include <stdint.h>
@@ -816,6 +817,34 @@ private:
 
 	void computeInternal(int start, int end, IntermediateHull& result);
 
+	void splitRange(int start, int end, int& split0, int& split1) const;
+
+	// a node of the top levels of the recursion of computeInternal, see computeParallel
+	class MergeNode
+	{
+	public:
+		int start;
+		int end;
+		int left;  // child nodes, -1 if the hull of the range is computed by computeInternal
+		int right;
+		btConvexHullInternal* context;
+		IntermediateHull hull;
+	};
+
+	class MergeNodeLoop : public btIParallelForBody
+	{
+	public:
+		btConvexHullInternal* owner;
+		MergeNode* nodes;
+		const int* nodeIndices;
+
+		void forLoop(int iBegin, int iEnd) const BT_OVERRIDE;
+	};
+
+	void computeParallel(int count, int numTasks, IntermediateHull& result);
+
+	btConvexHullInternal* newContext();
+
 	bool mergeProjection(IntermediateHull& h0, IntermediateHull& h1, Vertex*& c0, Vertex*& c1);
 
 	void merge(IntermediateHull& h0, IntermediateHull& h1);
@@ -829,11 +858,23 @@ private:
 public:
 	Vertex* vertexList;
 
-	void compute(const void* coords, bool doubleCoords, int stride, int count);
+	void compute(const void* coords, bool doubleCoords, int stride, int count, int numTasks);
 
 	btVector3 getCoordinates(const Vertex* v);
 
 	btScalar shrink(btScalar amount, btScalar clampAmount);
+
+	void getHullPointIndices(btAlignedObjectArray<int>& indices) const;
+
+	btConvexHullInternal() : vertexList(NULL)
+	{
+	}
+
+	~btConvexHullInternal();
+
+private:
+	// the merge contexts of computeParallel, they own the edges of the hull
+	btAlignedObjectArray<btConvexHullInternal*> contexts;
 };
 
 btConvexHullInternal::Int128 btConvexHullInternal::Int128::operator*(int64_t b) const
@@ -1309,13 +1350,8 @@ void btConvexHullInternal::computeInternal(int start, int end, IntermediateHull&
 		}
 	}
 
-	int split0 = start + n / 2;
-	Point32 p = originalVertices[split0 - 1]->point;
-	int split1 = split0;
-	while ((split1 < end) && (originalVertices[split1]->point == p))
-	{
-		split1++;
-	}
+	int split0, split1;
+	splitRange(start, end, split0, split1);
 	computeInternal(start, split0, result);
 	IntermediateHull hull1;
 	computeInternal(split1, end, hull1);
@@ -1331,6 +1367,170 @@ void btConvexHullInternal::computeInternal(int start, int end, IntermediateHull&
 #endif
 }
 
+void btConvexHullInternal::splitRange(int start, int end, int& split0, int& split1) const
+{
+	split0 = start + (end - start) / 2;
+	Point32 p = originalVertices[split0 - 1]->point;
+	split1 = split0;
+	while ((split1 < end) && (originalVertices[split1]->point == p))
+	{
+		split1++;
+	}
+}
+
+btConvexHullInternal* btConvexHullInternal::newContext()
+{
+	btConvexHullInternal* context = new (btAlignedAlloc(sizeof(btConvexHullInternal), 16)) btConvexHullInternal();
+	context->usedEdgePairs = 0;
+	context->maxUsedEdgePairs = 0;
+	context->mergeStamp = -3;
+	contexts.push_back(context);
+	return context;
+}
+
+btConvexHullInternal::~btConvexHullInternal()
+{
+	for (int i = 0; i < contexts.size(); i++)
+	{
+		contexts[i]->~btConvexHullInternal();
+		btAlignedFree(contexts[i]);
+	}
+}
+
+void btConvexHullInternal::MergeNodeLoop::forLoop(int iBegin, int iEnd) const
+{
+	for (int i = iBegin; i < iEnd; i++)
+	{
+		MergeNode& node = nodes[nodeIndices[i]];
+		btConvexHullInternal* context = node.context;
+		if (node.left < 0)
+		{
+			// the vertices of the range are contiguous in the vertex pool, like computeInternal expects
+			int n = node.end - node.start;
+			context->originalVertices.resize(n);
+			for (int j = 0; j < n; j++)
+			{
+				context->originalVertices[j] = owner->originalVertices[node.start + j];
+			}
+			context->edgePool.setArraySize(btMax(6 * n, 16));
+			context->computeInternal(0, n, node.hull);
+		}
+		else
+		{
+			node.hull = nodes[node.left].hull;
+			context->merge(node.hull, nodes[node.right].hull);
+		}
+	}
+}
+
+// smaller ranges are not worth a task
+#define BT_CONVEX_HULL_MIN_POINTS_PER_TASK 256
+
+// Computes the same hull as computeInternal(0, count, result): the top levels of its recursion are unrolled in to a tree of
+// about numTasks leaves, the hulls of the leaves are computed in parallel, and then the children of each level are merged
+// in parallel, from the bottom up. Each node has its own edge pool and merge stamps, so the tasks share no state. Merge stamps
+// only tell apart the edges of the current merge from older ones, so the stamps of a level start below all older stamps.
+void btConvexHullInternal::computeParallel(int count, int numTasks, IntermediateHull& result)
+{
+	int maxDepth = 0;
+	while (((1 << maxDepth) < numTasks) && ((count >> (maxDepth + 1)) >= BT_CONVEX_HULL_MIN_POINTS_PER_TASK))
+	{
+		maxDepth++;
+	}
+
+	btAlignedObjectArray<MergeNode> nodes;
+	btAlignedObjectArray<int> depths;
+	MergeNode root;
+	root.start = 0;
+	root.end = count;
+	root.left = -1;
+	root.right = -1;
+	nodes.push_back(root);
+	depths.push_back(0);
+	for (int i = 0; i < nodes.size(); i++)
+	{
+		int start = nodes[i].start;
+		int end = nodes[i].end;
+		// computeInternal splits ranges of more than 2 points
+		if ((depths[i] < maxDepth) && (end - start > 2))
+		{
+			int split0, split1;
+			splitRange(start, end, split0, split1);
+			MergeNode child;
+			child.left = -1;
+			child.right = -1;
+			child.start = start;
+			child.end = split0;
+			nodes[i].left = nodes.size();
+			nodes.push_back(child);
+			depths.push_back(depths[i] + 1);
+			child.start = split1;
+			child.end = end;
+			nodes[i].right = nodes.size();
+			nodes.push_back(child);
+			depths.push_back(depths[i] + 1);
+		}
+	}
+
+	btAlignedObjectArray<int> nodeIndices;
+	for (int i = 0; i < nodes.size(); i++)
+	{
+		nodes[i].context = newContext();
+		if (nodes[i].left < 0)
+		{
+			nodeIndices.push_back(i);
+		}
+	}
+
+	MergeNodeLoop loop;
+	loop.owner = this;
+	loop.nodes = &nodes[0];
+	for (int depth = maxDepth; depth >= 0; depth--)
+	{
+		if (depth < maxDepth)
+		{
+			int stamp = mergeStamp;
+			for (int i = 0; i < contexts.size(); i++)
+			{
+				stamp = btMin(stamp, contexts[i]->mergeStamp);
+			}
+			nodeIndices.resize(0);
+			for (int i = 0; i < nodes.size(); i++)
+			{
+				if ((depths[i] == depth) && (nodes[i].left >= 0))
+				{
+					nodes[i].context->mergeStamp = stamp;
+					nodeIndices.push_back(i);
+				}
+			}
+		}
+		if (nodeIndices.size())
+		{
+			loop.nodeIndices = &nodeIndices[0];
+			btParallelForIfScheduled(0, nodeIndices.size(), 1, loop);
+		}
+	}
+
+	for (int i = 0; i < contexts.size(); i++)
+	{
+		mergeStamp = btMin(mergeStamp, contexts[i]->mergeStamp);
+	}
+	result = nodes[0].hull;
+}
+
+void btConvexHullInternal::getHullPointIndices(btAlignedObjectArray<int>& indices) const
+{
+	indices.resize(0);
+	for (int i = 0; i < originalVertices.size(); i++)
+	{
+		const Vertex* v = originalVertices[i];
+		if (v->edges || (v == vertexList))
+		{
+			indices.push_back(v->point.index);
+		}
+	}
+}
+
 #ifdef DEBUG_CONVEX_HULL
 void btConvexHullInternal::IntermediateHull::print()
 {
@@ -1953,7 +2153,7 @@ public:
 	}
 };
 
-void btConvexHullInternal::compute(const void* coords, bool doubleCoords, int stride, int count)
+void btConvexHullInternal::compute(const void* coords, bool doubleCoords, int stride, int count, int numTasks)
 {
 	btVector3 min(btScalar(1e30), btScalar(1e30), btScalar(1e30)), max(btScalar(-1e30), btScalar(-1e30), btScalar(-1e30));
 	const char* ptr = (const char*)coords;
@@ -2067,7 +2267,14 @@ void btConvexHullInternal::compute(const void* coords, bool doubleCoords, int st
 	mergeStamp = -3;
 
 	IntermediateHull hull;
-	computeInternal(0, count, hull);
+	if (numTasks > 1)
+	{
+		computeParallel(count, numTasks, hull);
+	}
+	else
+	{
+		computeInternal(0, count, hull);
+	}
 	vertexList = hull.minXy;
 #ifdef DEBUG_CONVEX_HULL
 	printf("max. edges %d (3v = %d)", maxUsedEdgePairs, 3 * count);
@@ -2650,23 +2857,50 @@ static int getVertexCopy(btConvexHullInternal::Vertex* vertex, btAlignedObjectAr
 	return index;
 }
 
-btScalar btConvexHullComputer::compute(const void* coords, bool doubleCoords, int stride, int count, btScalar shrink, btScalar shrinkClamp)
+static btVector3 getInputPoint(const void* coords, bool doubleCoords, int stride, int index)
 {
+	const char* ptr = (const char*)coords + index * stride;
+	if (doubleCoords)
+	{
+		const double* v = (const double*)ptr;
+		return btVector3((btScalar)v[0], (btScalar)v[1], (btScalar)v[2]);
+	}
+	const float* v = (const float*)ptr;
+	return btVector3(v[0], v[1], v[2]);
+}
+
+btScalar btConvexHullComputer::compute(const void* coords, bool doubleCoords, int stride, int count, btScalar shrink, btScalar shrinkClamp, int numTasks)
+{
+	inputCount = btMax(count, 0);
+	shrinkAmount = shrink;
+	shrinkClampAmount = shrinkClamp;
+	hullPoints.resize(0);
+	hullPointIndices.resize(0);
+	shift = 0;
+
 	if (count <= 0)
 	{
 		vertices.clear();
+		original_vertex_index.clear();
 		edges.clear();
 		faces.clear();
 		return 0;
 	}
 
 	btConvexHullInternal hull;
-	hull.compute(coords, doubleCoords, stride, count);
+	hull.compute(coords, doubleCoords, stride, count, numTasks);
+
+	hull.getHullPointIndices(hullPointIndices);
+	hullPoints.resize(hullPointIndices.size());
+	for (int i = 0; i < hullPointIndices.size(); i++)
+	{
+		hullPoints[i] = getInputPoint(coords, doubleCoords, stride, hullPointIndices[i]);
+	}
 
-	btScalar shift = 0;
 	if ((shrink > 0) && ((shift = hull.shrink(shrink, shrinkClamp)) < 0))
 	{
 		vertices.clear();
+		original_vertex_index.clear();
 		edges.clear();
 		faces.clear();
 		return shift;
@@ -2758,3 +2992,112 @@ btScalar btConvexHullComputer::compute(const void* coords, bool doubleCoords, in
 
 	return shift;
 }
+
+btScalar btConvexHullComputer::addPoints(const void* coords, bool doubleCoords, int stride, int count)
+{
+	if (count <= 0)
+	{
+		return shift;
+	}
+	int firstIndex = inputCount;
+	inputCount += count;
+
+	// the planes of the faces, pointing away from the center, and the precision of the hull
+	btAlignedObjectArray<btVector4> planes;
+	btScalar tolerance = 0;
+	if (vertices.size() > 3)
+	{
+		btVector3 center(0, 0, 0);
+		btVector3 min = vertices[0];
+		btVector3 max = vertices[0];
+		for (int i = 0; i < vertices.size(); i++)
+		{
+			center += vertices[i];
+			min.setMin(vertices[i]);
+			max.setMax(vertices[i]);
+		}
+		center /= btScalar(vertices.size());
+		// the hull is computed on a grid of about 10^4 steps along the largest axis
+		tolerance = (max - min).length() * btScalar(1e-4);
+
+		planes.resize(faces.size());
+		for (int i = 0; i < faces.size(); i++)
+		{
+			// Newell's method, which is robust for n-gons
+			btVector3 normal(0, 0, 0);
+			btVector3 point(0, 0, 0);
+			int numPoints = 0;
+			const Edge* firstEdge = &edges[faces[i]];
+			const Edge* edge = firstEdge;
+			do
+			{
+				const btVector3& a = vertices[edge->getSourceVertex()];
+				const btVector3& b = vertices[edge->getTargetVertex()];
+				normal += a.cross(b);
+				point += a;
+				numPoints++;
+				edge = edge->getNextEdgeOfFace();
+			} while (edge != firstEdge);
+			normal.safeNormalize();
+			point /= btScalar(numPoints);
+			btScalar offset = normal.dot(point);
+			if (normal.dot(center) > offset)
+			{
+				normal = -normal;
+				offset = -offset;
+			}
+			planes[i].setValue(normal.x(), normal.y(), normal.z(), offset);
+		}
+	}
+
+	// without faces, the hull is flat and every point is outside
+	btAlignedObjectArray<int> outside;
+	for (int i = 0; i < count; i++)
+	{
+		btVector3 p = getInputPoint(coords, doubleCoords, stride, i);
+		bool inside = planes.size() > 0;
+		for (int j = 0; inside && (j < planes.size()); j++)
+		{
+			inside = planes[j].dot(p) - planes[j].w() <= tolerance;
+		}
+		if (!inside)
+		{
+			outside.push_back(i);
+		}
+	}
+	if (!outside.size())
+	{
+		return shift;
+	}
+
+	btAlignedObjectArray<btVector3> points;
+	btAlignedObjectArray<int> indices;
+	points.copyFromArray(hullPoints);
+	indices.copyFromArray(hullPointIndices);
+	for (int i = 0; i < outside.size(); i++)
+	{
+		points.push_back(getInputPoint(coords, doubleCoords, stride, outside[i]));
+		indices.push_back(firstIndex + outside[i]);
+	}
+
+	int numInputPoints = inputCount;
+#ifdef BT_USE_DOUBLE_PRECISION
+	btScalar result = compute(&points[0][0], true, sizeof(btVector3), points.size(), shrinkAmount, shrinkClampAmount, 1);
+#else
+	btScalar result = compute(&points[0][0], false, sizeof(btVector3), points.size(), shrinkAmount, shrinkClampAmount, 1);
+#endif
+	inputCount = numInputPoints;
+	for (int i = 0; i < original_vertex_index.size(); i++)
+	{
+		// vertices created by shrinking have no original index
+		if (original_vertex_index[i] >= 0)
+		{
+			original_vertex_index[i] = indices[original_vertex_index[i]];
+		}
+	}
+	for (int i = 0; i < hullPointIndices.size(); i++)
+	{
+		hullPointIndices[i] = indices[hullPointIndices[i]];
+	}
+	return result;
+}
@@ -24,7 +24,17 @@ subject to the following restrictions:
 class btConvexHullComputer
 {
 private:
-	btScalar compute(const void* coords, bool doubleCoords, int stride, int count, btScalar shrink, btScalar shrinkClamp);
+	// the input points that are vertices of the hull before shrinking, and their original indices, for addPoints
+	btAlignedObjectArray<btVector3> hullPoints;
+	btAlignedObjectArray<int> hullPointIndices;
+	int inputCount;
+	btScalar shrinkAmount;
+	btScalar shrinkClampAmount;
+	btScalar shift;
+
+	btScalar compute(const void* coords, bool doubleCoords, int stride, int count, btScalar shrink, btScalar shrinkClamp, int numTasks);
+
+	btScalar addPoints(const void* coords, bool doubleCoords, int stride, int count);
 
 public:
 	class Edge
@@ -75,6 +85,10 @@ public:
 	// Faces of the convex hull. Each entry is an index into the "edges" array pointing to an edge of the face. Faces are planar n-gons
 	btAlignedObjectArray<int> faces;
 
+	btConvexHullComputer() : inputCount(0), shrinkAmount(0), shrinkClampAmount(0), shift(0)
+	{
+	}
+
 	/*
 		Compute convex hull of "count" vertices stored in "coords". "stride" is the difference in bytes
 		between the addresses of consecutive vertices. If "shrink" is positive, the convex hull is shrunken
@@ -89,13 +103,50 @@ public:
 		*/
 	btScalar compute(const float* coords, int stride, int count, btScalar shrink, btScalar shrinkClamp)
 	{
-		return compute(coords, false, stride, count, shrink, shrinkClamp);
+		return compute(coords, false, stride, count, shrink, shrinkClamp, 1);
 	}
 
 	// same as above, but double precision
 	btScalar compute(const double* coords, int stride, int count, btScalar shrink, btScalar shrinkClamp)
 	{
-		return compute(coords, true, stride, count, shrink, shrinkClamp);
+		return compute(coords, true, stride, count, shrink, shrinkClamp, 1);
+	}
+
+	/*
+		Same as compute, but the sorted points are split into up to "numTasks" ranges, whose hulls are computed on
+		the threads of the task scheduler (see btParallelFor) and then merged, also in parallel where possible.
+		The ranges and the merges are the ones of the serial divide and conquer, so the output is identical to compute.
+		Ranges are kept above a few hundred points, so small inputs are computed by a single task.
+		*/
+	btScalar computeParallel(const float* coords, int stride, int count, btScalar shrink, btScalar shrinkClamp, int numTasks)
+	{
+		return compute(coords, false, stride, count, shrink, shrinkClamp, numTasks);
+	}
+
+	// same as above, but double precision
+	btScalar computeParallel(const double* coords, int stride, int count, btScalar shrink, btScalar shrinkClamp, int numTasks)
+	{
+		return compute(coords, true, stride, count, shrink, shrinkClamp, numTasks);
+	}
+
+	/*
+		Adds "count" points to the hull of the last call to compute. Points that are inside the hull, up to its precision,
+		are dropped without touching the hull. If any point is outside, the hull is rebuilt from the vertices it had
+		before shrinking and the points outside, and shrunken again with the shrink parameters of compute.
+		The indices in "original_vertex_index" keep counting from the points given to compute, so the first added point
+		has the index of the number of points passed so far.
+
+		Returns the same as compute.
+		*/
+	btScalar addPoints(const float* coords, int stride, int count)
+	{
+		return addPoints(coords, false, stride, count);
+	}
+
+	// same as above, but double precision
+	btScalar addPoints(const double* coords, int stride, int count)
+	{
+		return addPoints(coords, true, stride, count);
 	}
 };
 
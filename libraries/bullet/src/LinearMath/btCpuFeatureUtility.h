@@ -7,10 +7,10 @@
 #include <string.h>  //memset
 #ifdef USE_SIMD
 #include <emmintrin.h>
-#ifdef BT_ALLOW_SSE4
-#include <intrin.h>
-#endif  //BT_ALLOW_SSE4
 #endif  //USE_SIMD
+#if defined(BT_HAS_SSE2_INTRINSICS) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
 
 #if defined BT_USE_NEON
 #define ARM_NEON_GCC_COMPATIBILITY 1
@@ -19,8 +19,9 @@
 #include <sys/sysctl.h>  //for sysctlbyname
 #endif                   //BT_USE_NEON
 
-///Rudimentary btCpuFeatureUtility for CPU features: only report the features that Bullet actually uses (SSE4/FMA3, NEON_HPFP)
-///We assume SSE2 in case BT_USE_SSE2 is defined in LinearMath/btScalar.h
+///Rudimentary btCpuFeatureUtility for CPU features: only report the features that Bullet actually uses (SSE2/SSE4/FMA3/AVX2, NEON_HPFP)
+///The features are tested once, and kernels that are selected at runtime check them before they pick a wider instruction set
+///than the one the library was compiled for. See BT_HAS_SSE2_INTRINSICS and BT_AVX2_TARGET in LinearMath/btScalar.h
 class btCpuFeatureUtility
 {
 public:
@@ -28,7 +29,9 @@ public:
 	{
 		CPU_FEATURE_FMA3 = 1,
 		CPU_FEATURE_SSE4_1 = 2,
-		CPU_FEATURE_NEON_HPFP = 4
+		CPU_FEATURE_NEON_HPFP = 4,
+		CPU_FEATURE_SSE2 = 8,
+		CPU_FEATURE_AVX2 = 16
 	};
 
 	static int getCpuFeatures()
@@ -50,11 +53,26 @@ public:
 		}
 #endif  //BT_USE_NEON
 
-#ifdef BT_ALLOW_SSE4
+#if defined(BT_HAS_SSE2_INTRINSICS) && defined(__GNUC__)
+		{
+			__builtin_cpu_init();
+			if (__builtin_cpu_supports("sse2"))
+				capabilities |= btCpuFeatureUtility::CPU_FEATURE_SSE2;
+			if (__builtin_cpu_supports("sse4.1"))
+				capabilities |= btCpuFeatureUtility::CPU_FEATURE_SSE4_1;
+			//the builtins also check that the os saves the ymm registers
+			if (__builtin_cpu_supports("fma"))
+				capabilities |= btCpuFeatureUtility::CPU_FEATURE_FMA3;
+			if (__builtin_cpu_supports("avx2"))
+				capabilities |= btCpuFeatureUtility::CPU_FEATURE_AVX2;
+		}
+#elif defined(BT_HAS_SSE2_INTRINSICS) && defined(_MSC_VER)
 		{
 			int cpuInfo[4];
 			memset(cpuInfo, 0, sizeof(cpuInfo));
 			unsigned long long sseExt = 0;
+			__cpuid(cpuInfo, 0);
+			int maxLeaf = cpuInfo[0];
 			__cpuid(cpuInfo, 1);
 
 			bool osUsesXSAVE_XRSTORE = cpuInfo[2] & (1 << 27) || false;
@@ -77,8 +95,24 @@ public:
 			{
 				capabilities |= btCpuFeatureUtility::CPU_FEATURE_SSE4_1;
 			}
+
+			const int SSE2Flag = (1 << 26);
+			if (cpuInfo[3] & SSE2Flag)
+			{
+				capabilities |= btCpuFeatureUtility::CPU_FEATURE_SSE2;
+			}
+
+			if (maxLeaf >= 7 && (cpuInfo[2] & AVXFlag) == AVXFlag && (sseExt & 6) == 6)
+			{
+				__cpuidex(cpuInfo, 7, 0);
+				const int AVX2Flag = (1 << 5);
+				if (cpuInfo[1] & AVX2Flag)
+				{
+					capabilities |= btCpuFeatureUtility::CPU_FEATURE_AVX2;
+				}
+			}
 		}
-#endif  //BT_ALLOW_SSE4
+#endif  //BT_HAS_SSE2_INTRINSICS
 
 		testedCapabilities = true;
 		return capabilities;
@@ -422,6 +422,20 @@ inline int btIsDoublePrecision()
 		(float32x4_t) { r0, r1, r2, r3 }
 #endif//BT_USE_NEON
 
+///BT_HAS_SSE2_INTRINSICS is defined when the compiler targets an x86 cpu with SSE2, which every x86-64 cpu has, also when BT_USE_SSE is not defined.
+///Kernels for wider instruction sets are compiled with BT_AVX2_TARGET, and are only called when btCpuFeatureUtility reports the feature at runtime.
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))
+	#define BT_HAS_SSE2_INTRINSICS
+	#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+		#define BT_HAS_AVX2_INTRINSICS
+		//avx2 without fma, so the kernels round exactly like their scalar and sse2 versions
+		#define BT_AVX2_TARGET __attribute__((target("avx2")))
+	#elif defined(_MSC_VER) && (_MSC_VER >= 1700)
+		#define BT_HAS_AVX2_INTRINSICS
+		#define BT_AVX2_TARGET
+	#endif
+#endif
+
 #define BT_DECLARE_ALIGNED_ALLOCATOR()                                                                     \
 	SIMD_FORCE_INLINE void *operator new(size_t sizeInBytes) { return btAlignedAlloc(sizeInBytes, 16); }   \
 	SIMD_FORCE_INLINE void operator delete(void *ptr) { btAlignedFree(ptr); }                              \
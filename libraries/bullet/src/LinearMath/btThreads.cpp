@@ -436,6 +436,19 @@ void btParallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody
 #endif  // #if BT_THREADSAFE
 }
 
+void btParallelForIfScheduled(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body)
+{
+#if BT_THREADSAFE
+	if (gBtTaskScheduler)
+	{
+		btParallelFor(iBegin, iEnd, grainSize, body);
+		return;
+	}
+#endif  // #if BT_THREADSAFE
+	(void)grainSize;
+	body.forLoop(iBegin, iEnd);
+}
+
 btScalar btParallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body)
 {
 #if BT_THREADSAFE
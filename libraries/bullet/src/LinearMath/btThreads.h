@@ -170,6 +170,10 @@ btITaskScheduler* btGetPPLTaskScheduler();
 //                 (iterations may be done out of order, so no dependencies are allowed)
 void btParallelFor(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body);
 
+// btParallelForIfScheduled -- like btParallelFor, but runs the whole range on the calling thread in a non-threadsafe build
+//                 or when no task scheduler is set (for code that may run before the application sets one up)
+void btParallelForIfScheduled(int iBegin, int iEnd, int grainSize, const btIParallelForBody& body);
+
 // btParallelSum -- call this to dispatch work like a for-loop, returns the sum of all iterations
 //                 (iterations may be done out of order, so no dependencies are allowed)
 btScalar btParallelSum(int iBegin, int iEnd, int grainSize, const btIParallelSumBody& body);
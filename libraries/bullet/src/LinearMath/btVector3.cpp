@@ -1662,3 +1662,186 @@ long _mindot_large_v1(const float *vv, const float *vec, unsigned long count, fl
 #endif
 
 #endif /* __APPLE__ */
+
+#if defined BT_USE_RUNTIME_DOT_KERNELS
+
+#include "btCpuFeatureUtility.h"
+#include <emmintrin.h>
+#ifdef BT_HAS_AVX2_INTRINSICS
+#include <immintrin.h>
+#endif
+
+//The btVector3 of this build are not 16 byte aligned, so the kernels use unaligned loads. Every lane keeps the first index of
+//its best dot, and the dots are summed in the order of btVector3::dot, so the result is always the one of the scalar loop.
+
+static long _maxdot_large_sse2(const float *vv, const float *vec, unsigned long count, float *dotResult);
+static long _mindot_large_sse2(const float *vv, const float *vec, unsigned long count, float *dotResult);
+#ifdef BT_HAS_AVX2_INTRINSICS
+static long _maxdot_large_avx2(const float *vv, const float *vec, unsigned long count, float *dotResult);
+static long _mindot_large_avx2(const float *vv, const float *vec, unsigned long count, float *dotResult);
+#endif
+static long _maxdot_large_sel(const float *vv, const float *vec, unsigned long count, float *dotResult);
+static long _mindot_large_sel(const float *vv, const float *vec, unsigned long count, float *dotResult);
+
+long (*_maxdot_large)(const float *vv, const float *vec, unsigned long count, float *dotResult) = _maxdot_large_sel;
+long (*_mindot_large)(const float *vv, const float *vec, unsigned long count, float *dotResult) = _mindot_large_sel;
+
+static long _maxdot_large_sel(const float *vv, const float *vec, unsigned long count, float *dotResult)
+{
+#ifdef BT_HAS_AVX2_INTRINSICS
+	if (btCpuFeatureUtility::getCpuFeatures() & btCpuFeatureUtility::CPU_FEATURE_AVX2)
+		_maxdot_large = _maxdot_large_avx2;
+	else
+#endif
+		_maxdot_large = _maxdot_large_sse2;
+
+	return _maxdot_large(vv, vec, count, dotResult);
+}
+
+static long _mindot_large_sel(const float *vv, const float *vec, unsigned long count, float *dotResult)
+{
+#ifdef BT_HAS_AVX2_INTRINSICS
+	if (btCpuFeatureUtility::getCpuFeatures() & btCpuFeatureUtility::CPU_FEATURE_AVX2)
+		_mindot_large = _mindot_large_avx2;
+	else
+#endif
+		_mindot_large = _mindot_large_sse2;
+
+	return _mindot_large(vv, vec, count, dotResult);
+}
+
+template <bool isMax>
+static SIMD_FORCE_INLINE bool btDotIsBetter(float dot, float best)
+{
+	return isMax ? dot > best : dot < best;
+}
+
+//picks the first index of the best dot of the lanes, and finishes the vertices [i, count) one at a time
+template <bool isMax>
+static long btDotReduce(const float *laneDot, const int *laneIndex, int numLanes, const float *vv, const float *vec, unsigned long i, unsigned long count, float *dotResult)
+{
+	float best = laneDot[0];
+	long bestIndex = laneIndex[0];
+	for (int lane = 1; lane < numLanes; lane++)
+	{
+		if (btDotIsBetter<isMax>(laneDot[lane], best) || (laneDot[lane] == best && laneIndex[lane] < bestIndex))
+		{
+			best = laneDot[lane];
+			bestIndex = laneIndex[lane];
+		}
+	}
+	for (; i < count; i++)
+	{
+		const float *v = vv + 4 * i;
+		float dot = v[0] * vec[0] + v[1] * vec[1] + v[2] * vec[2];
+		if (btDotIsBetter<isMax>(dot, best))
+		{
+			best = dot;
+			bestIndex = long(i);
+		}
+	}
+	*dotResult = best;
+	return bestIndex;
+}
+
+template <bool isMax>
+static long btDotLargeSse2(const float *vv, const float *vec, unsigned long count, float *dotResult)
+{
+	const __m128 vx = _mm_set1_ps(vec[0]);
+	const __m128 vy = _mm_set1_ps(vec[1]);
+	const __m128 vz = _mm_set1_ps(vec[2]);
+	__m128 best = _mm_set1_ps(isMax ? -BT_INFINITY : BT_INFINITY);
+	__m128i bestIndex = _mm_set1_epi32(-1);
+	__m128i index = _mm_setr_epi32(0, 1, 2, 3);
+	const __m128i step = _mm_set1_epi32(4);
+
+	unsigned long i = 0;
+	for (; i + 4 <= count; i += 4)
+	{
+		__m128 x = _mm_loadu_ps(vv + 4 * i);
+		__m128 y = _mm_loadu_ps(vv + 4 * i + 4);
+		__m128 z = _mm_loadu_ps(vv + 4 * i + 8);
+		__m128 w = _mm_loadu_ps(vv + 4 * i + 12);
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+		__m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(x, vx), _mm_mul_ps(y, vy)), _mm_mul_ps(z, vz));
+		__m128 better = isMax ? _mm_cmpgt_ps(dot, best) : _mm_cmplt_ps(dot, best);
+		best = _mm_or_ps(_mm_and_ps(better, dot), _mm_andnot_ps(better, best));
+		__m128i betteri = _mm_castps_si128(better);
+		bestIndex = _mm_or_si128(_mm_and_si128(betteri, index), _mm_andnot_si128(betteri, bestIndex));
+		index = _mm_add_epi32(index, step);
+	}
+
+	float laneDot[4];
+	int laneIndex[4];
+	_mm_storeu_ps(laneDot, best);
+	_mm_storeu_si128((__m128i *)laneIndex, bestIndex);
+	return btDotReduce<isMax>(laneDot, laneIndex, 4, vv, vec, i, count, dotResult);
+}
+
+long _maxdot_large_sse2(const float *vv, const float *vec, unsigned long count, float *dotResult)
+{
+	return btDotLargeSse2<true>(vv, vec, count, dotResult);
+}
+
+long _mindot_large_sse2(const float *vv, const float *vec, unsigned long count, float *dotResult)
+{
+	return btDotLargeSse2<false>(vv, vec, count, dotResult);
+}
+
+#ifdef BT_HAS_AVX2_INTRINSICS
+
+template <bool isMax>
+BT_AVX2_TARGET static long btDotLargeAvx2(const float *vv, const float *vec, unsigned long count, float *dotResult)
+{
+	const __m256 vx = _mm256_set1_ps(vec[0]);
+	const __m256 vy = _mm256_set1_ps(vec[1]);
+	const __m256 vz = _mm256_set1_ps(vec[2]);
+	__m256 best = _mm256_set1_ps(isMax ? -BT_INFINITY : BT_INFINITY);
+	__m256i bestIndex = _mm256_set1_epi32(-1);
+	__m256i index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256i step = _mm256_set1_epi32(8);
+
+	unsigned long i = 0;
+	for (; i + 8 <= count; i += 8)
+	{
+		//vertex k and k + 4 share a register, so the 128 bit halves transpose like 2 x 4 vertices
+		const float *v = vv + 4 * i;
+		__m256 r0 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(v)), _mm_loadu_ps(v + 16), 1);
+		__m256 r1 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(v + 4)), _mm_loadu_ps(v + 20), 1);
+		__m256 r2 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(v + 8)), _mm_loadu_ps(v + 24), 1);
+		__m256 r3 = _mm256_insertf128_ps(_mm256_castps128_ps256(_mm_loadu_ps(v + 12)), _mm_loadu_ps(v + 28), 1);
+		__m256 t0 = _mm256_unpacklo_ps(r0, r1);
+		__m256 t1 = _mm256_unpacklo_ps(r2, r3);
+		__m256 t2 = _mm256_unpackhi_ps(r0, r1);
+		__m256 t3 = _mm256_unpackhi_ps(r2, r3);
+		__m256 x = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(1, 0, 1, 0));
+		__m256 y = _mm256_shuffle_ps(t0, t1, _MM_SHUFFLE(3, 2, 3, 2));
+		__m256 z = _mm256_shuffle_ps(t2, t3, _MM_SHUFFLE(1, 0, 1, 0));
+		__m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(x, vx), _mm256_mul_ps(y, vy)), _mm256_mul_ps(z, vz));
+		__m256 better = _mm256_cmp_ps(dot, best, isMax ? _CMP_GT_OQ : _CMP_LT_OQ);
+		best = _mm256_blendv_ps(best, dot, better);
+		bestIndex = _mm256_blendv_epi8(bestIndex, index, _mm256_castps_si256(better));
+		index = _mm256_add_epi32(index, step);
+	}
+
+	float laneDot[8];
+	int laneIndex[8];
+	_mm256_storeu_ps(laneDot, best);
+	_mm256_storeu_si256((__m256i *)laneIndex, bestIndex);
+	_mm256_zeroupper();
+	return btDotReduce<isMax>(laneDot, laneIndex, 8, vv, vec, i, count, dotResult);
+}
+
+long _maxdot_large_avx2(const float *vv, const float *vec, unsigned long count, float *dotResult)
+{
+	return btDotLargeAvx2<true>(vv, vec, count, dotResult);
+}
+
+long _mindot_large_avx2(const float *vv, const float *vec, unsigned long count, float *dotResult)
+{
+	return btDotLargeAvx2<false>(vv, vec, count, dotResult);
+}
+
+#endif  //BT_HAS_AVX2_INTRINSICS
+
+#endif  //BT_USE_RUNTIME_DOT_KERNELS
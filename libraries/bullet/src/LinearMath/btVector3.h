@@ -73,6 +73,11 @@ const int32x4_t ATTRIBUTE_ALIGNED16(btv3AbsMask) = (int32x4_t){0x7FFFFFFF, 0x7FF
 
 #endif
 
+///x86 builds that don't use SSE for btVector3 still pick an SSE2 or AVX2 kernel for maxDot and minDot of large arrays at runtime, see btVector3.cpp
+#if defined(BT_HAS_SSE2_INTRINSICS) && !defined(BT_USE_SSE) && !defined(BT_USE_NEON) && !defined(BT_USE_DOUBLE_PRECISION)
+#define BT_USE_RUNTIME_DOT_KERNELS
+#endif
+
 /**@brief btVector3 can be used to represent 3D points and vectors.
  * It has an un-used w component to suit 16-byte alignment when btVector3 is stored in containers. This extra component can be used by derived classes (Quaternion?) or by user
  * Ideally, this class should be replaced by a platform optimized SIMD version that keeps the data in registers
@@ -997,8 +1002,11 @@ SIMD_FORCE_INLINE btVector3 btVector3::rotate(const btVector3& wAxis, const btSc
 
 SIMD_FORCE_INLINE long btVector3::maxDot(const btVector3* array, long array_count, btScalar& dotOut) const
 {
-#if (defined BT_USE_SSE && defined BT_USE_SIMD_VECTOR3 && defined BT_USE_SSE_IN_API) || defined(BT_USE_NEON)
-#if defined _WIN32 || defined(BT_USE_SSE)
+#if (defined BT_USE_SSE && defined BT_USE_SIMD_VECTOR3 && defined BT_USE_SSE_IN_API) || defined(BT_USE_NEON) || defined(BT_USE_RUNTIME_DOT_KERNELS)
+#if defined BT_USE_RUNTIME_DOT_KERNELS
+	const long scalar_cutoff = 16;
+	extern long (*_maxdot_large)(const float* array, const float* vec, unsigned long array_count, float* dotOut);
+#elif defined _WIN32 || defined(BT_USE_SSE)
 	const long scalar_cutoff = 10;
 	long _maxdot_large(const float* array, const float* vec, unsigned long array_count, float* dotOut);
 #elif defined BT_USE_NEON
@@ -1025,15 +1033,18 @@ SIMD_FORCE_INLINE long btVector3::maxDot(const btVector3* array, long array_coun
 		dotOut = maxDot1;
 		return ptIndex;
 	}
-#if (defined BT_USE_SSE && defined BT_USE_SIMD_VECTOR3 && defined BT_USE_SSE_IN_API) || defined(BT_USE_NEON)
+#if (defined BT_USE_SSE && defined BT_USE_SIMD_VECTOR3 && defined BT_USE_SSE_IN_API) || defined(BT_USE_NEON) || defined(BT_USE_RUNTIME_DOT_KERNELS)
 	return _maxdot_large((float*)array, (float*)&m_floats[0], array_count, &dotOut);
 #endif
 }
 
 SIMD_FORCE_INLINE long btVector3::minDot(const btVector3* array, long array_count, btScalar& dotOut) const
 {
-#if (defined BT_USE_SSE && defined BT_USE_SIMD_VECTOR3 && defined BT_USE_SSE_IN_API) || defined(BT_USE_NEON)
-#if defined BT_USE_SSE
+#if (defined BT_USE_SSE && defined BT_USE_SIMD_VECTOR3 && defined BT_USE_SSE_IN_API) || defined(BT_USE_NEON) || defined(BT_USE_RUNTIME_DOT_KERNELS)
+#if defined BT_USE_RUNTIME_DOT_KERNELS
+	const long scalar_cutoff = 16;
+	extern long (*_mindot_large)(const float* array, const float* vec, unsigned long array_count, float* dotOut);
+#elif defined BT_USE_SSE
 	const long scalar_cutoff = 10;
 	long _mindot_large(const float* array, const float* vec, unsigned long array_count, float* dotOut);
 #elif defined BT_USE_NEON
@@ -1065,7 +1076,7 @@ SIMD_FORCE_INLINE long btVector3::minDot(const btVector3* array, long array_coun
 
 		return ptIndex;
 	}
-#if (defined BT_USE_SSE && defined BT_USE_SIMD_VECTOR3 && defined BT_USE_SSE_IN_API) || defined(BT_USE_NEON)
+#if (defined BT_USE_SSE && defined BT_USE_SIMD_VECTOR3 && defined BT_USE_SSE_IN_API) || defined(BT_USE_NEON) || defined(BT_USE_RUNTIME_DOT_KERNELS)
 	return _mindot_large((float*)array, (float*)&m_floats[0], array_count, &dotOut);
 #endif  //BT_USE_SIMD_VECTOR3
 }
@@ -1,6 +1,7 @@
 #include "BulletCollision/BroadphaseCollision/btAxisSweep3.cpp"
 #include "BulletCollision/BroadphaseCollision/btDbvt.cpp"
 #include "BulletCollision/BroadphaseCollision/btOverlappingPairCache.cpp"
+#include "BulletCollision/BroadphaseCollision/btOpenAddressedOverlappingPairCache.cpp"
 #include "BulletCollision/BroadphaseCollision/btBroadphaseProxy.cpp"
 #include "BulletCollision/BroadphaseCollision/btDbvtBroadphase.cpp"
 #include "BulletCollision/BroadphaseCollision/btQuantizedBvh.cpp"
@@ -30,9 +31,11 @@
 #include "BulletCollision/CollisionDispatch/btDefaultCollisionConfiguration.cpp"
 #include "BulletCollision/CollisionDispatch/btSphereTriangleCollisionAlgorithm.cpp"
 #include "BulletCollision/CollisionDispatch/btCollisionWorld.cpp"
+#include "BulletCollision/CollisionDispatch/btCollisionWorldArena.cpp"
 #include "BulletCollision/CollisionDispatch/btEmptyCollisionAlgorithm.cpp"
 #include "BulletCollision/CollisionDispatch/btUnionFind.cpp"
 #include "BulletCollision/CollisionDispatch/btCollisionWorldImporter.cpp"
+#include "BulletCollision/CollisionDispatch/btCollisionWorldSnapshot.cpp"
 #include "BulletCollision/CollisionDispatch/btGhostObject.cpp"
 #include "BulletCollision/NarrowPhaseCollision/btContinuousConvexCollision.cpp"
 #include "BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.cpp"
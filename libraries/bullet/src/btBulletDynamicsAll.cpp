@@ -4,6 +4,7 @@
 #include "BulletDynamics/Dynamics/btDiscreteDynamicsWorldMt.cpp"
 #include "BulletDynamics/Dynamics/btSimpleDynamicsWorld.cpp"
 #include "BulletDynamics/ConstraintSolver/btBatchedConstraints.cpp"
+#include "BulletDynamics/ConstraintSolver/btSoaContactConstraints.cpp"
 #include "BulletDynamics/ConstraintSolver/btConeTwistConstraint.cpp"
 #include "BulletDynamics/ConstraintSolver/btGeneric6DofSpringConstraint.cpp"
 #include "BulletDynamics/ConstraintSolver/btSliderConstraint.cpp"
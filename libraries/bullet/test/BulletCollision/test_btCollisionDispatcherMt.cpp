@@ -0,0 +1,193 @@
+#include <btBulletCollisionCommon.h>
+#include <BulletCollision/CollisionDispatch/btCollisionDispatcherMt.h>
+#include <BulletCollision/BroadphaseCollision/btOpenAddressedOverlappingPairCache.h>
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+namespace {
+
+//the records are compared bit by bit, so they have no padding and the unused contacts are zero
+struct ContactRecord
+{
+	int m_index0;
+	int m_index1;
+	int m_numContacts;
+	int m_padding;
+	btVector3 m_positionWorldOnA[4];
+	btVector3 m_normalWorldOnB[4];
+	btScalar m_distance[4];
+
+	ContactRecord()
+		: m_index0(0),
+		  m_index1(0),
+		  m_numContacts(0),
+		  m_padding(0)
+	{
+		for (int i = 0; i < 4; i++)
+		{
+			m_positionWorldOnA[i].setValue(0, 0, 0);
+			m_normalWorldOnB[i].setValue(0, 0, 0);
+			m_distance[i] = 0;
+		}
+	}
+};
+
+struct TestWorld
+{
+	btDefaultCollisionConfiguration m_config;
+	btCollisionDispatcher* m_dispatcher;
+	//sorting this cache keeps the collision algorithms and manifolds of the pairs
+	btOpenAddressedOverlappingPairCache m_pairCache;
+	btDbvtBroadphase m_broadphase;
+	btCollisionWorld* m_world;
+	btBoxShape m_box;
+	btSphereShape m_sphere;
+	btAlignedObjectArray<btCollisionObject*> m_objects;
+
+	TestWorld(bool multithreaded, int grainSize, bool deterministic)
+		: m_broadphase(&m_pairCache),
+		  m_box(btVector3(1, 1, 1)),
+		  m_sphere(btScalar(0.8))
+	{
+		m_dispatcher = multithreaded ? new btCollisionDispatcherMt(&m_config, grainSize) : new btCollisionDispatcher(&m_config);
+		m_world = new btCollisionWorld(m_dispatcher, &m_broadphase, &m_config);
+		m_world->getDispatchInfo().m_deterministicOverlappingPairs = deterministic;
+		for (int i = 0; i < 400; i++)
+		{
+			btCollisionObject* object = new btCollisionObject();
+			object->setCollisionShape((i % 3) ? (btCollisionShape*)&m_box : (btCollisionShape*)&m_sphere);
+			object->setUserIndex(i);
+			object->setCollisionFlags(0);
+			m_objects.push_back(object);
+			m_world->addCollisionObject(object);
+		}
+	}
+
+	~TestWorld()
+	{
+		for (int i = 0; i < m_objects.size(); i++)
+		{
+			m_world->removeCollisionObject(m_objects[i]);
+			delete m_objects[i];
+		}
+		delete m_world;
+		delete m_dispatcher;
+	}
+
+	//moves the objects on a slowly shrinking spiral, so pairs start and stop overlapping
+	void step(int stepIndex, bool sortPairs)
+	{
+		for (int i = 0; i < m_objects.size(); i++)
+		{
+			btScalar angle = btScalar(i) * btScalar(0.37) + btScalar(stepIndex) * btScalar(0.05);
+			btScalar radius = btScalar(2) + btScalar(i) * btScalar(0.04) - btScalar(stepIndex) * btScalar(0.02);
+			btTransform transform;
+			transform.setIdentity();
+			transform.setOrigin(btVector3(radius * btCos(angle), radius * btSin(angle), btScalar(i % 7) * btScalar(0.5)));
+			transform.getBasis().setEulerZYX(angle, btScalar(0), btScalar(i) * btScalar(0.1));
+			m_objects[i]->setWorldTransform(transform);
+		}
+		m_world->updateAabbs();
+		m_broadphase.calculateOverlappingPairs(m_dispatcher);
+		if (sortPairs)
+		{
+			//changes the order of the pair array, but not the set of pairs
+			m_broadphase.getOverlappingPairCache()->sortOverlappingPairs(m_dispatcher);
+		}
+		m_dispatcher->dispatchAllCollisionPairs(m_broadphase.getOverlappingPairCache(), m_world->getDispatchInfo(), m_dispatcher);
+	}
+
+	void getContacts(btAlignedObjectArray<ContactRecord>& contacts) const
+	{
+		contacts.resize(m_dispatcher->getNumManifolds());
+		for (int i = 0; i < contacts.size(); i++)
+		{
+			const btPersistentManifold* manifold = m_dispatcher->getInternalManifoldPointer()[i];
+			ContactRecord& record = contacts[i];
+			record = ContactRecord();
+			record.m_index0 = manifold->getBody0()->getUserIndex();
+			record.m_index1 = manifold->getBody1()->getUserIndex();
+			record.m_numContacts = manifold->getNumContacts();
+			for (int j = 0; j < manifold->getNumContacts(); j++)
+			{
+				const btManifoldPoint& point = manifold->getContactPoint(j);
+				record.m_positionWorldOnA[j] = point.m_positionWorldOnA;
+				record.m_normalWorldOnB[j] = point.m_normalWorldOnB;
+				record.m_distance[j] = point.m_distance1;
+			}
+		}
+	}
+};
+
+bool equalBits(const btAlignedObjectArray<ContactRecord>& a, const btAlignedObjectArray<ContactRecord>& b)
+{
+	return a.size() == b.size() && (a.size() == 0 || memcmp(&a[0], &b[0], a.size() * sizeof(ContactRecord)) == 0);
+}
+
+int numContacts(const btAlignedObjectArray<ContactRecord>& contacts)
+{
+	int count = 0;
+	for (int i = 0; i < contacts.size(); i++)
+	{
+		count += contacts[i].m_numContacts;
+	}
+	return count;
+}
+
+}  // namespace
+
+GTEST_TEST(BulletCollision, CollisionDispatcherMtDeterministicIgnoresPairOrder)
+{
+	TestWorld reference(true, 40, true);
+	TestWorld sorted(true, 7, true);
+	btAlignedObjectArray<ContactRecord> referenceContacts;
+	btAlignedObjectArray<ContactRecord> sortedContacts;
+	for (int step = 0; step < 30; step++)
+	{
+		reference.step(step, false);
+		sorted.step(step, true);
+		reference.getContacts(referenceContacts);
+		sorted.getContacts(sortedContacts);
+		ASSERT_GT(numContacts(referenceContacts), 0);
+		ASSERT_TRUE(equalBits(referenceContacts, sortedContacts)) << "step " << step;
+	}
+}
+
+GTEST_TEST(BulletCollision, CollisionDispatcherMtDeterministicMatchesSerial)
+{
+	//the first step only creates manifolds, so the serial dispatcher visiting the pairs in the same order creates them in the same order
+	TestWorld serial(false, 0, true);
+	TestWorld multithreaded(true, 1, true);
+	serial.step(0, false);
+	multithreaded.step(0, true);
+
+	btAlignedObjectArray<ContactRecord> serialContacts;
+	btAlignedObjectArray<ContactRecord> multithreadedContacts;
+	serial.getContacts(serialContacts);
+	multithreaded.getContacts(multithreadedContacts);
+	ASSERT_GT(numContacts(serialContacts), 0);
+	EXPECT_TRUE(equalBits(serialContacts, multithreadedContacts));
+}
+
+GTEST_TEST(BulletCollision, CollisionDispatcherMtManifoldIndices)
+{
+	TestWorld deterministic(true, 3, true);
+	TestWorld unordered(true, 3, false);
+	for (int step = 0; step < 30; step++)
+	{
+		deterministic.step(step, step & 1);
+		unordered.step(step, step & 1);
+		EXPECT_EQ(deterministic.m_dispatcher->getNumManifolds(), unordered.m_dispatcher->getNumManifolds());
+		for (int i = 0; i < deterministic.m_dispatcher->getNumManifolds(); i++)
+		{
+			ASSERT_EQ(i, deterministic.m_dispatcher->getInternalManifoldPointer()[i]->m_index1a);
+		}
+	}
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,94 @@
+#include <btBulletCollisionCommon.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorldArena.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+void fillWorld(btCollisionWorldArena& arena, int numObjects)
+{
+	btBoxShape* box = arena.createBoxShape(btVector3(1, 1, 1));
+	for (int i = 0; i < numObjects; i++)
+	{
+		btTransform transform;
+		transform.setIdentity();
+		transform.setOrigin(btVector3(btScalar(i % 50) * btScalar(1.5), btScalar(i / 50) * btScalar(1.5), 0));
+		btCollisionObject* object = arena.createCollisionObject(box, transform);
+		object->setUserIndex(i);
+		//overlapping dynamic objects, so the dispatcher creates collision algorithms
+		object->setCollisionFlags(0);
+	}
+}
+
+int rayTest(btCollisionWorld* world, const btVector3& from, const btVector3& to)
+{
+	btCollisionWorld::ClosestRayResultCallback result(from, to);
+	world->rayTest(from, to, result);
+	return result.hasHit() ? result.m_collisionObject->getUserIndex() : -1;
+}
+
+}  // namespace
+
+GTEST_TEST(BulletCollision, CollisionWorldArenaObjectsAreCacheAligned)
+{
+	btCollisionWorldArena arena;
+	fillWorld(arena, 100);
+
+	const btCollisionObjectArray& objects = arena.getCollisionWorld()->getCollisionObjectArray();
+	ASSERT_EQ(100, objects.size());
+	for (int i = 0; i < objects.size(); i++)
+	{
+		EXPECT_EQ(0u, size_t(objects[i]) % BT_ARENA_CACHE_LINE_SIZE);
+	}
+	EXPECT_EQ(53, rayTest(arena.getCollisionWorld(), btVector3(btScalar(4.5), btScalar(1.5), 10), btVector3(btScalar(4.5), btScalar(1.5), -10)));
+}
+
+GTEST_TEST(BulletCollision, CollisionWorldArenaReset)
+{
+	btCollisionWorldArena arena(16 * 1024);
+	for (int round = 0; round < 3; round++)
+	{
+		fillWorld(arena, 1000);
+		btCollisionWorld* world = arena.getCollisionWorld();
+		world->performDiscreteCollisionDetection();
+		EXPECT_EQ(1000, world->getNumCollisionObjects());
+
+		//objects can still be removed individually, their proxies and nodes are recycled
+		world->removeCollisionObject(world->getCollisionObjectArray()[0]);
+		fillWorld(arena, 1);
+		EXPECT_EQ(1000, world->getNumCollisionObjects());
+		EXPECT_EQ(0, rayTest(world, btVector3(0, 0, 10), btVector3(0, 0, -10)));
+
+		arena.reset();
+		EXPECT_EQ(0, arena.getCollisionWorld()->getNumCollisionObjects());
+	}
+}
+
+GTEST_TEST(BulletCollision, CollisionWorldArenaMultithreaded)
+{
+	btCollisionWorldArena serial;
+	btCollisionWorldArena multithreaded(64 * 1024, true);
+	fillWorld(serial, 200);
+	fillWorld(multithreaded, 200);
+	serial.getCollisionWorld()->performDiscreteCollisionDetection();
+	multithreaded.getCollisionWorld()->performDiscreteCollisionDetection();
+
+	btDispatcher* serialDispatcher = serial.getCollisionWorld()->getDispatcher();
+	btDispatcher* multithreadedDispatcher = multithreaded.getCollisionWorld()->getDispatcher();
+	ASSERT_GT(serialDispatcher->getNumManifolds(), 0);
+	ASSERT_EQ(serialDispatcher->getNumManifolds(), multithreadedDispatcher->getNumManifolds());
+	int serialContacts = 0;
+	int multithreadedContacts = 0;
+	for (int i = 0; i < serialDispatcher->getNumManifolds(); i++)
+	{
+		serialContacts += serialDispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+		multithreadedContacts += multithreadedDispatcher->getManifoldByIndexInternal(i)->getNumContacts();
+	}
+	EXPECT_EQ(serialContacts, multithreadedContacts);
+	multithreaded.reset();
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
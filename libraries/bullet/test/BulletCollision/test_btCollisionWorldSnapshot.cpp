@@ -0,0 +1,285 @@
+#include <btBulletCollisionCommon.h>
+#include <BulletCollision/CollisionDispatch/btCollisionWorldSnapshot.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+struct TestWorld
+{
+	btDefaultCollisionConfiguration m_configuration;
+	btCollisionDispatcher m_dispatcher;
+	btDbvtBroadphase m_broadphase;
+	btCollisionWorld m_world;
+
+	TestWorld()
+		: m_dispatcher(&m_configuration),
+		  m_world(&m_dispatcher, &m_broadphase, &m_configuration)
+	{
+	}
+};
+
+struct CollectObjects : public btBroadphaseAabbCallback
+{
+	std::vector<int> m_userIndices;
+
+	virtual bool process(const btBroadphaseProxy* proxy)
+	{
+		m_userIndices.push_back(((const btCollisionObject*)proxy->m_clientObject)->getUserIndex());
+		return true;
+	}
+};
+
+std::vector<int> query(btCollisionWorld& world, const btVector3& aabbMin, const btVector3& aabbMax)
+{
+	CollectObjects callback;
+	world.getBroadphase()->aabbTest(aabbMin, aabbMax, callback);
+	std::sort(callback.m_userIndices.begin(), callback.m_userIndices.end());
+	return callback.m_userIndices;
+}
+
+int rayTest(btCollisionWorld& world, const btVector3& from, const btVector3& to)
+{
+	btCollisionWorld::ClosestRayResultCallback result(from, to);
+	world.rayTest(from, to, result);
+	return result.hasHit() ? result.m_collisionObject->getUserIndex() : -1;
+}
+
+//a world with dynamic and fixed objects of both shapes
+struct SnapshotSource
+{
+	btBoxShape m_box;
+	btSphereShape m_sphere;
+	std::vector<btCollisionObject*> m_objects;
+	TestWorld m_world;
+
+	SnapshotSource() : m_box(btVector3(1, 2, 0.5)), m_sphere(btScalar(0.75))
+	{
+		for (int i = 0; i < 20; i++)
+		{
+			btCollisionObject* object = new btCollisionObject();
+			object->setCollisionShape(i & 1 ? (btCollisionShape*)&m_sphere : &m_box);
+			object->getWorldTransform().setOrigin(btVector3(btScalar(i % 5), btScalar(i / 5), 0));
+			object->setUserIndex(i);
+			m_world.m_world.addCollisionObject(object, i < 15 ? btBroadphaseProxy::DefaultFilter : btBroadphaseProxy::StaticFilter,
+											   i < 15 ? btBroadphaseProxy::AllFilter : btBroadphaseProxy::AllFilter ^ btBroadphaseProxy::StaticFilter);
+			m_objects.push_back(object);
+		}
+		m_world.m_world.updateAabbs();
+		m_world.m_broadphase.calculateOverlappingPairs(&m_world.m_dispatcher);
+	}
+
+	~SnapshotSource()
+	{
+		for (size_t i = 0; i < m_objects.size(); i++)
+		{
+			m_world.m_world.removeCollisionObject(m_objects[i]);
+			delete m_objects[i];
+		}
+	}
+};
+
+//loads a corrupted copy of the snapshot into a new world, unloading it again if it was accepted
+bool loadCorrupted(const btAlignedObjectArray<char>& buffer, int size, void (*corrupt)(char* base, btCollisionWorldSnapshotHeader& header))
+{
+	btAlignedObjectArray<char> copy(buffer);
+	char* base = &copy[0];
+	if (corrupt)
+	{
+		corrupt(base, *(btCollisionWorldSnapshotHeader*)base);
+	}
+
+	TestWorld loaded;
+	btCollisionWorldSnapshot snapshot;
+	return snapshot.load(base, size, &loaded.m_world, &loaded.m_broadphase);
+}
+
+btDbvtNode* snapshotNodes(char* base, const btCollisionWorldSnapshotHeader& header)
+{
+	return (btDbvtNode*)(base + header.m_nodesOffset);
+}
+
+btDbvtProxy* snapshotProxies(char* base, const btCollisionWorldSnapshotHeader& header)
+{
+	return (btDbvtProxy*)(base + header.m_proxiesOffset);
+}
+
+btDbvtNode* firstInternalNode(char* base, const btCollisionWorldSnapshotHeader& header)
+{
+	for (int i = 0; i < header.m_numNodes; i++)
+	{
+		if (snapshotNodes(base, header)[i].childs[1])
+			return &snapshotNodes(base, header)[i];
+	}
+	return 0;
+}
+
+void corruptNodePointer(char* base, btCollisionWorldSnapshotHeader& header)
+{
+	firstInternalNode(base, header)->childs[0] = (btDbvtNode*)(size_t)(header.m_nodesOffset + 8);
+}
+
+void corruptNodeCycle(char* base, btCollisionWorldSnapshotHeader& header)
+{
+	btDbvtNode* node = firstInternalNode(base, header);
+	node->childs[1] = node->childs[0];
+}
+
+void corruptLeafProxy(char* base, btCollisionWorldSnapshotHeader& header)
+{
+	for (int i = 0; i < header.m_numNodes; i++)
+	{
+		if (!snapshotNodes(base, header)[i].childs[1])
+		{
+			snapshotNodes(base, header)[i].data = (void*)(size_t)header.m_totalSize;
+			return;
+		}
+	}
+}
+
+}  // namespace
+
+GTEST_TEST(BulletCollision, CollisionWorldSnapshotRoundTrip)
+{
+	btBoxShape box(btVector3(1, 2, 0.5));
+	btSphereShape sphere(btScalar(0.75));
+	std::vector<btCollisionObject*> objects;
+
+	TestWorld original;
+	srand(5);
+	for (int i = 0; i < 500; i++)
+	{
+		btTransform transform;
+		transform.setIdentity();
+		transform.setOrigin(btVector3(btScalar(rand() % 200 - 100), btScalar(rand() % 200 - 100), btScalar(rand() % 20)));
+
+		btCollisionObject* object = new btCollisionObject();
+		object->setCollisionShape((i % 3) ? (btCollisionShape*)&box : (btCollisionShape*)&sphere);
+		object->setWorldTransform(transform);
+		object->setUserIndex(i);
+		original.m_world.addCollisionObject(object);
+		objects.push_back(object);
+	}
+
+	btAlignedObjectArray<char> buffer;
+	ASSERT_TRUE(btCollisionWorldSnapshot::write(&original.m_world, &original.m_broadphase, buffer));
+
+	TestWorld loaded;
+	btCollisionWorldSnapshot snapshot;
+	ASSERT_TRUE(snapshot.load(&buffer[0], buffer.size(), &loaded.m_world, &loaded.m_broadphase));
+	EXPECT_EQ(500, loaded.m_world.getNumCollisionObjects());
+	EXPECT_EQ(2, snapshot.getNumCollisionShapes());
+	EXPECT_EQ(original.m_broadphase.getOverlappingPairCache()->getNumOverlappingPairs(),
+			  loaded.m_broadphase.getOverlappingPairCache()->getNumOverlappingPairs());
+
+	srand(9);
+	for (int i = 0; i < 200; i++)
+	{
+		btVector3 aabbMin(btScalar(rand() % 220 - 110), btScalar(rand() % 220 - 110), btScalar(rand() % 20 - 5));
+		btVector3 aabbMax = aabbMin + btVector3(btScalar(rand() % 40), btScalar(rand() % 40), btScalar(rand() % 10));
+		EXPECT_EQ(query(original.m_world, aabbMin, aabbMax), query(loaded.m_world, aabbMin, aabbMax));
+
+		btVector3 from(btScalar(rand() % 200 - 100), btScalar(rand() % 200 - 100), btScalar(100));
+		btVector3 to = from - btVector3(0, 0, 200);
+		EXPECT_EQ(rayTest(original.m_world, from, to), rayTest(loaded.m_world, from, to));
+	}
+
+	//the loaded world stays fully dynamic
+	btTransform transform;
+	transform.setIdentity();
+	transform.setOrigin(btVector3(500, 500, 0));
+	btCollisionObject* moved = snapshot.getCollisionObject(0);
+	moved->setWorldTransform(transform);
+	loaded.m_world.updateAabbs();
+	loaded.m_broadphase.calculateOverlappingPairs(&loaded.m_dispatcher);
+	EXPECT_EQ(moved->getUserIndex(), rayTest(loaded.m_world, btVector3(500, 500, 100), btVector3(500, 500, -100)));
+
+	snapshot.unload();
+	EXPECT_EQ(0, loaded.m_world.getNumCollisionObjects());
+
+	for (size_t i = 0; i < objects.size(); i++)
+	{
+		original.m_world.removeCollisionObject(objects[i]);
+		delete objects[i];
+	}
+}
+
+GTEST_TEST(BulletCollision, CollisionWorldSnapshotRejectsInvalidData)
+{
+	TestWorld original;
+	btAlignedObjectArray<char> buffer;
+	ASSERT_TRUE(btCollisionWorldSnapshot::write(&original.m_world, &original.m_broadphase, buffer));
+	buffer[0] = 'X';
+
+	TestWorld loaded;
+	btCollisionWorldSnapshot snapshot;
+	EXPECT_FALSE(snapshot.load(&buffer[0], buffer.size(), &loaded.m_world, &loaded.m_broadphase));
+}
+
+//a truncated or corrupted snapshot is rejected before anything is read or written out of its bounds
+GTEST_TEST(BulletCollision, CollisionWorldSnapshotRejectsCorruptData)
+{
+	SnapshotSource source;
+	btAlignedObjectArray<char> buffer;
+	ASSERT_TRUE(btCollisionWorldSnapshot::write(&source.m_world.m_world, &source.m_world.m_broadphase, buffer));
+	ASSERT_TRUE(loadCorrupted(buffer, buffer.size(), 0));
+
+	//truncated buffers, and a header that claims the truncated size
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size() / 2, 0));
+	EXPECT_FALSE(loadCorrupted(buffer, int(sizeof(btCollisionWorldSnapshotHeader)) - 1, 0));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size() / 2, [](char*, btCollisionWorldSnapshotHeader& header) { header.m_totalSize /= 2; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_totalSize = 0; }));
+
+	//sections and counts outside of the snapshot
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_shapesOffset = header.m_totalSize; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_objectsOffset = -16; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_nodesOffset += 4; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_proxiesOffset = 0x7ffffff0; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_numNodes = 0x7fffffff; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_numObjects = -1; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_numProxies--; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_numPairs = 0x10000000; }));
+
+	//records that refer outside of their sections
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char* base, btCollisionWorldSnapshotHeader& header) {
+		((btCollisionWorldSnapshotObject*)(base + header.m_objectsOffset))[3].m_shapeIndex = header.m_numShapes;
+	}));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char* base, btCollisionWorldSnapshotHeader& header) {
+		((btCollisionWorldSnapshotShape*)(base + header.m_shapesOffset))[0].m_shapeType = CAPSULE_SHAPE_PROXYTYPE;
+	}));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_rootOffsets[0] = header.m_proxiesOffset; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_rootOffsets[1] = header.m_rootOffsets[0]; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_leaves[0]++; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_stageRootOffsets[0] = header.m_totalSize; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char*, btCollisionWorldSnapshotHeader& header) { header.m_stageCurrent = 7; }));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), corruptNodePointer));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), corruptNodeCycle));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), corruptLeafProxy));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char* base, btCollisionWorldSnapshotHeader& header) {
+		snapshotProxies(base, header)[0].links[1] = snapshotProxies(base, header)[0].links[0];
+	}));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char* base, btCollisionWorldSnapshotHeader& header) {
+		snapshotProxies(base, header)[0].stage = btDbvtBroadphase::SLEEPING_STAGE + 1;
+	}));
+	EXPECT_FALSE(loadCorrupted(buffer, buffer.size(), [](char* base, btCollisionWorldSnapshotHeader& header) {
+		((int*)(base + header.m_pairsOffset))[1] = header.m_numProxies;
+	}));
+
+	//random bytes past the header are either rejected or loaded without reading or writing out of bounds
+	srand(11);
+	for (int i = 0; i < 2000; i++)
+	{
+		btAlignedObjectArray<char> copy(buffer);
+		int offset = int(sizeof(btCollisionWorldSnapshotHeader)) + rand() % (copy.size() - int(sizeof(btCollisionWorldSnapshotHeader)));
+		copy[offset] = char(rand());
+		loadCorrupted(copy, copy.size(), 0);
+	}
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,241 @@
+#include <LinearMath/btConvexHullComputer.h>
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+namespace {
+
+//a small linear congruential generator, so every run tests the same points
+struct TestRandom
+{
+	unsigned int m_state;
+
+	TestRandom(unsigned int seed) : m_state(seed) {}
+
+	btScalar next()
+	{
+		m_state = m_state * 1664525u + 1013904223u;
+		return btScalar(int((m_state >> 8) % 20001) - 10000) * btScalar(0.0001);
+	}
+
+	btVector3 nextVector() { return btVector3(next(), next(), next()); }
+};
+
+//points in a ball, with a share on its surface, and some exact duplicates, like the pieces of a convex decomposition
+void makePoints(btAlignedObjectArray<btVector3>& points, int count, unsigned int seed)
+{
+	TestRandom random(seed);
+	points.resize(0);
+	for (int i = 0; i < count; i++)
+	{
+		btVector3 p = random.nextVector();
+		if ((i % 3) == 0)
+		{
+			p.safeNormalize();
+		}
+		points.push_back(p);
+		if ((i % 17) == 0)
+		{
+			points.push_back(p);
+		}
+	}
+}
+
+btScalar computeHull(btConvexHullComputer& computer, const btAlignedObjectArray<btVector3>& points, int numTasks, btScalar shrink)
+{
+	return computer.computeParallel(&points[0][0], sizeof(btVector3), points.size(), shrink, btScalar(0.), numTasks);
+}
+
+bool equalHulls(const btConvexHullComputer& a, const btConvexHullComputer& b)
+{
+	if (a.vertices.size() != b.vertices.size() || a.edges.size() != b.edges.size() || a.faces.size() != b.faces.size())
+	{
+		return false;
+	}
+	for (int i = 0; i < a.vertices.size(); i++)
+	{
+		if (memcmp(&a.vertices[i], &b.vertices[i], sizeof(btScalar) * 3) != 0 || a.original_vertex_index[i] != b.original_vertex_index[i])
+		{
+			return false;
+		}
+	}
+	for (int i = 0; i < a.edges.size(); i++)
+	{
+		const btConvexHullComputer::Edge& ea = a.edges[i];
+		const btConvexHullComputer::Edge& eb = b.edges[i];
+		if (ea.getSourceVertex() != eb.getSourceVertex() || ea.getTargetVertex() != eb.getTargetVertex() ||
+			ea.getNextEdgeOfVertex() - &ea != eb.getNextEdgeOfVertex() - &eb || ea.getReverseEdge() - &ea != eb.getReverseEdge() - &eb)
+		{
+			return false;
+		}
+	}
+	for (int i = 0; i < a.faces.size(); i++)
+	{
+		if (a.faces[i] != b.faces[i])
+		{
+			return false;
+		}
+	}
+	return true;
+}
+
+struct PointLess
+{
+	bool operator()(const btVector3& a, const btVector3& b) const
+	{
+		return a.x() < b.x() || (a.x() == b.x() && (a.y() < b.y() || (a.y() == b.y() && a.z() < b.z())));
+	}
+};
+
+//the input points of the hull vertices, sorted; duplicated input points may be found by either index
+void sortedHullPoints(const btConvexHullComputer& computer, const btAlignedObjectArray<btVector3>& input, btAlignedObjectArray<btVector3>& points)
+{
+	points.resize(0);
+	for (int i = 0; i < computer.original_vertex_index.size(); i++)
+	{
+		points.push_back(input[computer.original_vertex_index[i]]);
+	}
+	points.quickSort(PointLess());
+}
+
+}  // namespace
+
+//the parallel mode runs the same merges as the serial divide and conquer, so the hulls are identical
+GTEST_TEST(LinearMath, ConvexHullParallelMatchesSerial)
+{
+	const int counts[] = {5, 300, 2000, 20000, 100000};
+	for (int c = 0; c < int(sizeof(counts) / sizeof(counts[0])); c++)
+	{
+		btAlignedObjectArray<btVector3> points;
+		makePoints(points, counts[c], 1000 + c);
+
+		btConvexHullComputer serial;
+		btScalar serialShift = computeHull(serial, points, 1, btScalar(0.));
+		ASSERT_GT(serial.vertices.size(), 3);
+		for (int numTasks = 2; numTasks <= 64; numTasks *= 4)
+		{
+			btConvexHullComputer parallel;
+			EXPECT_EQ(serialShift, computeHull(parallel, points, numTasks, btScalar(0.)));
+			EXPECT_TRUE(equalHulls(serial, parallel)) << counts[c] << " points, " << numTasks << " tasks";
+		}
+
+		//shrinking works on the merged hull
+		btConvexHullComputer serialShrunk;
+		btConvexHullComputer parallelShrunk;
+		EXPECT_EQ(computeHull(serialShrunk, points, 1, btScalar(0.05)), computeHull(parallelShrunk, points, 16, btScalar(0.05)));
+		EXPECT_TRUE(equalHulls(serialShrunk, parallelShrunk)) << counts[c] << " points, shrunk";
+	}
+}
+
+GTEST_TEST(LinearMath, ConvexHullParallelFlatInput)
+{
+	//all points on a plane, and on a line
+	btAlignedObjectArray<btVector3> points;
+	TestRandom random(7);
+	for (int i = 0; i < 5000; i++)
+	{
+		points.push_back(btVector3(random.next(), random.next(), btScalar(0.5)));
+	}
+	btConvexHullComputer serial;
+	btConvexHullComputer parallel;
+	computeHull(serial, points, 1, btScalar(0.));
+	computeHull(parallel, points, 16, btScalar(0.));
+	EXPECT_TRUE(equalHulls(serial, parallel));
+
+	for (int i = 0; i < points.size(); i++)
+	{
+		points[i].setValue(random.next(), btScalar(0.), btScalar(0.));
+	}
+	computeHull(serial, points, 1, btScalar(0.));
+	computeHull(parallel, points, 16, btScalar(0.));
+	EXPECT_TRUE(equalHulls(serial, parallel));
+	EXPECT_EQ(2, parallel.vertices.size());
+}
+
+//points inside the hull leave it untouched
+GTEST_TEST(LinearMath, ConvexHullAddPointsInside)
+{
+	btAlignedObjectArray<btVector3> points;
+	makePoints(points, 1000, 11);
+	btConvexHullComputer computer;
+	computeHull(computer, points, 1, btScalar(0.));
+	btConvexHullComputer reference;
+	computeHull(reference, points, 1, btScalar(0.));
+
+	btAlignedObjectArray<btVector3> inside;
+	TestRandom random(12);
+	for (int i = 0; i < 500; i++)
+	{
+		inside.push_back(random.nextVector() * btScalar(0.5));
+	}
+	//the hull vertices themselves are on the hull
+	inside.copyFromArray(computer.vertices);
+	EXPECT_EQ(btScalar(0.), computer.addPoints(&inside[0][0], sizeof(btVector3), inside.size()));
+	EXPECT_TRUE(equalHulls(reference, computer));
+}
+
+//adding points gives the hull of all points, with indices that count on from the first batch
+GTEST_TEST(LinearMath, ConvexHullAddPointsMatchesRecompute)
+{
+	btAlignedObjectArray<btVector3> first;
+	makePoints(first, 2000, 21);
+	btAlignedObjectArray<btVector3> added;
+	TestRandom random(22);
+	for (int i = 0; i < 300; i++)
+	{
+		//inside the first batch, or well outside of it
+		btVector3 p = random.nextVector();
+		added.push_back((i % 2) ? p * btScalar(0.5) : p.normalized() * btScalar(1.2));
+	}
+	//stay inside the bounds of the first batch, so both hulls are computed on the same grid
+	for (int i = 0; i < added.size(); i++)
+	{
+		added[i].setMax(btVector3(-1, -1, -1) * btScalar(0.999));
+		added[i].setMin(btVector3(1, 1, 1) * btScalar(0.999));
+	}
+	first.push_back(btVector3(-1, -1, -1));
+	first.push_back(btVector3(1, 1, 1));
+
+	btConvexHullComputer incremental;
+	computeHull(incremental, first, 1, btScalar(0.));
+	int numFirstVertices = incremental.vertices.size();
+	incremental.addPoints(&added[0][0], sizeof(btVector3), added.size());
+	EXPECT_GT(incremental.vertices.size(), numFirstVertices);
+
+	btAlignedObjectArray<btVector3> all;
+	all.copyFromArray(first);
+	for (int i = 0; i < added.size(); i++)
+	{
+		all.push_back(added[i]);
+	}
+	btConvexHullComputer full;
+	computeHull(full, all, 1, btScalar(0.));
+
+	btAlignedObjectArray<btVector3> incrementalPoints;
+	btAlignedObjectArray<btVector3> fullPoints;
+	sortedHullPoints(incremental, all, incrementalPoints);
+	sortedHullPoints(full, all, fullPoints);
+	ASSERT_EQ(fullPoints.size(), incrementalPoints.size());
+	for (int i = 0; i < fullPoints.size(); i++)
+	{
+		EXPECT_EQ(fullPoints[i], incrementalPoints[i]);
+	}
+	EXPECT_EQ(full.faces.size(), incremental.faces.size());
+
+	//and the next batch counts on from there
+	btAlignedObjectArray<btVector3> far;
+	far.push_back(btVector3(5, 0, 0));
+	incremental.addPoints(&far[0][0], sizeof(btVector3), far.size());
+	bool found = false;
+	for (int i = 0; i < incremental.vertices.size(); i++)
+	{
+		found |= incremental.original_vertex_index[i] == all.size();
+	}
+	EXPECT_TRUE(found);
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,155 @@
+#include <btBulletCollisionCommon.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+btBroadphaseProxy* createProxy(btDbvtBroadphase& broadphase, const btVector3& center, int index)
+{
+	btVector3 halfExtents(1, 1, 1);
+	return broadphase.createProxy(center - halfExtents, center + halfExtents, BOX_SHAPE_PROXYTYPE, (void*)(size_t)(index + 1),
+								  btBroadphaseProxy::DefaultFilter, btBroadphaseProxy::AllFilter, 0);
+}
+
+struct CountingAabbCallback : public btBroadphaseAabbCallback
+{
+	int m_count;
+
+	CountingAabbCallback() : m_count(0) {}
+
+	virtual bool process(const btBroadphaseProxy* proxy)
+	{
+		(void)proxy;
+		m_count++;
+		return true;
+	}
+};
+
+}  // namespace
+
+GTEST_TEST(BulletCollision, DbvtBroadphaseSleepingPairs)
+{
+	btDbvtBroadphase broadphase;
+	btOverlappingPairCache* pairs = broadphase.getOverlappingPairCache();
+
+	btBroadphaseProxy* a = createProxy(broadphase, btVector3(0, 0, 0), 0);
+	broadphase.sleepProxy(a, 0);
+	EXPECT_EQ(1, broadphase.getNumSleepingProxies());
+	EXPECT_EQ(0, broadphase.m_sets[btDbvtBroadphase::DYNAMIC_SET].m_leaves);
+
+	//a new proxy still finds the sleeping one
+	btBroadphaseProxy* b = createProxy(broadphase, btVector3(1, 0, 0), 1);
+	broadphase.calculateOverlappingPairs(0);
+	EXPECT_EQ(1, pairs->getNumOverlappingPairs());
+
+	//the pair stays when both sleep, but two sleeping proxies don't find each other again
+	broadphase.sleepProxy(b, 0);
+	broadphase.sleepProxy(b, 0);
+	EXPECT_EQ(2, broadphase.getNumSleepingProxies());
+	broadphase.calculateOverlappingPairs(0);
+	EXPECT_EQ(1, pairs->getNumOverlappingPairs());
+	pairs->removeOverlappingPair(a, b, 0);
+	for (int i = 0; i < 4; i++)
+	{
+		broadphase.calculateOverlappingPairs(0);
+	}
+	EXPECT_EQ(0, pairs->getNumOverlappingPairs());
+
+	//setAabb wakes the proxy, and it finds the sleeping one
+	broadphase.setAabb(b, btVector3(0, -1, -1), btVector3(btScalar(2.5), 1, 1), 0);
+	EXPECT_EQ(1, broadphase.getNumSleepingProxies());
+	EXPECT_EQ(1, broadphase.m_sets[btDbvtBroadphase::DYNAMIC_SET].m_leaves);
+	broadphase.calculateOverlappingPairs(0);
+	EXPECT_EQ(1, pairs->getNumOverlappingPairs());
+
+	//a proxy that became fixed doesn't find the sleeping one
+	for (int i = 0; i < 4; i++)
+	{
+		broadphase.calculateOverlappingPairs(0);
+	}
+	EXPECT_EQ(1, broadphase.m_sets[btDbvtBroadphase::FIXED_SET].m_leaves);
+	pairs->removeOverlappingPair(a, b, 0);
+	broadphase.calculateOverlappingPairs(0);
+	EXPECT_EQ(0, pairs->getNumOverlappingPairs());
+
+	broadphase.destroyProxy(a, 0);
+	broadphase.destroyProxy(b, 0);
+	EXPECT_EQ(0, broadphase.getNumSleepingProxies());
+	EXPECT_EQ(0, broadphase.m_sets[btDbvtBroadphase::FIXED_SET].m_leaves);
+}
+
+GTEST_TEST(BulletCollision, DbvtBroadphaseSleepingQueries)
+{
+	btDbvtBroadphase broadphase;
+	btBroadphaseProxy* proxies[3];
+	for (int i = 0; i < 3; i++)
+	{
+		proxies[i] = createProxy(broadphase, btVector3(btScalar(i) * 10, 0, 0), i);
+	}
+	broadphase.sleepProxy(proxies[2], 0);
+
+	CountingAabbCallback callback;
+	broadphase.aabbTest(btVector3(-100, -100, -100), btVector3(100, 100, 100), callback);
+	EXPECT_EQ(3, callback.m_count);
+
+	btVector3 aabbMin, aabbMax;
+	broadphase.getBroadphaseAabb(aabbMin, aabbMax);
+	EXPECT_NEAR(btScalar(21), aabbMax.x(), btScalar(1e-3));
+	EXPECT_NEAR(btScalar(-1), aabbMin.x(), btScalar(1e-3));
+
+	for (int i = 0; i < 3; i++)
+	{
+		broadphase.destroyProxy(proxies[i], 0);
+	}
+	broadphase.resetPool(0);
+	EXPECT_TRUE(broadphase.m_sets[btDbvtBroadphase::SLEEPING_SET].empty());
+}
+
+GTEST_TEST(BulletCollision, CollisionWorldBroadphaseSleeping)
+{
+	btDefaultCollisionConfiguration config;
+	btCollisionDispatcher dispatcher(&config);
+	btDbvtBroadphase broadphase;
+	btCollisionWorld world(&dispatcher, &broadphase, &config);
+	world.setUseBroadphaseSleeping(true);
+
+	btBoxShape box(btVector3(1, 1, 1));
+	const int numObjects = 10;
+	btCollisionObject objects[numObjects];
+	for (int i = 0; i < numObjects; i++)
+	{
+		objects[i].setCollisionShape(&box);
+		//dynamic objects, static ones don't sleep in the broadphase
+		objects[i].setCollisionFlags(0);
+		objects[i].getWorldTransform().setOrigin(btVector3(btScalar(i) * btScalar(1.5), 0, 0));
+		world.addCollisionObject(&objects[i]);
+	}
+	world.performDiscreteCollisionDetection();
+	EXPECT_EQ(numObjects - 1, broadphase.getOverlappingPairCache()->getNumOverlappingPairs());
+
+	//all but the last object go to sleep, and keep their pairs
+	for (int i = 0; i < numObjects - 1; i++)
+	{
+		objects[i].setActivationState(ISLAND_SLEEPING);
+	}
+	world.performDiscreteCollisionDetection();
+	EXPECT_EQ(numObjects - 1, broadphase.getNumSleepingProxies());
+	EXPECT_EQ(numObjects - 1, broadphase.getOverlappingPairCache()->getNumOverlappingPairs());
+
+	//moving an activated object wakes it
+	objects[0].activate();
+	objects[0].getWorldTransform().setOrigin(btVector3(-10, 0, 0));
+	world.performDiscreteCollisionDetection();
+	EXPECT_EQ(numObjects - 2, broadphase.getNumSleepingProxies());
+
+	for (int i = 0; i < numObjects; i++)
+	{
+		world.removeCollisionObject(&objects[i]);
+	}
+	EXPECT_EQ(0, broadphase.getNumSleepingProxies());
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,53 @@
+#include <BulletCollision/BroadphaseCollision/btDbvt.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+//a small linear congruential generator, so every run tests the same volumes
+struct TestRandom
+{
+	unsigned int m_state;
+
+	TestRandom() : m_state(12345) {}
+
+	unsigned int next()
+	{
+		m_state = m_state * 1664525u + 1013904223u;
+		return m_state >> 8;
+	}
+
+	//few distinct values, so there are touching and equal bounds
+	btScalar coarse() { return btScalar(int(next() % 9) - 4) * btScalar(0.5); }
+};
+
+}  // namespace
+
+GTEST_TEST(BulletCollision, DbvtIntersectMatchesGeneric)
+{
+	TestRandom random;
+	for (int i = 0; i < 100000; i++)
+	{
+		btVector3 a0(random.coarse(), random.coarse(), random.coarse());
+		btVector3 a1(random.coarse(), random.coarse(), random.coarse());
+		btVector3 b0(random.coarse(), random.coarse(), random.coarse());
+		btVector3 b1(random.coarse(), random.coarse(), random.coarse());
+		btVector3 aMin = a0, aMax = a0, bMin = b0, bMax = b0;
+		aMin.setMin(a1);
+		aMax.setMax(a1);
+		bMin.setMin(b1);
+		bMax.setMax(b1);
+		btDbvtVolume a = btDbvtVolume::FromMM(aMin, aMax);
+		btDbvtVolume b = btDbvtVolume::FromMM(bMin, bMax);
+		bool expected = a.Mins().x() <= b.Maxs().x() && a.Maxs().x() >= b.Mins().x() &&
+						a.Mins().y() <= b.Maxs().y() && a.Maxs().y() >= b.Mins().y() &&
+						a.Mins().z() <= b.Maxs().z() && a.Maxs().z() >= b.Mins().z();
+		ASSERT_EQ(expected, Intersect(a, b));
+		ASSERT_EQ(expected, Intersect(b, a));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,223 @@
+#include <btBulletCollisionCommon.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpa2.h>
+#include <BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h>
+#include <BulletCollision/NarrowPhaseCollision/btVoronoiSimplexSolver.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+struct TestResult : public btDiscreteCollisionDetectorInterface::Result
+{
+	btVector3 m_normalOnBInWorld;
+	btVector3 m_pointInWorld;
+	btScalar m_depth;
+	bool m_hasResult;
+
+	TestResult() : m_depth(0), m_hasResult(false) {}
+
+	virtual void setShapeIdentifiersA(int partId0, int index0) {}
+	virtual void setShapeIdentifiersB(int partId1, int index1) {}
+	virtual void addContactPoint(const btVector3& normalOnBInWorld, const btVector3& pointInWorld, btScalar depth)
+	{
+		m_normalOnBInWorld = normalOnBInWorld;
+		m_pointInWorld = pointInWorld;
+		m_depth = depth;
+		m_hasResult = true;
+	}
+};
+
+//a rounded, irregular hull, so the simplex changes as the shapes move
+void makeHull(btConvexHullShape& hull, unsigned int state, int numPoints, btScalar radius)
+{
+	for (int i = 0; i < numPoints; i++)
+	{
+		btVector3 point;
+		for (int k = 0; k < 3; k++)
+		{
+			state = state * 1664525u + 1013904223u;
+			point[k] = btScalar(int((state >> 8) % 2001) - 1000) * btScalar(0.001);
+		}
+		hull.addPoint(point.normalized() * radius, false);
+	}
+	hull.recalcLocalAabb();
+}
+
+//B circles around A, and moves in and out of contact and penetration
+btTransform orbit(int step, btScalar speed)
+{
+	btScalar t = btScalar(step) * speed;
+	btTransform transform;
+	transform.setIdentity();
+	transform.setOrigin(btVector3(btCos(t), btSin(t * btScalar(0.7)) * btScalar(0.3), btSin(t)) * (btScalar(0.95) + btScalar(0.15) * btSin(t * btScalar(3))));
+	transform.setRotation(btQuaternion(btVector3(1, 1, 0).normalized(), t * btScalar(0.5)));
+	return transform;
+}
+
+void query(btGjkPairDetector& detector, const btTransform& transformA, const btTransform& transformB, TestResult& result)
+{
+	btGjkPairDetector::ClosestPointInput input;
+	input.m_transformA = transformA;
+	input.m_transformB = transformB;
+	input.m_maximumDistanceSquared = BT_LARGE_FLOAT;
+	detector.getClosestPoints(input, result, 0);
+}
+
+}  // namespace
+
+//the cache changes the starting point of GJK, but not where it converges
+GTEST_TEST(BulletCollision, GjkWarmStartMatchesColdQueries)
+{
+	btConvexHullShape hull;
+	makeHull(hull, 12345, 64, btScalar(0.5));
+	btConvexHullShape other;
+	makeHull(other, 54321, 24, btScalar(0.4));
+	btVoronoiSimplexSolver simplexSolver;
+	btGjkEpaPenetrationDepthSolver penetrationSolver;
+	btGjkWarmStartCache cache;
+	btScalar margin = hull.getMargin() + other.getMargin();
+
+	btTransform transformA;
+	transformA.setIdentity();
+	int coldIterations = 0;
+	int warmIterations = 0;
+	int numPenetrations = 0;
+	for (int step = 0; step < 500; step++)
+	{
+		btTransform transformB = orbit(step, btScalar(0.01));
+
+		btGjkPairDetector cold(&hull, &other, &simplexSolver, &penetrationSolver);
+		TestResult coldResult;
+		query(cold, transformA, transformB, coldResult);
+		coldIterations += cold.getNumIterations();
+
+		btGjkPairDetector warm(&hull, &other, &simplexSolver, &penetrationSolver);
+		warm.setWarmStartCache(&cache, btScalar(0.1));
+		TestResult warmResult;
+		query(warm, transformA, transformB, warmResult);
+		warmIterations += warm.getNumIterations();
+		EXPECT_EQ(warm.getNumIterations(), cache.m_lastIterations);
+
+		ASSERT_TRUE(coldResult.m_hasResult);
+		ASSERT_TRUE(warmResult.m_hasResult);
+		numPenetrations += coldResult.m_depth < 0;
+		EXPECT_GT(coldResult.m_normalOnBInWorld.dot(warmResult.m_normalOnBInWorld), btScalar(0.99)) << "step " << step;
+
+		//where the shapes without margin are apart, both agree with the exact distance, up to the tolerance of GJK
+		btGjkEpaSolver2::sResults reference;
+		if (btGjkEpaSolver2::Distance(&hull, transformA, &other, transformB, btVector3(1, 0, 0), reference))
+		{
+			EXPECT_NEAR(reference.distance - margin, coldResult.m_depth, btScalar(1e-3)) << "step " << step;
+			EXPECT_NEAR(reference.distance - margin, warmResult.m_depth, btScalar(1e-3)) << "step " << step;
+		}
+		else
+		{
+			EXPECT_NEAR(coldResult.m_depth, warmResult.m_depth, btScalar(1e-3)) << "step " << step;
+		}
+	}
+	//the orbit goes through all cases
+	EXPECT_GT(numPenetrations, 0);
+	EXPECT_LT(numPenetrations, 500);
+
+	EXPECT_EQ(500, cache.m_numQueries);
+	EXPECT_EQ(499, cache.m_numWarmStarts);
+	EXPECT_EQ(0, cache.m_numInvalidations);
+	EXPECT_EQ(warmIterations, cache.m_numIterations);
+	EXPECT_LT(warmIterations, coldIterations);
+}
+
+GTEST_TEST(BulletCollision, GjkWarmStartInvalidatedByMotion)
+{
+	btConvexHullShape hull;
+	makeHull(hull, 12345, 64, btScalar(0.5));
+	btSphereShape sphere(btScalar(0.25));
+	btVoronoiSimplexSolver simplexSolver;
+	btGjkEpaPenetrationDepthSolver penetrationSolver;
+	btGjkWarmStartCache cache;
+
+	btTransform transformA;
+	transformA.setIdentity();
+	btTransform transformB = orbit(0, btScalar(0.));
+	btGjkPairDetector detector(&hull, &sphere, &simplexSolver, &penetrationSolver);
+	detector.setWarmStartCache(&cache, btScalar(0.1));
+	TestResult result;
+	query(detector, transformA, transformB, result);
+	EXPECT_TRUE(cache.m_valid);
+	EXPECT_EQ(0, cache.m_numWarmStarts);
+
+	//a small step reuses the cache
+	transformB.getOrigin() += btVector3(btScalar(0.05), 0, 0);
+	query(detector, transformA, transformB, result);
+	EXPECT_EQ(1, cache.m_numWarmStarts);
+	EXPECT_EQ(0, cache.m_numInvalidations);
+
+	//a large step, or a rotation of A that moves the simplex far, drops it
+	transformB.getOrigin() += btVector3(0, btScalar(0.5), 0);
+	query(detector, transformA, transformB, result);
+	EXPECT_EQ(1, cache.m_numWarmStarts);
+	EXPECT_EQ(1, cache.m_numInvalidations);
+
+	transformA.setRotation(btQuaternion(btVector3(0, 0, 1), SIMD_HALF_PI));
+	query(detector, transformA, transformB, result);
+	EXPECT_EQ(1, cache.m_numWarmStarts);
+	EXPECT_EQ(2, cache.m_numInvalidations);
+
+	//both shapes moving together is no relative motion
+	btTransform offset(btQuaternion(btVector3(0, 1, 0), btScalar(1.)), btVector3(10, 20, 30));
+	transformA = offset * transformA;
+	transformB = offset * transformB;
+	query(detector, transformA, transformB, result);
+	EXPECT_EQ(2, cache.m_numWarmStarts);
+	EXPECT_EQ(2, cache.m_numInvalidations);
+	EXPECT_EQ(5, cache.m_numQueries);
+
+	//another shape doesn't use the cache of this pair
+	btGjkPairDetector other(&sphere, &sphere, &simplexSolver, &penetrationSolver);
+	other.setWarmStartCache(&cache, btScalar(0.1));
+	query(other, transformA, transformB, result);
+	EXPECT_EQ(2, cache.m_numWarmStarts);
+	EXPECT_EQ(3, cache.m_numInvalidations);
+}
+
+//the collision world stores the cache on the manifold of each convex pair
+GTEST_TEST(BulletCollision, GjkWarmStartOnManifold)
+{
+	btDefaultCollisionConfiguration config;
+	btCollisionDispatcher dispatcher(&config);
+	btDbvtBroadphase broadphase;
+	btCollisionWorld world(&dispatcher, &broadphase, &config);
+	world.getDispatchInfo().m_useGjkWarmStart = true;
+
+	btConvexHullShape hull;
+	makeHull(hull, 12345, 64, btScalar(0.5));
+	btConvexHullShape other;
+	makeHull(other, 54321, 24, btScalar(0.4));
+	btCollisionObject objectA;
+	objectA.setCollisionShape(&hull);
+	btCollisionObject objectB;
+	objectB.setCollisionShape(&other);
+	world.addCollisionObject(&objectA);
+	world.addCollisionObject(&objectB);
+
+	for (int step = 0; step < 120; step++)
+	{
+		objectB.setWorldTransform(orbit(step, btScalar(0.01)));
+		world.performDiscreteCollisionDetection();
+	}
+	ASSERT_EQ(1, dispatcher.getNumManifolds());
+	const btGjkWarmStartCache& cache = dispatcher.getManifoldByIndexInternal(0)->m_gjkWarmStartCache;
+	EXPECT_TRUE(cache.m_valid);
+	EXPECT_GT(cache.m_numQueries, 0);
+	EXPECT_EQ(cache.m_numQueries - 1, cache.m_numWarmStarts);
+	EXPECT_GT(cache.m_numIterations, 0);
+	EXPECT_GT(dispatcher.getManifoldByIndexInternal(0)->getNumContacts(), 0);
+
+	world.removeCollisionObject(&objectB);
+	world.removeCollisionObject(&objectA);
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
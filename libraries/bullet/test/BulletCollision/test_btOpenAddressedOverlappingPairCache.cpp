@@ -0,0 +1,202 @@
+#include <btBulletCollisionCommon.h>
+#include <BulletCollision/BroadphaseCollision/btOpenAddressedOverlappingPairCache.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+namespace {
+
+struct Proxies
+{
+	btAlignedObjectArray<btBroadphaseProxy> m_proxies;
+
+	Proxies(int numProxies)
+	{
+		m_proxies.resize(numProxies);
+		for (int i = 0; i < numProxies; i++)
+		{
+			m_proxies[i].m_uniqueId = i + 1;
+			m_proxies[i].m_collisionFilterGroup = btBroadphaseProxy::DefaultFilter;
+			m_proxies[i].m_collisionFilterMask = btBroadphaseProxy::AllFilter;
+		}
+	}
+};
+
+std::vector<std::pair<int, int> > sortedPairs(btOverlappingPairCache& cache)
+{
+	std::vector<std::pair<int, int> > pairs;
+	for (int i = 0; i < cache.getNumOverlappingPairs(); i++)
+	{
+		const btBroadphasePair& pair = cache.getOverlappingPairArrayPtr()[i];
+		EXPECT_LT(pair.m_pProxy0->getUid(), pair.m_pProxy1->getUid());
+		pairs.push_back(std::make_pair(pair.m_pProxy0->getUid(), pair.m_pProxy1->getUid()));
+	}
+	std::sort(pairs.begin(), pairs.end());
+	return pairs;
+}
+
+struct RemoveProxyPairs : public btOverlapCallback
+{
+	int m_uid;
+
+	virtual bool processOverlap(btBroadphasePair& pair)
+	{
+		return pair.m_pProxy0->getUid() == m_uid || pair.m_pProxy1->getUid() == m_uid;
+	}
+};
+
+//visits the pairs and removes every third one it sees
+struct RemoveEveryThirdPair : public btOverlapCallback
+{
+	std::vector<std::pair<int, int> > m_visited;
+	std::vector<std::pair<int, int> > m_kept;
+
+	virtual bool processOverlap(btBroadphasePair& pair)
+	{
+		const std::pair<int, int> uids(pair.m_pProxy0->getUid(), pair.m_pProxy1->getUid());
+		m_visited.push_back(uids);
+		if (m_visited.size() % 3 == 0)
+		{
+			return true;
+		}
+		m_kept.push_back(uids);
+		return false;
+	}
+};
+
+}  // namespace
+
+GTEST_TEST(BulletCollision, OpenAddressedPairCacheDeterministicRemovesPairs)
+{
+	Proxies proxies(100);
+	btOpenAddressedOverlappingPairCache cache;
+
+	srand(13);
+	for (int i = 0; i < 2000; i++)
+	{
+		btBroadphaseProxy* a = &proxies.m_proxies[rand() % 100];
+		btBroadphaseProxy* b = &proxies.m_proxies[rand() % 100];
+		if (a != b)
+			cache.addOverlappingPair(a, b);
+	}
+	const std::vector<std::pair<int, int> > pairs = sortedPairs(cache);
+	ASSERT_GT(pairs.size(), 1000u);
+
+	btDispatcherInfo dispatchInfo;
+	dispatchInfo.m_deterministicOverlappingPairs = true;
+	RemoveEveryThirdPair callback;
+	cache.processAllOverlappingPairs(&callback, 0, dispatchInfo);
+
+	//every pair is visited once, in descending unique ids, also after the pairs before it were removed
+	std::vector<std::pair<int, int> > descending(pairs.rbegin(), pairs.rend());
+	EXPECT_EQ(descending, callback.m_visited);
+
+	std::sort(callback.m_kept.begin(), callback.m_kept.end());
+	EXPECT_EQ(callback.m_kept, sortedPairs(cache));
+	for (int i = 0; i < cache.getNumOverlappingPairs(); i++)
+	{
+		const btBroadphasePair& pair = cache.getOverlappingPairArrayPtr()[i];
+		EXPECT_EQ(&pair, cache.findPair(pair.m_pProxy0, pair.m_pProxy1));
+	}
+}
+
+GTEST_TEST(BulletCollision, OpenAddressedPairCacheMatchesHashedPairCache)
+{
+	Proxies proxies(300);
+	btHashedOverlappingPairCache hashed;
+	btOpenAddressedOverlappingPairCache openAddressed;
+
+	srand(11);
+	for (int i = 0; i < 50000; i++)
+	{
+		btBroadphaseProxy* a = &proxies.m_proxies[rand() % 300];
+		btBroadphaseProxy* b = &proxies.m_proxies[rand() % 300];
+		if (a == b)
+			continue;
+
+		switch (rand() % 4)
+		{
+			case 0:
+			case 1:
+			{
+				btBroadphasePair* expected = hashed.addOverlappingPair(a, b);
+				btBroadphasePair* actual = openAddressed.addOverlappingPair(a, b);
+				ASSERT_TRUE(expected && actual);
+				EXPECT_EQ(expected->m_pProxy0, actual->m_pProxy0);
+				EXPECT_EQ(expected->m_pProxy1, actual->m_pProxy1);
+				break;
+			}
+			case 2:
+			{
+				hashed.removeOverlappingPair(a, b, 0);
+				openAddressed.removeOverlappingPair(a, b, 0);
+				break;
+			}
+			default:
+			{
+				EXPECT_EQ(hashed.findPair(a, b) != 0, openAddressed.findPair(b, a) != 0);
+				break;
+			}
+		}
+	}
+	EXPECT_GT(openAddressed.getNumOverlappingPairs(), 1000);
+	EXPECT_EQ(sortedPairs(hashed), sortedPairs(openAddressed));
+
+	RemoveProxyPairs removeProxy;
+	removeProxy.m_uid = 17;
+	hashed.processAllOverlappingPairs(&removeProxy, 0);
+	openAddressed.processAllOverlappingPairs(&removeProxy, 0);
+	openAddressed.removeOverlappingPairsContainingProxy(&proxies.m_proxies[20], 0);
+	hashed.removeOverlappingPairsContainingProxy(&proxies.m_proxies[20], 0);
+	EXPECT_EQ(sortedPairs(hashed), sortedPairs(openAddressed));
+
+	openAddressed.sortOverlappingPairs(0);
+	EXPECT_EQ(sortedPairs(hashed), sortedPairs(openAddressed));
+	for (int i = 0; i < openAddressed.getNumOverlappingPairs(); i++)
+	{
+		const btBroadphasePair& pair = openAddressed.getOverlappingPairArrayPtr()[i];
+		EXPECT_EQ(&pair, openAddressed.findPair(pair.m_pProxy0, pair.m_pProxy1));
+	}
+}
+
+GTEST_TEST(BulletCollision, OpenAddressedPairCacheInBroadphase)
+{
+	btDefaultCollisionConfiguration configuration;
+	btCollisionDispatcher dispatcher(&configuration);
+	btOpenAddressedOverlappingPairCache pairCache;
+	btDbvtBroadphase broadphase(&pairCache);
+	btCollisionWorld world(&dispatcher, &broadphase, &configuration);
+
+	btBoxShape box(btVector3(1, 1, 1));
+	btCollisionObject objects[20];
+	for (int i = 0; i < 20; i++)
+	{
+		btTransform transform;
+		transform.setIdentity();
+		transform.setOrigin(btVector3(btScalar(i) * btScalar(1.5), 0, 0));
+		objects[i].setCollisionShape(&box);
+		objects[i].setWorldTransform(transform);
+		objects[i].setCollisionFlags(0);
+		world.addCollisionObject(&objects[i]);
+	}
+	world.performDiscreteCollisionDetection();
+	EXPECT_EQ(19, pairCache.getNumOverlappingPairs());
+	EXPECT_EQ(19, dispatcher.getNumManifolds());
+
+	world.removeCollisionObject(&objects[5]);
+	EXPECT_EQ(17, pairCache.getNumOverlappingPairs());
+	for (int i = 0; i < 20; i++)
+	{
+		if (i != 5)
+			world.removeCollisionObject(&objects[i]);
+	}
+	EXPECT_EQ(0, pairCache.getNumOverlappingPairs());
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,204 @@
+#include <btBulletCollisionCommon.h>
+#include <LinearMath/btThreads.h>
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+struct TriangleSoup
+{
+	std::vector<btScalar> m_vertices;
+	std::vector<int> m_indices;
+	btTriangleIndexVertexArray* m_mesh;
+
+	TriangleSoup(int numTriangles, unsigned int seed)
+	{
+		srand(seed);
+		for (int i = 0; i < numTriangles; i++)
+		{
+			btVector3 center(btScalar(rand() % 2000 - 1000), btScalar(rand() % 200), btScalar(rand() % 2000 - 1000));
+			for (int j = 0; j < 3; j++)
+			{
+				m_vertices.push_back(center.x() + btScalar(rand() % 100) * btScalar(0.1));
+				m_vertices.push_back(center.y() + btScalar(rand() % 100) * btScalar(0.1));
+				m_vertices.push_back(center.z() + btScalar(rand() % 100) * btScalar(0.1));
+				m_indices.push_back(i * 3 + j);
+			}
+		}
+		m_mesh = new btTriangleIndexVertexArray(numTriangles, &m_indices[0], 3 * sizeof(int),
+												 int(m_vertices.size() / 3), &m_vertices[0], 3 * sizeof(btScalar));
+	}
+
+	~TriangleSoup()
+	{
+		delete m_mesh;
+	}
+};
+
+struct CollectTriangles : public btNodeOverlapCallback
+{
+	std::vector<int> m_triangles;
+
+	virtual void processNode(int subPart, int triangleIndex)
+	{
+		m_triangles.push_back(triangleIndex);
+	}
+};
+
+btOptimizedBvh* buildBvh(TriangleSoup& soup, bool quantized, btQuantizedBvh::btBuildMode buildMode)
+{
+	btVector3 aabbMin, aabbMax;
+	soup.m_mesh->calculateAabbBruteForce(aabbMin, aabbMax);
+
+	btOptimizedBvh* bvh = new btOptimizedBvh();
+	bvh->setBuildMode(buildMode);
+	bvh->build(soup.m_mesh, quantized, aabbMin, aabbMax);
+	return bvh;
+}
+
+std::vector<int> query(const btOptimizedBvh* bvh, const btVector3& aabbMin, const btVector3& aabbMax)
+{
+	CollectTriangles callback;
+	bvh->reportAabbOverlappingNodex(&callback, aabbMin, aabbMax);
+	std::sort(callback.m_triangles.begin(), callback.m_triangles.end());
+	return callback.m_triangles;
+}
+
+void expectSameQueries(const btOptimizedBvh* expected, const btOptimizedBvh* actual)
+{
+	srand(7);
+	for (int i = 0; i < 200; i++)
+	{
+		btVector3 aabbMin(btScalar(rand() % 2200 - 1100), btScalar(rand() % 220 - 10), btScalar(rand() % 2200 - 1100));
+		btVector3 aabbMax = aabbMin + btVector3(btScalar(rand() % 300), btScalar(rand() % 100), btScalar(rand() % 300));
+		EXPECT_EQ(query(expected, aabbMin, aabbMax), query(actual, aabbMin, aabbMax));
+	}
+}
+
+}  // namespace
+
+GTEST_TEST(BulletCollision, OptimizedBvhSahMatchesMedianSplitQuantized)
+{
+	TriangleSoup soup(20000, 1);
+	btOptimizedBvh* median = buildBvh(soup, true, btQuantizedBvh::BUILD_MEDIAN_SPLIT);
+	btOptimizedBvh* sah = buildBvh(soup, true, btQuantizedBvh::BUILD_BINNED_SAH);
+
+	EXPECT_EQ(median->getQuantizedNodeArray().size(), sah->getQuantizedNodeArray().size());
+	EXPECT_GT(sah->getSubtreeInfoArray().size(), 0);
+	expectSameQueries(median, sah);
+
+	delete sah;
+	delete median;
+}
+
+GTEST_TEST(BulletCollision, OptimizedBvhSahMatchesMedianSplit)
+{
+	TriangleSoup soup(5000, 2);
+	btOptimizedBvh* median = buildBvh(soup, false, btQuantizedBvh::BUILD_MEDIAN_SPLIT);
+	btOptimizedBvh* sah = buildBvh(soup, false, btQuantizedBvh::BUILD_BINNED_SAH);
+
+	expectSameQueries(median, sah);
+
+	delete sah;
+	delete median;
+}
+
+GTEST_TEST(BulletCollision, OptimizedBvhSahIsDeterministic)
+{
+	TriangleSoup soup(20000, 3);
+	btOptimizedBvh* first = buildBvh(soup, true, btQuantizedBvh::BUILD_BINNED_SAH);
+	btOptimizedBvh* second = buildBvh(soup, true, btQuantizedBvh::BUILD_BINNED_SAH);
+
+	const QuantizedNodeArray& firstNodes = first->getQuantizedNodeArray();
+	const QuantizedNodeArray& secondNodes = second->getQuantizedNodeArray();
+	ASSERT_EQ(firstNodes.size(), secondNodes.size());
+	for (int i = 0; i < firstNodes.size(); i++)
+	{
+		EXPECT_EQ(firstNodes[i].m_escapeIndexOrTriangleIndex, secondNodes[i].m_escapeIndexOrTriangleIndex);
+	}
+
+	delete second;
+	delete first;
+}
+
+#if BT_THREADSAFE
+
+namespace {
+
+void expectSameNodes(btOptimizedBvh* expected, btOptimizedBvh* actual)
+{
+	const QuantizedNodeArray& expectedNodes = expected->getQuantizedNodeArray();
+	const QuantizedNodeArray& actualNodes = actual->getQuantizedNodeArray();
+	ASSERT_EQ(expectedNodes.size(), actualNodes.size());
+	for (int i = 0; i < expectedNodes.size(); i++)
+	{
+		EXPECT_EQ(expectedNodes[i].m_escapeIndexOrTriangleIndex, actualNodes[i].m_escapeIndexOrTriangleIndex);
+		for (int j = 0; j < 3; j++)
+		{
+			EXPECT_EQ(expectedNodes[i].m_quantizedAabbMin[j], actualNodes[i].m_quantizedAabbMin[j]);
+			EXPECT_EQ(expectedNodes[i].m_quantizedAabbMax[j], actualNodes[i].m_quantizedAabbMax[j]);
+		}
+	}
+
+	const BvhSubtreeInfoArray& expectedSubtrees = expected->getSubtreeInfoArray();
+	const BvhSubtreeInfoArray& actualSubtrees = actual->getSubtreeInfoArray();
+	ASSERT_EQ(expectedSubtrees.size(), actualSubtrees.size());
+	for (int i = 0; i < expectedSubtrees.size(); i++)
+	{
+		EXPECT_EQ(expectedSubtrees[i].m_rootNodeIndex, actualSubtrees[i].m_rootNodeIndex);
+		EXPECT_EQ(expectedSubtrees[i].m_subtreeSize, actualSubtrees[i].m_subtreeSize);
+	}
+}
+
+}  // namespace
+
+//the build runs on the calling thread without a task scheduler, and builds the same tree with any scheduler and thread count
+GTEST_TEST(BulletCollision, OptimizedBvhSahSameTreeWithAnyScheduler)
+{
+	TriangleSoup soup(20000, 5);
+
+	btSetTaskScheduler(NULL);
+	btOptimizedBvh* unscheduled = buildBvh(soup, true, btQuantizedBvh::BUILD_BINNED_SAH);
+
+	btSetTaskScheduler(btGetSequentialTaskScheduler());
+	btOptimizedBvh* sequential = buildBvh(soup, true, btQuantizedBvh::BUILD_BINNED_SAH);
+	expectSameNodes(unscheduled, sequential);
+	delete sequential;
+
+	btITaskScheduler* scheduler = btCreateDefaultTaskScheduler();
+	ASSERT_TRUE(scheduler != NULL);
+	btSetTaskScheduler(scheduler);
+	int threadCounts[] = {1, scheduler->getMaxNumThreads()};
+	for (int i = 0; i < 2; i++)
+	{
+		scheduler->setNumThreads(threadCounts[i]);
+		btOptimizedBvh* parallel = buildBvh(soup, true, btQuantizedBvh::BUILD_BINNED_SAH);
+		expectSameNodes(unscheduled, parallel);
+		delete parallel;
+	}
+
+	btSetTaskScheduler(btGetSequentialTaskScheduler());
+	delete scheduler;
+	delete unscheduled;
+}
+
+#endif  //BT_THREADSAFE
+
+GTEST_TEST(BulletCollision, OptimizedBvhSahSingleTriangle)
+{
+	TriangleSoup soup(1, 4);
+	btOptimizedBvh* sah = buildBvh(soup, true, btQuantizedBvh::BUILD_BINNED_SAH);
+
+	EXPECT_EQ(1, sah->getSubtreeInfoArray().size());
+	EXPECT_EQ(1u, query(sah, btVector3(-2000, -2000, -2000), btVector3(2000, 2000, 2000)).size());
+
+	delete sah;
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,171 @@
+#include <btBulletDynamicsCommon.h>
+#include <LinearMath/btAllocationTracker.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+btAllocationStats getStats(int tag)
+{
+	btAllocationStats stats;
+	btAllocationTrackerGetStats(tag, stats);
+	return stats;
+}
+
+}  // namespace
+
+GTEST_TEST(LinearMath, AllocationTrackerCountsPerTag)
+{
+	ASSERT_TRUE(btAllocationTrackerIsInstalled());
+	btAllocationTrackerResetStats();
+	btAllocationStats before = getStats(BT_ALLOCATION_TAG_USER);
+
+	void* untagged = btAlignedAlloc(10, 16);
+	void* blocks[3];
+	{
+		BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_USER);
+		EXPECT_EQ(int(BT_ALLOCATION_TAG_USER), btAllocationTrackerGetCurrentTag());
+		const int alignments[3] = {4, 16, 128};
+		for (int i = 0; i < 3; i++)
+		{
+			blocks[i] = btAlignedAlloc(100, alignments[i]);
+			EXPECT_EQ(size_t(0), size_t(blocks[i]) % alignments[i]);
+		}
+		{
+			BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SOLVER);
+			EXPECT_EQ(int(BT_ALLOCATION_TAG_SOLVER), btAllocationTrackerGetCurrentTag());
+		}
+		EXPECT_EQ(int(BT_ALLOCATION_TAG_USER), btAllocationTrackerGetCurrentTag());
+		//a second tag in the same scope is current until the scope ends, then both are undone
+		{
+			BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SOLVER);
+			BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SHAPES);
+			EXPECT_EQ(int(BT_ALLOCATION_TAG_SHAPES), btAllocationTrackerGetCurrentTag());
+		}
+		EXPECT_EQ(int(BT_ALLOCATION_TAG_USER), btAllocationTrackerGetCurrentTag());
+	}
+	EXPECT_EQ(int(BT_ALLOCATION_TAG_UNTAGGED), btAllocationTrackerGetCurrentTag());
+
+	btAllocationStats user = getStats(BT_ALLOCATION_TAG_USER);
+	EXPECT_EQ(before.m_numAllocations + 3, user.m_numAllocations);
+	EXPECT_EQ(before.m_bytesInUse + 300, user.m_bytesInUse);
+	EXPECT_EQ(before.m_numLiveAllocations + 3, user.m_numLiveAllocations);
+	EXPECT_EQ(user.m_bytesInUse, user.m_peakBytesInUse);
+
+	//frees count for the tag of the allocation
+	{
+		BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_SHAPES);
+		for (int i = 0; i < 3; i++)
+		{
+			btAlignedFree(blocks[i]);
+		}
+	}
+	user = getStats(BT_ALLOCATION_TAG_USER);
+	EXPECT_EQ(before.m_numFrees + 3, user.m_numFrees);
+	EXPECT_EQ(before.m_bytesInUse, user.m_bytesInUse);
+	EXPECT_EQ(before.m_bytesInUse + 300, user.m_peakBytesInUse);
+	EXPECT_EQ(before.m_bytesAllocated + 300, user.m_bytesAllocated);
+
+	btAllocationStats total = getStats(-1);
+	EXPECT_GE(total.m_bytesInUse, size_t(10));
+	btAlignedFree(untagged);
+	EXPECT_EQ(total.m_bytesInUse - 10, getStats(-1).m_bytesInUse);
+
+	btAllocationTrackerSetTagName(BT_ALLOCATION_TAG_USER + 1, "audio");
+	EXPECT_STREQ("audio", btAllocationTrackerGetTagName(BT_ALLOCATION_TAG_USER + 1));
+	EXPECT_STREQ("manifolds", btAllocationTrackerGetTagName(BT_ALLOCATION_TAG_MANIFOLDS));
+}
+
+GTEST_TEST(LinearMath, AllocationTrackerTicks)
+{
+	btAllocationTrackerResetStats();
+	EXPECT_EQ(0, btAllocationTrackerGetNumTicks());
+
+	BT_ALLOCATION_TAG(BT_ALLOCATION_TAG_USER);
+	btAlignedObjectArray<int> array;
+	for (int tick = 0; tick < 3; tick++)
+	{
+		array.clear();
+		for (int i = 0; i < 100; i++)
+		{
+			array.push_back(i);
+		}
+		btAllocationTrackerTick();
+	}
+	btAllocationStats user = getStats(BT_ALLOCATION_TAG_USER);
+	EXPECT_EQ(3, btAllocationTrackerGetNumTicks());
+	//the array grows 1, 2, 4 .. 128 in every tick, and frees the smaller buffers
+	EXPECT_EQ(8, user.m_numAllocationsLastTick);
+	EXPECT_EQ(0, user.m_numAllocationsThisTick);
+	EXPECT_EQ(size_t(4 * (1 + 2 + 4 + 8 + 16 + 32 + 64 + 128)), user.m_bytesAllocatedLastTick);
+	EXPECT_EQ(size_t(4 * 128), user.m_bytesInUse);
+}
+
+//a small stack of boxes, that allocates in all subsystems while it settles, and then only reuses its buffers
+GTEST_TEST(BulletDynamics, AllocationTrackerSubsystems)
+{
+	btAllocationTrackerResetStats();
+	{
+		btDefaultCollisionConfiguration config;
+		btCollisionDispatcher dispatcher(&config);
+		btDbvtBroadphase broadphase;
+		btSequentialImpulseConstraintSolver solver;
+		btDiscreteDynamicsWorld world(&dispatcher, &broadphase, &solver, &config);
+
+		btBoxShape ground(btVector3(10, 1, 10));
+		btCompoundShape compound;
+		btBoxShape box(btVector3(btScalar(0.5), btScalar(0.5), btScalar(0.5)));
+		btTransform transform;
+		transform.setIdentity();
+		compound.addChildShape(transform, &box);
+
+		btRigidBody groundBody(0, 0, &ground);
+		groundBody.setWorldTransform(btTransform(btQuaternion::getIdentity(), btVector3(0, -1, 0)));
+		world.addRigidBody(&groundBody);
+		btAlignedObjectArray<btRigidBody*> bodies;
+		for (int i = 0; i < 8; i++)
+		{
+			btVector3 inertia;
+			compound.calculateLocalInertia(1, inertia);
+			btRigidBody* body = new btRigidBody(1, 0, &compound, inertia);
+			body->setWorldTransform(btTransform(btQuaternion::getIdentity(), btVector3(btScalar(i % 2) * btScalar(0.3), btScalar(0.5) + btScalar(i), 0)));
+			world.addRigidBody(body);
+			bodies.push_back(body);
+		}
+
+		for (int step = 0; step < 120; step++)
+		{
+			world.stepSimulation(btScalar(1.) / btScalar(60.), 0);
+			btAllocationTrackerTick();
+		}
+		const int tags[4] = {BT_ALLOCATION_TAG_BROADPHASE, BT_ALLOCATION_TAG_MANIFOLDS, BT_ALLOCATION_TAG_SOLVER, BT_ALLOCATION_TAG_SHAPES};
+		for (int i = 0; i < 4; i++)
+		{
+			btAllocationStats stats = getStats(tags[i]);
+			EXPECT_GT(stats.m_numAllocations, 0ull) << btAllocationTrackerGetTagName(tags[i]);
+			EXPECT_GT(stats.m_peakBytesInUse, size_t(0)) << btAllocationTrackerGetTagName(tags[i]);
+		}
+		EXPECT_GT(getStats(BT_ALLOCATION_TAG_MANIFOLDS).m_numLiveAllocations, 0);
+
+		//at rest nothing allocates per step
+		EXPECT_EQ(0, getStats(-1).m_numAllocationsLastTick);
+
+		for (int i = 0; i < bodies.size(); i++)
+		{
+			world.removeRigidBody(bodies[i]);
+			delete bodies[i];
+		}
+		world.removeRigidBody(&groundBody);
+	}
+	EXPECT_EQ(0, getStats(BT_ALLOCATION_TAG_MANIFOLDS).m_numLiveAllocations);
+	EXPECT_EQ(size_t(0), getStats(BT_ALLOCATION_TAG_SOLVER).m_bytesInUse);
+}
+
+int main(int argc, char** argv)
+{
+	//before anything is allocated by Bullet
+	btAllocationTrackerInstall();
+	::testing::InitGoogleTest(&argc, argv);
+	int result = RUN_ALL_TESTS();
+	btAllocationTrackerUninstall();
+	return result;
+}
@@ -0,0 +1,185 @@
+#include <btBulletDynamicsCommon.h>
+#include <BulletDynamics/ConstraintSolver/btSequentialImpulseConstraintSolverMt.h>
+#include <BulletCollision/CollisionDispatch/btSimulationIslandManager.h>
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+namespace {
+
+struct TestSolver : public btSequentialImpulseConstraintSolverMt
+{
+	int m_numSoaSolves;
+
+	TestSolver() : m_numSoaSolves(0) {}
+
+	virtual btScalar solveGroupCacheFriendlySetup(btCollisionObject** bodies, int numBodies, btPersistentManifold** manifoldPtr, int numManifolds, btTypedConstraint** constraints, int numConstraints, const btContactSolverInfo& infoGlobal, btIDebugDraw* debugDrawer)
+	{
+		btScalar result = btSequentialImpulseConstraintSolverMt::solveGroupCacheFriendlySetup(bodies, numBodies, manifoldPtr, numManifolds, constraints, numConstraints, infoGlobal, debugDrawer);
+		m_numSoaSolves += m_useSoaContactConstraints;
+		return result;
+	}
+};
+
+//a wall of boxes on the ground, solved as one island, so the solver batches its contacts
+struct TestScene
+{
+	btDefaultCollisionConfiguration m_config;
+	btCollisionDispatcher m_dispatcher;
+	btDbvtBroadphase m_broadphase;
+	TestSolver m_solver;
+	btDiscreteDynamicsWorld m_world;
+	btBoxShape m_groundShape;
+	btBoxShape m_boxShape;
+	btRigidBody* m_ground;
+	btAlignedObjectArray<btRigidBody*> m_boxes;
+
+	TestScene(int solverMode, bool scaleFactors)
+		: m_dispatcher(&m_config),
+		  m_world(&m_dispatcher, &m_broadphase, &m_solver, &m_config),
+		  m_groundShape(btVector3(100, 1, 100)),
+		  m_boxShape(btVector3(btScalar(0.5), btScalar(0.5), btScalar(0.5)))
+	{
+		m_world.getSolverInfo().m_solverMode = solverMode;
+		m_world.getSimulationIslandManager()->setSplitIslands(false);
+
+		btTransform transform;
+		transform.setIdentity();
+		transform.setOrigin(btVector3(0, -1, 0));
+		m_ground = new btRigidBody(btRigidBody::btRigidBodyConstructionInfo(0, NULL, &m_groundShape));
+		m_ground->setWorldTransform(transform);
+		m_world.addRigidBody(m_ground);
+
+		btVector3 inertia;
+		m_boxShape.calculateLocalInertia(1, inertia);
+		for (int y = 0; y < 4; y++)
+		{
+			for (int z = 0; z < 10; z++)
+			{
+				for (int x = 0; x < 10; x++)
+				{
+					//every other layer is shifted by half a box, and the boxes slide apart, so friction has work to do
+					transform.setOrigin(btVector3(btScalar(x) * btScalar(1.1) + btScalar(y & 1) * btScalar(0.5), btScalar(y) * btScalar(1.01) + btScalar(0.5), btScalar(z) * btScalar(1.1)));
+					btRigidBody* box = new btRigidBody(btRigidBody::btRigidBodyConstructionInfo(1, NULL, &m_boxShape, inertia));
+					box->setWorldTransform(transform);
+					box->setLinearVelocity(btVector3(btScalar((x + y) % 3 - 1), 0, btScalar((z + y) % 3 - 1)));
+					box->setActivationState(DISABLE_DEACTIVATION);
+					if (scaleFactors)
+					{
+						//factors that are not powers of two round differently when they are applied before the impulse
+						box->setLinearFactor(btVector3(btScalar(0.9), btScalar(0.7) + btScalar(x) * btScalar(0.01), btScalar(1.1)));
+						box->setAngularFactor(btVector3(btScalar(0.3), btScalar(0.6) + btScalar(z) * btScalar(0.01), btScalar(0.8)));
+					}
+					m_boxes.push_back(box);
+					m_world.addRigidBody(box);
+				}
+			}
+		}
+	}
+
+	~TestScene()
+	{
+		for (int i = 0; i < m_boxes.size(); i++)
+		{
+			m_world.removeRigidBody(m_boxes[i]);
+			delete m_boxes[i];
+		}
+		m_world.removeRigidBody(m_ground);
+		delete m_ground;
+	}
+
+	void step(btSoaContactConstraints::Kernel kernel)
+	{
+		btSequentialImpulseConstraintSolverMt::s_soaContactKernel = kernel;
+		m_world.stepSimulation(btScalar(1) / btScalar(60), 0);
+	}
+
+	bool equalBits(const TestScene& other) const
+	{
+		for (int i = 0; i < m_boxes.size(); i++)
+		{
+			const btRigidBody* a = m_boxes[i];
+			const btRigidBody* b = other.m_boxes[i];
+			if (memcmp(&a->getWorldTransform(), &b->getWorldTransform(), sizeof(btTransform)) != 0 ||
+				memcmp(&a->getLinearVelocity(), &b->getLinearVelocity(), sizeof(btVector3)) != 0 ||
+				memcmp(&a->getAngularVelocity(), &b->getAngularVelocity(), sizeof(btVector3)) != 0)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+};
+
+void testKernelMatchesRows(btSoaContactConstraints::Kernel kernel, int solverMode, bool scaleFactors = false)
+{
+	btSoaContactConstraints::Kernel defaultKernel = btSequentialImpulseConstraintSolverMt::s_soaContactKernel;
+	TestScene rows(solverMode, scaleFactors);
+	TestScene soa(solverMode, scaleFactors);
+	for (int step = 0; step < 60; step++)
+	{
+		rows.step(btSoaContactConstraints::KERNEL_NONE);
+		soa.step(kernel);
+		EXPECT_EQ(0, rows.m_solver.m_numSoaSolves);
+		EXPECT_EQ(step + 1, soa.m_solver.m_numSoaSolves);
+		ASSERT_TRUE(rows.equalBits(soa)) << "kernel " << kernel << " step " << step;
+	}
+	//the wall settled instead of exploding
+	for (int i = 0; i < soa.m_boxes.size(); i++)
+	{
+		ASSERT_GT(soa.m_boxes[i]->getWorldTransform().getOrigin().y(), btScalar(0));
+		ASSERT_LT(soa.m_boxes[i]->getLinearVelocity().length(), btScalar(1));
+	}
+	btSequentialImpulseConstraintSolverMt::s_soaContactKernel = defaultKernel;
+}
+
+}  // namespace
+
+GTEST_TEST(BulletDynamics, SoaContactConstraintsSupportedKernel)
+{
+	EXPECT_EQ(btSoaContactConstraints::KERNEL_NONE, btSoaContactConstraints::getSupportedKernel(btSoaContactConstraints::KERNEL_NONE));
+	EXPECT_EQ(btSoaContactConstraints::KERNEL_SCALAR, btSoaContactConstraints::getSupportedKernel(btSoaContactConstraints::KERNEL_SCALAR));
+	EXPECT_EQ(btSoaContactConstraints::getBestKernel(), btSequentialImpulseConstraintSolverMt::s_soaContactKernel);
+	EXPECT_GE(btSoaContactConstraints::getBestKernel(), btSoaContactConstraints::KERNEL_SCALAR);
+}
+
+#if BT_THREADSAFE
+
+//the kernels resolve the rows of each batch in the same order and with the same arithmetic as the solver, so they agree to the bit
+GTEST_TEST(BulletDynamics, SoaContactConstraintsMatchRows)
+{
+	for (int kernel = btSoaContactConstraints::KERNEL_SCALAR; kernel < btSoaContactConstraints::KERNEL_COUNT; kernel++)
+	{
+		if (btSoaContactConstraints::getSupportedKernel(btSoaContactConstraints::Kernel(kernel)) == kernel)
+		{
+			testKernelMatchesRows(btSoaContactConstraints::Kernel(kernel), SOLVER_USE_WARMSTARTING | SOLVER_SIMD);
+		}
+	}
+}
+
+GTEST_TEST(BulletDynamics, SoaContactConstraintsMatchRowsTwoFrictionDirections)
+{
+	testKernelMatchesRows(btSoaContactConstraints::getBestKernel(), SOLVER_USE_WARMSTARTING | SOLVER_SIMD | SOLVER_USE_2_FRICTION_DIRECTIONS);
+}
+
+GTEST_TEST(BulletDynamics, SoaContactConstraintsMatchRowsLinearAndAngularFactors)
+{
+	for (int kernel = btSoaContactConstraints::KERNEL_SCALAR; kernel < btSoaContactConstraints::KERNEL_COUNT; kernel++)
+	{
+		if (btSoaContactConstraints::getSupportedKernel(btSoaContactConstraints::Kernel(kernel)) == kernel)
+		{
+			testKernelMatchesRows(btSoaContactConstraints::Kernel(kernel), SOLVER_USE_WARMSTARTING | SOLVER_SIMD, true);
+		}
+	}
+}
+
+#endif  //BT_THREADSAFE
+
+int main(int argc, char** argv)
+{
+#if BT_THREADSAFE
+	btSetTaskScheduler(btGetSequentialTaskScheduler());
+#endif
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
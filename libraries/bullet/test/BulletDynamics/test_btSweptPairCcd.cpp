@@ -0,0 +1,150 @@
+#include <btBulletDynamicsCommon.h>
+#include <gtest/gtest.h>
+
+namespace {
+
+//thin cards that are shot at each other, or at a thin static wall, fast enough to pass through in a single step
+struct TestScene
+{
+	btDefaultCollisionConfiguration m_config;
+	btCollisionDispatcher m_dispatcher;
+	btDbvtBroadphase m_broadphase;
+	btSequentialImpulseConstraintSolver m_solver;
+	btDiscreteDynamicsWorld m_world;
+	btBoxShape m_wallShape;
+	btBoxShape m_cardShape;
+	btAlignedObjectArray<btRigidBody*> m_bodies;
+
+	TestScene(bool useSweptPairCcd)
+		: m_dispatcher(&m_config),
+		  m_world(&m_dispatcher, &m_broadphase, &m_solver, &m_config),
+		  m_wallShape(btVector3(btScalar(0.05), 10, 10)),
+		  m_cardShape(btVector3(btScalar(0.02), btScalar(0.97), btScalar(0.65)))
+	{
+		m_world.setGravity(btVector3(0, 0, 0));
+		m_world.setUseSweptPairCcd(useSweptPairCcd);
+	}
+
+	~TestScene()
+	{
+		for (int i = 0; i < m_bodies.size(); i++)
+		{
+			m_world.removeRigidBody(m_bodies[i]);
+			delete m_bodies[i];
+		}
+	}
+
+	btRigidBody* addBody(btBoxShape* shape, btScalar mass, const btVector3& position, const btVector3& velocity)
+	{
+		btVector3 inertia(0, 0, 0);
+		if (mass > 0)
+			shape->calculateLocalInertia(mass, inertia);
+		btRigidBody* body = new btRigidBody(mass, 0, shape, inertia);
+		body->setWorldTransform(btTransform(btQuaternion::getIdentity(), position));
+		body->setLinearVelocity(velocity);
+		body->setRestitution(0);
+		if (mass > 0)
+		{
+			body->setCcdMotionThreshold(btScalar(0.02));
+			body->setCcdSweptSphereRadius(btScalar(0.02));
+		}
+		m_world.addRigidBody(body);
+		m_bodies.push_back(body);
+		return body;
+	}
+
+	void step(int numSteps)
+	{
+		for (int i = 0; i < numSteps; i++)
+		{
+			m_world.stepSimulation(btScalar(1.) / btScalar(60.), 0);
+		}
+	}
+};
+
+}  // namespace
+
+GTEST_TEST(BulletDynamics, SweptPairCcdStopsCardAtThinWall)
+{
+	const btVector3 velocity(600, 0, 0);  //10 units per step
+	{
+		TestScene scene(false);
+		scene.addBody(&scene.m_wallShape, 0, btVector3(5, 0, 0), btVector3(0, 0, 0));
+		btRigidBody* card = scene.addBody(&scene.m_cardShape, 1, btVector3(0, 0, 0), velocity);
+		card->setCcdMotionThreshold(0);
+		scene.step(2);
+		//without CCD the card passes through the wall
+		EXPECT_GT(card->getWorldTransform().getOrigin().x(), btScalar(5.));
+	}
+	{
+		TestScene scene(true);
+		scene.addBody(&scene.m_wallShape, 0, btVector3(5, 0, 0), btVector3(0, 0, 0));
+		btRigidBody* card = scene.addBody(&scene.m_cardShape, 1, btVector3(0, 0, 0), velocity);
+		scene.step(1);
+		EXPECT_EQ(1, scene.m_world.getNumSweptPairCcdQueries());
+		scene.step(10);
+		EXPECT_LT(card->getWorldTransform().getOrigin().x(), btScalar(5.));
+		EXPECT_GT(card->getWorldTransform().getOrigin().x(), btScalar(4.));
+	}
+}
+
+//the card rests until the solver resolves the hit of the box, so its broadphase AABB, swept before the solver, misses the wall
+GTEST_TEST(BulletDynamics, SweptPairCcdStopsCardThatTheSolverSpedUp)
+{
+	TestScene scene(true);
+	btBoxShape boxShape(btVector3(btScalar(0.5), btScalar(0.5), btScalar(0.5)));
+	scene.addBody(&scene.m_wallShape, 0, btVector3(5, 0, 0), btVector3(0, 0, 0));
+	btRigidBody* card = scene.addBody(&scene.m_cardShape, 1, btVector3(0, 0, 0), btVector3(0, 0, 0));
+	scene.addBody(&boxShape, 100, btVector3(btScalar(-0.52), 0, 0), btVector3(600, 0, 0));
+	scene.step(1);
+	EXPECT_GT(card->getLinearVelocity().x(), btScalar(300.));
+	EXPECT_LT(card->getWorldTransform().getOrigin().x(), btScalar(5.));
+	scene.step(10);
+	EXPECT_LT(card->getWorldTransform().getOrigin().x(), btScalar(5.));
+	EXPECT_GT(card->getWorldTransform().getOrigin().x(), btScalar(4.));
+}
+
+GTEST_TEST(BulletDynamics, SweptPairCcdCardsDontPassEachOther)
+{
+	TestScene scene(true);
+	btRigidBody* left = scene.addBody(&scene.m_cardShape, 1, btVector3(-6, 0, 0), btVector3(300, 0, 0));
+	btRigidBody* right = scene.addBody(&scene.m_cardShape, 1, btVector3(6, 0, 0), btVector3(-300, 0, 0));
+	for (int i = 0; i < 10; i++)
+	{
+		scene.step(1);
+		EXPECT_LT(left->getWorldTransform().getOrigin().x(), right->getWorldTransform().getOrigin().x()) << "step " << i;
+	}
+}
+
+GTEST_TEST(BulletDynamics, SweptPairCcdSkipsSlowBodies)
+{
+	TestScene scene(true);
+	scene.m_world.setGravity(btVector3(0, -10, 0));
+	btBoxShape ground(btVector3(50, 1, 50));
+	btBoxShape box(btVector3(btScalar(0.5), btScalar(0.5), btScalar(0.5)));
+	scene.addBody(&ground, 0, btVector3(0, -1, 0), btVector3(0, 0, 0));
+	btAlignedObjectArray<btRigidBody*> boxes;
+	for (int i = 0; i < 5; i++)
+	{
+		boxes.push_back(scene.addBody(&box, 1, btVector3(0, btScalar(0.5) + btScalar(i), 0), btVector3(0, 0, 0)));
+		boxes[i]->setCcdMotionThreshold(btScalar(0.25));
+	}
+	int numQueries = 0;
+	for (int i = 0; i < 60; i++)
+	{
+		scene.step(1);
+		numQueries += scene.m_world.getNumSweptPairCcdQueries();
+	}
+	//a resting stack never moves fast enough for a time of impact query
+	EXPECT_EQ(0, numQueries);
+	for (int i = 0; i < boxes.size(); i++)
+	{
+		EXPECT_NEAR(btScalar(0.5) + btScalar(i), boxes[i]->getWorldTransform().getOrigin().y(), btScalar(0.05));
+	}
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
@@ -0,0 +1,158 @@
+///Benchmark for btOptimizedBvh::build, comparing the median split build with the (parallel) binned SAH build.
+///Usage: Test_BvhBuildBenchmark [maxTriangleCount]
+///For each mesh size it reports the build time and the average number of nodes visited per AABB query.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "btBulletCollisionCommon.h"
+#include "LinearMath/btAabbUtil2.h"
+#include "LinearMath/btQuickprof.h"
+#include "LinearMath/btThreads.h"
+
+#include <vector>
+
+struct BenchmarkMesh
+{
+	std::vector<btScalar> m_vertices;
+	std::vector<int> m_indices;
+	btTriangleIndexVertexArray* m_mesh;
+
+	///a mix of a regular terrain grid and clustered props, similar to an imported level
+	BenchmarkMesh(int numTriangles)
+	{
+		srand(numTriangles);
+
+		int numTerrainTriangles = numTriangles / 2;
+		int gridSize = int(btSqrt(btScalar(numTerrainTriangles / 2)));
+		for (int z = 0; z <= gridSize; z++)
+		{
+			for (int x = 0; x <= gridSize; x++)
+			{
+				m_vertices.push_back(btScalar(x));
+				m_vertices.push_back(btSin(btScalar(x) * btScalar(0.05)) * btCos(btScalar(z) * btScalar(0.05)) * btScalar(4.));
+				m_vertices.push_back(btScalar(z));
+			}
+		}
+		for (int z = 0; z < gridSize; z++)
+		{
+			for (int x = 0; x < gridSize; x++)
+			{
+				int i = z * (gridSize + 1) + x;
+				int quad[6] = {i, i + 1, i + gridSize + 1, i + 1, i + gridSize + 2, i + gridSize + 1};
+				m_indices.insert(m_indices.end(), quad, quad + 6);
+			}
+		}
+
+		int numPropTriangles = numTriangles - int(m_indices.size() / 3);
+		btVector3 cluster(0, 0, 0);
+		for (int i = 0; i < numPropTriangles; i++)
+		{
+			if ((i % 512) == 0)
+			{
+				cluster.setValue(btScalar(rand() % (gridSize + 1)), btScalar(rand() % 16), btScalar(rand() % (gridSize + 1)));
+			}
+			for (int j = 0; j < 3; j++)
+			{
+				m_indices.push_back(int(m_vertices.size() / 3));
+				m_vertices.push_back(cluster.x() + btScalar(rand() % 1000) * btScalar(0.004));
+				m_vertices.push_back(cluster.y() + btScalar(rand() % 1000) * btScalar(0.004));
+				m_vertices.push_back(cluster.z() + btScalar(rand() % 1000) * btScalar(0.004));
+			}
+		}
+
+		m_mesh = new btTriangleIndexVertexArray(int(m_indices.size() / 3), &m_indices[0], 3 * sizeof(int),
+												 int(m_vertices.size() / 3), &m_vertices[0], 3 * sizeof(btScalar));
+	}
+
+	~BenchmarkMesh()
+	{
+		delete m_mesh;
+	}
+};
+
+///replicates the stackless quantized traversal and counts the visited nodes
+static int countNodeVisits(btOptimizedBvh* bvh, const btVector3& aabbMin, const btVector3& aabbMax)
+{
+	unsigned short int quantizedQueryAabbMin[3];
+	unsigned short int quantizedQueryAabbMax[3];
+	bvh->quantizeWithClamp(quantizedQueryAabbMin, aabbMin, 0);
+	bvh->quantizeWithClamp(quantizedQueryAabbMax, aabbMax, 1);
+
+	const QuantizedNodeArray& nodes = bvh->getQuantizedNodeArray();
+	//the node array holds 2n entries for n leaf nodes, of which 2n-1 are used
+	int numNodes = nodes.size() - 1;
+	int visits = 0;
+	int curIndex = 0;
+	while (curIndex < numNodes)
+	{
+		const btQuantizedBvhNode& node = nodes[curIndex];
+		visits++;
+		bool overlap = testQuantizedAabbAgainstQuantizedAabb(quantizedQueryAabbMin, quantizedQueryAabbMax, node.m_quantizedAabbMin, node.m_quantizedAabbMax) != 0;
+		if (overlap || node.isLeafNode())
+		{
+			curIndex++;
+		}
+		else
+		{
+			curIndex += node.getEscapeIndex();
+		}
+	}
+	return visits;
+}
+
+static void runBenchmark(int numTriangles, btQuantizedBvh::btBuildMode buildMode, const char* name)
+{
+	BenchmarkMesh mesh(numTriangles);
+
+	btVector3 aabbMin, aabbMax;
+	mesh.m_mesh->calculateAabbBruteForce(aabbMin, aabbMax);
+
+	btOptimizedBvh* bvh = new btOptimizedBvh();
+	bvh->setBuildMode(buildMode);
+
+	btClock clock;
+	bvh->build(mesh.m_mesh, true, aabbMin, aabbMax);
+	unsigned long long int buildTime = clock.getTimeMicroseconds();
+
+	const int numQueries = 10000;
+	btVector3 extent = aabbMax - aabbMin;
+	long long int visits = 0;
+	srand(1);
+	for (int i = 0; i < numQueries; i++)
+	{
+		btVector3 queryMin = aabbMin + extent * btVector3(btScalar(rand()) / RAND_MAX, btScalar(rand()) / RAND_MAX, btScalar(rand()) / RAND_MAX);
+		btVector3 queryMax = queryMin + btVector3(2, 2, 2);
+		visits += countNodeVisits(bvh, queryMin, queryMax);
+	}
+
+	printf("%10d triangles  %-12s build %10.2f ms  %8.1f nodes/query\n", numTriangles, name, double(buildTime) / 1000.0, double(visits) / numQueries);
+
+	delete bvh;
+}
+
+int main(int argc, char* argv[])
+{
+	int maxTriangleCount = 10000000;
+	if (argc > 1)
+	{
+		maxTriangleCount = atoi(argv[1]);
+	}
+
+#if BT_THREADSAFE
+	btITaskScheduler* scheduler = btCreateDefaultTaskScheduler();
+	if (scheduler)
+	{
+		btSetTaskScheduler(scheduler);
+	}
+	printf("task scheduler: %s, %d threads\n", btGetTaskScheduler()->getName(), btGetTaskScheduler()->getNumThreads());
+#endif
+
+	for (int numTriangles = 100000; numTriangles <= maxTriangleCount; numTriangles *= 10)
+	{
+		runBenchmark(numTriangles, btQuantizedBvh::BUILD_MEDIAN_SPLIT, "median");
+		runBenchmark(numTriangles, btQuantizedBvh::BUILD_BINNED_SAH, "binned SAH");
+	}
+
+	return 0;
+}
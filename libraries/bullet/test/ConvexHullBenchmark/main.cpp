@@ -0,0 +1,158 @@
+///Benchmark for btConvexHullComputer, comparing the serial build with the parallel divide and conquer build, and
+///incremental edits with addPoints against recomputing the hull.
+///Usage: Test_ConvexHullBenchmark [maxPointCount]
+///The inputs are similar to the pieces of a convex decomposition: clusters of surface samples of smooth parts,
+///with many points inside the hull and many on it.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "LinearMath/btConvexHullComputer.h"
+#include "LinearMath/btQuickprof.h"
+#include "LinearMath/btThreads.h"
+
+#include <vector>
+
+static btScalar randomScalar()
+{
+	return btScalar(rand()) / btScalar(RAND_MAX) * btScalar(2.) - btScalar(1.);
+}
+
+///samples of a squashed, bumpy ellipsoid, two thirds on its surface and the rest inside, like a piece of a decomposed mesh
+static void makePiece(std::vector<btVector3>& points, int numPoints, const btVector3& center, const btVector3& extent)
+{
+	for (int i = 0; i < numPoints; i++)
+	{
+		btVector3 p(randomScalar(), randomScalar(), randomScalar());
+		p.safeNormalize();
+		btScalar bump = btScalar(1.) + btScalar(0.05) * btSin(p.x() * btScalar(9.)) * btCos(p.z() * btScalar(7.));
+		if ((i % 3) == 2)
+		{
+			bump *= btFabs(randomScalar());
+		}
+		points.push_back(center + p * extent * bump);
+	}
+}
+
+static int computeHull(btConvexHullComputer& computer, const std::vector<btVector3>& points, int numTasks)
+{
+	computer.computeParallel(&points[0][0], sizeof(btVector3), int(points.size()), btScalar(0.), btScalar(0.), numTasks);
+	return computer.vertices.size();
+}
+
+static void runLargeHull(int numPoints, int numTasks)
+{
+	srand(numPoints);
+	std::vector<btVector3> points;
+	makePiece(points, numPoints, btVector3(0, 0, 0), btVector3(4, 1, 2));
+
+	btConvexHullComputer computer;
+	btClock clock;
+	int numVertices = computeHull(computer, points, 1);
+	unsigned long long int serialTime = clock.getTimeMicroseconds();
+
+	clock.reset();
+	computeHull(computer, points, numTasks);
+	unsigned long long int parallelTime = clock.getTimeMicroseconds();
+
+	printf("%10d points      %6d vertices  serial %10.2f ms  parallel %10.2f ms\n", numPoints, numVertices,
+		   double(serialTime) / 1000.0, double(parallelTime) / 1000.0);
+}
+
+static void runDecomposition(int numPieces, int numTasks)
+{
+	srand(numPieces);
+	std::vector<std::vector<btVector3> > pieces(numPieces);
+	for (int i = 0; i < numPieces; i++)
+	{
+		btVector3 center(randomScalar() * btScalar(50.), randomScalar() * btScalar(50.), randomScalar() * btScalar(50.));
+		btVector3 extent(btScalar(1.5) + randomScalar(), btScalar(1.5) + randomScalar(), btScalar(1.5) + randomScalar());
+		makePiece(pieces[i], 256 + rand() % 4096, center, extent);
+	}
+
+	btConvexHullComputer computer;
+	btClock clock;
+	for (int i = 0; i < numPieces; i++)
+	{
+		computeHull(computer, pieces[i], 1);
+	}
+	unsigned long long int serialTime = clock.getTimeMicroseconds();
+
+	clock.reset();
+	for (int i = 0; i < numPieces; i++)
+	{
+		computeHull(computer, pieces[i], numTasks);
+	}
+	unsigned long long int parallelTime = clock.getTimeMicroseconds();
+
+	printf("%10d pieces                     serial %10.2f ms  parallel %10.2f ms\n", numPieces,
+		   double(serialTime) / 1000.0, double(parallelTime) / 1000.0);
+}
+
+///an edit of a piece adds a batch of points, of which only a share is outside of the hull
+static void runEdits(int numPoints, int numEdits, int pointsPerEdit)
+{
+	srand(numPoints);
+	std::vector<btVector3> points;
+	makePiece(points, numPoints, btVector3(0, 0, 0), btVector3(2, 2, 2));
+
+	std::vector<std::vector<btVector3> > edits(numEdits);
+	for (int i = 0; i < numEdits; i++)
+	{
+		makePiece(edits[i], pointsPerEdit, btVector3(randomScalar(), randomScalar(), randomScalar()) * btScalar(0.2), btVector3(2, 2, 2));
+	}
+
+	btConvexHullComputer incremental;
+	computeHull(incremental, points, 1);
+	btClock clock;
+	for (int i = 0; i < numEdits; i++)
+	{
+		incremental.addPoints(&edits[i][0][0], sizeof(btVector3), pointsPerEdit);
+	}
+	unsigned long long int incrementalTime = clock.getTimeMicroseconds();
+
+	btConvexHullComputer full;
+	std::vector<btVector3> all(points);
+	clock.reset();
+	for (int i = 0; i < numEdits; i++)
+	{
+		all.insert(all.end(), edits[i].begin(), edits[i].end());
+		computeHull(full, all, 1);
+	}
+	unsigned long long int fullTime = clock.getTimeMicroseconds();
+
+	printf("%10d points  %4d edits of %4d points  addPoints %10.2f ms  recompute %10.2f ms  (%d / %d vertices)\n", numPoints, numEdits,
+		   pointsPerEdit, double(incrementalTime) / 1000.0, double(fullTime) / 1000.0, incremental.vertices.size(), full.vertices.size());
+}
+
+int main(int argc, char* argv[])
+{
+	int maxPointCount = 1000000;
+	if (argc > 1)
+	{
+		maxPointCount = atoi(argv[1]);
+	}
+
+	int numTasks = 8;
+#if BT_THREADSAFE
+	btITaskScheduler* scheduler = btCreateDefaultTaskScheduler();
+	if (scheduler)
+	{
+		btSetTaskScheduler(scheduler);
+	}
+	numTasks = btMax(numTasks, btGetTaskScheduler()->getNumThreads());
+	printf("task scheduler: %s, %d threads\n", btGetTaskScheduler()->getName(), btGetTaskScheduler()->getNumThreads());
+#endif
+
+	for (int numPoints = 10000; numPoints <= maxPointCount; numPoints *= 10)
+	{
+		runLargeHull(numPoints, numTasks);
+	}
+	runDecomposition(1000, numTasks);
+	for (int numPoints = 1000; numPoints <= maxPointCount && numPoints <= 100000; numPoints *= 10)
+	{
+		runEdits(numPoints, 100, 64);
+	}
+
+	return 0;
+}
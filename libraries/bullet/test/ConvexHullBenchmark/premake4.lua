@@ -0,0 +1,17 @@
+	project "Test_ConvexHullBenchmark"
+
+	kind "ConsoleApp"
+
+	includedirs {"../../src"}
+
+	links {"LinearMath"}
+
+	language "C++"
+
+	files {
+		"main.cpp",
+	}
+
+	if os.is("Linux") then
+		links {"pthread"}
+	end
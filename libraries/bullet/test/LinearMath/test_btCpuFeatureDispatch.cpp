@@ -0,0 +1,110 @@
+#include <LinearMath/btAlignedObjectArray.h>
+#include <LinearMath/btCpuFeatureUtility.h>
+#include <LinearMath/btVector3.h>
+#include <gtest/gtest.h>
+
+#include <string.h>
+
+namespace {
+
+//a small linear congruential generator, so every run tests the same arrays
+struct TestRandom
+{
+	unsigned int m_state;
+
+	TestRandom() : m_state(12345) {}
+
+	unsigned int next()
+	{
+		m_state = m_state * 1664525u + 1013904223u;
+		return m_state >> 8;
+	}
+
+	//few distinct values, so there are ties to break
+	btScalar coarse() { return btScalar(int(next() % 9) - 4) * btScalar(0.5); }
+
+	btScalar fine() { return btScalar(int(next() % 20001) - 10000) * btScalar(0.001); }
+};
+
+template <bool isMax>
+long referenceDot(const btVector3& vec, const btVector3* array, long count, btScalar& dotOut)
+{
+	btScalar best = isMax ? -SIMD_INFINITY : SIMD_INFINITY;
+	long bestIndex = -1;
+	for (long i = 0; i < count; i++)
+	{
+		btScalar dot = array[i].dot(vec);
+		if (isMax ? dot > best : dot < best)
+		{
+			best = dot;
+			bestIndex = i;
+		}
+	}
+	dotOut = best;
+	return bestIndex;
+}
+
+void testDots(const btVector3& vec, const btAlignedObjectArray<btVector3>& array, long count)
+{
+	btScalar dot, expectedDot;
+	long index = vec.maxDot(&array[0], count, dot);
+	long expectedIndex = referenceDot<true>(vec, &array[0], count, expectedDot);
+	ASSERT_EQ(expectedIndex, index) << "maxDot of " << count;
+	ASSERT_EQ(0, memcmp(&expectedDot, &dot, sizeof(btScalar))) << "maxDot of " << count;
+
+	index = vec.minDot(&array[0], count, dot);
+	expectedIndex = referenceDot<false>(vec, &array[0], count, expectedDot);
+	ASSERT_EQ(expectedIndex, index) << "minDot of " << count;
+	ASSERT_EQ(0, memcmp(&expectedDot, &dot, sizeof(btScalar))) << "minDot of " << count;
+}
+
+}  // namespace
+
+GTEST_TEST(LinearMath, CpuFeatures)
+{
+	int features = btCpuFeatureUtility::getCpuFeatures();
+	EXPECT_EQ(features, btCpuFeatureUtility::getCpuFeatures());
+#ifdef BT_HAS_SSE2_INTRINSICS
+	EXPECT_NE(0, features & btCpuFeatureUtility::CPU_FEATURE_SSE2);
+#else
+	EXPECT_EQ(0, features & (btCpuFeatureUtility::CPU_FEATURE_SSE2 | btCpuFeatureUtility::CPU_FEATURE_AVX2));
+#endif
+}
+
+//the kernel that is picked at runtime finds the same vertex and dot as the scalar loop, also for ties and any count
+GTEST_TEST(LinearMath, MaxDotMinDotMatchScalar)
+{
+	TestRandom random;
+	btAlignedObjectArray<btVector3> array;
+	array.resize(1000);
+	for (int round = 0; round < 20; round++)
+	{
+		bool coarse = (round & 1) == 0;
+		for (int i = 0; i < array.size(); i++)
+		{
+			array[i] = coarse ? btVector3(random.coarse(), random.coarse(), random.coarse()) : btVector3(random.fine(), random.fine(), random.fine());
+			//the kernels must ignore w
+			array[i][3] = (i & 1) ? SIMD_INFINITY : btScalar(random.next());
+		}
+		btVector3 vec = coarse ? btVector3(random.coarse(), random.coarse(), random.coarse()) : btVector3(random.fine(), random.fine(), random.fine());
+		for (long count = 0; count <= 100; count++)
+		{
+			testDots(vec, array, count);
+		}
+		testDots(vec, array, array.size());
+	}
+}
+
+GTEST_TEST(LinearMath, MaxDotMinDotEqualVertices)
+{
+	btAlignedObjectArray<btVector3> array;
+	array.resize(50, btVector3(1, 2, 3));
+	testDots(btVector3(1, 1, 1), array, array.size());
+	testDots(btVector3(0, 0, 0), array, array.size());
+}
+
+int main(int argc, char** argv)
+{
+	::testing::InitGoogleTest(&argc, argv);
+	return RUN_ALL_TESTS();
+}
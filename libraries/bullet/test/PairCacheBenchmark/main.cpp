@@ -0,0 +1,113 @@
+///Benchmark for the overlapping pair caches, comparing btHashedOverlappingPairCache with btOpenAddressedOverlappingPairCache.
+///Usage: Test_PairCacheBenchmark [maxPairCount]
+///Each frame looks up every pair once, then removes 10% of the pairs and adds as many new ones, like a broadphase with moving objects.
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "btBulletCollisionCommon.h"
+#include "BulletCollision/BroadphaseCollision/btOpenAddressedOverlappingPairCache.h"
+#include "LinearMath/btQuickprof.h"
+
+struct BenchmarkPairs
+{
+	btAlignedObjectArray<btBroadphaseProxy> m_proxies;
+	btAlignedObjectArray<int> m_pairs;
+
+	BenchmarkPairs(int numProxies)
+	{
+		m_proxies.resize(numProxies);
+		for (int i = 0; i < numProxies; i++)
+		{
+			m_proxies[i].m_uniqueId = i + 1;
+			m_proxies[i].m_collisionFilterGroup = btBroadphaseProxy::DefaultFilter;
+			m_proxies[i].m_collisionFilterMask = btBroadphaseProxy::AllFilter;
+		}
+	}
+
+	///a random pair between nearby proxies, the way spatially sorted ids overlap
+	void randomPair(int& a, int& b)
+	{
+		a = rand() % m_proxies.size();
+		b = (a + 1 + rand() % 64) % m_proxies.size();
+	}
+};
+
+static void runBenchmark(int numPairs, btOverlappingPairCache* cache, const char* name)
+{
+	const int numFrames = 20;
+	BenchmarkPairs pairs(numPairs / 4);
+
+	srand(numPairs);
+	btClock clock;
+	while (cache->getNumOverlappingPairs() < numPairs)
+	{
+		int a, b;
+		pairs.randomPair(a, b);
+		cache->addOverlappingPair(&pairs.m_proxies[a], &pairs.m_proxies[b]);
+	}
+	unsigned long long int fillTime = clock.getTimeMicroseconds();
+
+	btAlignedObjectArray<btBroadphaseProxy*> lookups;
+	unsigned long long int findTime = 0;
+	unsigned long long int updateTime = 0;
+	int found = 0;
+	for (int frame = 0; frame < numFrames; frame++)
+	{
+		//look the pairs up in a random order, so the lookups don't simply walk the pair array
+		lookups.resize(0);
+		const btBroadphasePair* pairArray = cache->getOverlappingPairArrayPtr();
+		for (int i = 0; i < cache->getNumOverlappingPairs(); i++)
+		{
+			int j = rand() % cache->getNumOverlappingPairs();
+			lookups.push_back(pairArray[j].m_pProxy1);
+			lookups.push_back(pairArray[j].m_pProxy0);
+		}
+
+		clock.reset();
+		for (int i = 0; i < lookups.size(); i += 2)
+		{
+			found += cache->findPair(lookups[i], lookups[i + 1]) != 0;
+		}
+		findTime += clock.getTimeMicroseconds();
+
+		clock.reset();
+		int numUpdates = numPairs / 10;
+		for (int i = 0; i < numUpdates; i++)
+		{
+			const btBroadphasePair& pair = cache->getOverlappingPairArrayPtr()[rand() % cache->getNumOverlappingPairs()];
+			cache->removeOverlappingPair(pair.m_pProxy0, pair.m_pProxy1, 0);
+		}
+		while (cache->getNumOverlappingPairs() < numPairs)
+		{
+			int a, b;
+			pairs.randomPair(a, b);
+			cache->addOverlappingPair(&pairs.m_proxies[a], &pairs.m_proxies[b]);
+		}
+		updateTime += clock.getTimeMicroseconds();
+	}
+
+	double numLookups = double(numPairs) * numFrames;
+	double numUpdates = double(numPairs / 10) * 2 * numFrames;
+	printf("%9d pairs  %-14s fill %8.2f ms  find %6.1f ns/pair  add+remove %6.1f ns/pair  (%d found)\n", numPairs, name,
+		   double(fillTime) / 1000.0, double(findTime) * 1000.0 / numLookups, double(updateTime) * 1000.0 / numUpdates, found);
+
+	delete cache;
+}
+
+int main(int argc, char* argv[])
+{
+	int maxPairCount = 1000000;
+	if (argc > 1)
+	{
+		maxPairCount = atoi(argv[1]);
+	}
+
+	for (int numPairs = 10000; numPairs <= maxPairCount; numPairs *= 10)
+	{
+		runBenchmark(numPairs, new btHashedOverlappingPairCache(), "hashed");
+		runBenchmark(numPairs, new btOpenAddressedOverlappingPairCache(), "open addressed");
+	}
+
+	return 0;
+}
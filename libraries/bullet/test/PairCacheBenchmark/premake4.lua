@@ -0,0 +1,17 @@
+	project "Test_PairCacheBenchmark"
+
+	kind "ConsoleApp"
+
+	includedirs {"../../src"}
+
+	links {"BulletCollision", "LinearMath"}
+
+	language "C++"
+
+	files {
+		"main.cpp",
+	}
+
+	if os.is("Linux") then
+		links {"pthread"}
+	end
@@ -0,0 +1,406 @@
+///Micro benchmarks of the collision and dynamics hot paths: broadphase insert, update and query, single and batched
+///raycasts, GJK pair queries, BVH triangle mesh builds and a dynamics step of stacked boxes.
+///Usage: Test_PhysicsBenchmark [maxProxyCount] [filter]
+///The results are written as JSON to stdout, each with the time and the allocations of btAlignedAlloc per operation, so
+///they can be compared between builds. Only the benchmarks whose name contains the filter run.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "btBulletDynamicsCommon.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkPairDetector.h"
+#include "BulletCollision/NarrowPhaseCollision/btGjkEpaPenetrationDepthSolver.h"
+#include "BulletCollision/NarrowPhaseCollision/btPointCollector.h"
+#include "BulletCollision/CollisionShapes/btTriangleIndexVertexArray.h"
+#include "LinearMath/btAllocationTracker.h"
+#include "LinearMath/btQuickprof.h"
+#include "LinearMath/btThreads.h"
+
+static const char* sFilter = 0;
+static int sNumResults = 0;
+
+static btScalar randomScalar()
+{
+	return btScalar(rand()) / btScalar(RAND_MAX) * btScalar(2.) - btScalar(1.);
+}
+
+static bool shouldRun(const char* name)
+{
+	return !sFilter || strstr(name, sFilter);
+}
+
+///measures the time and the allocations between its construction and report
+class BenchmarkTimer
+{
+	btClock m_clock;
+	btAllocationStats m_stats;
+
+public:
+	BenchmarkTimer()
+	{
+		btAllocationTrackerGetStats(-1, m_stats);
+		m_clock.reset();
+	}
+
+	void report(const char* name, int size, int numOperations)
+	{
+		unsigned long long int time = m_clock.getTimeNanoseconds();
+		btAllocationStats stats;
+		btAllocationTrackerGetStats(-1, stats);
+		double operations = double(btMax(numOperations, 1));
+		printf("%s\n    {\"name\": \"%s\", \"size\": %d, \"operations\": %d, \"ns_per_op\": %.2f, \"allocations_per_op\": %.4f, \"bytes_per_op\": %.2f}",
+			   sNumResults ? "," : "", name, size, numOperations, double(time) / operations,
+			   double(stats.m_numAllocations - m_stats.m_numAllocations) / operations,
+			   double(stats.m_bytesAllocated - m_stats.m_bytesAllocated) / operations);
+		fflush(stdout);
+		sNumResults++;
+	}
+};
+
+///unit boxes in a cube that is sized for a few overlaps per proxy
+static void randomBox(int numProxies, btVector3& aabbMin, btVector3& aabbMax)
+{
+	btScalar extent = btPow(btScalar(numProxies), btScalar(1.) / btScalar(3.));
+	btVector3 center(randomScalar(), randomScalar(), randomScalar());
+	center *= extent;
+	aabbMin = center - btVector3(btScalar(0.5), btScalar(0.5), btScalar(0.5));
+	aabbMax = center + btVector3(btScalar(0.5), btScalar(0.5), btScalar(0.5));
+}
+
+struct CountingAabbCallback : public btBroadphaseAabbCallback
+{
+	int m_count;
+
+	CountingAabbCallback() : m_count(0) {}
+
+	virtual bool process(const btBroadphaseProxy* proxy)
+	{
+		(void)proxy;
+		m_count++;
+		return true;
+	}
+};
+
+static void runBroadphase(int numProxies)
+{
+	srand(numProxies);
+	btDbvtBroadphase broadphase;
+	btAlignedObjectArray<btBroadphaseProxy*> proxies;
+	proxies.reserve(numProxies);
+
+	{
+		BenchmarkTimer timer;
+		for (int i = 0; i < numProxies; i++)
+		{
+			btVector3 aabbMin, aabbMax;
+			randomBox(numProxies, aabbMin, aabbMax);
+			proxies.push_back(broadphase.createProxy(aabbMin, aabbMax, BOX_SHAPE_PROXYTYPE, 0, btBroadphaseProxy::DefaultFilter, btBroadphaseProxy::AllFilter, 0));
+		}
+		broadphase.calculateOverlappingPairs(0);
+		if (shouldRun("broadphase_insert"))
+			timer.report("broadphase_insert", numProxies, numProxies);
+	}
+
+	if (shouldRun("broadphase_update"))
+	{
+		const int numFrames = 8;
+		btScalar step = btScalar(0.05);
+		BenchmarkTimer timer;
+		for (int frame = 0; frame < numFrames; frame++)
+		{
+			btVector3 delta(randomScalar() * step, randomScalar() * step, randomScalar() * step);
+			for (int i = 0; i < numProxies; i++)
+			{
+				btVector3 aabbMin, aabbMax;
+				broadphase.getAabb(proxies[i], aabbMin, aabbMax);
+				broadphase.setAabb(proxies[i], aabbMin + delta, aabbMax + delta, 0);
+			}
+			broadphase.calculateOverlappingPairs(0);
+		}
+		timer.report("broadphase_update", numProxies, numProxies * numFrames);
+	}
+
+	if (shouldRun("broadphase_query"))
+	{
+		const int numQueries = 10000;
+		CountingAabbCallback callback;
+		BenchmarkTimer timer;
+		for (int i = 0; i < numQueries; i++)
+		{
+			btVector3 aabbMin, aabbMax;
+			randomBox(numProxies, aabbMin, aabbMax);
+			broadphase.aabbTest(aabbMin - btVector3(1, 1, 1), aabbMax + btVector3(1, 1, 1), callback);
+		}
+		timer.report("broadphase_query", numProxies, numQueries);
+	}
+
+	for (int i = 0; i < proxies.size(); i++)
+	{
+		broadphase.destroyProxy(proxies[i], 0);
+	}
+}
+
+struct RaycastBatchBody : public btIParallelForBody
+{
+	const btCollisionWorld* m_world;
+	const btAlignedObjectArray<btVector3>* m_from;
+	const btAlignedObjectArray<btVector3>* m_to;
+
+	void forLoop(int iBegin, int iEnd) const BT_OVERRIDE
+	{
+		for (int i = iBegin; i < iEnd; i++)
+		{
+			btCollisionWorld::ClosestRayResultCallback result((*m_from)[i], (*m_to)[i]);
+			m_world->rayTest((*m_from)[i], (*m_to)[i], result);
+		}
+	}
+};
+
+static void runRaycasts(int numObjects)
+{
+	if (!shouldRun("raycast"))
+		return;
+	srand(numObjects);
+	btDefaultCollisionConfiguration config;
+	btCollisionDispatcher dispatcher(&config);
+	btDbvtBroadphase broadphase;
+	btCollisionWorld world(&dispatcher, &broadphase, &config);
+	btBoxShape box(btVector3(btScalar(0.5), btScalar(0.5), btScalar(0.5)));
+	btSphereShape sphere(btScalar(0.5));
+
+	btCollisionObject* objects = new btCollisionObject[numObjects];
+	for (int i = 0; i < numObjects; i++)
+	{
+		btVector3 aabbMin, aabbMax;
+		randomBox(numObjects, aabbMin, aabbMax);
+		objects[i].setCollisionShape((i & 1) ? (btCollisionShape*)&box : (btCollisionShape*)&sphere);
+		objects[i].getWorldTransform().setOrigin((aabbMin + aabbMax) * btScalar(0.5));
+		world.addCollisionObject(&objects[i]);
+	}
+	world.updateAabbs();
+
+	const int numRays = 4096;
+	btScalar extent = btPow(btScalar(numObjects), btScalar(1.) / btScalar(3.));
+	btAlignedObjectArray<btVector3> from, to;
+	for (int i = 0; i < numRays; i++)
+	{
+		from.push_back(btVector3(randomScalar(), randomScalar(), randomScalar()) * extent);
+		to.push_back(from[i] + btVector3(randomScalar(), randomScalar(), randomScalar()).normalized() * extent);
+	}
+
+	RaycastBatchBody body;
+	body.m_world = &world;
+	body.m_from = &from;
+	body.m_to = &to;
+	if (shouldRun("raycast_single"))
+	{
+		BenchmarkTimer timer;
+		for (int i = 0; i < numRays; i++)
+		{
+			body.forLoop(i, i + 1);
+		}
+		timer.report("raycast_single", numObjects, numRays);
+	}
+	if (shouldRun("raycast_batch"))
+	{
+		//a batch runs on the task scheduler when there is one
+		BenchmarkTimer timer;
+		btParallelForIfScheduled(0, numRays, 64, body);
+		timer.report("raycast_batch", numObjects, numRays);
+	}
+
+	for (int i = 0; i < numObjects; i++)
+	{
+		world.removeCollisionObject(&objects[i]);
+	}
+	delete[] objects;
+}
+
+static void runGjk(int numQueries)
+{
+	if (!shouldRun("gjk_pair"))
+		return;
+	srand(numQueries);
+	btBoxShape box(btVector3(1, btScalar(0.5), btScalar(0.75)));
+	btCylinderShape cylinder(btVector3(btScalar(0.5), 1, btScalar(0.5)));
+	btConvexHullShape hull;
+	for (int i = 0; i < 32; i++)
+	{
+		hull.addPoint(btVector3(randomScalar(), randomScalar(), randomScalar()), false);
+	}
+	hull.recalcLocalAabb();
+
+	btVoronoiSimplexSolver simplexSolver;
+	btGjkEpaPenetrationDepthSolver depthSolver;
+	const btConvexShape* shapes[3] = {&box, &cylinder, &hull};
+
+	btDiscreteCollisionDetectorInterface::ClosestPointInput input;
+	BenchmarkTimer timer;
+	for (int i = 0; i < numQueries; i++)
+	{
+		const btConvexShape* shapeA = shapes[i % 3];
+		const btConvexShape* shapeB = shapes[(i / 3) % 3];
+		btGjkPairDetector detector(shapeA, shapeB, &simplexSolver, &depthSolver);
+		input.m_transformA.setIdentity();
+		input.m_transformB.setRotation(btQuaternion(btVector3(0, 1, 0), randomScalar() * SIMD_PI));
+		input.m_transformB.setOrigin(btVector3(randomScalar(), randomScalar(), randomScalar()) * btScalar(2.5));
+		btPointCollector result;
+		detector.getClosestPoints(input, result, 0);
+	}
+	timer.report("gjk_pair", numQueries, numQueries);
+}
+
+static void runBvhBuild(int numTriangles)
+{
+	if (!shouldRun("bvh_build"))
+		return;
+	//a height field like grid, with two triangles per cell
+	int numCells = int(btSqrt(btScalar(numTriangles / 2)));
+	int numVertices = (numCells + 1) * (numCells + 1);
+	btAlignedObjectArray<btVector3> vertices;
+	vertices.resize(numVertices);
+	for (int z = 0; z <= numCells; z++)
+	{
+		for (int x = 0; x <= numCells; x++)
+		{
+			vertices[z * (numCells + 1) + x].setValue(btScalar(x), btSin(btScalar(x) * btScalar(0.3)) * btCos(btScalar(z) * btScalar(0.2)), btScalar(z));
+		}
+	}
+	btAlignedObjectArray<int> indices;
+	for (int z = 0; z < numCells; z++)
+	{
+		for (int x = 0; x < numCells; x++)
+		{
+			int i = z * (numCells + 1) + x;
+			indices.push_back(i);
+			indices.push_back(i + 1);
+			indices.push_back(i + numCells + 1);
+			indices.push_back(i + 1);
+			indices.push_back(i + numCells + 2);
+			indices.push_back(i + numCells + 1);
+		}
+	}
+	btTriangleIndexVertexArray mesh(indices.size() / 3, &indices[0], 3 * sizeof(int), numVertices, &vertices[0][0], sizeof(btVector3));
+
+	BenchmarkTimer timer;
+	btBvhTriangleMeshShape* shape = new btBvhTriangleMeshShape(&mesh, true);
+	timer.report("bvh_build", indices.size() / 3, indices.size() / 3);
+	delete shape;
+}
+
+static void runStackedBoxes(int numStacks)
+{
+	if (!shouldRun("dynamics_step"))
+		return;
+	btDefaultCollisionConfiguration config;
+	btCollisionDispatcher dispatcher(&config);
+	btDbvtBroadphase broadphase;
+	btSequentialImpulseConstraintSolver solver;
+	btDiscreteDynamicsWorld world(&dispatcher, &broadphase, &solver, &config);
+
+	btBoxShape ground(btVector3(btScalar(numStacks) * 2 + 10, 1, 10));
+	btRigidBody groundBody(0, 0, &ground);
+	groundBody.setWorldTransform(btTransform(btQuaternion::getIdentity(), btVector3(0, -1, 0)));
+	world.addRigidBody(&groundBody);
+
+	const int stackHeight = 10;
+	btBoxShape box(btVector3(btScalar(0.5), btScalar(0.5), btScalar(0.5)));
+	btVector3 inertia;
+	box.calculateLocalInertia(1, inertia);
+	btAlignedObjectArray<btRigidBody*> bodies;
+	for (int s = 0; s < numStacks; s++)
+	{
+		for (int i = 0; i < stackHeight; i++)
+		{
+			btRigidBody* body = new btRigidBody(1, 0, &box, inertia);
+			body->setWorldTransform(btTransform(btQuaternion::getIdentity(), btVector3(btScalar(s) * 2 - btScalar(numStacks), btScalar(0.5) + btScalar(i), 0)));
+			body->setActivationState(DISABLE_DEACTIVATION);
+			world.addRigidBody(body);
+			bodies.push_back(body);
+		}
+	}
+
+	//the first steps create the manifolds and grow the solver pools
+	const btScalar timeStep = btScalar(1.) / btScalar(60.);
+	for (int step = 0; step < 30; step++)
+	{
+		world.stepSimulation(timeStep, 0);
+	}
+	const int numSteps = 120;
+	BenchmarkTimer timer;
+	for (int step = 0; step < numSteps; step++)
+	{
+		world.stepSimulation(timeStep, 0);
+	}
+	timer.report("dynamics_step", bodies.size(), numSteps);
+
+	for (int i = 0; i < bodies.size(); i++)
+	{
+		world.removeRigidBody(bodies[i]);
+		delete bodies[i];
+	}
+	world.removeRigidBody(&groundBody);
+}
+
+int main(int argc, char* argv[])
+{
+	//before anything is allocated by Bullet
+	btAllocationTrackerInstall();
+
+	int maxProxyCount = 1000000;
+	if (argc > 1)
+	{
+		maxProxyCount = atoi(argv[1]);
+	}
+	if (argc > 2)
+	{
+		sFilter = argv[2];
+	}
+
+#if BT_THREADSAFE
+	btITaskScheduler* scheduler = btCreateDefaultTaskScheduler();
+	if (scheduler)
+	{
+		btSetTaskScheduler(scheduler);
+	}
+#endif
+
+	printf("{\n  \"threadsafe\": %s,\n  \"double_precision\": %s,\n  \"threads\": %d,\n  \"benchmarks\": [",
+#if BT_THREADSAFE
+		   "true",
+#else
+		   "false",
+#endif
+#ifdef BT_USE_DOUBLE_PRECISION
+		   "true",
+#else
+		   "false",
+#endif
+#if BT_THREADSAFE
+		   btGetTaskScheduler() ? btGetTaskScheduler()->getNumThreads() : 1
+#else
+		   1
+#endif
+	);
+
+	for (int numProxies = 1000; numProxies <= maxProxyCount; numProxies *= 10)
+	{
+		runBroadphase(numProxies);
+	}
+	for (int numObjects = 1000; numObjects <= maxProxyCount && numObjects <= 100000; numObjects *= 10)
+	{
+		runRaycasts(numObjects);
+	}
+	runGjk(100000);
+	for (int numTriangles = 10000; numTriangles <= maxProxyCount; numTriangles *= 10)
+	{
+		runBvhBuild(numTriangles);
+	}
+	runStackedBoxes(8);
+
+	printf("\n  ]\n}\n");
+
+	btAllocationTrackerUninstall();
+	return 0;
+}
@@ -0,0 +1,17 @@
+	project "Test_PhysicsBenchmark"
+
+	kind "ConsoleApp"
+
+	includedirs {"../../src"}
+
+	links {"BulletDynamics", "BulletCollision", "LinearMath"}
+
+	language "C++"
+
+	files {
+		"main.cpp",
+	}
+
+	if os.is("Linux") then
+		links {"pthread"}
+	end
@@ -857,6 +857,7 @@ extern "C" {
 #define GLFW_LOCK_KEY_MODS           0x00033004
 #define GLFW_RAW_MOUSE_MOTION        0x00033005
 #define GLFW_UNLIMITED_MOUSE_BUTTONS 0x00033006
+#define GLFW_BUFFERED_EVENTS         0x00033007
 
 #define GLFW_CURSOR_NORMAL          0x00034001
 #define GLFW_CURSOR_HIDDEN          0x00034002
@@ -980,6 +981,41 @@ extern "C" {
 #define GLFW_CONNECTED              0x00040001
 #define GLFW_DISCONNECTED           0x00040002
 
+/*! @defgroup events Buffered input event types
+ *  @brief Buffered input event types.
+ *
+ *  See [buffered input events](@ref glfwGetInputEvents) for how these are used.
+ *
+ *  @ingroup input
+ *  @{ */
+/*! @brief A key was pressed, repeated or released.
+ *
+ *  The `key`, `scancode`, `action` and `mods` members of the event are set.
+ */
+#define GLFW_KEY_EVENT              0x00070001
+/*! @brief A mouse button was pressed or released.
+ *
+ *  The `button`, `action` and `mods` members of the event are set.
+ */
+#define GLFW_MOUSE_BUTTON_EVENT     0x00070002
+/*! @brief The cursor moved.
+ *
+ *  The `xpos` and `ypos` members of the event are the new cursor position.
+ */
+#define GLFW_CURSOR_POS_EVENT       0x00070003
+/*! @brief The cursor entered or left the content area.
+ *
+ *  The `action` member of the event is `GLFW_TRUE` if the cursor entered the
+ *  content area, or `GLFW_FALSE` if it left it.
+ */
+#define GLFW_CURSOR_ENTER_EVENT     0x00070004
+/*! @brief The user scrolled.
+ *
+ *  The `xpos` and `ypos` members of the event are the scroll offsets.
+ */
+#define GLFW_SCROLL_EVENT           0x00070005
+/*! @} */
+
 /*! @brief Platform selection init hint.
  *
  *  Platform selection [init hint](@ref GLFW_PLATFORM).
@@ -1717,6 +1753,51 @@ typedef struct GLFWimage
     unsigned char* pixels;
 } GLFWimage;
 
+/*! @brief Buffered input event.
+ *
+ *  This describes a single input event that was recorded while the @ref
+ *  GLFW_BUFFERED_EVENTS input mode was enabled.  Members that do not apply to
+ *  the [type](@ref events) of the event are zero.
+ *
+ *  @sa @ref glfwGetInputEvents
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup input
+ */
+typedef struct GLFWinputevent
+{
+    /*! The [type](@ref events) of this event.
+     */
+    int type;
+    /*! The raw timer value when this event was received by GLFW, in the units
+     *  of @ref glfwGetTimerValue.
+     */
+    uint64_t time;
+    /*! The [key](@ref keys) of a key event.
+     */
+    int key;
+    /*! The platform-specific scancode of a key event.
+     */
+    int scancode;
+    /*! The [mouse button](@ref buttons) of a mouse button event.
+     */
+    int button;
+    /*! The action of a key or mouse button event, or whether the cursor
+     *  entered the content area for a cursor enter event.
+     */
+    int action;
+    /*! The [modifier keys](@ref mods) of a key or mouse button event.
+     */
+    int mods;
+    /*! The cursor position or the horizontal scroll offset.
+     */
+    double xpos;
+    /*! The cursor position or the vertical scroll offset.
+     */
+    double ypos;
+} GLFWinputevent;
+
 /*! @brief Custom heap memory allocator.
  *
  *  This describes a custom heap memory allocator for GLFW.  To set an allocator, pass it
@@ -3435,7 +3516,8 @@ int glfwGetInputMode(GLFWwindow* window, int mode);
  *  This function sets an input mode option for the specified window.  The mode
  *  must be one of @ref GLFW_CURSOR, @ref GLFW_STICKY_KEYS,
  *  @ref GLFW_STICKY_MOUSE_BUTTONS, @ref GLFW_LOCK_KEY_MODS
- *  @ref GLFW_RAW_MOUSE_MOTION, or @ref GLFW_UNLIMITED_MOUSE_BUTTONS.
+ *  @ref GLFW_RAW_MOUSE_MOTION, @ref GLFW_UNLIMITED_MOUSE_BUTTONS or
+ *  @ref GLFW_BUFFERED_EVENTS.
  *
  *  If the mode is `GLFW_CURSOR`, the value must be one of the following cursor
  *  modes:
@@ -3480,6 +3562,13 @@ int glfwGetInputMode(GLFWwindow* window, int mode);
  *  callback, or `GLFW_FALSE` to limit the mouse buttons sent to the callback
  *  to the mouse button token values up to `GLFW_MOUSE_BUTTON_LAST`.
  *
+ *  If the mode is `GLFW_BUFFERED_EVENTS`, the value must be either `GLFW_TRUE`
+ *  to record key, mouse button, cursor position, cursor enter and scroll
+ *  events into a queue of the window instead of calling their callbacks, or
+ *  `GLFW_FALSE` to call the callbacks again.  The recorded events are
+ *  retrieved with @ref glfwGetInputEvents.  Disabling it discards the events
+ *  that have not been retrieved.
+ *
  *  @param[in] window The window whose input mode to set.
  *  @param[in] mode One of `GLFW_CURSOR`, `GLFW_STICKY_KEYS`,
  *  `GLFW_STICKY_MOUSE_BUTTONS`, `GLFW_LOCK_KEY_MODS` or
@@ -4106,6 +4195,41 @@ GLFWscrollfun glfwSetScrollCallback(GLFWwindow* window, GLFWscrollfun callback);
  */
 GLFWdropfun glfwSetDropCallback(GLFWwindow* window, GLFWdropfun callback);
 
+/*! @brief Retrieves the buffered input events of the specified window.
+ *
+ *  This function removes up to `count` of the oldest input events recorded for
+ *  the specified window, while its @ref GLFW_BUFFERED_EVENTS input mode was
+ *  enabled, and copies them to `events` in the order they were received.
+ *
+ *  The events are recorded by @ref glfwPollEvents and the other event
+ *  processing functions, with a timestamp, into a fixed size queue.  If the
+ *  queue is full, new events are discarded until it is drained, so call this
+ *  at least once per frame.  Key and mouse button state returned by @ref
+ *  glfwGetKey and @ref glfwGetMouseButton is still updated when events are
+ *  received.
+ *
+ *  @param[in] window The window whose events to retrieve.
+ *  @param[out] events Where to store the retrieved events.
+ *  @param[in] count The maximum number of events to retrieve.
+ *  @return The number of events retrieved, or zero if there were none, the
+ *  input mode is disabled or an [error](@ref error_handling) occurred.
+ *
+ *  @errors Possible errors include @ref GLFW_NOT_INITIALIZED and @ref
+ *  GLFW_INVALID_VALUE.
+ *
+ *  @thread_safety This function may be called from any thread, but only from
+ *  one thread at a time, while the main thread keeps processing events.  The
+ *  input mode must not be changed and the window must not be destroyed while
+ *  this function is running.
+ *
+ *  @sa @ref glfwSetInputMode
+ *
+ *  @since Added in version 3.5.
+ *
+ *  @ingroup input
+ */
+int glfwGetInputEvents(GLFWwindow* window, GLFWinputevent* events, int count);
+
 /*! @brief Sets the clipboard to the specified string.
  *
  *  This function sets the system clipboard to the specified, UTF-8 encoded
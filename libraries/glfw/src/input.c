@@ -29,6 +29,7 @@
 
 #include <assert.h>
 #include <float.h>
+#include <string.h>
 
 // Internal key state used for sticky keys
 #define _GLFW_STICK 3
@@ -40,6 +41,31 @@
                        GLFW_MOD_CAPS_LOCK | \
                        GLFW_MOD_NUM_LOCK)
 
+// Returns the next free event in the event buffer of the window, or NULL if
+// the buffer is full
+//
+static GLFWinputevent* beginBufferedEvent(_GLFWwindow* window, int type)
+{
+    const unsigned int head = window->eventBuffer.head;
+    const unsigned int tail = _glfwPlatformLoadAcquire(&window->eventBuffer.tail);
+
+    if (head - tail == _GLFW_EVENT_BUFFER_SIZE)
+        return NULL;
+
+    GLFWinputevent* event = window->eventBuffer.events + head % _GLFW_EVENT_BUFFER_SIZE;
+    memset(event, 0, sizeof(GLFWinputevent));
+    event->type = type;
+    event->time = _glfwPlatformGetTimerValue();
+    return event;
+}
+
+// Publishes the event returned by beginBufferedEvent to glfwGetInputEvents
+//
+static void endBufferedEvent(_GLFWwindow* window)
+{
+    _glfwPlatformStoreRelease(&window->eventBuffer.head, window->eventBuffer.head + 1);
+}
+
 //////////////////////////////////////////////////////////////////////////
 //////                         GLFW event API                       //////
 //////////////////////////////////////////////////////////////////////////
@@ -76,6 +102,21 @@ void _glfwInputKey(_GLFWwindow* window, int key, int scancode, int action, int m
     if (!window->lockKeyMods)
         mods &= ~(GLFW_MOD_CAPS_LOCK | GLFW_MOD_NUM_LOCK);
 
+    if (window->eventBuffer.events)
+    {
+        GLFWinputevent* event = beginBufferedEvent(window, GLFW_KEY_EVENT);
+        if (event)
+        {
+            event->key = key;
+            event->scancode = scancode;
+            event->action = action;
+            event->mods = mods;
+            endBufferedEvent(window);
+        }
+
+        return;
+    }
+
     if (window->callbacks.key)
         window->callbacks.key(key, scancode, action, mods);
 }
@@ -115,6 +156,19 @@ void _glfwInputScroll(_GLFWwindow* window, double xoffset, double yoffset)
     assert(yoffset > -FLT_MAX);
     assert(yoffset < FLT_MAX);
 
+    if (window->eventBuffer.events)
+    {
+        GLFWinputevent* event = beginBufferedEvent(window, GLFW_SCROLL_EVENT);
+        if (event)
+        {
+            event->xpos = xoffset;
+            event->ypos = yoffset;
+            endBufferedEvent(window);
+        }
+
+        return;
+    }
+
     if (window->callbacks.scroll)
         window->callbacks.scroll((GLFWwindow*) window, xoffset, yoffset);
 }
@@ -142,6 +196,20 @@ void _glfwInputMouseClick(_GLFWwindow* window, int button, int action, int mods)
             window->mouseButtons[button] = (char) action;
     }
 
+    if (window->eventBuffer.events)
+    {
+        GLFWinputevent* event = beginBufferedEvent(window, GLFW_MOUSE_BUTTON_EVENT);
+        if (event)
+        {
+            event->button = button;
+            event->action = action;
+            event->mods = mods;
+            endBufferedEvent(window);
+        }
+
+        return;
+    }
+
     if (window->callbacks.mouseButton)
         window->callbacks.mouseButton(button, action, mods);
 }
@@ -163,6 +231,19 @@ void _glfwInputCursorPos(_GLFWwindow* window, double xpos, double ypos)
     window->virtualCursorPosX = xpos;
     window->virtualCursorPosY = ypos;
 
+    if (window->eventBuffer.events)
+    {
+        GLFWinputevent* event = beginBufferedEvent(window, GLFW_CURSOR_POS_EVENT);
+        if (event)
+        {
+            event->xpos = xpos;
+            event->ypos = ypos;
+            endBufferedEvent(window);
+        }
+
+        return;
+    }
+
     if (window->callbacks.cursorPos)
         window->callbacks.cursorPos(xpos, ypos);
 }
@@ -174,6 +255,18 @@ void _glfwInputCursorEnter(_GLFWwindow* window, GLFWbool entered)
     assert(window != NULL);
     assert(entered == GLFW_TRUE || entered == GLFW_FALSE);
 
+    if (window->eventBuffer.events)
+    {
+        GLFWinputevent* event = beginBufferedEvent(window, GLFW_CURSOR_ENTER_EVENT);
+        if (event)
+        {
+            event->action = entered;
+            endBufferedEvent(window);
+        }
+
+        return;
+    }
+
     if (window->callbacks.cursorEnter)
         window->callbacks.cursorEnter(entered);
 }
@@ -229,6 +322,8 @@ int glfwGetInputMode(GLFWwindow* handle, int mode)
             return window->rawMouseMotion;
         case GLFW_UNLIMITED_MOUSE_BUTTONS:
             return window->disableMouseButtonLimit;
+        case GLFW_BUFFERED_EVENTS:
+            return window->eventBuffer.events != NULL;
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
@@ -338,6 +433,31 @@ void glfwSetInputMode(GLFWwindow* handle, int mode, int value)
             window->disableMouseButtonLimit = value ? GLFW_TRUE : GLFW_FALSE;
             return;
         }
+
+        case GLFW_BUFFERED_EVENTS:
+        {
+            value = value ? GLFW_TRUE : GLFW_FALSE;
+            if ((window->eventBuffer.events != NULL) == value)
+                return;
+
+            if (value)
+            {
+                window->eventBuffer.events =
+                    _glfw_calloc(_GLFW_EVENT_BUFFER_SIZE, sizeof(GLFWinputevent));
+                if (!window->eventBuffer.events)
+                    return;
+            }
+            else
+            {
+                // Discard the events that were not retrieved
+                _glfw_free(window->eventBuffer.events);
+                window->eventBuffer.events = NULL;
+            }
+
+            window->eventBuffer.head = 0;
+            window->eventBuffer.tail = 0;
+            return;
+        }
     }
 
     _glfwInputError(GLFW_INVALID_ENUM, "Invalid input mode 0x%08X", mode);
@@ -658,6 +778,38 @@ GLFWdropfun glfwSetDropCallback(GLFWwindow* handle, GLFWdropfun cbfun)
     return cbfun;
 }
 
+int glfwGetInputEvents(GLFWwindow* handle, GLFWinputevent* events, int count)
+{
+    _GLFW_REQUIRE_INIT_OR_RETURN(0);
+
+    _GLFWwindow* window = (_GLFWwindow*) handle;
+    assert(window != NULL);
+    assert(events != NULL || count == 0);
+
+    if (count < 0)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid event count %i", count);
+        return 0;
+    }
+
+    if (!window->eventBuffer.events)
+        return 0;
+
+    const unsigned int tail = window->eventBuffer.tail;
+    const unsigned int head = _glfwPlatformLoadAcquire(&window->eventBuffer.head);
+
+    int i = 0;
+
+    while (i < count && tail + i != head)
+    {
+        events[i] = window->eventBuffer.events[(tail + i) % _GLFW_EVENT_BUFFER_SIZE];
+        i++;
+    }
+
+    _glfwPlatformStoreRelease(&window->eventBuffer.tail, tail + i);
+    return i;
+}
+
 void glfwSetClipboardString(GLFWwindow* handle, const char* string)
 {
     assert(string != NULL);
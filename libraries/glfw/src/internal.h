@@ -36,6 +36,7 @@
 #define _GLFW_INSERT_LAST       1
 
 #define _GLFW_MESSAGE_SIZE      1024
+#define _GLFW_EVENT_BUFFER_SIZE 1024
 
 typedef int GLFWbool;
 typedef void (*GLFWproc)(void);
@@ -273,6 +274,14 @@ struct _GLFWwindow
     double              virtualCursorPosX, virtualCursorPosY;
     GLFWbool            rawMouseMotion;
 
+    // Buffered input events, a single producer single consumer queue written
+    // by the event processing functions and read by glfwGetInputEvents
+    struct {
+        GLFWinputevent*       events;
+        volatile unsigned int head;
+        volatile unsigned int tail;
+    } eventBuffer;
+
     _GLFWcontext        context;
 
     struct {
@@ -408,6 +417,9 @@ struct _GLFWplatform
     void (*setWindowFloating)(_GLFWwindow*,GLFWbool);
     void (*setWindowMousePassthrough)(_GLFWwindow*,GLFWbool);
     void (*pollEvents)(void);
+    void (*waitEvents)(void);
+    void (*waitEventsTimeout)(double);
+    void (*postEmptyEvent)(void);
 };
 
 // Library global data
@@ -475,6 +487,9 @@ void _glfwPlatformDestroyMutex(_GLFWmutex* mutex);
 void _glfwPlatformLockMutex(_GLFWmutex* mutex);
 void _glfwPlatformUnlockMutex(_GLFWmutex* mutex);
 
+unsigned int _glfwPlatformLoadAcquire(volatile unsigned int* value);
+void _glfwPlatformStoreRelease(volatile unsigned int* value, unsigned int newValue);
+
 void* _glfwPlatformLoadModule(const char* path);
 void _glfwPlatformFreeModule(void* module);
 GLFWproc _glfwPlatformGetModuleSymbol(void* module, const char* name);
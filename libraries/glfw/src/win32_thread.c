@@ -95,4 +95,14 @@ void _glfwPlatformUnlockMutex(_GLFWmutex* mutex)
     LeaveCriticalSection(&mutex->win32.section);
 }
 
+unsigned int _glfwPlatformLoadAcquire(volatile unsigned int* value)
+{
+    return (unsigned int) InterlockedCompareExchange((volatile LONG*) value, 0, 0);
+}
+
+void _glfwPlatformStoreRelease(volatile unsigned int* value, unsigned int newValue)
+{
+    InterlockedExchange((volatile LONG*) value, (LONG) newValue);
+}
+
 #endif // GLFW_BUILD_WIN32_THREAD
\ No newline at end of file
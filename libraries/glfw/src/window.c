@@ -449,6 +449,7 @@ void glfwDestroyWindow(GLFWwindow* handle)
         *prev = window->next;
     }
 
+    _glfw_free(window->eventBuffer.events);
     _glfw_free(window->title);
     _glfw_free(window);
 }
@@ -982,4 +983,32 @@ GLFWwindowcontentscalefun glfwSetWindowContentScaleCallback(GLFWwindow* handle,
 void glfwPollEvents(void)
 {
     _glfw.platform.pollEvents();
+}
+
+void glfwWaitEvents(void)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfw.platform.waitEvents();
+}
+
+void glfwWaitEventsTimeout(double timeout)
+{
+    _GLFW_REQUIRE_INIT();
+    assert(timeout == timeout);
+    assert(timeout >= 0.0);
+    assert(timeout <= DBL_MAX);
+
+    if (timeout != timeout || timeout < 0.0 || timeout > DBL_MAX)
+    {
+        _glfwInputError(GLFW_INVALID_VALUE, "Invalid time %f", timeout);
+        return;
+    }
+
+    _glfw.platform.waitEventsTimeout(timeout);
+}
+
+void glfwPostEmptyEvent(void)
+{
+    _GLFW_REQUIRE_INIT();
+    _glfw.platform.postEmptyEvent();
 }
\ No newline at end of file
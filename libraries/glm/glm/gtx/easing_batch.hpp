@@ -0,0 +1,242 @@
+/// @ref gtx_easing_batch
+/// @file glm/gtx/easing_batch.hpp
+///
+/// @see core (dependence)
+/// @see gtx_easing
+///
+/// @defgroup gtx_easing_batch GLM_GTX_easing_batch
+/// @ingroup gtx
+///
+/// Include <glm/gtx/easing_batch.hpp> to use the features of this extension.
+///
+/// Array versions of smoothstep, mix, clamp and of the GLM_GTX_easing functions, that evaluate 8 values at a time.
+/// With SSE2 or AVX enabled, the float versions use SIMD instructions, with a polynomial sine, cosine and exp2
+/// that are within a few ulps of the scalar functions.
+/// All easing functions take values in the range [0.0,1.0], and the result array may be the input array.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#	error "GLM: GLM_GTX_easing_batch is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
+#elif GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_easing_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_easing_batch
+	/// @{
+
+	/// Evaluates smoothstep(edge0, edge1, x[i]) for count values.
+	///
+	/// @param count Number of values to evaluate
+	/// @param edge0 Lower edge, shared by all the values
+	/// @param edge1 Upper edge, shared by all the values
+	/// @param x Array of count values
+	/// @param result Array of count values that receives the results
+	/// @see gtx_easing_batch
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void smoothstep(length_t count, T edge0, T edge1, T const* x, T* result);
+
+	/// Evaluates mix(x[i], y[i], a[i]) for count values.
+	///
+	/// @param count Number of values to evaluate
+	/// @param x Array of count values returned for a 0 interpolant
+	/// @param y Array of count values returned for a 1 interpolant
+	/// @param a Array of count interpolants
+	/// @param result Array of count values that receives the results
+	/// @see gtx_easing_batch
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void mix(length_t count, T const* x, T const* y, T const* a, T* result);
+
+	/// Evaluates clamp(x[i], minVal, maxVal) for count values.
+	///
+	/// @param count Number of values to evaluate
+	/// @param x Array of count values
+	/// @param minVal Lower bound, shared by all the values
+	/// @param maxVal Upper bound, shared by all the values
+	/// @param result Array of count values that receives the results
+	/// @see gtx_easing_batch
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void clamp(length_t count, T const* x, T minVal, T maxVal, T* result);
+
+	/// Modelled after the line y = x, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void linearInterpolation(length_t count, T const* a, T* result);
+
+	/// Modelled after the parabola y = x^2, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quadraticEaseIn(length_t count, T const* a, T* result);
+
+	/// Modelled after the parabola y = -x^2 + 2x, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quadraticEaseOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the piecewise quadratic, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quadraticEaseInOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the cubic y = x^3, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void cubicEaseIn(length_t count, T const* a, T* result);
+
+	/// Modelled after the cubic y = (x - 1)^3 + 1, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void cubicEaseOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the piecewise cubic, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void cubicEaseInOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the quartic x^4, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quarticEaseIn(length_t count, T const* a, T* result);
+
+	/// Modelled after the quartic y = 1 - (x - 1)^4, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quarticEaseOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the piecewise quartic, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quarticEaseInOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the quintic y = x^5, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quinticEaseIn(length_t count, T const* a, T* result);
+
+	/// Modelled after the quintic y = (x - 1)^5 + 1, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quinticEaseOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the piecewise quintic, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void quinticEaseInOut(length_t count, T const* a, T* result);
+
+	/// Modelled after quarter-cycle of sine wave, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void sineEaseIn(length_t count, T const* a, T* result);
+
+	/// Modelled after quarter-cycle of sine wave (different phase), evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void sineEaseOut(length_t count, T const* a, T* result);
+
+	/// Modelled after half sine wave, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void sineEaseInOut(length_t count, T const* a, T* result);
+
+	/// Modelled after shifted quadrant IV of unit circle, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void circularEaseIn(length_t count, T const* a, T* result);
+
+	/// Modelled after shifted quadrant II of unit circle, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void circularEaseOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the piecewise circular function, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void circularEaseInOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the exponential function y = 2^(10(x - 1)), evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void exponentialEaseIn(length_t count, T const* a, T* result);
+
+	/// Modelled after the exponential function y = -2^(-10x) + 1, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void exponentialEaseOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the piecewise exponential, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void exponentialEaseInOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the damped sine wave y = sin(13pi/2*x)*pow(2, 10 * (x - 1)), evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void elasticEaseIn(length_t count, T const* a, T* result);
+
+	/// Modelled after the damped sine wave y = sin(-13pi/2*(x + 1))*pow(2, -10x) + 1, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void elasticEaseOut(length_t count, T const* a, T* result);
+
+	/// Modelled after the piecewise exponentially-damped sine wave, evaluated for count values
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void elasticEaseInOut(length_t count, T const* a, T* result);
+
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void backEaseIn(length_t count, T const* a, T* result);
+
+	/// @param count Number of values to evaluate
+	/// @param a Array of count values in [0, 1]
+	/// @param o Optional overshoot modifier
+	/// @param result Array of count values that receives the results
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void backEaseIn(length_t count, T const* a, T o, T* result);
+
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void backEaseOut(length_t count, T const* a, T* result);
+
+	/// @param count Number of values to evaluate
+	/// @param a Array of count values in [0, 1]
+	/// @param o Optional overshoot modifier
+	/// @param result Array of count values that receives the results
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void backEaseOut(length_t count, T const* a, T o, T* result);
+
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void backEaseInOut(length_t count, T const* a, T* result);
+
+	/// @param count Number of values to evaluate
+	/// @param a Array of count values in [0, 1]
+	/// @param o Optional overshoot modifier
+	/// @param result Array of count values that receives the results
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void backEaseInOut(length_t count, T const* a, T o, T* result);
+
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void bounceEaseIn(length_t count, T const* a, T* result);
+
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void bounceEaseOut(length_t count, T const* a, T* result);
+
+	/// @see gtx_easing
+	template<typename T>
+	GLM_FUNC_DISCARD_DECL void bounceEaseInOut(length_t count, T const* a, T* result);
+
+	/// @}
+}// namespace glm
+
+#include "easing_batch.inl"
@@ -0,0 +1,1088 @@
+/// @ref gtx_easing_batch
+
+#include "../gtc/constants.hpp"
+#include "../simd/exponential.h"
+#include "../simd/trigonometric.h"
+#include <cmath>
+
+namespace glm{
+namespace detail
+{
+	// 8 values evaluated together, the generic version loops over them and the float version uses SIMD registers
+	template<typename T>
+	struct batch8
+	{
+		T data[8];
+
+		GLM_FUNC_QUALIFIER batch8() {}
+
+		template<typename U>
+		GLM_FUNC_QUALIFIER explicit batch8(U s)
+		{
+			for(length_t i = 0; i < 8; ++i)
+				data[i] = static_cast<T>(s);
+		}
+	};
+
+	template<typename T>
+	struct batch8_mask
+	{
+		bool data[8];
+	};
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> batch8_load(T const* p)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = p[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void batch8_store(T* p, batch8<T> const& v)
+	{
+		for(length_t i = 0; i < 8; ++i)
+			p[i] = v.data[i];
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> operator+(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = a.data[i] + b.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> operator-(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = a.data[i] - b.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> operator*(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = a.data[i] * b.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> operator/(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = a.data[i] / b.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> operator-(batch8<T> const& a)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = -a.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8_mask<T> operator<(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8_mask<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = a.data[i] < b.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8_mask<T> operator<=(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8_mask<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = a.data[i] <= b.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8_mask<T> operator>=(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8_mask<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = a.data[i] >= b.data[i];
+		return r;
+	}
+
+	// Lanes of a where the mask is set, lanes of b elsewhere
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> batch8_select(batch8_mask<T> const& m, batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = m.data[i] ? a.data[i] : b.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> batch8_min(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = b.data[i] < a.data[i] ? b.data[i] : a.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> batch8_max(batch8<T> const& a, batch8<T> const& b)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = a.data[i] < b.data[i] ? b.data[i] : a.data[i];
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> batch8_sqrt(batch8<T> const& a)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = std::sqrt(a.data[i]);
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> batch8_sin(batch8<T> const& a)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = std::sin(a.data[i]);
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> batch8_cos(batch8<T> const& a)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = std::cos(a.data[i]);
+		return r;
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER batch8<T> batch8_exp2(batch8<T> const& a)
+	{
+		batch8<T> r;
+		for(length_t i = 0; i < 8; ++i)
+			r.data[i] = std::pow(static_cast<T>(2), a.data[i]);
+		return r;
+	}
+
+#	if GLM_ARCH & GLM_ARCH_AVX_BIT
+	template<>
+	struct batch8<float>
+	{
+		glm_f32vec8 data;
+
+		GLM_FUNC_QUALIFIER batch8() {}
+		GLM_FUNC_QUALIFIER batch8(glm_f32vec8 v) : data(v) {}
+
+		template<typename U>
+		GLM_FUNC_QUALIFIER explicit batch8(U s) : data(_mm256_set1_ps(static_cast<float>(s))) {}
+	};
+
+	template<>
+	struct batch8_mask<float>
+	{
+		glm_f32vec8 data;
+	};
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_load(float const* p)
+	{
+		return _mm256_loadu_ps(p);
+	}
+
+	GLM_FUNC_QUALIFIER void batch8_store(float* p, batch8<float> const& v)
+	{
+		_mm256_storeu_ps(p, v.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator+(batch8<float> const& a, batch8<float> const& b)
+	{
+		return _mm256_add_ps(a.data, b.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator-(batch8<float> const& a, batch8<float> const& b)
+	{
+		return _mm256_sub_ps(a.data, b.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator*(batch8<float> const& a, batch8<float> const& b)
+	{
+		return _mm256_mul_ps(a.data, b.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator/(batch8<float> const& a, batch8<float> const& b)
+	{
+		return _mm256_div_ps(a.data, b.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator-(batch8<float> const& a)
+	{
+		return _mm256_xor_ps(a.data, _mm256_set1_ps(-0.0f));
+	}
+
+	GLM_FUNC_QUALIFIER batch8_mask<float> operator<(batch8<float> const& a, batch8<float> const& b)
+	{
+		batch8_mask<float> r = {_mm256_cmp_ps(a.data, b.data, _CMP_LT_OQ)};
+		return r;
+	}
+
+	GLM_FUNC_QUALIFIER batch8_mask<float> operator<=(batch8<float> const& a, batch8<float> const& b)
+	{
+		batch8_mask<float> r = {_mm256_cmp_ps(a.data, b.data, _CMP_LE_OQ)};
+		return r;
+	}
+
+	GLM_FUNC_QUALIFIER batch8_mask<float> operator>=(batch8<float> const& a, batch8<float> const& b)
+	{
+		batch8_mask<float> r = {_mm256_cmp_ps(a.data, b.data, _CMP_GE_OQ)};
+		return r;
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_select(batch8_mask<float> const& m, batch8<float> const& a, batch8<float> const& b)
+	{
+		return _mm256_blendv_ps(b.data, a.data, m.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_min(batch8<float> const& a, batch8<float> const& b)
+	{
+		return _mm256_min_ps(a.data, b.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_max(batch8<float> const& a, batch8<float> const& b)
+	{
+		return _mm256_max_ps(a.data, b.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_sqrt(batch8<float> const& a)
+	{
+		return _mm256_sqrt_ps(a.data);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_sin(batch8<float> const& a)
+	{
+		glm_f32vec8 s, c;
+		glm_vec8_sincos(a.data, &s, &c);
+		return s;
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_cos(batch8<float> const& a)
+	{
+		glm_f32vec8 s, c;
+		glm_vec8_sincos(a.data, &s, &c);
+		return c;
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_exp2(batch8<float> const& a)
+	{
+		return glm_vec8_exp2(a.data);
+	}
+
+#	elif GLM_ARCH & GLM_ARCH_SSE2_BIT
+	// Two SSE registers
+	template<>
+	struct batch8<float>
+	{
+		glm_f32vec4 data[2];
+
+		GLM_FUNC_QUALIFIER batch8() {}
+		GLM_FUNC_QUALIFIER batch8(glm_f32vec4 lo, glm_f32vec4 hi)
+		{
+			data[0] = lo;
+			data[1] = hi;
+		}
+
+		template<typename U>
+		GLM_FUNC_QUALIFIER explicit batch8(U s)
+		{
+			data[0] = data[1] = _mm_set1_ps(static_cast<float>(s));
+		}
+	};
+
+	template<>
+	struct batch8_mask<float>
+	{
+		glm_f32vec4 data[2];
+	};
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_load(float const* p)
+	{
+		return batch8<float>(_mm_loadu_ps(p), _mm_loadu_ps(p + 4));
+	}
+
+	GLM_FUNC_QUALIFIER void batch8_store(float* p, batch8<float> const& v)
+	{
+		_mm_storeu_ps(p, v.data[0]);
+		_mm_storeu_ps(p + 4, v.data[1]);
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator+(batch8<float> const& a, batch8<float> const& b)
+	{
+		return batch8<float>(_mm_add_ps(a.data[0], b.data[0]), _mm_add_ps(a.data[1], b.data[1]));
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator-(batch8<float> const& a, batch8<float> const& b)
+	{
+		return batch8<float>(_mm_sub_ps(a.data[0], b.data[0]), _mm_sub_ps(a.data[1], b.data[1]));
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator*(batch8<float> const& a, batch8<float> const& b)
+	{
+		return batch8<float>(_mm_mul_ps(a.data[0], b.data[0]), _mm_mul_ps(a.data[1], b.data[1]));
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator/(batch8<float> const& a, batch8<float> const& b)
+	{
+		return batch8<float>(_mm_div_ps(a.data[0], b.data[0]), _mm_div_ps(a.data[1], b.data[1]));
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> operator-(batch8<float> const& a)
+	{
+		glm_f32vec4 const sign = _mm_set1_ps(-0.0f);
+		return batch8<float>(_mm_xor_ps(a.data[0], sign), _mm_xor_ps(a.data[1], sign));
+	}
+
+	GLM_FUNC_QUALIFIER batch8_mask<float> operator<(batch8<float> const& a, batch8<float> const& b)
+	{
+		batch8_mask<float> r = {{_mm_cmplt_ps(a.data[0], b.data[0]), _mm_cmplt_ps(a.data[1], b.data[1])}};
+		return r;
+	}
+
+	GLM_FUNC_QUALIFIER batch8_mask<float> operator<=(batch8<float> const& a, batch8<float> const& b)
+	{
+		batch8_mask<float> r = {{_mm_cmple_ps(a.data[0], b.data[0]), _mm_cmple_ps(a.data[1], b.data[1])}};
+		return r;
+	}
+
+	GLM_FUNC_QUALIFIER batch8_mask<float> operator>=(batch8<float> const& a, batch8<float> const& b)
+	{
+		batch8_mask<float> r = {{_mm_cmpge_ps(a.data[0], b.data[0]), _mm_cmpge_ps(a.data[1], b.data[1])}};
+		return r;
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_select(batch8_mask<float> const& m, batch8<float> const& a, batch8<float> const& b)
+	{
+		return batch8<float>(
+			_mm_or_ps(_mm_and_ps(m.data[0], a.data[0]), _mm_andnot_ps(m.data[0], b.data[0])),
+			_mm_or_ps(_mm_and_ps(m.data[1], a.data[1]), _mm_andnot_ps(m.data[1], b.data[1])));
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_min(batch8<float> const& a, batch8<float> const& b)
+	{
+		return batch8<float>(_mm_min_ps(a.data[0], b.data[0]), _mm_min_ps(a.data[1], b.data[1]));
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_max(batch8<float> const& a, batch8<float> const& b)
+	{
+		return batch8<float>(_mm_max_ps(a.data[0], b.data[0]), _mm_max_ps(a.data[1], b.data[1]));
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_sqrt(batch8<float> const& a)
+	{
+		return batch8<float>(_mm_sqrt_ps(a.data[0]), _mm_sqrt_ps(a.data[1]));
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_sin(batch8<float> const& a)
+	{
+		batch8<float> s, c;
+		glm_vec4_sincos(a.data[0], &s.data[0], &c.data[0]);
+		glm_vec4_sincos(a.data[1], &s.data[1], &c.data[1]);
+		return s;
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_cos(batch8<float> const& a)
+	{
+		batch8<float> s, c;
+		glm_vec4_sincos(a.data[0], &s.data[0], &c.data[0]);
+		glm_vec4_sincos(a.data[1], &s.data[1], &c.data[1]);
+		return c;
+	}
+
+	GLM_FUNC_QUALIFIER batch8<float> batch8_exp2(batch8<float> const& a)
+	{
+		return batch8<float>(glm_vec4_exp2(a.data[0]), glm_vec4_exp2(a.data[1]));
+	}
+#	endif//GLM_ARCH
+
+	template<typename T, typename F>
+	GLM_FUNC_QUALIFIER void compute_batch8(length_t count, T const* a, T* result, F const& f)
+	{
+		length_t i = 0;
+		for(; i + 8 <= count; i += 8)
+			batch8_store(result + i, f(batch8_load(a + i)));
+
+		// The remainder goes through a zero padded batch, 0 is in the domain of every function
+		if(i < count)
+		{
+			T in[8] = {};
+			T out[8];
+			for(length_t j = 0; i + j < count; ++j)
+				in[j] = a[i + j];
+			batch8_store(out, f(batch8_load(in)));
+			for(length_t j = 0; i + j < count; ++j)
+				result[i + j] = out[j];
+		}
+	}
+
+	template<typename T>
+	struct smoothstep_batch8
+	{
+		typedef batch8<T> V;
+
+		V edge0;
+		V edge1;
+
+		GLM_FUNC_QUALIFIER smoothstep_batch8(T e0, T e1) : edge0(e0), edge1(e1) {}
+
+		GLM_FUNC_QUALIFIER V operator()(V const& x) const
+		{
+			V const tmp = batch8_min(batch8_max((x - edge0) / (edge1 - edge0), V(0)), V(1));
+			return tmp * tmp * (V(3) - V(2) * tmp);
+		}
+	};
+
+	template<typename T>
+	struct clamp_batch8
+	{
+		typedef batch8<T> V;
+
+		V minVal;
+		V maxVal;
+
+		GLM_FUNC_QUALIFIER clamp_batch8(T mn, T mx) : minVal(mn), maxVal(mx) {}
+
+		GLM_FUNC_QUALIFIER V operator()(V const& x) const
+		{
+			return batch8_min(batch8_max(x, minVal), maxVal);
+		}
+	};
+
+	template<typename T>
+	struct linearInterpolation_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return a;
+		}
+	};
+
+	template<typename T>
+	struct quadraticEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return a * a;
+		}
+	};
+
+	template<typename T>
+	struct quadraticEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return -(a * (a - V(2)));
+		}
+	};
+
+	template<typename T>
+	struct quadraticEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return batch8_select(a < V(0.5), V(2) * a * a, (-V(2) * a * a) + (V(4) * a) - V(1));
+		}
+	};
+
+	template<typename T>
+	struct cubicEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return a * a * a;
+		}
+	};
+
+	template<typename T>
+	struct cubicEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const f = a - V(1);
+			return f * f * f + V(1);
+		}
+	};
+
+	template<typename T>
+	struct cubicEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const f = (V(2) * a) - V(2);
+			return batch8_select(a < V(0.5), V(4) * a * a * a, V(0.5) * f * f * f + V(1));
+		}
+	};
+
+	template<typename T>
+	struct quarticEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return a * a * a * a;
+		}
+	};
+
+	template<typename T>
+	struct quarticEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const f = a - V(1);
+			return f * f * f * (V(1) - a) + V(1);
+		}
+	};
+
+	template<typename T>
+	struct quarticEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const f = a - V(1);
+			return batch8_select(a < V(0.5), V(8) * a * a * a * a, -V(8) * f * f * f * f + V(1));
+		}
+	};
+
+	template<typename T>
+	struct quinticEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return a * a * a * a * a;
+		}
+	};
+
+	template<typename T>
+	struct quinticEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const f = a - V(1);
+			return f * f * f * f * f + V(1);
+		}
+	};
+
+	template<typename T>
+	struct quinticEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const f = (V(2) * a) - V(2);
+			return batch8_select(a < V(0.5), V(16) * a * a * a * a * a, V(0.5) * f * f * f * f * f + V(1));
+		}
+	};
+
+	template<typename T>
+	struct sineEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return batch8_sin((a - V(1)) * V(half_pi<T>())) + V(1);
+		}
+	};
+
+	template<typename T>
+	struct sineEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return batch8_sin(a * V(half_pi<T>()));
+		}
+	};
+
+	template<typename T>
+	struct sineEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return V(0.5) * (V(1) - batch8_cos(a * V(pi<T>())));
+		}
+	};
+
+	template<typename T>
+	struct circularEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return V(1) - batch8_sqrt(V(1) - (a * a));
+		}
+	};
+
+	template<typename T>
+	struct circularEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return batch8_sqrt((V(2) - a) * a);
+		}
+	};
+
+	template<typename T>
+	struct circularEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			// The square root of the other half is negative, its lanes are discarded
+			V const in = V(0.5) * (V(1) - batch8_sqrt(V(1) - V(4) * (a * a)));
+			V const out = V(0.5) * (batch8_sqrt(-((V(2) * a) - V(3)) * ((V(2) * a) - V(1))) + V(1));
+			return batch8_select(a < V(0.5), in, out);
+		}
+	};
+
+	template<typename T>
+	struct exponentialEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return batch8_select(a <= V(0), a, batch8_exp2((a - V(1)) * V(10)));
+		}
+	};
+
+	template<typename T>
+	struct exponentialEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return batch8_select(a >= V(1), a, V(1) - batch8_exp2(-V(10) * a));
+		}
+	};
+
+	template<typename T>
+	struct exponentialEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const in = V(0.5) * batch8_exp2((V(20) * a) - V(10));
+			V const out = -V(0.5) * batch8_exp2((-V(20) * a) + V(10)) + V(1);
+			return batch8_select(a < V(0.5), in, out);
+		}
+	};
+
+	template<typename T>
+	struct elasticEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return batch8_sin(V(13) * V(half_pi<T>()) * a) * batch8_exp2(V(10) * (a - V(1)));
+		}
+	};
+
+	template<typename T>
+	struct elasticEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return batch8_sin(-V(13) * V(half_pi<T>()) * (a + V(1))) * batch8_exp2(-V(10) * a) + V(1);
+		}
+	};
+
+	template<typename T>
+	struct elasticEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const b = V(2) * a - V(1);
+			V const in = V(0.5) * batch8_sin(V(13) * V(half_pi<T>()) * (V(2) * a)) * batch8_exp2(V(10) * b);
+			V const out = V(0.5) * (batch8_sin(-V(13) * V(half_pi<T>()) * (b + V(1))) * batch8_exp2(-V(10) * b) + V(2));
+			return batch8_select(a < V(0.5), in, out);
+		}
+	};
+
+	template<typename T>
+	struct backEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		V o;
+
+		GLM_FUNC_QUALIFIER explicit backEaseIn_batch8(T overshoot) : o(overshoot) {}
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const z = ((o + V(1)) * a) - o;
+			return a * a * z;
+		}
+	};
+
+	template<typename T>
+	struct backEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		V o;
+
+		GLM_FUNC_QUALIFIER explicit backEaseOut_batch8(T overshoot) : o(overshoot) {}
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const n = a - V(1);
+			V const z = ((o + V(1)) * n) + o;
+			return (n * n * z) + V(1);
+		}
+	};
+
+	template<typename T>
+	struct backEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		V s;
+
+		GLM_FUNC_QUALIFIER explicit backEaseInOut_batch8(T overshoot) : s(overshoot * static_cast<T>(1.525)) {}
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const n = a / V(0.5);
+			V const m = n - V(2);
+			V const in = V(0.5) * (n * n * (((s + V(1)) * n) - s));
+			V const out = V(0.5) * ((m * m * (((s + V(1)) * m) + s)) + V(2));
+			return batch8_select(n < V(1), in, out);
+		}
+	};
+
+	template<typename T>
+	struct bounceEaseOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			V const a2 = a * a;
+			V const r0 = (V(121) * a2) / V(16);
+			V const r1 = (V(363.0 / 40.0) * a2) - (V(99.0 / 10.0) * a) + V(17.0 / 5.0);
+			V const r2 = (V(4356.0 / 361.0) * a2) - (V(35442.0 / 1805.0) * a) + V(16061.0 / 1805.0);
+			V const r3 = (V(54.0 / 5.0) * a2) - (V(513.0 / 25.0) * a) + V(268.0 / 25.0);
+			return batch8_select(a < V(4.0 / 11.0), r0, batch8_select(a < V(8.0 / 11.0), r1, batch8_select(a < V(9.0 / 10.0), r2, r3)));
+		}
+	};
+
+	template<typename T>
+	struct bounceEaseIn_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			return V(1) - bounceEaseOut_batch8<T>()(V(1) - a);
+		}
+	};
+
+	template<typename T>
+	struct bounceEaseInOut_batch8
+	{
+		typedef batch8<T> V;
+
+		GLM_FUNC_QUALIFIER V operator()(V const& a) const
+		{
+			bounceEaseOut_batch8<T> bounce;
+			V const in = V(0.5) * (V(1) - bounce(V(1) - a * V(2)));
+			V const out = V(0.5) * bounce(a * V(2) - V(1)) + V(0.5);
+			return batch8_select(a < V(0.5), in, out);
+		}
+	};
+}//namespace detail
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void smoothstep(length_t count, T edge0, T edge1, T const* x, T* result)
+	{
+		detail::compute_batch8(count, x, result, detail::smoothstep_batch8<T>(edge0, edge1));
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void mix(length_t count, T const* x, T const* y, T const* a, T* result)
+	{
+		typedef detail::batch8<T> V;
+
+		length_t i = 0;
+		for(; i + 8 <= count; i += 8)
+		{
+			V const s = detail::batch8_load(a + i);
+			detail::batch8_store(result + i, detail::batch8_load(x + i) * (V(1) - s) + detail::batch8_load(y + i) * s);
+		}
+		for(; i < count; ++i)
+			result[i] = x[i] * (static_cast<T>(1) - a[i]) + y[i] * a[i];
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void clamp(length_t count, T const* x, T minVal, T maxVal, T* result)
+	{
+		detail::compute_batch8(count, x, result, detail::clamp_batch8<T>(minVal, maxVal));
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void linearInterpolation(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::linearInterpolation_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quadraticEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quadraticEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quadraticEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quadraticEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quadraticEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quadraticEaseInOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void cubicEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::cubicEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void cubicEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::cubicEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void cubicEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::cubicEaseInOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quarticEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quarticEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quarticEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quarticEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quarticEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quarticEaseInOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quinticEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quinticEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quinticEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quinticEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void quinticEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::quinticEaseInOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void sineEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::sineEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void sineEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::sineEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void sineEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::sineEaseInOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void circularEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::circularEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void circularEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::circularEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void circularEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::circularEaseInOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void exponentialEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::exponentialEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void exponentialEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::exponentialEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void exponentialEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::exponentialEaseInOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void elasticEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::elasticEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void elasticEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::elasticEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void elasticEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::elasticEaseInOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void backEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::backEaseIn_batch8<T>(static_cast<T>(1.70158)));
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void backEaseIn(length_t count, T const* a, T o, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::backEaseIn_batch8<T>(o));
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void backEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::backEaseOut_batch8<T>(static_cast<T>(1.70158)));
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void backEaseOut(length_t count, T const* a, T o, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::backEaseOut_batch8<T>(o));
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void backEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::backEaseInOut_batch8<T>(static_cast<T>(1.70158)));
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void backEaseInOut(length_t count, T const* a, T o, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::backEaseInOut_batch8<T>(o));
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void bounceEaseIn(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::bounceEaseIn_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void bounceEaseOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::bounceEaseOut_batch8<T>());
+	}
+
+	template<typename T>
+	GLM_FUNC_QUALIFIER void bounceEaseInOut(length_t count, T const* a, T* result)
+	{
+		detail::compute_batch8(count, a, result, detail::bounceEaseInOut_batch8<T>());
+	}
+}//namespace glm
@@ -0,0 +1,52 @@
+/// @ref gtx_transform_batch
+/// @file glm/gtx/transform_batch.hpp
+///
+/// @see core (dependence)
+/// @see gtc_matrix_transform
+/// @see gtx_transform
+///
+/// @defgroup gtx_transform_batch GLM_GTX_transform_batch
+/// @ingroup gtx
+///
+/// Include <glm/gtx/transform_batch.hpp> to use the features of this extension.
+///
+/// Build many transformation matrices at once from structure of arrays inputs.
+/// With SSE2 or AVX enabled, the float versions build 4 or 8 matrices per iteration.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#	error "GLM: GLM_GTX_transform_batch is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
+#elif GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_transform_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_transform_batch
+	/// @{
+
+	/// Builds count 4 * 4 matrices, each equal to translate(position) * scale(scale) * rotate(angle, vec3(0, 1, 0)),
+	/// in a single pass instead of three matrix products per matrix.
+	/// Each input is an array of count scalars, angles are expressed in radians.
+	/// The float versions use a polynomial sine and cosine, that is accurate for angles below 8192 radians.
+	///
+	/// @param count Number of matrices to build.
+	/// @param result Array of count matrices that receives the transforms, it doesn't need to be aligned.
+	/// @see gtc_matrix_transform
+	/// @see gtx_transform
+	template<typename T, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void translateScaleRotateY(
+		length_t count,
+		T const* positionX, T const* positionY, T const* positionZ,
+		T const* scaleX, T const* scaleY, T const* scaleZ,
+		T const* angle,
+		mat<4, 4, T, Q>* result);
+
+	/// @}
+}// namespace glm
+
+#include "transform_batch.inl"
@@ -0,0 +1,131 @@
+/// @ref gtx_transform_batch
+
+#include "../trigonometric.hpp"
+#include "../simd/trigonometric.h"
+
+namespace glm{
+namespace detail
+{
+	template<typename T, qualifier Q, bool UseSimd>
+	struct compute_translateScaleRotateY
+	{
+		GLM_FUNC_QUALIFIER static void call(length_t count, T const* px, T const* py, T const* pz, T const* sx, T const* sy, T const* sz, T const* angle, mat<4, 4, T, Q>* result)
+		{
+			for(length_t i = 0; i < count; ++i)
+			{
+				T const c = cos(angle[i]);
+				T const s = sin(angle[i]);
+
+				result[i][0] = vec<4, T, Q>(sx[i] * c, static_cast<T>(0), -sz[i] * s, static_cast<T>(0));
+				result[i][1] = vec<4, T, Q>(static_cast<T>(0), sy[i], static_cast<T>(0), static_cast<T>(0));
+				result[i][2] = vec<4, T, Q>(sx[i] * s, static_cast<T>(0), sz[i] * c, static_cast<T>(0));
+				result[i][3] = vec<4, T, Q>(px[i], py[i], pz[i], static_cast<T>(1));
+			}
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	// Transposes the structure of arrays columns of 4 matrices and stores them
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void store_translateScaleRotateY(
+		glm_f32vec4 c0x, glm_f32vec4 c0z, glm_f32vec4 c1y, glm_f32vec4 c2x, glm_f32vec4 c2z,
+		glm_f32vec4 px, glm_f32vec4 py, glm_f32vec4 pz, mat<4, 4, float, Q>* result)
+	{
+		glm_f32vec4 const zero = _mm_setzero_ps();
+
+		glm_f32vec4 a = c0x, b = zero, c = c0z, d = zero;
+		_MM_TRANSPOSE4_PS(a, b, c, d);
+		_mm_storeu_ps(&result[0][0][0], a);
+		_mm_storeu_ps(&result[1][0][0], b);
+		_mm_storeu_ps(&result[2][0][0], c);
+		_mm_storeu_ps(&result[3][0][0], d);
+
+		a = zero; b = c1y; c = zero; d = zero;
+		_MM_TRANSPOSE4_PS(a, b, c, d);
+		_mm_storeu_ps(&result[0][1][0], a);
+		_mm_storeu_ps(&result[1][1][0], b);
+		_mm_storeu_ps(&result[2][1][0], c);
+		_mm_storeu_ps(&result[3][1][0], d);
+
+		a = c2x; b = zero; c = c2z; d = zero;
+		_MM_TRANSPOSE4_PS(a, b, c, d);
+		_mm_storeu_ps(&result[0][2][0], a);
+		_mm_storeu_ps(&result[1][2][0], b);
+		_mm_storeu_ps(&result[2][2][0], c);
+		_mm_storeu_ps(&result[3][2][0], d);
+
+		a = px; b = py; c = pz; d = _mm_set1_ps(1.0f);
+		_MM_TRANSPOSE4_PS(a, b, c, d);
+		_mm_storeu_ps(&result[0][3][0], a);
+		_mm_storeu_ps(&result[1][3][0], b);
+		_mm_storeu_ps(&result[2][3][0], c);
+		_mm_storeu_ps(&result[3][3][0], d);
+	}
+
+	template<qualifier Q>
+	struct compute_translateScaleRotateY<float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static void call(length_t count, float const* px, float const* py, float const* pz, float const* sx, float const* sy, float const* sz, float const* angle, mat<4, 4, float, Q>* result)
+		{
+			length_t i = 0;
+
+#			if GLM_ARCH & GLM_ARCH_AVX_BIT
+			for(; i + 8 <= count; i += 8)
+			{
+				glm_f32vec8 s, c;
+				glm_vec8_sincos(_mm256_loadu_ps(angle + i), &s, &c);
+
+				glm_f32vec8 const scaleX = _mm256_loadu_ps(sx + i);
+				glm_f32vec8 const scaleZ = _mm256_loadu_ps(sz + i);
+				glm_f32vec8 const c0x = _mm256_mul_ps(scaleX, c);
+				glm_f32vec8 const c0z = _mm256_xor_ps(_mm256_mul_ps(scaleZ, s), _mm256_set1_ps(-0.0f));
+				glm_f32vec8 const c2x = _mm256_mul_ps(scaleX, s);
+				glm_f32vec8 const c2z = _mm256_mul_ps(scaleZ, c);
+				glm_f32vec8 const c1y = _mm256_loadu_ps(sy + i);
+				glm_f32vec8 const x = _mm256_loadu_ps(px + i);
+				glm_f32vec8 const y = _mm256_loadu_ps(py + i);
+				glm_f32vec8 const z = _mm256_loadu_ps(pz + i);
+
+				store_translateScaleRotateY(
+					_mm256_castps256_ps128(c0x), _mm256_castps256_ps128(c0z), _mm256_castps256_ps128(c1y),
+					_mm256_castps256_ps128(c2x), _mm256_castps256_ps128(c2z),
+					_mm256_castps256_ps128(x), _mm256_castps256_ps128(y), _mm256_castps256_ps128(z), result + i);
+				store_translateScaleRotateY(
+					_mm256_extractf128_ps(c0x, 1), _mm256_extractf128_ps(c0z, 1), _mm256_extractf128_ps(c1y, 1),
+					_mm256_extractf128_ps(c2x, 1), _mm256_extractf128_ps(c2z, 1),
+					_mm256_extractf128_ps(x, 1), _mm256_extractf128_ps(y, 1), _mm256_extractf128_ps(z, 1), result + i + 4);
+			}
+#			endif
+
+			for(; i + 4 <= count; i += 4)
+			{
+				glm_f32vec4 s, c;
+				glm_vec4_sincos(_mm_loadu_ps(angle + i), &s, &c);
+
+				glm_f32vec4 const scaleX = _mm_loadu_ps(sx + i);
+				glm_f32vec4 const scaleZ = _mm_loadu_ps(sz + i);
+
+				store_translateScaleRotateY(
+					_mm_mul_ps(scaleX, c), _mm_xor_ps(_mm_mul_ps(scaleZ, s), _mm_set1_ps(-0.0f)), _mm_loadu_ps(sy + i),
+					_mm_mul_ps(scaleX, s), _mm_mul_ps(scaleZ, c),
+					_mm_loadu_ps(px + i), _mm_loadu_ps(py + i), _mm_loadu_ps(pz + i), result + i);
+			}
+
+			compute_translateScaleRotateY<float, Q, false>::call(count - i, px + i, py + i, pz + i, sx + i, sy + i, sz + i, angle + i, result + i);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+}//namespace detail
+
+	template<typename T, qualifier Q>
+	GLM_FUNC_QUALIFIER void translateScaleRotateY(
+		length_t count,
+		T const* positionX, T const* positionY, T const* positionZ,
+		T const* scaleX, T const* scaleY, T const* scaleZ,
+		T const* angle,
+		mat<4, 4, T, Q>* result)
+	{
+		detail::compute_translateScaleRotateY<T, Q, (GLM_ARCH & GLM_ARCH_SSE2_BIT) != 0>::call(
+			count, positionX, positionY, positionZ, scaleX, scaleY, scaleZ, angle, result);
+	}
+}//namespace glm
@@ -0,0 +1,93 @@
+/// @ref gtx_unproject_batch
+/// @file glm/gtx/unproject_batch.hpp
+///
+/// @see core (dependence)
+/// @see ext_matrix_projection
+///
+/// @defgroup gtx_unproject_batch GLM_GTX_unproject_batch
+/// @ingroup gtx
+///
+/// Include <glm/gtx/unproject_batch.hpp> to use the features of this extension.
+///
+/// Generate many picking rays at once from window coordinates, with an inverse projection computed once for the whole batch.
+/// With SSE2 enabled, the float versions generate 4 rays per iteration.
+
+#pragma once
+
+// Dependency:
+#include "../glm.hpp"
+
+#ifndef GLM_ENABLE_EXPERIMENTAL
+#	error "GLM: GLM_GTX_unproject_batch is an experimental extension and may change in the future. Use #define GLM_ENABLE_EXPERIMENTAL before including it, if you really want to use it."
+#elif GLM_MESSAGES == GLM_ENABLE && !defined(GLM_EXT_INCLUDED)
+#	pragma message("GLM: GLM_GTX_unproject_batch extension included")
+#endif
+
+namespace glm
+{
+	/// @addtogroup gtx_unproject_batch
+	/// @{
+
+	/// Map count window coordinates (winX[i], winY[i]) into object space rays, starting on the near plane and directed toward the far plane.
+	/// The near and far clip planes correspond to z normalized device coordinates of 0 and +1 respectively. (Direct3D clip volume definition)
+	/// Orthographic projections, whose inverse is affine, take a faster path that shares the direction of all the rays.
+	///
+	/// @param count Number of rays to generate.
+	/// @param winX Array of count window x coordinates.
+	/// @param winY Array of count window y coordinates.
+	/// @param inverseProjModel Inverse of proj * model, computed once for many batches.
+	/// @param viewport Specifies the viewport
+	/// @param origins Array of count object coordinates that receives the points of the rays on the near plane.
+	/// @param directions Array of count normalized vectors that receives the directions of the rays.
+	/// @tparam T Native type used for the computation. Currently supported: float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see ext_matrix_projection
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void unProjectRaysZO(
+		length_t count, T const* winX, T const* winY, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport,
+		vec<3, T, Q>* origins, vec<3, T, Q>* directions);
+
+	/// Map count window coordinates (winX[i], winY[i]) into object space rays, starting on the near plane and directed toward the far plane.
+	/// The near and far clip planes correspond to z normalized device coordinates of -1 and +1 respectively. (OpenGL clip volume definition)
+	/// Orthographic projections, whose inverse is affine, take a faster path that shares the direction of all the rays.
+	///
+	/// @param count Number of rays to generate.
+	/// @param winX Array of count window x coordinates.
+	/// @param winY Array of count window y coordinates.
+	/// @param inverseProjModel Inverse of proj * model, computed once for many batches.
+	/// @param viewport Specifies the viewport
+	/// @param origins Array of count object coordinates that receives the points of the rays on the near plane.
+	/// @param directions Array of count normalized vectors that receives the directions of the rays.
+	/// @tparam T Native type used for the computation. Currently supported: float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see ext_matrix_projection
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void unProjectRaysNO(
+		length_t count, T const* winX, T const* winY, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport,
+		vec<3, T, Q>* origins, vec<3, T, Q>* directions);
+
+	/// Map count window coordinates (winX[i], winY[i]) into object space rays using default near and far clip planes definition.
+	/// To change default near and far clip planes definition use GLM_FORCE_DEPTH_ZERO_TO_ONE.
+	///
+	/// @param count Number of rays to generate.
+	/// @param winX Array of count window x coordinates.
+	/// @param winY Array of count window y coordinates.
+	/// @param inverseProjModel Inverse of proj * model, computed once for many batches.
+	/// @param viewport Specifies the viewport
+	/// @param origins Array of count object coordinates that receives the points of the rays on the near plane.
+	/// @param directions Array of count normalized vectors that receives the directions of the rays.
+	/// @tparam T Native type used for the computation. Currently supported: float or double.
+	/// @tparam U Currently supported: Floating-point types and integer types.
+	///
+	/// @see ext_matrix_projection
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_DISCARD_DECL void unProjectRays(
+		length_t count, T const* winX, T const* winY, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport,
+		vec<3, T, Q>* origins, vec<3, T, Q>* directions);
+
+	/// @}
+}// namespace glm
+
+#include "unproject_batch.inl"
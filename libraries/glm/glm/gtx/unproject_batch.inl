@@ -0,0 +1,186 @@
+/// @ref gtx_unproject_batch
+
+#include "../geometric.hpp"
+#include "../detail/compute_vector_relational.hpp"
+#include <limits>
+
+namespace glm{
+namespace detail
+{
+	// Window coordinates map to object space points as dx * winX + dy * winY + point, where point is on the near or the far plane
+	template<typename T, qualifier Q, bool UseSimd>
+	struct compute_unProjectRays
+	{
+		GLM_FUNC_QUALIFIER static void call(length_t count, T const* winX, T const* winY,
+			vec<4, T, Q> const& dx, vec<4, T, Q> const& dy, vec<4, T, Q> const& nearPoint, vec<4, T, Q> const& farPoint, bool affine,
+			vec<3, T, Q>* origins, vec<3, T, Q>* directions)
+		{
+			if(affine)
+			{
+				T const invW = static_cast<T>(1) / nearPoint.w;
+				vec<3, T, Q> const direction = normalize(vec<3, T, Q>(farPoint - nearPoint) * invW);
+
+				for(length_t i = 0; i < count; ++i)
+				{
+					origins[i] = vec<3, T, Q>(dx * winX[i] + dy * winY[i] + nearPoint) * invW;
+					directions[i] = direction;
+				}
+			}
+			else
+			{
+				for(length_t i = 0; i < count; ++i)
+				{
+					vec<4, T, Q> const offset = dx * winX[i] + dy * winY[i];
+					vec<4, T, Q> const nearObj = offset + nearPoint;
+					vec<4, T, Q> const farObj = offset + farPoint;
+
+					origins[i] = vec<3, T, Q>(nearObj) / nearObj.w;
+					directions[i] = normalize(vec<3, T, Q>(farObj) / farObj.w - origins[i]);
+				}
+			}
+		}
+	};
+
+#	if GLM_ARCH & GLM_ARCH_SSE2_BIT
+	// Transposes the structure of arrays coordinates of 4 vectors and stores them
+	template<qualifier Q>
+	GLM_FUNC_QUALIFIER void store_unProjectRays(glm_f32vec4 x, glm_f32vec4 y, glm_f32vec4 z, vec<3, float, Q>* result)
+	{
+		glm_f32vec4 w = _mm_setzero_ps();
+		_MM_TRANSPOSE4_PS(x, y, z, w);
+
+		glm_f32vec4 const v[4] = {x, y, z, w};
+		for(length_t i = 0; i < 4; ++i)
+		{
+			_mm_storel_pi(reinterpret_cast<__m64*>(&result[i].x), v[i]);
+			_mm_store_ss(&result[i].z, _mm_movehl_ps(v[i], v[i]));
+		}
+	}
+
+	template<qualifier Q>
+	struct compute_unProjectRays<float, Q, true>
+	{
+		GLM_FUNC_QUALIFIER static void call(length_t count, float const* winX, float const* winY,
+			vec<4, float, Q> const& dx, vec<4, float, Q> const& dy, vec<4, float, Q> const& nearPoint, vec<4, float, Q> const& farPoint, bool affine,
+			vec<3, float, Q>* origins, vec<3, float, Q>* directions)
+		{
+			length_t i = 0;
+
+			if(affine)
+			{
+				float const invW = 1.0f / nearPoint.w;
+				vec<3, float, Q> const direction = normalize(vec<3, float, Q>(farPoint - nearPoint) * invW);
+
+				glm_f32vec4 const dxx = _mm_set1_ps(dx.x * invW), dxy = _mm_set1_ps(dx.y * invW), dxz = _mm_set1_ps(dx.z * invW);
+				glm_f32vec4 const dyx = _mm_set1_ps(dy.x * invW), dyy = _mm_set1_ps(dy.y * invW), dyz = _mm_set1_ps(dy.z * invW);
+				glm_f32vec4 const px = _mm_set1_ps(nearPoint.x * invW), py = _mm_set1_ps(nearPoint.y * invW), pz = _mm_set1_ps(nearPoint.z * invW);
+
+				for(; i + 4 <= count; i += 4)
+				{
+					glm_f32vec4 const x = _mm_loadu_ps(winX + i);
+					glm_f32vec4 const y = _mm_loadu_ps(winY + i);
+
+					store_unProjectRays(
+						_mm_add_ps(_mm_add_ps(_mm_mul_ps(dxx, x), _mm_mul_ps(dyx, y)), px),
+						_mm_add_ps(_mm_add_ps(_mm_mul_ps(dxy, x), _mm_mul_ps(dyy, y)), py),
+						_mm_add_ps(_mm_add_ps(_mm_mul_ps(dxz, x), _mm_mul_ps(dyz, y)), pz), origins + i);
+
+					directions[i + 0] = direction;
+					directions[i + 1] = direction;
+					directions[i + 2] = direction;
+					directions[i + 3] = direction;
+				}
+			}
+			else
+			{
+				glm_f32vec4 const dxv[4] = {_mm_set1_ps(dx.x), _mm_set1_ps(dx.y), _mm_set1_ps(dx.z), _mm_set1_ps(dx.w)};
+				glm_f32vec4 const dyv[4] = {_mm_set1_ps(dy.x), _mm_set1_ps(dy.y), _mm_set1_ps(dy.z), _mm_set1_ps(dy.w)};
+				glm_f32vec4 const nv[4] = {_mm_set1_ps(nearPoint.x), _mm_set1_ps(nearPoint.y), _mm_set1_ps(nearPoint.z), _mm_set1_ps(nearPoint.w)};
+				glm_f32vec4 const fv[4] = {_mm_set1_ps(farPoint.x), _mm_set1_ps(farPoint.y), _mm_set1_ps(farPoint.z), _mm_set1_ps(farPoint.w)};
+
+				for(; i + 4 <= count; i += 4)
+				{
+					glm_f32vec4 const x = _mm_loadu_ps(winX + i);
+					glm_f32vec4 const y = _mm_loadu_ps(winY + i);
+
+					glm_f32vec4 nearObj[4], farObj[4];
+					for(length_t k = 0; k < 4; ++k)
+					{
+						glm_f32vec4 const offset = _mm_add_ps(_mm_mul_ps(dxv[k], x), _mm_mul_ps(dyv[k], y));
+						nearObj[k] = _mm_add_ps(offset, nv[k]);
+						farObj[k] = _mm_add_ps(offset, fv[k]);
+					}
+
+					glm_f32vec4 const invNearW = _mm_div_ps(_mm_set1_ps(1.0f), nearObj[3]);
+					glm_f32vec4 const invFarW = _mm_div_ps(_mm_set1_ps(1.0f), farObj[3]);
+
+					glm_f32vec4 const ox = _mm_mul_ps(nearObj[0], invNearW);
+					glm_f32vec4 const oy = _mm_mul_ps(nearObj[1], invNearW);
+					glm_f32vec4 const oz = _mm_mul_ps(nearObj[2], invNearW);
+
+					glm_f32vec4 const rx = _mm_sub_ps(_mm_mul_ps(farObj[0], invFarW), ox);
+					glm_f32vec4 const ry = _mm_sub_ps(_mm_mul_ps(farObj[1], invFarW), oy);
+					glm_f32vec4 const rz = _mm_sub_ps(_mm_mul_ps(farObj[2], invFarW), oz);
+					glm_f32vec4 const length = _mm_sqrt_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(rx, rx), _mm_mul_ps(ry, ry)), _mm_mul_ps(rz, rz)));
+					glm_f32vec4 const invLength = _mm_div_ps(_mm_set1_ps(1.0f), length);
+
+					store_unProjectRays(ox, oy, oz, origins + i);
+					store_unProjectRays(_mm_mul_ps(rx, invLength), _mm_mul_ps(ry, invLength), _mm_mul_ps(rz, invLength), directions + i);
+				}
+			}
+
+			compute_unProjectRays<float, Q, false>::call(count - i, winX + i, winY + i, dx, dy, nearPoint, farPoint, affine, origins + i, directions + i);
+		}
+	};
+#	endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void unProjectRays(
+		length_t count, T const* winX, T const* winY, mat<4, 4, T, Q> const& m, vec<4, U, Q> const& viewport, T nearDepth,
+		vec<3, T, Q>* origins, vec<3, T, Q>* directions)
+	{
+		// Folds the viewport transform into the inverse projection
+		T const scaleX = static_cast<T>(2) / T(viewport[2]);
+		T const scaleY = static_cast<T>(2) / T(viewport[3]);
+
+		vec<4, T, Q> const dx = m[0] * scaleX;
+		vec<4, T, Q> const dy = m[1] * scaleY;
+		vec<4, T, Q> const base = m[3] - m[0] * (T(viewport[0]) * scaleX + static_cast<T>(1)) - m[1] * (T(viewport[1]) * scaleY + static_cast<T>(1));
+		bool const affine =
+			compute_equal<T, std::numeric_limits<T>::is_iec559>::call(m[0].w, static_cast<T>(0)) &&
+			compute_equal<T, std::numeric_limits<T>::is_iec559>::call(m[1].w, static_cast<T>(0)) &&
+			compute_equal<T, std::numeric_limits<T>::is_iec559>::call(m[2].w, static_cast<T>(0));
+
+		compute_unProjectRays<T, Q, (GLM_ARCH & GLM_ARCH_SSE2_BIT) != 0>::call(
+			count, winX, winY, dx, dy, base + m[2] * nearDepth, base + m[2], affine, origins, directions);
+	}
+}//namespace detail
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void unProjectRaysZO(
+		length_t count, T const* winX, T const* winY, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport,
+		vec<3, T, Q>* origins, vec<3, T, Q>* directions)
+	{
+		detail::unProjectRays(count, winX, winY, inverseProjModel, viewport, static_cast<T>(0), origins, directions);
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void unProjectRaysNO(
+		length_t count, T const* winX, T const* winY, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport,
+		vec<3, T, Q>* origins, vec<3, T, Q>* directions)
+	{
+		detail::unProjectRays(count, winX, winY, inverseProjModel, viewport, static_cast<T>(-1), origins, directions);
+	}
+
+	template<typename T, typename U, qualifier Q>
+	GLM_FUNC_QUALIFIER void unProjectRays(
+		length_t count, T const* winX, T const* winY, mat<4, 4, T, Q> const& inverseProjModel, vec<4, U, Q> const& viewport,
+		vec<3, T, Q>* origins, vec<3, T, Q>* directions)
+	{
+#		if GLM_CONFIG_CLIP_CONTROL & GLM_CLIP_CONTROL_ZO_BIT
+			unProjectRaysZO(count, winX, winY, inverseProjModel, viewport, origins, directions);
+#		else
+			unProjectRaysNO(count, winX, winY, inverseProjModel, viewport, origins, directions);
+#		endif
+	}
+}//namespace glm
@@ -17,4 +17,57 @@ GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_sqrt_lowp(glm_f32vec4 x)
 	return _mm_mul_ps(_mm_rsqrt_ps(x), x);
 }
 
+// Cephes exp2f minimax polynomial on [-0.5, 0.5], scaled by the power of two of the rounded exponent.
+// x is clamped to [-126, 127] so the result stays a normal float.
+GLM_FUNC_QUALIFIER glm_f32vec4 glm_vec4_exp2(glm_f32vec4 x)
+{
+	x = _mm_min_ps(_mm_max_ps(x, _mm_set1_ps(-126.0f)), _mm_set1_ps(127.0f));
+
+	glm_i32vec4 const n = _mm_cvtps_epi32(x);
+	glm_f32vec4 const f = _mm_sub_ps(x, _mm_cvtepi32_ps(n));
+
+	glm_f32vec4 p = _mm_set1_ps(1.535336188319500e-4f);
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.339887440266574e-3f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(9.618437357674640e-3f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(5.550332471162809e-2f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(2.402264791363012e-1f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(6.931472028550421e-1f));
+	p = _mm_add_ps(_mm_mul_ps(p, f), _mm_set1_ps(1.0f));
+
+	glm_f32vec4 const scale = _mm_castsi128_ps(_mm_slli_epi32(_mm_add_epi32(n, _mm_set1_epi32(127)), 23));
+	return _mm_mul_ps(p, scale);
+}
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
+
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+GLM_FUNC_QUALIFIER glm_f32vec8 glm_vec8_exp2(glm_f32vec8 x)
+{
+	x = _mm256_min_ps(_mm256_max_ps(x, _mm256_set1_ps(-126.0f)), _mm256_set1_ps(127.0f));
+
+	glm_f32vec8 const fn = _mm256_round_ps(x, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	glm_f32vec8 const f = _mm256_sub_ps(x, fn);
+
+	glm_f32vec8 p = _mm256_set1_ps(1.535336188319500e-4f);
+	p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(1.339887440266574e-3f));
+	p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(9.618437357674640e-3f));
+	p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(5.550332471162809e-2f));
+	p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(2.402264791363012e-1f));
+	p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(6.931472028550421e-1f));
+	p = _mm256_add_ps(_mm256_mul_ps(p, f), _mm256_set1_ps(1.0f));
+
+	__m256i const n = _mm256_cvtps_epi32(fn);
+#	if GLM_ARCH & GLM_ARCH_AVX2_BIT
+		__m256i const bits = _mm256_slli_epi32(_mm256_add_epi32(n, _mm256_set1_epi32(127)), 23);
+#	else
+		// AVX has no 256-bit integer operations, the exponent bits are built in two halves
+		glm_i32vec4 const bias = _mm_set1_epi32(127);
+		glm_i32vec4 const lo = _mm_slli_epi32(_mm_add_epi32(_mm256_castsi256_si128(n), bias), 23);
+		glm_i32vec4 const hi = _mm_slli_epi32(_mm_add_epi32(_mm256_extractf128_si256(n, 1), bias), 23);
+		__m256i const bits = _mm256_insertf128_si256(_mm256_castsi128_si256(lo), hi, 1);
+#	endif
+	return _mm256_mul_ps(p, _mm256_castsi256_ps(bits));
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
@@ -3,7 +3,84 @@
 
 #pragma once
 
+#include "platform.h"
+
 #if GLM_ARCH & GLM_ARCH_SSE2_BIT
 
+// Cephes sinf/cosf minimax polynomials on [-pi/4, pi/4], after a Cody-Waite reduction by multiples of pi/2.
+// Accurate to a few ulps for |x| < 8192.
+GLM_FUNC_QUALIFIER void glm_vec4_sincos(glm_f32vec4 x, glm_f32vec4* s, glm_f32vec4* c)
+{
+	glm_f32vec4 const sign_mask = _mm_castsi128_ps(_mm_set1_epi32(static_cast<int>(0x80000000)));
+
+	// Quadrant of x, rounded to nearest
+	glm_i32vec4 const q = _mm_cvtps_epi32(_mm_mul_ps(x, _mm_set1_ps(0.63661977236758134308f)));
+	glm_f32vec4 const j = _mm_cvtepi32_ps(q);
+
+	glm_f32vec4 r = _mm_sub_ps(x, _mm_mul_ps(j, _mm_set1_ps(1.5703125f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(4.837512969970703125e-4f)));
+	r = _mm_sub_ps(r, _mm_mul_ps(j, _mm_set1_ps(7.54978995489188216e-8f)));
+	glm_f32vec4 const r2 = _mm_mul_ps(r, r);
+
+	glm_f32vec4 ps = _mm_set1_ps(-1.9515295891e-4f);
+	ps = _mm_add_ps(_mm_mul_ps(ps, r2), _mm_set1_ps(8.3321608736e-3f));
+	ps = _mm_add_ps(_mm_mul_ps(ps, r2), _mm_set1_ps(-1.6666654611e-1f));
+	ps = _mm_add_ps(_mm_mul_ps(_mm_mul_ps(ps, r2), r), r);
+
+	glm_f32vec4 pc = _mm_set1_ps(2.443315711809948e-5f);
+	pc = _mm_add_ps(_mm_mul_ps(pc, r2), _mm_set1_ps(-1.388731625493765e-3f));
+	pc = _mm_add_ps(_mm_mul_ps(pc, r2), _mm_set1_ps(4.166664568298827e-2f));
+	pc = _mm_mul_ps(_mm_mul_ps(pc, r2), r2);
+	pc = _mm_add_ps(_mm_sub_ps(pc, _mm_mul_ps(r2, _mm_set1_ps(0.5f))), _mm_set1_ps(1.0f));
+
+	// Odd quadrants swap sine and cosine, quadrants 2 and 3 negate the sine, quadrants 1 and 2 negate the cosine
+	glm_f32vec4 const swap = _mm_castsi128_ps(_mm_cmpeq_epi32(_mm_and_si128(q, _mm_set1_epi32(1)), _mm_set1_epi32(1)));
+	glm_f32vec4 const sin_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(q, _mm_set1_epi32(2)), 30));
+	glm_f32vec4 const cos_sign = _mm_castsi128_ps(_mm_slli_epi32(_mm_and_si128(_mm_add_epi32(q, _mm_set1_epi32(1)), _mm_set1_epi32(2)), 30));
+
+	glm_f32vec4 const sin_r = _mm_or_ps(_mm_and_ps(swap, pc), _mm_andnot_ps(swap, ps));
+	glm_f32vec4 const cos_r = _mm_or_ps(_mm_and_ps(swap, ps), _mm_andnot_ps(swap, pc));
+	*s = _mm_xor_ps(sin_r, _mm_and_ps(sin_sign, sign_mask));
+	*c = _mm_xor_ps(cos_r, _mm_and_ps(cos_sign, sign_mask));
+}
+
 #endif//GLM_ARCH & GLM_ARCH_SSE2_BIT
 
+#if GLM_ARCH & GLM_ARCH_AVX_BIT
+
+// Same reduction and polynomials as glm_vec4_sincos, with the quadrant kept in floats since AVX has no 256-bit integer operations.
+GLM_FUNC_QUALIFIER void glm_vec8_sincos(glm_f32vec8 x, glm_f32vec8* s, glm_f32vec8* c)
+{
+	glm_f32vec8 const sign_mask = _mm256_set1_ps(-0.0f);
+
+	glm_f32vec8 const j = _mm256_round_ps(_mm256_mul_ps(x, _mm256_set1_ps(0.63661977236758134308f)), _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC);
+	// j modulo 4, in [0, 4)
+	glm_f32vec8 const q = _mm256_sub_ps(j, _mm256_mul_ps(_mm256_floor_ps(_mm256_mul_ps(j, _mm256_set1_ps(0.25f))), _mm256_set1_ps(4.0f)));
+
+	glm_f32vec8 r = _mm256_sub_ps(x, _mm256_mul_ps(j, _mm256_set1_ps(1.5703125f)));
+	r = _mm256_sub_ps(r, _mm256_mul_ps(j, _mm256_set1_ps(4.837512969970703125e-4f)));
+	r = _mm256_sub_ps(r, _mm256_mul_ps(j, _mm256_set1_ps(7.54978995489188216e-8f)));
+	glm_f32vec8 const r2 = _mm256_mul_ps(r, r);
+
+	glm_f32vec8 ps = _mm256_set1_ps(-1.9515295891e-4f);
+	ps = _mm256_add_ps(_mm256_mul_ps(ps, r2), _mm256_set1_ps(8.3321608736e-3f));
+	ps = _mm256_add_ps(_mm256_mul_ps(ps, r2), _mm256_set1_ps(-1.6666654611e-1f));
+	ps = _mm256_add_ps(_mm256_mul_ps(_mm256_mul_ps(ps, r2), r), r);
+
+	glm_f32vec8 pc = _mm256_set1_ps(2.443315711809948e-5f);
+	pc = _mm256_add_ps(_mm256_mul_ps(pc, r2), _mm256_set1_ps(-1.388731625493765e-3f));
+	pc = _mm256_add_ps(_mm256_mul_ps(pc, r2), _mm256_set1_ps(4.166664568298827e-2f));
+	pc = _mm256_mul_ps(_mm256_mul_ps(pc, r2), r2);
+	pc = _mm256_add_ps(_mm256_sub_ps(pc, _mm256_mul_ps(r2, _mm256_set1_ps(0.5f))), _mm256_set1_ps(1.0f));
+
+	glm_f32vec8 const one = _mm256_set1_ps(1.0f);
+	glm_f32vec8 const two = _mm256_set1_ps(2.0f);
+	glm_f32vec8 const swap = _mm256_or_ps(_mm256_cmp_ps(q, one, _CMP_EQ_OQ), _mm256_cmp_ps(q, _mm256_set1_ps(3.0f), _CMP_EQ_OQ));
+	glm_f32vec8 const sin_sign = _mm256_and_ps(_mm256_cmp_ps(q, two, _CMP_GE_OQ), sign_mask);
+	glm_f32vec8 const cos_sign = _mm256_and_ps(_mm256_and_ps(_mm256_cmp_ps(q, one, _CMP_GE_OQ), _mm256_cmp_ps(q, two, _CMP_LE_OQ)), sign_mask);
+
+	*s = _mm256_xor_ps(_mm256_blendv_ps(ps, pc, swap), sin_sign);
+	*c = _mm256_xor_ps(_mm256_blendv_ps(pc, ps, swap), cos_sign);
+}
+
+#endif//GLM_ARCH & GLM_ARCH_AVX_BIT
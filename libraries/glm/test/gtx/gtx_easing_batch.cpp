@@ -0,0 +1,187 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/easing_batch.hpp>
+#include <glm/gtx/easing.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <cstdio>
+#include <ctime>
+#include <vector>
+
+namespace
+{
+	template<typename T>
+	struct easing
+	{
+		typedef void (*batch)(glm::length_t, T const*, T*);
+		typedef T (*scalar)(T const&);
+
+		char const* Name;
+		batch Batch;
+		scalar Scalar;
+	};
+
+	template<typename T>
+	static std::vector<easing<T> > easings()
+	{
+		easing<T> const Easings[] =
+		{
+			{"linearInterpolation", glm::linearInterpolation<T>, glm::linearInterpolation<T>},
+			{"quadraticEaseIn", glm::quadraticEaseIn<T>, glm::quadraticEaseIn<T>},
+			{"quadraticEaseOut", glm::quadraticEaseOut<T>, glm::quadraticEaseOut<T>},
+			{"quadraticEaseInOut", glm::quadraticEaseInOut<T>, glm::quadraticEaseInOut<T>},
+			{"cubicEaseIn", glm::cubicEaseIn<T>, glm::cubicEaseIn<T>},
+			{"cubicEaseOut", glm::cubicEaseOut<T>, glm::cubicEaseOut<T>},
+			{"cubicEaseInOut", glm::cubicEaseInOut<T>, glm::cubicEaseInOut<T>},
+			{"quarticEaseIn", glm::quarticEaseIn<T>, glm::quarticEaseIn<T>},
+			{"quarticEaseOut", glm::quarticEaseOut<T>, glm::quarticEaseOut<T>},
+			{"quarticEaseInOut", glm::quarticEaseInOut<T>, glm::quarticEaseInOut<T>},
+			{"quinticEaseIn", glm::quinticEaseIn<T>, glm::quinticEaseIn<T>},
+			{"quinticEaseOut", glm::quinticEaseOut<T>, glm::quinticEaseOut<T>},
+			{"quinticEaseInOut", glm::quinticEaseInOut<T>, glm::quinticEaseInOut<T>},
+			{"sineEaseIn", glm::sineEaseIn<T>, glm::sineEaseIn<T>},
+			{"sineEaseOut", glm::sineEaseOut<T>, glm::sineEaseOut<T>},
+			{"sineEaseInOut", glm::sineEaseInOut<T>, glm::sineEaseInOut<T>},
+			{"circularEaseIn", glm::circularEaseIn<T>, glm::circularEaseIn<T>},
+			{"circularEaseOut", glm::circularEaseOut<T>, glm::circularEaseOut<T>},
+			{"circularEaseInOut", glm::circularEaseInOut<T>, glm::circularEaseInOut<T>},
+			{"exponentialEaseIn", glm::exponentialEaseIn<T>, glm::exponentialEaseIn<T>},
+			{"exponentialEaseOut", glm::exponentialEaseOut<T>, glm::exponentialEaseOut<T>},
+			{"exponentialEaseInOut", glm::exponentialEaseInOut<T>, glm::exponentialEaseInOut<T>},
+			{"elasticEaseIn", glm::elasticEaseIn<T>, glm::elasticEaseIn<T>},
+			{"elasticEaseOut", glm::elasticEaseOut<T>, glm::elasticEaseOut<T>},
+			{"elasticEaseInOut", glm::elasticEaseInOut<T>, glm::elasticEaseInOut<T>},
+			{"backEaseIn", glm::backEaseIn<T>, glm::backEaseIn<T>},
+			{"backEaseOut", glm::backEaseOut<T>, glm::backEaseOut<T>},
+			{"backEaseInOut", glm::backEaseInOut<T>, glm::backEaseInOut<T>},
+			{"bounceEaseIn", glm::bounceEaseIn<T>, glm::bounceEaseIn<T>},
+			{"bounceEaseOut", glm::bounceEaseOut<T>, glm::bounceEaseOut<T>},
+			{"bounceEaseInOut", glm::bounceEaseInOut<T>, glm::bounceEaseInOut<T>}
+		};
+		return std::vector<easing<T> >(Easings, Easings + sizeof(Easings) / sizeof(Easings[0]));
+	}
+
+	template<typename T>
+	static std::vector<T> values(glm::length_t Count)
+	{
+		std::vector<T> Values(Count);
+		for(glm::length_t i = 0; i < Count; ++i)
+			Values[i] = static_cast<T>(i) / static_cast<T>(Count - 1);
+		return Values;
+	}
+
+	template<typename T>
+	static int test_easing(glm::length_t Count)
+	{
+		int Error = 0;
+
+		std::vector<T> const A = values<T>(Count);
+		std::vector<T> Result(Count);
+
+		std::vector<easing<T> > const Easings = easings<T>();
+		for(std::size_t e = 0; e < Easings.size(); ++e)
+		{
+			Easings[e].Batch(Count, &A[0], &Result[0]);
+			for(glm::length_t i = 0; i < Count; ++i)
+			{
+				bool const Equal = glm::epsilonEqual(Result[i], Easings[e].Scalar(A[i]), static_cast<T>(1e-5));
+				if(!Equal)
+					std::printf("%s(%f) %f\n", Easings[e].Name, static_cast<double>(A[i]), static_cast<double>(Result[i]));
+				Error += Equal ? 0 : 1;
+			}
+		}
+
+		// With an overshoot, and in place
+		std::vector<T> InPlace(A);
+		glm::backEaseInOut(Count, &InPlace[0], static_cast<T>(2.5), &InPlace[0]);
+		for(glm::length_t i = 0; i < Count; ++i)
+			Error += glm::epsilonEqual(InPlace[i], glm::backEaseInOut(A[i], static_cast<T>(2.5)), static_cast<T>(1e-5)) ? 0 : 1;
+
+		return Error;
+	}
+
+	template<typename T>
+	static int test_common(glm::length_t Count)
+	{
+		int Error = 0;
+
+		std::vector<T> const A = values<T>(Count);
+		std::vector<T> X(Count), Y(Count), Result(Count);
+		for(glm::length_t i = 0; i < Count; ++i)
+		{
+			X[i] = static_cast<T>(i) * static_cast<T>(3) - static_cast<T>(20);
+			Y[i] = static_cast<T>(i % 5);
+		}
+
+		glm::smoothstep(Count, static_cast<T>(-10), static_cast<T>(30), &X[0], &Result[0]);
+		for(glm::length_t i = 0; i < Count; ++i)
+			Error += glm::epsilonEqual(Result[i], glm::smoothstep(static_cast<T>(-10), static_cast<T>(30), X[i]), static_cast<T>(1e-6)) ? 0 : 1;
+
+		glm::mix(Count, &X[0], &Y[0], &A[0], &Result[0]);
+		for(glm::length_t i = 0; i < Count; ++i)
+			Error += glm::epsilonEqual(Result[i], glm::mix(X[i], Y[i], A[i]), static_cast<T>(1e-5)) ? 0 : 1;
+
+		glm::clamp(Count, &X[0], static_cast<T>(-5), static_cast<T>(5), &Result[0]);
+		for(glm::length_t i = 0; i < Count; ++i)
+			Error += glm::epsilonEqual(Result[i], glm::clamp(X[i], static_cast<T>(-5), static_cast<T>(5)), static_cast<T>(1e-6)) ? 0 : 1;
+
+		return Error;
+	}
+}//namespace
+
+namespace perf
+{
+	static int test()
+	{
+		glm::length_t const Count = 4096;
+		int const Passes = 1000;
+
+		std::vector<float> const A = values<float>(Count);
+		std::vector<float> Result(Count);
+
+		std::clock_t const TimeScalarSmoothstep0 = std::clock();
+		for(int p = 0; p < Passes; ++p)
+			for(glm::length_t i = 0; i < Count; ++i)
+				Result[i] = glm::smoothstep(0.0f, 1.0f, A[i]);
+		std::clock_t const TimeScalarSmoothstep1 = std::clock();
+		for(int p = 0; p < Passes; ++p)
+			glm::smoothstep(Count, 0.0f, 1.0f, &A[0], &Result[0]);
+		std::clock_t const TimeBatchSmoothstep = std::clock();
+
+		std::printf("smoothstep scalar %d clocks, batch %d clocks\n",
+			static_cast<int>(TimeScalarSmoothstep1 - TimeScalarSmoothstep0), static_cast<int>(TimeBatchSmoothstep - TimeScalarSmoothstep1));
+
+		std::vector<easing<float> > const Easings = easings<float>();
+		for(std::size_t e = 0; e < Easings.size(); ++e)
+		{
+			std::clock_t const TimeScalar = std::clock();
+			for(int p = 0; p < Passes / 10; ++p)
+				for(glm::length_t i = 0; i < Count; ++i)
+					Result[i] = Easings[e].Scalar(A[i]);
+			std::clock_t const TimeBatch = std::clock();
+			for(int p = 0; p < Passes / 10; ++p)
+				Easings[e].Batch(Count, &A[0], &Result[0]);
+			std::clock_t const TimeEnd = std::clock();
+
+			std::printf("%s scalar %d clocks, batch %d clocks\n", Easings[e].Name,
+				static_cast<int>(TimeBatch - TimeScalar), static_cast<int>(TimeEnd - TimeBatch));
+		}
+
+		return 0;
+	}
+}//namespace perf
+
+int main()
+{
+	int Error = 0;
+
+	// Sizes with and without a remainder after the 8 wide loop
+	Error += test_easing<float>(2);
+	Error += test_easing<float>(64);
+	Error += test_easing<float>(101);
+	Error += test_easing<double>(101);
+	Error += test_common<float>(101);
+	Error += test_common<double>(37);
+
+	Error += perf::test();
+
+	return Error;
+}
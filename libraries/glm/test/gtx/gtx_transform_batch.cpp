@@ -0,0 +1,56 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/transform_batch.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <vector>
+
+template<typename T>
+static int test_translateScaleRotateY(glm::length_t Count)
+{
+	int Error = 0;
+
+	std::vector<T> PositionX(Count), PositionY(Count), PositionZ(Count);
+	std::vector<T> ScaleX(Count), ScaleY(Count), ScaleZ(Count);
+	std::vector<T> Angle(Count);
+	for(glm::length_t i = 0; i < Count; ++i)
+	{
+		PositionX[i] = static_cast<T>(i) * static_cast<T>(145.5);
+		PositionY[i] = static_cast<T>(i % 4) * static_cast<T>(-212);
+		PositionZ[i] = static_cast<T>(i % 3);
+		ScaleX[i] = static_cast<T>(130);
+		ScaleY[i] = static_cast<T>(1 + i);
+		ScaleZ[i] = static_cast<T>(0.5);
+		// Covers every quadrant, in both directions
+		Angle[i] = static_cast<T>(i) * static_cast<T>(0.7) - static_cast<T>(10);
+	}
+
+	std::vector<glm::mat<4, 4, T, glm::defaultp> > Result(Count);
+	glm::translateScaleRotateY(Count, &PositionX[0], &PositionY[0], &PositionZ[0], &ScaleX[0], &ScaleY[0], &ScaleZ[0], &Angle[0], &Result[0]);
+
+	for(glm::length_t i = 0; i < Count; ++i)
+	{
+		glm::mat<4, 4, T, glm::defaultp> Expected(static_cast<T>(1));
+		Expected = glm::translate(Expected, glm::vec<3, T, glm::defaultp>(PositionX[i], PositionY[i], PositionZ[i]));
+		Expected = glm::scale(Expected, glm::vec<3, T, glm::defaultp>(ScaleX[i], ScaleY[i], ScaleZ[i]));
+		Expected = glm::rotate(Expected, Angle[i], glm::vec<3, T, glm::defaultp>(0, 1, 0));
+
+		for(glm::length_t j = 0; j < 4; ++j)
+			Error += glm::all(glm::epsilonEqual(Result[i][j], Expected[j], static_cast<T>(1e-5) * ScaleX[i])) ? 0 : 1;
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	// Sizes with and without a remainder after the 4 and 8 wide loops
+	Error += test_translateScaleRotateY<float>(1);
+	Error += test_translateScaleRotateY<float>(4);
+	Error += test_translateScaleRotateY<float>(29);
+	Error += test_translateScaleRotateY<float>(52);
+	Error += test_translateScaleRotateY<double>(29);
+
+	return Error;
+}
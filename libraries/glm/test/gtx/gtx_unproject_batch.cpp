@@ -0,0 +1,78 @@
+#define GLM_ENABLE_EXPERIMENTAL
+#include <glm/gtx/unproject_batch.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_projection.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/gtc/epsilon.hpp>
+#include <glm/gtc/matrix_inverse.hpp>
+#include <vector>
+
+template<typename T>
+static int test_unProjectRays(glm::mat<4, 4, T, glm::defaultp> const& Proj, glm::mat<4, 4, T, glm::defaultp> const& Model, bool ZeroToOne, glm::length_t Count)
+{
+	typedef glm::vec<3, T, glm::defaultp> vec3;
+
+	int Error = 0;
+
+	glm::vec<4, int, glm::defaultp> const Viewport(10, 20, 1920, 980);
+
+	std::vector<T> WinX(Count), WinY(Count);
+	for(glm::length_t i = 0; i < Count; ++i)
+	{
+		WinX[i] = static_cast<T>(10 + (i * 397) % 1920);
+		WinY[i] = static_cast<T>(20 + (i * 211) % 980);
+	}
+
+	std::vector<vec3> Origins(Count), Directions(Count);
+	glm::mat<4, 4, T, glm::defaultp> const Inverse = glm::inverse(Proj * Model);
+	if(ZeroToOne)
+		glm::unProjectRaysZO(Count, &WinX[0], &WinY[0], Inverse, Viewport, &Origins[0], &Directions[0]);
+	else
+		glm::unProjectRaysNO(Count, &WinX[0], &WinY[0], Inverse, Viewport, &Origins[0], &Directions[0]);
+
+	for(glm::length_t i = 0; i < Count; ++i)
+	{
+		vec3 const NearWin(WinX[i], WinY[i], static_cast<T>(0));
+		vec3 const FarWin(WinX[i], WinY[i], static_cast<T>(1));
+		vec3 const Near = ZeroToOne ? glm::unProjectZO(NearWin, Model, Proj, Viewport) : glm::unProjectNO(NearWin, Model, Proj, Viewport);
+		vec3 const Far = ZeroToOne ? glm::unProjectZO(FarWin, Model, Proj, Viewport) : glm::unProjectNO(FarWin, Model, Proj, Viewport);
+
+		Error += glm::all(glm::epsilonEqual(Origins[i], Near, static_cast<T>(1e-3))) ? 0 : 1;
+		Error += glm::all(glm::epsilonEqual(Directions[i], glm::normalize(Far - Near), static_cast<T>(1e-4))) ? 0 : 1;
+	}
+
+	return Error;
+}
+
+template<typename T>
+static int test_unProjectRays()
+{
+	typedef glm::vec<3, T, glm::defaultp> vec3;
+	typedef glm::mat<4, 4, T, glm::defaultp> mat4;
+
+	int Error = 0;
+
+	mat4 const View = glm::lookAt(vec3(3, 4, 10), vec3(0), vec3(0, 1, 0));
+
+	// Sizes with and without a remainder after the 4 wide loop
+	glm::length_t const Counts[] = {1, 4, 23};
+	for(std::size_t i = 0; i < sizeof(Counts) / sizeof(Counts[0]); ++i)
+	{
+		Error += test_unProjectRays(glm::orthoNO(static_cast<T>(0), static_cast<T>(1920), static_cast<T>(0), static_cast<T>(980), static_cast<T>(-1), static_cast<T>(1)), mat4(1), false, Counts[i]);
+		Error += test_unProjectRays(glm::orthoZO(static_cast<T>(-8), static_cast<T>(8), static_cast<T>(-4), static_cast<T>(4), static_cast<T>(1), static_cast<T>(100)), View, true, Counts[i]);
+		Error += test_unProjectRays(glm::perspectiveNO(glm::radians(static_cast<T>(60)), static_cast<T>(1920) / static_cast<T>(980), static_cast<T>(0.1), static_cast<T>(100)), View, false, Counts[i]);
+		Error += test_unProjectRays(glm::perspectiveZO(glm::radians(static_cast<T>(60)), static_cast<T>(1920) / static_cast<T>(980), static_cast<T>(0.1), static_cast<T>(100)), View, true, Counts[i]);
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	Error += test_unProjectRays<float>();
+	Error += test_unProjectRays<double>();
+
+	return Error;
+}
@@ -0,0 +1,112 @@
+#define GLM_FORCE_INLINE
+#include <glm/ext/matrix_float4x4.hpp>
+#include <glm/ext/matrix_transform.hpp>
+#include <glm/ext/matrix_clip_space.hpp>
+#include <glm/ext/matrix_relational.hpp>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/trigonometric.hpp>
+#if GLM_CONFIG_SIMD == GLM_ENABLE
+#include <glm/gtc/type_aligned.hpp>
+#include <vector>
+#include <chrono>
+#include <cstdio>
+
+// The math of a frame of the match-two game: the models of the 52 cards of the board,
+// with the turning cards rotated, and the models of the 1664 rigid bodies of the end of round cascade,
+// built from their physics transforms. Each model is then combined with the camera.
+template <typename matType>
+struct frame
+{
+	typedef typename matType::value_type T;
+	typedef glm::vec<3, T, matType::col_type::is_aligned::value ? glm::aligned_highp : glm::packed_highp> vecType;
+
+	std::vector<matType> Bodies;
+	std::vector<matType> Models;
+	std::vector<matType> ModelViewProjs;
+	matType ViewProj;
+
+	explicit frame(std::size_t BodyCount)
+		: Bodies(BodyCount)
+		, Models(52 + BodyCount)
+		, ModelViewProjs(52 + BodyCount)
+		, ViewProj(glm::ortho(T(0), T(1920), T(0), T(980), T(-1), T(1)))
+	{
+		for(std::size_t i = 0; i < BodyCount; ++i)
+			Bodies[i] = glm::rotate(glm::translate(matType(T(1)), vecType(T(i % 100), T(i / 100), T(0))), T(i) * T(0.1), vecType(0, 0, 1));
+	}
+
+	void update()
+	{
+		for(std::size_t i = 0; i < 52; ++i)
+		{
+			matType Model = glm::translate(matType(T(1)), vecType(T(145.5) * T(i % 13), T(212) * T(i / 13), T(0)));
+			Model = glm::scale(Model, vecType(T(130), T(130), T(1)));
+			if(i % 4 == 0)
+				Model = glm::rotate(Model, glm::radians(T(i) * T(3)), vecType(0, 1, 0));
+			Models[i] = Model;
+		}
+
+		for(std::size_t i = 0, n = Bodies.size(); i < n; ++i)
+		{
+			matType Model = Bodies[i];
+			Model[3] = typename matType::col_type(vecType(Model[3]) * T(100), T(1));
+			Models[52 + i] = glm::scale(Model, vecType(T(4), T(4), T(1)));
+		}
+
+		for(std::size_t i = 0, n = Models.size(); i < n; ++i)
+			ModelViewProjs[i] = ViewProj * Models[i];
+	}
+};
+
+template <typename matType>
+static int launch_frame(frame<matType>& Frame, std::size_t Frames)
+{
+	std::chrono::high_resolution_clock::time_point t1 = std::chrono::high_resolution_clock::now();
+	for(std::size_t i = 0; i < Frames; ++i)
+		Frame.update();
+	std::chrono::high_resolution_clock::time_point t2 = std::chrono::high_resolution_clock::now();
+
+	return static_cast<int>(std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count());
+}
+
+static int comp_frame(std::size_t BodyCount, std::size_t Frames)
+{
+	int Error = 0;
+
+	frame<glm::mat4> SISD(BodyCount);
+	std::printf("- SISD: %d us\n", launch_frame(SISD, Frames));
+
+	frame<glm::aligned_mat4> SIMD(BodyCount);
+	std::printf("- SIMD: %d us\n", launch_frame(SIMD, Frames));
+
+	for(std::size_t i = 0, n = SISD.ModelViewProjs.size(); i < n; ++i)
+	{
+		glm::mat4 const A = SISD.ModelViewProjs[i];
+		glm::mat4 const B = SIMD.ModelViewProjs[i];
+		Error += glm::all(glm::equal(A, B, 0.001f)) ? 0 : 1;
+	}
+
+	return Error;
+}
+
+int main()
+{
+	int Error = 0;
+
+	std::printf("board frame:\n");
+	Error += comp_frame(0, 10000);
+
+	std::printf("cascade frame:\n");
+	Error += comp_frame(1664, 1000);
+
+	return Error;
+}
+
+#else
+
+int main()
+{
+	return 0;
+}
+
+#endif